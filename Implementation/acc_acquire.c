@@ -0,0 +1,121 @@
+#include "acc_acquire.h"
+#include "acc_config.h"
+#include <stdatomic.h>
+#include <string.h>
+
+// Oversampled Sensor Acquisition (see acc_acquire.h)
+
+#if ACC_OVERSAMPLE_EN
+
+#if (ACC_OVERSAMPLE_TAPS & (ACC_OVERSAMPLE_TAPS - 1u)) != 0u
+#error "ACC_OVERSAMPLE_TAPS must be a power of 2"
+#endif
+#if ACC_OVERSAMPLE_N != ACC_OVERSAMPLE_TAPS + FILTER_MEDIAN_LEN - 1u
+#error "ACC_OVERSAMPLE_N must cover the median windows of ACC_OVERSAMPLE_TAPS outputs"
+#endif
+
+#define FILTER_MIN(a, b)      (((a) < (b)) ? (a) : (b))
+#define FILTER_MAX(a, b)      (((a) < (b)) ? (b) : (a))
+
+void PingPong_Init(ACC_PingPong_t *p_pp)
+{
+    memset(p_pp, 0, sizeof(*p_pp));
+}
+
+ACC_SensorBlock_t *PingPong_Filling(ACC_PingPong_t *p_pp)
+{
+    return &p_pp->buf[p_pp->done & 1u];
+}
+
+void PingPong_Put(ACC_PingPong_t *p_pp, ACC_Value_t dist, ACC_Value_t speed)
+{
+    ACC_SensorBlock_t *p_blk = PingPong_Filling(p_pp);
+
+    p_blk->dist[p_pp->fill] = dist;
+    p_blk->speed[p_pp->fill] = speed;
+    if (++p_pp->fill == ACC_OVERSAMPLE_N)
+    {
+        PingPong_Complete(p_pp);
+    }
+}
+
+void PingPong_Complete(ACC_PingPong_t *p_pp)
+{
+    // Samples are visible before the block is counted ...
+    atomic_thread_fence(memory_order_release);
+    p_pp->done = p_pp->done + 1u;
+    // ... and the count before any sample of the next block (which reuses the
+    // buffer of the block before this one)
+    atomic_thread_fence(memory_order_release);
+    p_pp->fill = 0u;
+}
+
+void PingPong_Restart(ACC_PingPong_t *p_pp)
+{
+    p_pp->fill = 0u;
+}
+
+const ACC_SensorBlock_t *PingPong_Take(ACC_PingPong_t *p_pp, uint32_t *p_seq)
+{
+    uint32_t seq = p_pp->done;
+
+    // done load completes before the sample loads
+    atomic_thread_fence(memory_order_acquire);
+    if (seq == p_pp->taken)
+    {
+        p_pp->missed++;
+        return NULL;
+    }
+    p_pp->taken = seq;
+    *p_seq = seq;
+    return &p_pp->buf[(seq - 1u) & 1u];
+}
+
+bool PingPong_Release(ACC_PingPong_t *p_pp, uint32_t seq)
+{
+    // Sample loads complete before done is re-read
+    atomic_thread_fence(memory_order_acquire);
+    if (p_pp->done != seq)
+    {
+        p_pp->overruns++;
+        return false;
+    }
+    return true;
+}
+
+static inline ACC_Value_t Filter_Avg2(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return (acc_q_t)(((int64_t)a + b) >> 1);
+#else
+    return (a + b) * 0.5f;
+#endif
+}
+
+ACC_Value_t Filter_Block(const ACC_Value_t x[ACC_OVERSAMPLE_N])
+{
+    ACC_Value_t m[ACC_OVERSAMPLE_TAPS];
+    uint32_t i, w;
+
+    // Median of 5 per output: median3(e, max(min(a,b), min(c,d)), min(max(a,b), max(c,d)))
+    for (i = 0u; i < ACC_OVERSAMPLE_TAPS; i++)
+    {
+        ACC_Value_t a = x[i], b = x[i + 1u], c = x[i + 2u], d = x[i + 3u], e = x[i + 4u];
+        ACC_Value_t f = FILTER_MAX(FILTER_MIN(a, b), FILTER_MIN(c, d));
+        ACC_Value_t g = FILTER_MIN(FILTER_MAX(a, b), FILTER_MAX(c, d));
+
+        m[i] = FILTER_MAX(FILTER_MIN(e, f), FILTER_MIN(FILTER_MAX(e, f), g));
+    }
+
+    // Mean of the medians by pairwise halving (no overflow in Q16.16, exact for equal samples)
+    for (w = ACC_OVERSAMPLE_TAPS / 2u; w > 0u; w /= 2u)
+    {
+        for (i = 0u; i < w; i++)
+        {
+            m[i] = Filter_Avg2(m[i], m[i + w]);
+        }
+    }
+    return m[0];
+}
+
+#endif // ACC_OVERSAMPLE_EN
@@ -0,0 +1,58 @@
+#ifndef ACC_ACQUIRE_H
+#define ACC_ACQUIRE_H
+
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Oversampled Sensor Acquisition (ACC_OVERSAMPLE_EN)
+//
+// Ping-pong buffers: the producer (DMA on the target, a sampling thread or
+// the simulation on the host) fills one ACC_SensorBlock_t of
+// ACC_OVERSAMPLE_N distance/speed sample pairs per frame while Sensors_Task
+// filters the other. Block k (k = 1, 2, ...) lives in buf[(k - 1) & 1]; the
+// producer starts overwriting it once block k + 1 is complete, so a consumer
+// that took block k checks `done` again after filtering, seqlock style, and
+// discards the result if the producer has moved on.
+//
+// Filter_Block() reduces one sensor's block to the value published for the
+// frame: a sliding median of 5 (rejects isolated spikes such as radar
+// multipath returns) over the block, then the mean of the newest
+// ACC_OVERSAMPLE_TAPS medians (FIR, cuts white noise by about
+// sqrt(ACC_OVERSAMPLE_TAPS)). Both stages are fixed-length loops of
+// branch-free min/max and add/halve steps over arrays, so the cost per frame
+// does not depend on the data and compilers vectorize them. A block of equal
+// samples filters to exactly that sample.
+
+#define FILTER_MEDIAN_LEN     5u
+
+typedef struct {
+    ACC_Value_t dist[ACC_OVERSAMPLE_N];     // m
+    ACC_Value_t speed[ACC_OVERSAMPLE_N];    // km/h
+} ACC_SensorBlock_t;
+
+typedef struct {
+    ACC_SensorBlock_t buf[2];
+    uint32_t          fill;         // Producer: samples in the block being filled
+    volatile uint32_t done;         // Blocks completed
+    uint32_t          taken;        // Consumer: latest block taken
+    uint32_t          missed;       // Consumer: takes that found no new block
+    uint32_t          skipped;      // Consumer: completed blocks never taken
+    uint32_t          overruns;     // Consumer: blocks overwritten while being filtered
+} ACC_PingPong_t;
+
+void PingPong_Init(ACC_PingPong_t *p_pp);
+
+// Producer side (single writer)
+ACC_SensorBlock_t *PingPong_Filling(ACC_PingPong_t *p_pp);     // Block being filled (DMA target address)
+void PingPong_Put(ACC_PingPong_t *p_pp, ACC_Value_t dist, ACC_Value_t speed);
+void PingPong_Complete(ACC_PingPong_t *p_pp);                   // DMA transfer complete
+void PingPong_Restart(ACC_PingPong_t *p_pp);                    // Drop a partly filled block
+
+// Consumer side (Sensors_Task)
+const ACC_SensorBlock_t *PingPong_Take(ACC_PingPong_t *p_pp, uint32_t *p_seq);
+bool PingPong_Release(ACC_PingPong_t *p_pp, uint32_t seq);      // false: overwritten meanwhile
+
+ACC_Value_t Filter_Block(const ACC_Value_t x[ACC_OVERSAMPLE_N]);
+
+#endif // ACC_ACQUIRE_H
@@ -0,0 +1,213 @@
+#include "acc_calib.h"
+#include "acc_config.h"
+#include <stddef.h>
+#include <string.h>
+
+// Calibration Tables (see acc_calib.h)
+
+#if ACC_CALIB_EN
+
+#define CALIB_FLAT_STEP_KMH   20.0    // Calib_Flat(): breakpoints 0, 20, ... km/h
+#define CALIB_CRC_POLY        0xEDB88320u
+
+static inline ACC_Value_t Calib_Mul(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Mul(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline ACC_Value_t Calib_Add(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Add(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline ACC_Value_t Calib_Sub(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Sub(a, b);
+#else
+    return a - b;
+#endif
+}
+
+// lo ≤ v ≤ hi (false for a NaN in the float build)
+static inline bool Calib_In(ACC_Value_t v, ACC_Value_t lo, ACC_Value_t hi)
+{
+    return v >= lo && v <= hi;
+}
+
+uint32_t Calib_Crc(const ACC_CalibImage_t *p_img)
+{
+    const uint8_t *p = (const uint8_t *)p_img;
+    uint32_t crc = 0xFFFFFFFFu;
+    size_t i;
+    uint32_t bit;
+
+    // Bitwise: writer side only, no table in flash
+    for (i = 0u; i < offsetof(ACC_CalibImage_t, crc); i++)
+    {
+        crc ^= p[i];
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = (crc >> 1) ^ (CALIB_CRC_POLY & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// Checks the image in *p_set and fills in the segment slopes
+static ACC_CalibStatus_t Calib_Check(ACC_CalibSet_t *p_set)
+{
+    const ACC_CalibImage_t *p_img = &p_set->img;
+    uint32_t i;
+
+    if (Calib_Crc(p_img) != p_img->crc)
+    {
+        return CALIB_ERR_CRC;
+    }
+    if (!Calib_In(p_img->Vcruise, ACC_VALUE(CALIB_VCRUISE_MIN), ACC_VALUE(CALIB_VCRUISE_MAX)) ||
+        !Calib_In(p_img->Xset, ACC_VALUE(CALIB_XSET_MIN), ACC_VALUE(CALIB_XSET_MAX)) ||
+        !Calib_In(p_img->deltaV, ACC_VALUE(0.0), ACC_VALUE(CALIB_DELTAV_MAX)) ||
+        !Calib_In(p_img->V[0], ACC_VALUE(0.0), ACC_VALUE(CALIB_V_MAX)))
+    {
+        return CALIB_ERR_RANGE;
+    }
+    for (i = 0u; i < CALIB_POINTS; i++)
+    {
+        if (!Calib_In(p_img->K1[i], ACC_VALUE(0.0), ACC_VALUE(CALIB_K_MAX)) ||
+            !Calib_In(p_img->K2[i], ACC_VALUE(0.0), ACC_VALUE(CALIB_K_MAX)) ||
+            !Calib_In(p_img->K3[i], ACC_VALUE(0.0), ACC_VALUE(CALIB_K_MAX)))
+        {
+            return CALIB_ERR_RANGE;
+        }
+    }
+    for (i = 0u; i + 1u < CALIB_POINTS; i++)
+    {
+        ACC_Value_t step = Calib_Sub(p_img->V[i + 1u], p_img->V[i]);
+
+        if (!Calib_In(p_img->V[i + 1u], ACC_VALUE(0.0), ACC_VALUE(CALIB_V_MAX)) ||
+            !(step >= ACC_VALUE(CALIB_V_STEP_MIN)))
+        {
+            return CALIB_ERR_RANGE;
+        }
+        // Writer side: one division per segment here instead of per frame
+#if ACC_FIXED_POINT
+        p_set->slope[i] = Q_FromFloat(1.0f / Q_ToFloat(step));
+#else
+        p_set->slope[i] = 1.0f / step;
+#endif
+    }
+    return CALIB_OK;
+}
+
+ACC_CalibStatus_t Calib_Init(ACC_Calib_t *p_cal, const ACC_CalibImage_t *p_img)
+{
+    ACC_CalibStatus_t status;
+
+    memset(p_cal, 0, sizeof(*p_cal));
+    p_cal->buf[0].img = *p_img;
+    status = Calib_Check(&p_cal->buf[0]);
+    p_cal->active = &p_cal->buf[0];
+    p_cal->last = 0u;
+    atomic_init(&p_cal->pending, NULL);
+    return status;
+}
+
+void Calib_Flat(ACC_CalibImage_t *p_img, uint32_t version,
+                ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                ACC_Value_t Vcruise, ACC_Value_t Xset, ACC_Value_t deltaV)
+{
+    uint32_t i;
+
+    memset(p_img, 0, sizeof(*p_img));
+    p_img->version = version;
+    p_img->Vcruise = Vcruise;
+    p_img->Xset = Xset;
+    p_img->deltaV = deltaV;
+    for (i = 0u; i < CALIB_POINTS; i++)
+    {
+        p_img->V[i] = ACC_VALUE_FROM_FLOAT((float)(CALIB_FLAT_STEP_KMH * i));
+        p_img->K1[i] = K1;
+        p_img->K2[i] = K2;
+        p_img->K3[i] = K3;
+    }
+    p_img->crc = Calib_Crc(p_img);
+}
+
+ACC_CalibStatus_t Calib_Write(ACC_Calib_t *p_cal, const ACC_CalibImage_t *p_img)
+{
+    ACC_CalibSet_t *p_set;
+    ACC_CalibStatus_t status;
+    uint8_t b;
+
+    // Take back an image Control has not started a frame with: it was never
+    // in force, the one published before it still is. The other buffer is
+    // free either way.
+    if (atomic_exchange_explicit(&p_cal->pending, NULL, memory_order_acq_rel) != NULL)
+    {
+        p_cal->last ^= 1u;
+    }
+    b = (uint8_t)(p_cal->last ^ 1u);
+    p_set = &p_cal->buf[b];
+    p_set->img = *p_img;
+    status = Calib_Check(p_set);
+    if (status != CALIB_OK)
+    {
+        p_cal->rejected++;
+        return status;
+    }
+
+    // Buffer complete before Control can see its address
+    atomic_store_explicit(&p_cal->pending, p_set, memory_order_release);
+    p_cal->last = b;
+    p_cal->written++;
+    return CALIB_OK;
+}
+
+const ACC_CalibSet_t *Calib_Frame(ACC_Calib_t *p_cal)
+{
+    const ACC_CalibSet_t *p_set = atomic_exchange_explicit(&p_cal->pending, NULL, memory_order_acquire);
+
+    if (p_set != NULL)
+    {
+        p_cal->active = p_set;
+        p_cal->swaps++;
+    }
+    return p_cal->active;
+}
+
+void Calib_Gains(const ACC_CalibSet_t *p_set, ACC_Value_t Vn,
+                 ACC_Value_t *p_K1, ACC_Value_t *p_K2, ACC_Value_t *p_K3)
+{
+    const ACC_CalibImage_t *p_img = &p_set->img;
+    ACC_Value_t t;
+    uint32_t i = 0u;
+
+    // Segment [V[i], V[i+1]] holding Vn, the first or last one beyond the
+    // ends; t is clamped there, so the end values are held
+    while (i + 2u < CALIB_POINTS && Vn >= p_img->V[i + 1u])
+    {
+        i++;
+    }
+    t = Calib_Mul(Calib_Sub(Vn, p_img->V[i]), p_set->slope[i]);
+    if (t < ACC_VALUE(0.0))
+    {
+        t = ACC_VALUE(0.0);
+    }
+    else if (t > ACC_VALUE(1.0))
+    {
+        t = ACC_VALUE(1.0);
+    }
+    *p_K1 = Calib_Add(p_img->K1[i], Calib_Mul(t, Calib_Sub(p_img->K1[i + 1u], p_img->K1[i])));
+    *p_K2 = Calib_Add(p_img->K2[i], Calib_Mul(t, Calib_Sub(p_img->K2[i + 1u], p_img->K2[i])));
+    *p_K3 = Calib_Add(p_img->K3[i], Calib_Mul(t, Calib_Sub(p_img->K3[i + 1u], p_img->K3[i])));
+}
+
+#endif // ACC_CALIB_EN
@@ -0,0 +1,89 @@
+#ifndef ACC_CALIB_H
+#define ACC_CALIB_H
+
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Calibration Tables (ACC_CALIB_EN)
+//
+// K1..K3 are tables over the ego speed (CALIB_POINTS breakpoints, linear in
+// between, held beyond the ends); Vcruise, Xset and deltaV are scalars of the
+// same set. A set is replaced whole, never field by field:
+//   writer   one task below the hard tasks (calibration link, diagnostics)
+//            calls Calib_Write() with a new image. It is copied into the
+//            buffer Control does not use, checked there (CRC-32, ranges,
+//            increasing breakpoints) and published by storing its address
+//            in `pending`. A rejected image changes nothing in force.
+//   Control  takes `pending` at the start of each engaged frame with one
+//            atomic exchange (Calib_Frame()) and uses that set, through
+//            `active`, for the whole frame. Sensors_Task reads `active`
+//            (Xset for the rate levels) on the same core, before Control.
+// Nothing waits on the other side: the writer never touches `active`'s
+// buffer, and Control's cost is one exchange per frame instead of a
+// configuration snapshot. The exchange also tells the writer which buffer is
+// free: if the writer takes `pending` back first (Control has not started a
+// frame since, e.g. ACC off), that image was never in force and its buffer is
+// reused; otherwise Control now uses it and the other one is free. An image
+// taken back is dropped even if the one replacing it is then rejected.
+//
+// The CRC covers the image as stored (ACC_Value_t: float or Q16.16), so an
+// image belongs to the build it was made for.
+
+typedef struct {
+    uint32_t    version;                    // Chosen by the writer, reported only
+    ACC_Value_t Vcruise;                    // km/h
+    ACC_Value_t Xset;                       // m
+    ACC_Value_t deltaV;                     // km/h per TIMER_PERIOD_MS frame
+    ACC_Value_t V[CALIB_POINTS];            // Ego-speed breakpoints (km/h), increasing
+    ACC_Value_t K1[CALIB_POINTS];
+    ACC_Value_t K2[CALIB_POINTS];
+    ACC_Value_t K3[CALIB_POINTS];
+    uint32_t    crc;                        // CRC-32 of every field above
+} ACC_CalibImage_t;
+
+typedef struct {
+    ACC_CalibImage_t img;
+    ACC_Value_t      slope[CALIB_POINTS - 1u];  // 1 / (V[i+1] - V[i]), set when checked
+} ACC_CalibSet_t;
+
+typedef struct {
+    ACC_CalibSet_t                   buf[2];
+    const ACC_CalibSet_t            *active;    // Control (Sensors reads it)
+    _Atomic(const ACC_CalibSet_t *)  pending;   // Writer → Control
+    uint8_t                          last;      // Writer: buffer in force or pending
+    uint32_t                         written;   // Writer: images published
+    uint32_t                         rejected;  // Writer: images refused
+    uint32_t                         swaps;     // Control: sets taken
+} ACC_Calib_t;
+
+typedef enum {
+    CALIB_OK = 0,
+    CALIB_ERR_CRC,                  // Image damaged in transfer
+    CALIB_ERR_RANGE                 // A value outside its CALIB_* range (acc_config.h)
+} ACC_CalibStatus_t;
+
+// Before the kernel starts: check *p_img and put it in force directly
+ACC_CalibStatus_t Calib_Init(ACC_Calib_t *p_cal, const ACC_CalibImage_t *p_img);
+
+// Image with the same gains at every speed (evenly spread breakpoints), CRC set
+void Calib_Flat(ACC_CalibImage_t *p_img, uint32_t version,
+                ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                ACC_Value_t Vcruise, ACC_Value_t Xset, ACC_Value_t deltaV);
+
+// CRC-32 (IEEE 802.3) of an image without its crc field
+uint32_t Calib_Crc(const ACC_CalibImage_t *p_img);
+
+// Writer side (single writer task)
+ACC_CalibStatus_t Calib_Write(ACC_Calib_t *p_cal, const ACC_CalibImage_t *p_img);
+
+// Control side: frame boundary, returns the set for this frame
+const ACC_CalibSet_t *Calib_Frame(ACC_Calib_t *p_cal);
+
+// K1..K3 at ego speed Vn (km/h)
+void Calib_Gains(const ACC_CalibSet_t *p_set, ACC_Value_t Vn,
+                 ACC_Value_t *p_K1, ACC_Value_t *p_K2, ACC_Value_t *p_K3);
+
+#endif // ACC_CALIB_H
@@ -0,0 +1,105 @@
+#include "acc_control.h"
+
+// Control Law (see acc_control.h)
+
+float Control_Law_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                        float Vn, float Vn1, float Vn2,
+                        float K1, float K2, float K3,
+                        float *p_Vset)
+{
+    float Vset;
+    float e_n, e_n1, e_n2;  // Error values
+
+    if (Xn >= Xset)
+    {
+        // Equation 1: Vset = Vcruise
+        Vset = Vcruise;
+    }
+    else  // Xn < Xset
+    {
+        // Equation 4: Vset = Vset - deltaV
+        Vset = *p_Vset - deltaV;
+    }
+    *p_Vset = Vset;
+
+    // Equation 2: Calculate errors
+    e_n = Vset - Vn;
+    e_n1 = Vset - Vn1;
+    e_n2 = Vset - Vn2;
+
+    // Equation 3: Calculate manipulated variable
+    return K1 * e_n + K2 * e_n1 + K3 * e_n2;
+}
+
+acc_q_t Control_Law_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                          acc_q_t Vn, acc_q_t Vn1, acc_q_t Vn2,
+                          acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                          acc_q_t *p_Vset)
+{
+    acc_q_t Vset;
+    acc_q_t e_n, e_n1, e_n2;  // Error values
+
+    if (Xn >= Xset)
+    {
+        // Equation 1: Vset = Vcruise
+        Vset = Vcruise;
+    }
+    else  // Xn < Xset
+    {
+        // Equation 4: Vset = Vset - deltaV (saturates instead of wrapping)
+        Vset = Q_Sub(*p_Vset, deltaV);
+    }
+    *p_Vset = Vset;
+
+    // Equation 2: Calculate errors
+    e_n = Q_Sub(Vset, Vn);
+    e_n1 = Q_Sub(Vset, Vn1);
+    e_n2 = Q_Sub(Vset, Vn2);
+
+    // Equation 3: Calculate manipulated variable
+    return Q_Add(Q_Add(Q_Mul(K1, e_n), Q_Mul(K2, e_n1)), Q_Mul(K3, e_n2));
+}
+
+float Control_LawDegraded_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                                float Vn,
+                                float K1, float K2, float K3,
+                                float *p_Vset)
+{
+    float Vset;
+
+    // Equations 1 and 4 as in Control_Law_Float()
+    if (Xn >= Xset)
+    {
+        Vset = Vcruise;
+    }
+    else
+    {
+        Vset = *p_Vset - deltaV;
+    }
+    *p_Vset = Vset;
+
+    // Equation 3 with e(n-1) = e(n-2) = e(n)
+    return (K1 + K2 + K3) * (Vset - Vn);
+}
+
+acc_q_t Control_LawDegraded_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                                  acc_q_t Vn,
+                                  acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                                  acc_q_t *p_Vset)
+{
+    acc_q_t Vset;
+
+    // Equations 1 and 4 as in Control_Law_Fixed()
+    if (Xn >= Xset)
+    {
+        Vset = Vcruise;
+    }
+    else
+    {
+        Vset = Q_Sub(*p_Vset, deltaV);
+    }
+    *p_Vset = Vset;
+
+    // Equation 3 with e(n-1) = e(n-2) = e(n)
+    return Q_Mul(Q_Add(Q_Add(K1, K2), K3), Q_Sub(Vset, Vn));
+}
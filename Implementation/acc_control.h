@@ -0,0 +1,44 @@
+#ifndef ACC_CONTROL_H
+#define ACC_CONTROL_H
+
+#include "acc_fixed.h"
+
+// Control Law (Equations 1-4)
+//
+// Given the cycle's snapshot of the Parameter Memory Block, returns dM(n) and
+// updates *p_Vset (Equation 1 resets it to Vcruise, Equation 4 ramps it down
+// by deltaV). Both variants are always built so host tools can compare them;
+// Control_Law() is the one selected by ACC_FIXED_POINT.
+
+float Control_Law_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                        float Vn, float Vn1, float Vn2,
+                        float K1, float K2, float K3,
+                        float *p_Vset);
+
+// Same law in Q16.16: every add, subtract and multiply saturates
+acc_q_t Control_Law_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                          acc_q_t Vn, acc_q_t Vn1, acc_q_t Vn2,
+                          acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                          acc_q_t *p_Vset);
+
+// Degraded law (high criticality, acc_mode.h): Equations 1, 2 and 4 as
+// above, Equation 3 on the current error only with the summed gain
+// K1 + K2 + K3 (the same static gain): no speed history, one multiply
+float Control_LawDegraded_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                                float Vn,
+                                float K1, float K2, float K3,
+                                float *p_Vset);
+acc_q_t Control_LawDegraded_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                                  acc_q_t Vn,
+                                  acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                                  acc_q_t *p_Vset);
+
+#if ACC_FIXED_POINT
+#define Control_Law           Control_Law_Fixed
+#define Control_LawDegraded   Control_LawDegraded_Fixed
+#else
+#define Control_Law           Control_Law_Float
+#define Control_LawDegraded   Control_LawDegraded_Float
+#endif
+
+#endif // ACC_CONTROL_H
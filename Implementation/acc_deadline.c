@@ -0,0 +1,83 @@
+#include "acc_deadline.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Per-Job Deadline Monitor (see acc_deadline.h)
+
+#if DEADLINE_MK_K > DEADLINE_WINDOW_MAX || DEADLINE_MK_M > DEADLINE_MK_K || DEADLINE_MK_K == 0
+#error "DEADLINE_MK_M/DEADLINE_MK_K: need 0 <= m <= k <= DEADLINE_WINDOW_MAX, k > 0"
+#endif
+
+#define DEADLINE_WINDOW_OLDEST  (1ul << (DEADLINE_MK_K - 1u))
+
+void Deadline_Reset(ACC_Deadline_t *p_mon)
+{
+    memset(p_mon, 0, sizeof(*p_mon));
+}
+
+void Deadline_Rearm(ACC_Deadline_t *p_mon)
+{
+    // The open job and the window belong to the frames rolled back
+    p_mon->open = false;
+    p_mon->window = 0u;
+    p_mon->window_misses = 0u;
+    p_mon->consec = 0u;
+}
+
+bool Deadline_Release(ACC_Deadline_t *p_mon, CPU_TS release_ts, CPU_TS rel_deadline)
+{
+    if (p_mon->open)
+    {
+        // Completion is written before its release, so a matching release
+        // means done_ts belongs to the open job
+        bool done = p_mon->done_release == p_mon->release;
+        CPU_TS done_ts = p_mon->done_ts;
+        uint32_t miss = 1u;
+
+        if (done)
+        {
+            int32_t lateness = (int32_t)(done_ts - p_mon->deadline);
+
+            if (p_mon->jobs == p_mon->unfinished || lateness > p_mon->lateness_max)
+            {
+                p_mon->lateness_max = lateness;     // First completed job, or a worse one
+            }
+            p_mon->lateness_sum += lateness;
+            miss = (lateness > 0) ? 1u : 0u;
+            p_mon->late += miss;
+        }
+        else
+        {
+            p_mon->unfinished++;
+        }
+        p_mon->jobs++;
+
+        // Slide the window: drop the oldest verdict, add this one
+        p_mon->window_misses -= ((p_mon->window & DEADLINE_WINDOW_OLDEST) != 0u) ? 1u : 0u;
+        p_mon->window = (p_mon->window << 1) | miss;
+        p_mon->window_misses += miss;
+
+        p_mon->consec = miss ? p_mon->consec + 1u : 0u;
+        if (p_mon->consec > p_mon->consec_max)
+        {
+            p_mon->consec_max = p_mon->consec;
+        }
+    }
+
+    p_mon->release = release_ts;
+    p_mon->deadline = release_ts + rel_deadline;
+    p_mon->open = true;
+
+    if (p_mon->window_misses > DEADLINE_MK_K - DEADLINE_MK_M)
+    {
+        p_mon->violations++;
+        return true;
+    }
+    return false;
+}
+
+void Deadline_Complete(ACC_Deadline_t *p_mon, CPU_TS release_ts, CPU_TS done_ts)
+{
+    p_mon->done_ts = done_ts;
+    p_mon->done_release = release_ts;
+}
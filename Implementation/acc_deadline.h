@@ -0,0 +1,71 @@
+#ifndef ACC_DEADLINE_H
+#define ACC_DEADLINE_H
+
+#include "os.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-Job Deadline Monitor
+//
+// Every frame is a job released by IRQ_sensors_ISR: the OSSemPend timestamp
+// of the Timer Semaphore is its release, and release + FRAME_DEADLINE_MS its
+// absolute deadline. The release timestamp travels with the frame (Parameter
+// Memory Block, then the Control → Actuator mailbox), so the Actuator stage
+// stamps its completion against the exact job it applied.
+//
+// Two writers, no lock:
+//   Deadline_Complete()  Actuator stage: records (release, completion) of the
+//                        job it applied, completion first
+//   Deadline_Release()   Sensors stage, at the next release: judges the
+//                        previous job and opens the new one; the only writer
+//                        of everything else
+// A job is met if it completed by its deadline. It missed if it completed
+// later (lateness recorded exactly) or had not completed by the next release
+// (unfinished: the Actuator never applied it, or applied it only after the
+// next release, which is past any deadline of at most one period).
+//
+// Miss policy, (m,k)-firm: at least DEADLINE_MK_M of any DEADLINE_MK_K
+// consecutive jobs must meet their deadline. The verdicts of the last k jobs
+// are a bit window with a running miss count, so a release costs the same
+// few instructions whatever k is; Deadline_Release() returns true when the
+// window holds more than k − m misses, and the caller raises
+// DEADLINE_MISS_FLAG. No kernel object is involved.
+
+#define DEADLINE_WINDOW_MAX   32u     // Longest (m,k) window (bits in the verdict window)
+
+// Milliseconds to timestamp ticks
+#define DEADLINE_MS_TO_TS(ms) ((CPU_TS)(ms) * (CPU_TS)(CPU_TS_TmrFreq_Hz / 1000u))
+
+typedef struct {
+    // Completion side (Actuator stage)
+    volatile CPU_TS done_release;   // Release of the job applied last
+    volatile CPU_TS done_ts;        // Its completion time
+
+    // Release side (Sensors stage)
+    CPU_TS   release;               // Open job: ISR release
+    CPU_TS   deadline;              // Open job: absolute deadline
+    bool     open;                  // A job is waiting for its verdict
+    uint32_t window;                // Verdicts of the last k jobs, bit 0 newest (1 = miss)
+    uint32_t window_misses;         // Ones in window
+    uint32_t jobs;                  // Jobs judged
+    uint32_t late;                  // Completed after the deadline
+    uint32_t unfinished;            // Not completed by the next release
+    uint32_t consec;                // Current run of misses
+    uint32_t consec_max;            // Longest run of misses
+    uint32_t violations;            // Releases at which (m,k) did not hold
+    int32_t  lateness_max;          // Completion − deadline, worst completed job (ts units, < 0: slack)
+    int64_t  lateness_sum;          // Over the completed jobs
+} ACC_Deadline_t;
+
+void Deadline_Reset(ACC_Deadline_t *p_mon);     // ACC engaged: no open job, clean window
+void Deadline_Rearm(ACC_Deadline_t *p_mon);     // Rollback: as Deadline_Reset, counts kept
+
+// Judges the open job, then opens the job released at release_ts with the
+// relative deadline rel_deadline (ts units). Returns true if (m,k) is
+// violated after the verdict.
+bool Deadline_Release(ACC_Deadline_t *p_mon, CPU_TS release_ts, CPU_TS rel_deadline);
+
+// The job released at release_ts was applied at done_ts
+void Deadline_Complete(ACC_Deadline_t *p_mon, CPU_TS release_ts, CPU_TS done_ts);
+
+#endif // ACC_DEADLINE_H
@@ -0,0 +1,139 @@
+#include "acc_display.h"
+#include "acc_hardware.h"
+#include <string.h>
+
+// Incremental LCD Rendering (see acc_display.h)
+
+#define DISPLAY_FIELD_W       4u      // Numeric field width (-999 .. 9999)
+#define DISPLAY_FIELD_MAX     9999
+#define DISPLAY_FIELD_MIN     (-999)
+
+static const char DisplayLabels[DISPLAY_ROWS][DISPLAY_COLS + 1u] = {
+    "Dist      m     ",
+    "Speed      km/h ",
+};
+
+// Value in tenths of a unit, rounded (integer-only on the Q16.16 build)
+static int32_t Display_Tenths(ACC_Value_t v)
+{
+#if ACC_FIXED_POINT
+    int64_t t = (int64_t)v * 10;
+
+    t += (t >= 0) ? (ACC_Q_ONE / 2) : -(ACC_Q_ONE / 2);
+    return (int32_t)(t / ACC_Q_ONE);
+#else
+    float t = v * 10.0f;
+
+    if (t > 1e8f)
+    {
+        return 100000000;
+    }
+    if (t < -1e8f)
+    {
+        return -100000000;
+    }
+    return (int32_t)(t + ((t >= 0.0f) ? 0.5f : -0.5f));
+#endif
+}
+
+// Shown integer after hysteresis: keep it while the value stays within half
+// a unit plus DISPLAY_HYST_TENTHS of it
+static int32_t Display_Hyst(int32_t shown, int32_t tenths, bool valid)
+{
+    int32_t d = tenths - shown * 10;
+    int32_t n;
+
+    if (valid && d <= 5 + DISPLAY_HYST_TENTHS && d >= -(5 + DISPLAY_HYST_TENTHS))
+    {
+        return shown;
+    }
+    n = (tenths + ((tenths >= 0) ? 5 : -5)) / 10;
+    return (n > DISPLAY_FIELD_MAX) ? DISPLAY_FIELD_MAX : (n < DISPLAY_FIELD_MIN) ? DISPLAY_FIELD_MIN : n;
+}
+
+// Right-aligned integer in DISPLAY_FIELD_W cells
+static void Display_Field(char *p_cell, int32_t n)
+{
+    uint32_t u = (uint32_t)((n < 0) ? -n : n);
+    uint32_t i = DISPLAY_FIELD_W;
+
+    memset(p_cell, ' ', DISPLAY_FIELD_W);
+    do
+    {
+        p_cell[--i] = (char)('0' + u % 10u);
+        u /= 10u;
+    } while (u != 0u && i > 0u);
+    if (n < 0 && i > 0u)
+    {
+        p_cell[i - 1u] = '-';
+    }
+}
+
+// Sends the changed runs of one row; returns the bus bytes
+static uint32_t Display_Row(ACC_Display_t *p_disp, uint8_t row)
+{
+    const char *p_new = p_disp->frame[row];
+    char *p_old = p_disp->shadow[row];
+    uint32_t bytes = 0u;
+    uint32_t col = 0u, last, j;
+
+    while (col < DISPLAY_COLS)
+    {
+        if (p_new[col] == p_old[col])
+        {
+            col++;
+            continue;
+        }
+        // Extend the run over gaps no longer than a new address command
+        last = col;
+        for (j = col + 1u; j < DISPLAY_COLS && j - last <= LCD_ADDR_BYTES + 1u; j++)
+        {
+            if (p_new[j] != p_old[j])
+            {
+                last = j;
+            }
+        }
+        LCD_Write(row, (uint8_t)col, &p_new[col], (uint8_t)(last - col + 1u));
+        memcpy(&p_old[col], &p_new[col], last - col + 1u);
+        bytes += LCD_ADDR_BYTES + (last - col + 1u);
+        col = last + 1u;
+    }
+    return bytes;
+}
+
+void Display_Init(ACC_Display_t *p_disp)
+{
+    memset(p_disp, 0, sizeof(*p_disp));     // Shadow of NULs differs from every printable cell
+}
+
+uint32_t Display_Update(ACC_Display_t *p_disp, ACC_Value_t distance, ACC_Value_t speed, uint8_t status)
+{
+    uint32_t bytes = 0u;
+    uint8_t row;
+
+    p_disp->dist = Display_Hyst(p_disp->dist, Display_Tenths(distance), p_disp->valid);
+    p_disp->speed = Display_Hyst(p_disp->speed, Display_Tenths(speed), p_disp->valid);
+    p_disp->status = status;
+    p_disp->valid = true;
+
+    // Off-screen frame: labels, then the fields
+    for (row = 0u; row < DISPLAY_ROWS; row++)
+    {
+        memcpy(p_disp->frame[row], DisplayLabels[row], DISPLAY_COLS);
+    }
+    Display_Field(&p_disp->frame[0][5], p_disp->dist);
+    memcpy(&p_disp->frame[0][13], (status != 0u) ? " ON" : "OFF", 3u);
+    Display_Field(&p_disp->frame[1][6], p_disp->speed);
+
+    for (row = 0u; row < DISPLAY_ROWS; row++)
+    {
+        bytes += Display_Row(p_disp, row);
+    }
+    p_disp->updates++;
+    p_disp->bytes += bytes;
+    if (bytes > p_disp->bytes_max)
+    {
+        p_disp->bytes_max = bytes;
+    }
+    return bytes;
+}
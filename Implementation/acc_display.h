@@ -0,0 +1,49 @@
+#ifndef ACC_DISPLAY_H
+#define ACC_DISPLAY_H
+
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Incremental LCD Rendering (Display_Task)
+//
+// The panel is modelled as DISPLAY_ROWS × DISPLAY_COLS character cells.
+// Display_Update() formats the values into an off-screen frame, compares it
+// with a shadow of what the panel already shows and sends only the changed
+// runs of cells through LCD_Write() (acc_hardware.h). A numeric field only
+// changes when its value leaves the shown integer by more than half a unit
+// plus DISPLAY_HYST_TENTHS, so sensor noise around a rounding boundary does
+// not toggle digits. Labels are sent once, on the first update.
+//
+//   Dist  123 m   ON
+//   Speed   98 km/h
+//
+// Bus cost model: every LCD_Write() is one address command (LCD_ADDR_BYTES)
+// plus one data byte per cell, so runs separated by no more than
+// LCD_ADDR_BYTES unchanged cells are merged (resending those cells costs no
+// more than a new address).
+
+#define DISPLAY_ROWS          2u
+#define DISPLAY_COLS          16u
+#define DISPLAY_HYST_TENTHS   3       // Hysteresis beyond the rounding boundary (0.3 m, 0.3 km/h)
+#define LCD_ADDR_BYTES        1u      // Set-address command per write (HD44780-style)
+
+// Bus bytes of a full redraw: one write per row
+#define DISPLAY_FULL_BYTES    (DISPLAY_ROWS * (LCD_ADDR_BYTES + DISPLAY_COLS))
+
+typedef struct {
+    char     shadow[DISPLAY_ROWS][DISPLAY_COLS];    // What the panel shows
+    char     frame[DISPLAY_ROWS][DISPLAY_COLS];     // Off-screen frame being built
+    bool     valid;                 // Shadow matches the panel (false until the first update)
+    int32_t  dist;                  // Shown distance (m)
+    int32_t  speed;                 // Shown speed (km/h)
+    uint8_t  status;                // Shown ACC01
+    uint32_t updates;               // Display_Update() calls
+    uint32_t bytes;                 // Bus bytes sent in total
+    uint32_t bytes_max;             // Most bus bytes sent by one update
+} ACC_Display_t;
+
+void     Display_Init(ACC_Display_t *p_disp);
+uint32_t Display_Update(ACC_Display_t *p_disp, ACC_Value_t distance, ACC_Value_t speed, uint8_t status);
+
+#endif // ACC_DISPLAY_H
@@ -0,0 +1,100 @@
+#ifndef ACC_FIXED_H
+#define ACC_FIXED_H
+
+#include "acc_config.h"
+#include <stdint.h>
+
+// Q16.16 Fixed-Point Arithmetic
+//
+// acc_q_t holds value × 2^16 in an int32_t: range ±32768, resolution
+// 1.5e-5 (km/h, m or controller units). Add, subtract and multiply saturate
+// at ACC_Q_MAX/ACC_Q_MIN instead of wrapping, so an out-of-range result keeps
+// its sign; multiply rounds to nearest. Only integer instructions are used.
+
+typedef int32_t acc_q_t;
+
+#define ACC_Q_FRAC_BITS   16
+#define ACC_Q_ONE         ((acc_q_t)1 << ACC_Q_FRAC_BITS)
+#define ACC_Q_MAX         ((acc_q_t)INT32_MAX)
+#define ACC_Q_MIN         ((acc_q_t)INT32_MIN)
+
+// Compile-time constant conversion (folded by the compiler, no FP at run time)
+#define ACC_Q_CONST(x)    ((acc_q_t)((x) * (double)ACC_Q_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+
+static inline acc_q_t Q_Sat(int64_t v)
+{
+    if (v > (int64_t)ACC_Q_MAX)
+    {
+        return ACC_Q_MAX;
+    }
+    if (v < (int64_t)ACC_Q_MIN)
+    {
+        return ACC_Q_MIN;
+    }
+    return (acc_q_t)v;
+}
+
+static inline acc_q_t Q_Add(acc_q_t a, acc_q_t b)
+{
+    return Q_Sat((int64_t)a + b);
+}
+
+static inline acc_q_t Q_Sub(acc_q_t a, acc_q_t b)
+{
+    return Q_Sat((int64_t)a - b);
+}
+
+static inline acc_q_t Q_Mul(acc_q_t a, acc_q_t b)
+{
+    int64_t p = (int64_t)a * b;
+
+    // Round half away from zero, then drop the extra fraction bits
+    p += (p >= 0) ? (1 << (ACC_Q_FRAC_BITS - 1)) : -(1 << (ACC_Q_FRAC_BITS - 1));
+    return Q_Sat(p / ACC_Q_ONE);
+}
+
+// Run-time conversions: these use FP and belong in the HAL, host tools and
+// soft tasks only, never on the hard-task path of an FP-less build
+static inline acc_q_t Q_FromFloat(float f)
+{
+    float v = f * (float)ACC_Q_ONE;
+
+    if (v >= 2147483647.0f)
+    {
+        return ACC_Q_MAX;
+    }
+    if (v <= -2147483648.0f)
+    {
+        return ACC_Q_MIN;
+    }
+    if (v >= 8388608.0f || v <= -8388608.0f)
+    {
+        return (acc_q_t)v;      // |v| ≥ 2^23 is already integral (adding 0.5f would round)
+    }
+    return (acc_q_t)(v + ((v >= 0.0f) ? 0.5f : -0.5f));
+}
+
+static inline float Q_ToFloat(acc_q_t q)
+{
+    return (float)q / (float)ACC_Q_ONE;
+}
+
+// Control-Path Value Type
+//
+// ACC_Value_t is the type of every Parameter Memory Block value, of the
+// Control → Actuator command and of the HAL sensor/actuator interface. With
+// ACC_FIXED_POINT (acc_config.h) it is acc_q_t and the hard tasks need no FP
+// context; otherwise it is float.
+#if ACC_FIXED_POINT
+typedef acc_q_t ACC_Value_t;
+#define ACC_VALUE(x)              ACC_Q_CONST(x)
+#define ACC_VALUE_TO_FLOAT(v)     Q_ToFloat(v)
+#define ACC_VALUE_FROM_FLOAT(f)   Q_FromFloat(f)
+#else
+typedef float ACC_Value_t;
+#define ACC_VALUE(x)              ((float)(x))
+#define ACC_VALUE_TO_FLOAT(v)     (v)
+#define ACC_VALUE_FROM_FLOAT(f)   (f)
+#endif
+
+#endif // ACC_FIXED_H
@@ -1,37 +1,165 @@
 #include "acc_hardware.h"
+#include "acc_config.h"
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
+
+#if ACC_RECORD_EN
+#include "acc_log.h"
+#endif
 
 // Hardware Abstraction Layer
 // These functions interface with actual hardware peripherals
 
-float Read_Distance_Sensor(void)
+#if ACC_RECORD_EN
+// Drive recording: one ACC_LogRec_t per frame in a RAM image (acc_log.h).
+// Sensors_Task reads distance then speed; the sample is logged once both are
+// known and completed by the Actuator_Task output. Logging runs with the
+// scheduler locked because the two sides are different tasks.
+static CPU_INT32U RecordMem[(sizeof(ACC_LogHdr_t) + ACC_RECORD_FRAMES * sizeof(ACC_LogRec_t) + 3u) / 4u];
+static ACC_Log_t  RecordLog;
+static OS_TICK    RecordEngageTick;
+static ACC_Value_t RecordXn;
+
+static void Record_Sample(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    OS_ERR err;
+    OS_TICK now = OSTimeGet(&err);
+
+    OSSchedLock(&err);
+    Log_Sample(&RecordLog,
+               (uint32_t)(((now - RecordEngageTick) * 1000u) / OS_CFG_TICK_RATE_HZ),
+               Xn, Vn);
+    OSSchedUnlock(&err);
+}
+#endif
+
+#if ACC_OVERSAMPLE_EN
+// Oversampled acquisition: a timer triggers the distance/speed interfaces
+// ACC_OVERSAMPLE_N times per frame and DMA stores each sample pair into the
+// block being filled (PingPong_Filling); the transfer-complete interrupt
+// hands the block to Sensors_Task and re-arms DMA on the other buffer.
+static ACC_PingPong_t SensorPingPong;
+
+void DMA_Sensors_ISR(void)
+{
+    // Pseudo-code: DMA transfer-complete interrupt
+    // In real implementation, this would:
+    // 1. Clear the DMA transfer-complete flag
+    // 2. Hand the block over, then point DMA at the next buffer:
+    //      PingPong_Complete(&SensorPingPong);
+    //      DMA->DST = PingPong_Filling(&SensorPingPong); DMA->COUNT = ACC_OVERSAMPLE_N;
+    OSIntEnter();
+    PingPong_Complete(&SensorPingPong);
+    OSIntExit();
+}
+
+const ACC_SensorBlock_t *Read_Sensor_Block(uint32_t *p_seq)
+{
+    return PingPong_Take(&SensorPingPong, p_seq);
+}
+
+bool Release_Sensor_Block(uint32_t seq, ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    if (!PingPong_Release(&SensorPingPong, seq))
+    {
+        return false;
+    }
+#if ACC_RECORD_EN
+    Record_Sample(Xn, Vn);
+#endif
+    return true;
+}
+#endif
+
+#if ACC_RADAR_EN
+// Multi-target radar: the radar sends its track list once per radar cycle
+// (CAN FD / Ethernet, one message per track, then an end-of-cycle message
+// with the count). The receive interrupt assembles a frame in a receive copy;
+// the end-of-cycle message makes it the newest complete frame.
+static ACC_RadarFrame_t RadarDone;     // Newest complete frame
+
+void Radar_Rx_ISR(void)
+{
+    // Pseudo-code: radar message receive interrupt
+    // In real implementation, this would:
+    // 1. Read the message from the receive FIFO and release the FIFO entry
+    // 2. Track message: scale range, range rate, azimuth into the receive
+    //    copy's slot (track id) as ACC_Value_t
+    // 3. End-of-cycle message: set the count, sample the yaw-rate sensor
+    //    (yaw_rate) and copy the receive copy to RadarDone
+    OSIntEnter();
+    OSIntExit();
+}
+
+void Read_Radar_Frame(ACC_RadarFrame_t *p_frame)
+{
+    CPU_SR_ALLOC();
+
+    // The radar cycle is shorter than the frame: copy with its receive
+    // interrupt held off (about 800 bytes)
+    CPU_CRITICAL_ENTER();
+    memcpy(p_frame, &RadarDone, sizeof(*p_frame));
+    CPU_CRITICAL_EXIT();
+}
+
+void Release_Radar_Frame(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+#if ACC_RECORD_EN
+    Record_Sample(Xn, Vn);
+#else
+    (void)Xn;  // Suppress unused parameter warnings
+    (void)Vn;
+#endif
+}
+#endif
+
+ACC_Value_t Read_Distance_Sensor(void)
 {
     // Pseudo-code: Read distance sensor hardware
     // In real implementation, this would:
     // 1. Read ADC or digital sensor interface
-    // 2. Convert raw value to distance (meters)
+    // 2. Convert raw value to distance (meters, ACC_Value_t; integer scaling
+    //    with ACC_FIXED_POINT)
     // 3. Return distance value
-    return 0.0f;  // Placeholder
+    ACC_Value_t Xn = ACC_VALUE(0.0);  // Placeholder
+
+#if ACC_RECORD_EN
+    RecordXn = Xn;
+#endif
+    return Xn;
 }
 
-float Read_Speed_Sensor(void)
+ACC_Value_t Read_Speed_Sensor(void)
 {
     // Pseudo-code: Read speed sensor hardware
     // In real implementation, this would:
     // 1. Read encoder or GPS speed data
-    // 2. Convert raw value to speed (km/h or m/s)
+    // 2. Convert raw value to speed (km/h or m/s, ACC_Value_t; integer scaling
+    //    with ACC_FIXED_POINT)
     // 3. Return speed value
-    return 0.0f;  // Placeholder
+    ACC_Value_t Vn = ACC_VALUE(0.0);  // Placeholder
+
+#if ACC_RECORD_EN && !ACC_RADAR_EN
+    Record_Sample(RecordXn, Vn);
+#endif
+    return Vn;
 }
 
-void Apply_Throttle_Brake(float dM)
+void Apply_Throttle_Brake(ACC_Value_t dM)
 {
     // Pseudo-code: Apply control output to actuators
     // In real implementation, this would:
     // 1. Convert dM to throttle/brake commands
     // 2. Send commands to actuator hardware (PWM, CAN, etc.)
     // 3. Handle safety limits and neutral position
+#if ACC_RECORD_EN
+    OS_ERR err;
+
+    OSSchedLock(&err);
+    Log_Output(&RecordLog, dM);
+    OSSchedUnlock(&err);
+#endif
     (void)dM;  // Suppress unused parameter warning
 }
 
@@ -51,6 +179,15 @@ void Hardware_Timer_Enable(void)
     // 1. Configure timer period
     // 2. Enable timer interrupt in NVIC/peripheral
     // 3. Start timer counter
+#if ACC_RECORD_EN
+    OS_ERR err;
+
+    // New engagement: sample times restart at 0
+    RecordEngageTick = OSTimeGet(&err);
+    OSSchedLock(&err);
+    Log_Engage(&RecordLog);
+    OSSchedUnlock(&err);
+#endif
 }
 
 void Hardware_Timer_Disable(void)
@@ -59,7 +196,27 @@ void Hardware_Timer_Disable(void)
     // In real implementation, this would:
     // 1. Disable timer interrupt in NVIC/peripheral
     // 2. Stop timer counter
+#if ACC_RECORD_EN
+    OS_ERR err;
+
+    OSSchedLock(&err);
+    Log_Flush(&RecordLog);
+    OSSchedUnlock(&err);
+#endif
+}
+
+#if ACC_RATE_ADAPT_EN
+void Hardware_Timer_SetPeriod(uint32_t period_ms)
+{
+    // Pseudo-code: Change the timer period from the current release on
+    // In real implementation, this would:
+    // 1. Write the auto-reload register with preload disabled (the counter
+    //    is only microseconds past the release, below any new reload value)
+    // 2. With ACC_OVERSAMPLE_EN, rescale the sampling timer so a block
+    //    still completes once per frame
+    (void)period_ms;  // Suppress unused parameter warning
 }
+#endif
 
 void Hardware_Init(void)
 {
@@ -67,30 +224,48 @@ void Hardware_Init(void)
     // In real implementation, this would:
     // 1. Initialize CPU clocks
     // 2. Configure GPIO pins
-    // 3. Initialize ADC for sensors
+    // 3. Initialize ADC for sensors (ACC_OVERSAMPLE_EN: sampling timer and
+    //    DMA into PingPong_Filling())
     // 4. Initialize timer for periodic interrupts
-    // 5. Initialize actuator interfaces (PWM, CAN, etc.)
+    // 5. Initialize actuator interfaces (PWM, CAN, etc.) and, with
+    //    ACC_RADAR_EN, the radar receive filters and yaw-rate sensor
     // 6. Initialize LCD display
+    // 7. ACC_TELEMETRY_EN: telemetry UART and its transmit DMA channel
+#if ACC_RECORD_EN
+    (void)Log_Init(&RecordLog, RecordMem, sizeof(RecordMem));
+#endif
+#if ACC_OVERSAMPLE_EN
+    PingPong_Init(&SensorPingPong);
+#endif
+#if ACC_RADAR_EN
+    RadarDone.count = 0u;      // Free road until the first radar cycle
+#endif
 }
 
-void LCD_Display_Distance(float distance)
+void LCD_Write(uint8_t row, uint8_t col, const char *p_text, uint8_t len)
 {
-    // Pseudo-code: Display distance on LCD
-    // In real implementation, this would format and display distance value
-    (void)distance;  // Suppress unused parameter warning
-}
-
-void LCD_Display_Speed(float speed)
-{
-    // Pseudo-code: Display speed on LCD
-    // In real implementation, this would format and display speed value
-    (void)speed;  // Suppress unused parameter warning
+    // Pseudo-code: Write a run of character cells to the LCD
+    // In real implementation, this would:
+    // 1. Send the set-DDRAM-address command for (row, col)
+    // 2. Send the len characters as data bytes (cursor auto-increments)
+    (void)row;  // Suppress unused parameter warnings
+    (void)col;
+    (void)p_text;
+    (void)len;
 }
 
-void LCD_Display_ACC_Status(uint8_t status)
+#if ACC_TELEMETRY_EN
+void Telemetry_Write(const uint8_t *p_data, uint32_t len)
 {
-    // Pseudo-code: Display ACC status on LCD
-    // In real implementation, this would display ON/OFF status
-    (void)status;  // Suppress unused parameter warning
+    // Pseudo-code: Send the encoded telemetry bytes on the telemetry UART
+    // In real implementation, this would:
+    // 1. Copy the bytes into the free half of the transmit buffer (a
+    //    write that does not fit is dropped whole and counted)
+    // 2. Start the transmit DMA on that half if it is idle; the transfer
+    //    complete interrupt starts the other half
+    // Telem_Task never waits on the UART
+    (void)p_data;  // Suppress unused parameter warnings
+    (void)len;
 }
+#endif
 
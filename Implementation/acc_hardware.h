@@ -1,20 +1,48 @@
 #ifndef ACC_HARDWARE_H
 #define ACC_HARDWARE_H
 
+#include "acc_fixed.h"
+#include <stdbool.h>
 #include <stdint.h>
 
+#if ACC_OVERSAMPLE_EN
+#include "acc_acquire.h"
+#endif
+#if ACC_RADAR_EN
+#include "acc_radar.h"
+#endif
+
 // Hardware Abstraction Layer Function Declarations
+// Sensor and actuator values are ACC_Value_t (float, or Q16.16 with ACC_FIXED_POINT)
 
-float Read_Distance_Sensor(void);
-float Read_Speed_Sensor(void);
-void Apply_Throttle_Brake(float dM);
+ACC_Value_t Read_Distance_Sensor(void);
+ACC_Value_t Read_Speed_Sensor(void);
+void Apply_Throttle_Brake(ACC_Value_t dM);
 void Hardware_Timer_ClearFlag(void);
 void Hardware_Timer_Enable(void);
 void Hardware_Timer_Disable(void);
+#if ACC_RATE_ADAPT_EN
+void Hardware_Timer_SetPeriod(uint32_t period_ms);     // From the current release on
+#endif
 void Hardware_Init(void);
-void LCD_Display_Distance(float distance);
-void LCD_Display_Speed(float speed);
-void LCD_Display_ACC_Status(uint8_t status);
+#if ACC_OVERSAMPLE_EN
+// Oversampled acquisition: newest complete sample block (NULL if none since
+// the last call), then its release with the values published from it
+// (false: the block was overwritten while being filtered)
+const ACC_SensorBlock_t *Read_Sensor_Block(uint32_t *p_seq);
+bool Release_Sensor_Block(uint32_t seq, ACC_Value_t Xn, ACC_Value_t Vn);
+#endif
+#if ACC_RADAR_EN
+// Multi-target radar: copy of the newest complete track list (count 0 if the
+// radar reported nothing), then its release with the values selected from it
+void Read_Radar_Frame(ACC_RadarFrame_t *p_frame);
+void Release_Radar_Frame(ACC_Value_t Xn, ACC_Value_t Vn);
+#endif
+void LCD_Write(uint8_t row, uint8_t col, const char *p_text, uint8_t len);  // Character cells (acc_display.h)
+#if ACC_TELEMETRY_EN
+// Telemetry stream bytes (acc_telemetry.h), in order; Telem_Task only
+void Telemetry_Write(const uint8_t *p_data, uint32_t len);
+#endif
 
 #endif // ACC_HARDWARE_H
 
@@ -1,6 +1,7 @@
 #include "acc_types.h"
 #include "acc_config.h"
 #include "acc_hardware.h"
+#include "acc_trace.h"
 
 // ISR (IRQ_sensors) - Timer Interrupt Service Routine
 void IRQ_sensors_ISR(void)
@@ -9,6 +10,11 @@ void IRQ_sensors_ISR(void)
     
     // ISR Prologue (save CPU context)
     OSIntEnter();
+#if ACC_RATE_ADAPT_EN
+    TRACE_ARG(TRACE_RING_ISR, TRACE_EV_ISR, FRAME_PERIOD_MS);  // Release-jitter probe (period since the last release)
+#else
+    TRACE(TRACE_RING_ISR, TRACE_EV_ISR);  // Release-jitter probe
+#endif
     
     // Clear interrupt flag (hardware-specific)
     Hardware_Timer_ClearFlag();
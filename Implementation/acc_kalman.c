@@ -0,0 +1,363 @@
+#include "acc_kalman.h"
+#include "acc_config.h"
+#if ACC_RATE_ADAPT_EN
+#include "acc_rate.h"
+#endif
+#include <string.h>
+
+// Gap / Relative-Velocity Estimator (see acc_kalman.h)
+
+#if ACC_KALMAN_EN
+
+#if defined(__GNUC__)
+#define KALMAN_UNROLL   _Pragma("GCC unroll 16")
+#else
+#define KALMAN_UNROLL
+#endif
+
+#define KALMAN_D        0u      // State indices
+#define KALMAN_VL       1u
+#define KALMAN_VE       2u
+#define KALMAN_AL       3u
+
+#define KALMAN_KMH      (1.0 / 3.6)
+#define KALMAN_R_X      ((float)(KALMAN_SIGMA_X_M * KALMAN_SIGMA_X_M))      // Measurement variances
+#define KALMAN_R_V      ((float)(KALMAN_SIGMA_V_KMH * KALMAN_KMH * KALMAN_SIGMA_V_KMH * KALMAN_KMH))
+
+// Model per control-rate level (float: the recursion of both builds)
+static float KalmanF[KALMAN_LEVEL_QTY][KALMAN_NX][KALMAN_NX];
+static float KalmanQ[KALMAN_LEVEL_QTY][KALMAN_NX][KALMAN_NX];
+
+#if ACC_FIXED_POINT
+static acc_q_t KalmanFq[KALMAN_LEVEL_QTY][KALMAN_NX][KALMAN_NX];
+static acc_q_t KalmanKd[KALMAN_LEVEL_QTY][KALMAN_GAIN_STEPS][KALMAN_NX];    // Gap update gain
+static acc_q_t KalmanKv[KALMAN_LEVEL_QTY][KALMAN_GAIN_STEPS][KALMAN_NX];    // Speed update gain
+#endif
+
+static uint32_t Kalman_PeriodMs(uint32_t level)
+{
+#if ACC_RATE_ADAPT_EN
+    return RatePeriodsMs[level];
+#else
+    (void)level;
+    return TIMER_PERIOD_MS;
+#endif
+}
+
+// Covariance at a (re)start: gap and ego speed as measured, lead speed (and
+// acceleration) unknown
+static void Kalman_P0(float P[KALMAN_NX][KALMAN_NX])
+{
+    memset(P, 0, sizeof(float) * KALMAN_NX * KALMAN_NX);
+    P[KALMAN_D][KALMAN_D] = KALMAN_R_X;
+    P[KALMAN_VL][KALMAN_VL] = (float)(KALMAN_P0_VR * KALMAN_P0_VR);
+    P[KALMAN_VE][KALMAN_VE] = KALMAN_R_V;
+#if KALMAN_LEAD_ACCEL
+    P[KALMAN_AL][KALMAN_AL] = (float)(KALMAN_P0_AL * KALMAN_P0_AL);
+#endif
+}
+
+// P = F·P·Fᵀ + Q
+static void Kalman_Predict(float P[KALMAN_NX][KALMAN_NX], uint32_t level)
+{
+    const float (*F)[KALMAN_NX] = KalmanF[level];
+    const float (*Q)[KALMAN_NX] = KalmanQ[level];
+    float FP[KALMAN_NX][KALMAN_NX];
+    uint32_t i, j, k;
+
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        KALMAN_UNROLL
+        for (j = 0u; j < KALMAN_NX; j++)
+        {
+            float s = 0.0f;
+
+            KALMAN_UNROLL
+            for (k = 0u; k < KALMAN_NX; k++)
+            {
+                s += F[i][k] * P[k][j];
+            }
+            FP[i][j] = s;
+        }
+    }
+    // Upper triangle, mirrored: P stays exactly symmetric
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        KALMAN_UNROLL
+        for (j = i; j < KALMAN_NX; j++)
+        {
+            float s = Q[i][j];
+
+            KALMAN_UNROLL
+            for (k = 0u; k < KALMAN_NX; k++)
+            {
+                s += FP[i][k] * F[j][k];
+            }
+            P[i][j] = s;
+            P[j][i] = s;
+        }
+    }
+}
+
+// Scalar update with state m measured (variance r): gain into K, P updated
+static void Kalman_Gain(float P[KALMAN_NX][KALMAN_NX], uint32_t m, float r, float K[KALMAN_NX])
+{
+    float Pm[KALMAN_NX];
+    float inv = 1.0f / (P[m][m] + r);
+    uint32_t i, j;
+
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        Pm[i] = P[m][i];
+        K[i] = Pm[i] * inv;
+    }
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        KALMAN_UNROLL
+        for (j = 0u; j < KALMAN_NX; j++)
+        {
+            P[i][j] -= K[i] * Pm[j];
+        }
+    }
+}
+
+void Kalman_Init(void)
+{
+    uint32_t l;
+
+    memset(KalmanF, 0, sizeof(KalmanF));
+    memset(KalmanQ, 0, sizeof(KalmanQ));
+    for (l = 0u; l < KALMAN_LEVEL_QTY; l++)
+    {
+        const float T = (float)Kalman_PeriodMs(l) / 1000.0f;
+        const float sl2 = (float)(KALMAN_SIGMA_LEAD * KALMAN_SIGMA_LEAD);
+        const float se2 = (float)(KALMAN_SIGMA_EGO * KALMAN_SIGMA_EGO);
+        float gl[KALMAN_NX] = { 0.0f };     // Lead noise input
+        float ge[KALMAN_NX] = { 0.0f };     // Ego noise input
+        uint32_t i, j;
+
+        for (i = 0u; i < KALMAN_NX; i++)
+        {
+            KalmanF[l][i][i] = 1.0f;
+        }
+        KalmanF[l][KALMAN_D][KALMAN_VL] = T;
+        KalmanF[l][KALMAN_D][KALMAN_VE] = -T;
+        ge[KALMAN_D] = -0.5f * T * T;
+        ge[KALMAN_VE] = T;
+#if KALMAN_LEAD_ACCEL
+        KalmanF[l][KALMAN_D][KALMAN_AL] = 0.5f * T * T;
+        KalmanF[l][KALMAN_VL][KALMAN_AL] = T;
+        gl[KALMAN_D] = T * T * T / 6.0f;        // White jerk
+        gl[KALMAN_VL] = 0.5f * T * T;
+        gl[KALMAN_AL] = T;
+#else
+        gl[KALMAN_D] = 0.5f * T * T;            // White acceleration
+        gl[KALMAN_VL] = T;
+#endif
+        for (i = 0u; i < KALMAN_NX; i++)
+        {
+            for (j = 0u; j < KALMAN_NX; j++)
+            {
+                KalmanQ[l][i][j] = sl2 * gl[i] * gl[j] + se2 * ge[i] * ge[j];
+            }
+        }
+
+#if ACC_FIXED_POINT
+        {
+            float P[KALMAN_NX][KALMAN_NX];
+            float K[KALMAN_NX];
+            uint32_t n;
+
+            for (i = 0u; i < KALMAN_NX; i++)
+            {
+                for (j = 0u; j < KALMAN_NX; j++)
+                {
+                    KalmanFq[l][i][j] = Q_FromFloat(KalmanF[l][i][j]);
+                }
+            }
+            // Gains of the first steps after a restart at this level; the
+            // first step takes the sample as it is (see Kalman_Step)
+            Kalman_P0(P);
+            memset(KalmanKd[l][0], 0, sizeof(KalmanKd[l][0]));
+            memset(KalmanKv[l][0], 0, sizeof(KalmanKv[l][0]));
+            for (n = 1u; n < KALMAN_GAIN_STEPS; n++)
+            {
+                Kalman_Predict(P, l);
+                Kalman_Gain(P, KALMAN_D, KALMAN_R_X, K);
+                for (i = 0u; i < KALMAN_NX; i++)
+                {
+                    KalmanKd[l][n][i] = Q_FromFloat(K[i]);
+                }
+                Kalman_Gain(P, KALMAN_VE, KALMAN_R_V, K);
+                for (i = 0u; i < KALMAN_NX; i++)
+                {
+                    KalmanKv[l][n][i] = Q_FromFloat(K[i]);
+                }
+            }
+        }
+#endif
+    }
+}
+
+void Kalman_Reset(ACC_Kalman_t *p_kf)
+{
+    memset(p_kf, 0, sizeof(*p_kf));
+}
+
+static inline ACC_Value_t Kalman_Mul(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Mul(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline ACC_Value_t Kalman_Add(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Add(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline ACC_Value_t Kalman_Sub(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Sub(a, b);
+#else
+    return a - b;
+#endif
+}
+
+// New target: the sample as it is, lead at the ego speed
+static void Kalman_Restart(ACC_Kalman_t *p_kf, ACC_Value_t Xn, ACC_Value_t ve)
+{
+    memset(p_kf->x, 0, sizeof(p_kf->x));
+    p_kf->x[KALMAN_D] = Xn;
+    p_kf->x[KALMAN_VL] = ve;
+    p_kf->x[KALMAN_VE] = ve;
+#if !ACC_FIXED_POINT
+    Kalman_P0(p_kf->P);
+#endif
+    p_kf->steps = 0u;
+    p_kf->outliers = 0u;
+    p_kf->valid = true;
+}
+
+// Prediction and both updates; false if the gap sample is the second
+// outlier in a row (new target)
+static bool Kalman_Update(ACC_Kalman_t *p_kf, ACC_Value_t Xn, ACC_Value_t ve, uint8_t level)
+{
+    ACC_Value_t x[KALMAN_NX];
+    ACC_Value_t y;
+    const ACC_Value_t *Kd, *Kv;
+#if ACC_FIXED_POINT
+    const acc_q_t (*F)[KALMAN_NX] = KalmanFq[level];
+    uint32_t n;
+#else
+    const float (*F)[KALMAN_NX] = KalmanF[level];
+    float Kdf[KALMAN_NX], Kvf[KALMAN_NX];
+#endif
+    uint32_t i, k;
+
+    // Prediction: x = F·x (and the covariance)
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        ACC_Value_t s = ACC_VALUE(0.0);
+
+        KALMAN_UNROLL
+        for (k = 0u; k < KALMAN_NX; k++)
+        {
+            s = Kalman_Add(s, Kalman_Mul(F[i][k], p_kf->x[k]));
+        }
+        x[i] = s;
+    }
+#if ACC_FIXED_POINT
+    n = (p_kf->steps + 1u < KALMAN_GAIN_STEPS) ? p_kf->steps + 1u : KALMAN_GAIN_STEPS - 1u;
+    Kd = KalmanKd[level][n];
+    Kv = KalmanKv[level][n];
+#else
+    Kalman_Predict(p_kf->P, level);
+    Kd = Kdf;
+    Kv = Kvf;
+#endif
+
+    // Gap update, unless the innovation is an outlier
+    y = Kalman_Sub(Xn, x[KALMAN_D]);
+    if (y > ACC_VALUE(KALMAN_GATE_M) || y < ACC_VALUE(-KALMAN_GATE_M))
+    {
+        if (++p_kf->outliers >= 2u)
+        {
+            return false;
+        }
+        p_kf->rejected++;
+    }
+    else
+    {
+        p_kf->outliers = 0u;
+#if !ACC_FIXED_POINT
+        Kalman_Gain(p_kf->P, KALMAN_D, KALMAN_R_X, Kdf);
+#endif
+        KALMAN_UNROLL
+        for (i = 0u; i < KALMAN_NX; i++)
+        {
+            x[i] = Kalman_Add(x[i], Kalman_Mul(Kd[i], y));
+        }
+    }
+
+    // Speed update
+#if !ACC_FIXED_POINT
+    Kalman_Gain(p_kf->P, KALMAN_VE, KALMAN_R_V, Kvf);
+#endif
+    y = Kalman_Sub(ve, x[KALMAN_VE]);
+    KALMAN_UNROLL
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        x[i] = Kalman_Add(x[i], Kalman_Mul(Kv[i], y));
+    }
+    memcpy(p_kf->x, x, sizeof(x));
+    if (p_kf->steps < UINT32_MAX)
+    {
+        p_kf->steps++;
+    }
+    return true;
+}
+
+void Kalman_Step(ACC_Kalman_t *p_kf, ACC_Value_t Xn, ACC_Value_t Vn, uint8_t level,
+                 ACC_Estimate_t *p_est)
+{
+    ACC_Value_t ve = Kalman_Mul(Vn, ACC_VALUE(KALMAN_KMH));     // m/s
+
+    if (!p_kf->valid)
+    {
+        Kalman_Restart(p_kf, Xn, ve);
+    }
+    else if (!Kalman_Update(p_kf, Xn, ve, level))
+    {
+        p_kf->restarts++;
+        Kalman_Restart(p_kf, Xn, ve);
+    }
+
+    p_est->Xe = p_kf->x[KALMAN_D];
+    p_est->Vr = Kalman_Sub(p_kf->x[KALMAN_VL], p_kf->x[KALMAN_VE]);
+    p_est->Ve = Kalman_Mul(p_kf->x[KALMAN_VE], ACC_VALUE(3.6));
+#if KALMAN_LEAD_ACCEL
+    p_est->Al = p_kf->x[KALMAN_AL];
+#else
+    p_est->Al = ACC_VALUE(0.0);
+#endif
+}
+
+ACC_Value_t Kalman_Lookahead(ACC_Value_t Xe, ACC_Value_t Vr)
+{
+    return Kalman_Add(Xe, Kalman_Mul(Vr, ACC_VALUE(KALMAN_LOOKAHEAD_MS / 1000.0)));
+}
+
+#endif // ACC_KALMAN_EN
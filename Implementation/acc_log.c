@@ -0,0 +1,102 @@
+#include "acc_log.h"
+#include "acc_config.h"
+#include <stdatomic.h>
+#include <string.h>
+
+// Drive Log (see acc_log.h)
+
+uint32_t Log_Bytes(uint32_t records)
+{
+    return (uint32_t)sizeof(ACC_LogHdr_t) + records * (uint32_t)sizeof(ACC_LogRec_t);
+}
+
+bool Log_Init(ACC_Log_t *p_log, void *p_mem, uint32_t size)
+{
+    memset(p_log, 0, sizeof(*p_log));
+    if (size < sizeof(ACC_LogHdr_t))
+    {
+        return false;
+    }
+    p_log->hdr = (ACC_LogHdr_t *)p_mem;
+    p_log->rec = (ACC_LogRec_t *)(void *)(p_log->hdr + 1);
+
+    memcpy(p_log->hdr->magic, ACC_LOG_MAGIC, sizeof(p_log->hdr->magic));
+    p_log->hdr->version = ACC_LOG_VERSION;
+    p_log->hdr->value_format = ACC_FIXED_POINT ? ACC_LOG_FMT_Q16_16 : ACC_LOG_FMT_FLOAT;
+    p_log->hdr->period_ms = TIMER_PERIOD_MS;
+    p_log->hdr->rec_size = sizeof(ACC_LogRec_t);
+    p_log->hdr->count = 0u;
+    p_log->hdr->capacity = (size - (uint32_t)sizeof(ACC_LogHdr_t)) / (uint32_t)sizeof(ACC_LogRec_t);
+    return true;
+}
+
+static void Log_Append(ACC_Log_t *p_log, const ACC_LogRec_t *p_rec)
+{
+    uint32_t n = p_log->hdr->count;
+
+    if (n >= p_log->hdr->capacity)
+    {
+        p_log->lost++;
+        return;
+    }
+    p_log->rec[n] = *p_rec;
+    // Record complete before it is counted
+    atomic_thread_fence(memory_order_release);
+    p_log->hdr->count = n + 1u;
+}
+
+void Log_Engage(ACC_Log_t *p_log)
+{
+    Log_Flush(p_log);
+    p_log->next_flags = ACC_LOG_F_ENGAGE;
+}
+
+void Log_Sample(ACC_Log_t *p_log, uint32_t t_ms, ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    // A previous sample that never got an output (frame skipped) is kept as such
+    Log_Flush(p_log);
+    p_log->pending.t_ms = t_ms;
+    p_log->pending.flags = p_log->next_flags;
+    p_log->pending.Xn = Xn;
+    p_log->pending.Vn = Vn;
+    p_log->pending.dM = ACC_VALUE(0.0);
+    p_log->has_pending = true;
+    p_log->next_flags = 0u;
+}
+
+void Log_Output(ACC_Log_t *p_log, ACC_Value_t dM)
+{
+    if (!p_log->has_pending)
+    {
+        return;     // Output without a recorded sample (ACC engaged mid-frame)
+    }
+    p_log->pending.dM = dM;
+    p_log->pending.flags |= ACC_LOG_F_ACTUATED;
+    Log_Append(p_log, &p_log->pending);
+    p_log->has_pending = false;
+}
+
+void Log_Flush(ACC_Log_t *p_log)
+{
+    if (p_log->has_pending)
+    {
+        Log_Append(p_log, &p_log->pending);
+        p_log->has_pending = false;
+    }
+}
+
+const ACC_LogHdr_t *Log_Open(const void *p_mem, uint64_t size)
+{
+    const ACC_LogHdr_t *p_hdr = (const ACC_LogHdr_t *)p_mem;
+
+    if (p_mem == NULL || size < sizeof(ACC_LogHdr_t) ||
+        memcmp(p_hdr->magic, ACC_LOG_MAGIC, sizeof(p_hdr->magic)) != 0 ||
+        p_hdr->version != ACC_LOG_VERSION ||
+        p_hdr->rec_size != sizeof(ACC_LogRec_t) ||
+        p_hdr->count > p_hdr->capacity ||
+        (uint64_t)Log_Bytes(p_hdr->count) > size)
+    {
+        return NULL;
+    }
+    return p_hdr;
+}
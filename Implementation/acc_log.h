@@ -0,0 +1,74 @@
+#ifndef ACC_LOG_H
+#define ACC_LOG_H
+
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Drive Log (sensor samples and actuator output, ACC_RECORD_EN / host record)
+//
+// One record per frame: the Xn/Vn pair read by Sensors_Task and the dM(n)
+// that Actuator_Task applied for it. The log is a flat, memory-mappable
+// image: a fixed header followed by an array of fixed-size records in the
+// recording build's native byte order and ACC_Value_t format. The writer
+// stores a record before it bumps the header count, so a reader mapping a
+// live log sees a consistent prefix.
+
+#define ACC_LOG_MAGIC         "ACCDRIVE"
+#define ACC_LOG_VERSION       1u
+
+#define ACC_LOG_FMT_FLOAT     0u
+#define ACC_LOG_FMT_Q16_16    1u
+
+// Record flags
+#define ACC_LOG_F_ACTUATED    0x01u     // dM valid (Apply_Throttle_Brake ran for this sample)
+#define ACC_LOG_F_ENGAGE      0x02u     // First frame after ACC engaged
+
+typedef struct {
+    char     magic[8];              // ACC_LOG_MAGIC (not NUL-terminated)
+    uint32_t version;               // ACC_LOG_VERSION
+    uint32_t value_format;          // ACC_LOG_FMT_* of Xn/Vn/dM
+    uint32_t period_ms;             // TIMER_PERIOD_MS of the recording
+    uint32_t rec_size;              // sizeof(ACC_LogRec_t)
+    volatile uint32_t count;        // Records written
+    uint32_t capacity;              // Records the image holds
+} ACC_LogHdr_t;
+
+typedef struct {
+    uint32_t    t_ms;               // Sample time, ms since ACC engaged
+    uint32_t    flags;              // ACC_LOG_F_*
+    ACC_Value_t Xn;                 // Distance read (m)
+    ACC_Value_t Vn;                 // Speed read (km/h)
+    ACC_Value_t dM;                 // Output applied for this sample
+} ACC_LogRec_t;
+
+// Writer state (the image itself holds everything a reader needs)
+typedef struct {
+    ACC_LogHdr_t *hdr;
+    ACC_LogRec_t *rec;
+    ACC_LogRec_t  pending;          // Sample waiting for its output
+    bool          has_pending;
+    uint32_t      next_flags;       // Flags for the next sample
+    uint32_t      lost;             // Records dropped because the image is full
+} ACC_Log_t;
+
+// Formats size bytes at p_mem as an empty log; false if not even the header fits
+bool Log_Init(ACC_Log_t *p_log, void *p_mem, uint32_t size);
+
+// Writer calls, in frame order: Log_Engage at ACC_ON, Log_Sample once the
+// frame's sensors are read, Log_Output when its dM is applied
+void Log_Engage(ACC_Log_t *p_log);
+void Log_Sample(ACC_Log_t *p_log, uint32_t t_ms, ACC_Value_t Xn, ACC_Value_t Vn);
+void Log_Output(ACC_Log_t *p_log, ACC_Value_t dM);
+void Log_Flush(ACC_Log_t *p_log);       // Writes a sample still waiting for its output
+
+uint32_t Log_Bytes(uint32_t records);  // Image size for a capacity
+
+// Validates an image (size bytes at p_mem); returns NULL if it is not a log
+const ACC_LogHdr_t *Log_Open(const void *p_mem, uint64_t size);
+static inline const ACC_LogRec_t *Log_Records(const ACC_LogHdr_t *p_hdr)
+{
+    return (const ACC_LogRec_t *)(const void *)(p_hdr + 1);
+}
+
+#endif // ACC_LOG_H
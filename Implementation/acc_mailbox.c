@@ -0,0 +1,96 @@
+#include "acc_mailbox.h"
+#include "acc_seqlock.h"
+
+// Latest-Value Mailbox (see acc_mailbox.h)
+
+// Between the copy and the taken store of Mailbox_Take() (bench_handoff
+// preempts the consumer here)
+#ifndef MAILBOX_TAKE_HOOK
+#define MAILBOX_TAKE_HOOK()
+#endif
+
+void Mailbox_Init(ACC_Mailbox_t *p_mbox)
+{
+    p_mbox->lock = 0u;
+    p_mbox->slot.dM = ACC_VALUE(0.0);
+    p_mbox->slot.seq = 0u;
+    p_mbox->slot.ts = 0u;
+    p_mbox->posted = 0u;
+    p_mbox->taken = 0u;
+    p_mbox->discard = 0u;
+    p_mbox->discard_seen = 0u;
+}
+
+// Producer side (single writer). Returns true if the consumer needs a wake-up.
+bool Mailbox_Post(ACC_Mailbox_t *p_mbox, ACC_Value_t dM, CPU_TS ts)
+{
+    uint32_t seq = p_mbox->posted + 1u;
+
+    Seq_WriteBegin(&p_mbox->lock);
+    p_mbox->slot.dM = dM;
+    p_mbox->slot.seq = seq;
+    p_mbox->slot.ts = ts;
+    Seq_WriteEnd(&p_mbox->lock);
+
+    p_mbox->posted = seq;
+
+    // posted is visible before taken is read; pairs with the fence in
+    // Mailbox_Take(), so either the consumer sees this command or we see its
+    // taken store
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Previous command still untaken: its wake-up is still pending, or the
+    // consumer will see this one when it looks again before pending
+    return p_mbox->taken == seq - 1u;
+}
+
+// Consumer side. Copies the latest command if it has not been taken yet.
+// Call again until it returns false: a post that came in after the copy
+// may not have woken the consumer.
+bool Mailbox_Take(ACC_Mailbox_t *p_mbox, ACC_Command_t *p_cmd)
+{
+    uint32_t lock;
+    uint32_t discard = p_mbox->discard;
+
+    while (1)
+    {
+        do
+        {
+            lock = Seq_ReadBegin(&p_mbox->lock);
+            *p_cmd = p_mbox->slot;
+        } while (Seq_ReadRetry(&p_mbox->lock, lock));
+        MAILBOX_TAKE_HOOK();
+
+        if (p_cmd->seq == 0u || p_cmd->seq == p_mbox->taken)
+        {
+            return false;   // Nothing posted yet, or already applied or dropped
+        }
+        p_mbox->taken = p_cmd->seq;
+
+        // taken is visible before the slot is read again (see Mailbox_Post)
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (discard == p_mbox->discard_seen)
+        {
+            return true;
+        }
+        if ((int32_t)(p_cmd->seq - discard) > 0)
+        {
+            // First command past the Mailbox_Reset point: passed for good
+            p_mbox->discard_seen = discard;
+            return true;
+        }
+        // Posted up to the Mailbox_Reset point: drop it and read the slot
+        // again. A command posted between the copy and the taken store saw a
+        // stale taken and skipped the wake-up; it is taken here.
+    }
+}
+
+// O(1) discard of any untaken command (Setup_Task on ACC OFF / fault). One
+// store to a field only Setup_Task writes: the consumer drops the commands up
+// to it on its next take. A command posted after posted is read here is not
+// discarded (it belongs to the next frame).
+void Mailbox_Reset(ACC_Mailbox_t *p_mbox)
+{
+    p_mbox->discard = p_mbox->posted;
+}
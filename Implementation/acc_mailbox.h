@@ -0,0 +1,46 @@
+#ifndef ACC_MAILBOX_H
+#define ACC_MAILBOX_H
+
+#include "os.h"
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Latest-Value Mailbox (Control → Actuator handoff)
+//
+// Single slot, overwrite-on-post: only the newest command matters, so a post
+// replaces any command the Actuator has not taken yet. No partition block,
+// queue entry or flow-control semaphore is involved; the slot is a
+// single-writer seqlock (Control_Task writes, Actuator_Task reads).
+//
+// Mailbox_Post() returns true when the consumer has taken every previous
+// command, i.e. when it needs a wake-up (OSTaskSemPost). Otherwise a wake-up
+// is already pending, or the consumer is inside Mailbox_Take() and has not
+// stored taken yet. Either way it finds the newer command, provided it calls
+// Mailbox_Take() until it returns false before it pends again.
+//
+// Mailbox_Reset() (Setup_Task) does not touch taken: it publishes the latest
+// posted seq as the discard point with one store, and Mailbox_Take() drops
+// the commands up to it. Each field has a single writer.
+
+typedef struct {
+    ACC_Value_t dM;             // Manipulated variable dM(n)
+    uint32_t    seq;            // Control cycle sequence number (1, 2, ...)
+    CPU_TS      ts;             // ISR release of this frame (deadline monitor)
+} ACC_Command_t;
+
+typedef struct {
+    volatile uint32_t lock;     // Seqlock counter for slot
+    ACC_Command_t     slot;     // Latest command
+    volatile uint32_t posted;   // seq of the latest command posted
+    volatile uint32_t taken;    // seq of the latest command taken (or discarded)
+    volatile uint32_t discard;  // posted at the last Mailbox_Reset (Setup_Task)
+    uint32_t discard_seen;      // discard point already passed by the consumer
+} ACC_Mailbox_t;
+
+void Mailbox_Init(ACC_Mailbox_t *p_mbox);
+bool Mailbox_Post(ACC_Mailbox_t *p_mbox, ACC_Value_t dM, CPU_TS ts);
+bool Mailbox_Take(ACC_Mailbox_t *p_mbox, ACC_Command_t *p_cmd);
+void Mailbox_Reset(ACC_Mailbox_t *p_mbox);
+
+#endif // ACC_MAILBOX_H
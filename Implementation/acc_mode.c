@@ -0,0 +1,75 @@
+#include "acc_mode.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Criticality Mode Manager (see acc_mode.h)
+
+#if ACC_MODE_EN
+
+const CPU_TS ModeBudgetUs[MODE_STAGE_QTY] = {
+    MODE_BUDGET_SENSORS_US, MODE_BUDGET_CONTROL_US, MODE_BUDGET_ACTUATOR_US
+};
+
+void Mode_Init(ACC_Mode_t *p_mode)
+{
+    memset(p_mode, 0, sizeof(*p_mode));
+    atomic_init(&p_mode->level, MODE_LO);
+}
+
+void Mode_Reset(ACC_Mode_t *p_mode)
+{
+    uint32_t s;
+
+    for (s = 0u; s < MODE_STAGE_QTY; s++)
+    {
+        p_mode->overrun_frame[s] = 0u;
+    }
+    atomic_store_explicit(&p_mode->level, MODE_LO, memory_order_relaxed);
+}
+
+uint8_t Mode_Release(ACC_Mode_t *p_mode)
+{
+    uint32_t s;
+
+    p_mode->frame++;
+    if (!Mode_High(p_mode))
+    {
+        return MODE_LO;
+    }
+    // Quiet: no stage overran in the last MODE_QUIET_FRAMES frames (a fixed
+    // loop over the stages)
+    for (s = 0u; s < MODE_STAGE_QTY; s++)
+    {
+        if (p_mode->overrun_frame[s] != 0u &&
+            p_mode->frame - p_mode->overrun_frame[s] < MODE_QUIET_FRAMES)
+        {
+            p_mode->frames_hi++;
+            return MODE_HI;
+        }
+    }
+    atomic_store_explicit(&p_mode->level, MODE_LO, memory_order_relaxed);
+    p_mode->to_lo++;
+    return MODE_LO;
+}
+
+void Mode_Charge(ACC_Mode_t *p_mode, uint32_t stage, CPU_TS cost)
+{
+    if (cost > p_mode->worst[stage])
+    {
+        p_mode->worst[stage] = cost;
+    }
+    if (cost <= MODE_US_TO_TS(ModeBudgetUs[stage]))
+    {
+        return;
+    }
+    // Overrun: record it before raising the mode, so the Sensors stage
+    // never lowers the mode past it
+    p_mode->overruns[stage]++;
+    p_mode->overrun_frame[stage] = p_mode->frame;
+    if (atomic_exchange_explicit(&p_mode->level, MODE_HI, memory_order_acq_rel) == MODE_LO)
+    {
+        p_mode->to_hi[stage]++;
+    }
+}
+
+#endif // ACC_MODE_EN
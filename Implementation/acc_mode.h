@@ -0,0 +1,84 @@
+#ifndef ACC_MODE_H
+#define ACC_MODE_H
+
+#include "os.h"
+#include "acc_config.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Criticality Mode Manager (ACC_MODE_EN)
+//
+// Each hard stage (Sensors, Control, Actuator; the three stages of Frame_Task
+// in the cyclic executive) has an execution-time budget, MODE_BUDGET_*_US in
+// acc_config.h. The stage times itself (two timestamp reads) and charges the
+// time with Mode_Charge() when it completes. A stage over its budget switches
+// the system to high criticality (HI) at once:
+//   Control   runs the degraded law (Control_LawDegraded(), acc_control.h):
+//             Equation 3 on the current error with the summed gain, and none
+//             of the optional work: no Kalman lookahead, no vote, no MPC
+//   Display   updates the LCD on every MODE_DISPLAY_DIVIDER-th period only,
+//             and skips the stack sampling
+// Sensors and Actuator are essential and unchanged. The switch is one atomic
+// exchange of the mode word; every reader picks it up at its next frame or
+// period, so it takes effect within one frame and costs the same whatever
+// the load.
+//
+// Back to LO (normal) only from the Sensors stage, at a release: once no
+// stage has overrun for MODE_QUIET_FRAMES frames. If the overload is still
+// there, the first normal frame overruns again and HI is back for another
+// MODE_QUIET_FRAMES.
+//
+// Writers: every stage writes only its own entries; the mode word is atomic
+// and the Sensors stage is the only one to lower it. A stage preempted
+// between its overrun record and the exchange still leaves HI: Sensors sees
+// the record first, or the exchange comes after its decision.
+
+#define MODE_LO              0u      // Normal: full law, every soft task
+#define MODE_HI              1u      // Overload: degraded law, soft work shed
+
+#define MODE_STAGE_SENSORS   0u
+#define MODE_STAGE_CONTROL   1u
+#define MODE_STAGE_ACTUATOR  2u
+#define MODE_STAGE_QTY       3u
+
+// Microseconds to timestamp ticks
+#define MODE_US_TO_TS(us)    ((CPU_TS)(us) * (CPU_TS)(CPU_TS_TmrFreq_Hz / 1000000u))
+
+typedef struct {
+    _Atomic uint8_t level;                      // MODE_LO / MODE_HI
+
+    // Sensors stage
+    uint32_t frame;                             // Releases seen (frame clock of the quiet period)
+    uint32_t to_lo;                             // Switches back to LO
+    uint32_t frames_hi;                         // Releases in HI
+
+    // Per stage (written by that stage only)
+    uint32_t overrun_frame[MODE_STAGE_QTY];     // Frame of its last overrun (0: none; frames count from 1)
+    uint32_t overruns[MODE_STAGE_QTY];
+    uint32_t to_hi[MODE_STAGE_QTY];             // Overruns that switched LO → HI
+    CPU_TS   worst[MODE_STAGE_QTY];             // Longest stage time (ts units)
+} ACC_Mode_t;
+
+extern const CPU_TS ModeBudgetUs[MODE_STAGE_QTY];
+
+// Before the kernel starts
+void Mode_Init(ACC_Mode_t *p_mode);
+
+// ACC engaged (timer off): LO, no overrun pending; the counts are kept
+void Mode_Reset(ACC_Mode_t *p_mode);
+
+// Sensors stage, at each release: back to LO after MODE_QUIET_FRAMES quiet
+// frames; returns the mode for this frame
+uint8_t Mode_Release(ACC_Mode_t *p_mode);
+
+// A stage completed after `cost` ts units; switches to HI over its budget
+void Mode_Charge(ACC_Mode_t *p_mode, uint32_t stage, CPU_TS cost);
+
+// Mode in force (any task)
+static inline bool Mode_High(ACC_Mode_t *p_mode)
+{
+    return atomic_load_explicit(&p_mode->level, memory_order_acquire) == MODE_HI;
+}
+
+#endif // ACC_MODE_H
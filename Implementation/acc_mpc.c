@@ -0,0 +1,99 @@
+#include "acc_mpc.h"
+#include "acc_config.h"
+
+// Explicit Model-Predictive Control (see acc_mpc.h; regions in acc_mpc_table.c)
+
+#if ACC_MPC_EN
+
+#if !ACC_RATE_ADAPT_EN && RATE_PERIOD_MID_MS != TIMER_PERIOD_MS
+#error "the fixed-rate build uses the RATE_LEVEL_MID table, generated for RATE_PERIOD_MID_MS"
+#endif
+
+static inline ACC_Value_t Mpc_Mul(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Mul(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline ACC_Value_t Mpc_Add(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Add(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline ACC_Value_t Mpc_Sub(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Sub(a, b);
+#else
+    return a - b;
+#endif
+}
+
+// w·x + c over the state
+static inline ACC_Value_t Mpc_Affine(const ACC_Value_t w[MPC_NX], ACC_Value_t c, const ACC_Value_t x[MPC_NX])
+{
+    return Mpc_Add(Mpc_Add(Mpc_Add(c, Mpc_Mul(w[0], x[0])), Mpc_Mul(w[1], x[1])), Mpc_Mul(w[2], x[2]));
+}
+
+ACC_Value_t Mpc_Lookup(const ACC_MpcTable_t *p_tbl, const ACC_Value_t x[MPC_NX], uint32_t *p_region)
+{
+    const ACC_MpcRegion_t *p_reg = &p_tbl->free;
+    ACC_Value_t u;
+    uint32_t r;
+
+    // Regions in order; a region is left at its first violated row
+    for (r = 0u; r < p_tbl->region_qty; r++)
+    {
+        const ACC_MpcRow_t *p_row = &p_tbl->row[p_tbl->region[r].row];
+        const ACC_MpcRow_t *p_end = p_row + p_tbl->region[r].rows;
+
+        while (p_row < p_end && Mpc_Affine(p_row->a, p_row->b, x) <= ACC_VALUE(0.0))
+        {
+            p_row++;
+        }
+        if (p_row == p_end)
+        {
+            p_reg = &p_tbl->region[r];
+            break;
+        }
+    }
+    *p_region = r;
+
+    // Fallback state outside every region: the unconstrained law may leave
+    // the limits, the regions' laws do not (up to rounding)
+    u = Mpc_Affine(p_reg->K, p_reg->k, x);
+    if (u > ACC_VALUE(MPC_ACCEL_MAX))
+    {
+        u = ACC_VALUE(MPC_ACCEL_MAX);
+    }
+    else if (u < ACC_VALUE(MPC_ACCEL_MIN))
+    {
+        u = ACC_VALUE(MPC_ACCEL_MIN);
+    }
+    return u;
+}
+
+ACC_Value_t Mpc_Law(uint8_t level, ACC_Value_t Vset, ACC_Value_t Vn, ACC_Value_t dM_prev,
+                    ACC_Value_t *p_a)
+{
+    const ACC_MpcTable_t *p_tbl = &MpcTables[level];
+    ACC_Value_t x[MPC_NX];
+    uint32_t region;
+
+    // Previous request, and the acceleration it has built up over the frame
+    x[2] = Mpc_Mul(dM_prev, ACC_VALUE(MPC_ACCEL_PER_DM));
+    *p_a = Mpc_Add(Mpc_Mul(p_tbl->phi, Mpc_Sub(*p_a, x[2])), x[2]);
+    x[1] = *p_a;
+    x[0] = Mpc_Mul(Mpc_Sub(Vset, Vn), ACC_VALUE(1.0 / 3.6));
+
+    return Mpc_Mul(Mpc_Lookup(p_tbl, x, &region), ACC_VALUE(1.0 / MPC_ACCEL_PER_DM));
+}
+
+#endif // ACC_MPC_EN
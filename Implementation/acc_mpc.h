@@ -0,0 +1,83 @@
+#ifndef ACC_MPC_H
+#define ACC_MPC_H
+
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include "acc_rate.h"
+#include <stdint.h>
+
+// Explicit Model-Predictive Control (ACC_MPC_EN, law ACC_LAW_MPC)
+//
+// Alternative to Equation 3: Vset still comes from Equations 1/4, and the
+// acceleration request that tracks it is the first move of a model-predictive
+// controller that was solved offline.
+//   state    x = (e, a, u₋): speed error Vset - Vn (m/s), ego acceleration
+//            (m/s², modelled: first-order lag MPC_LAG_S behind the request)
+//            and the previous request u₋ (m/s²); Vset held over the horizon
+//   moves    MPC_NU requests held for MPC_BLOCK_n × TIMER_PERIOD_MS each
+//            (horizon about 1.5 s at every control-rate level)
+//   cost     MPC_Q_E · e² per second over the horizon + MPC_R_DU · Δu² per move
+//   limits   MPC_ACCEL_MIN ≤ u ≤ MPC_ACCEL_MAX on every move (acc_config.h)
+//
+// The optimum is piecewise affine in x: for each combination of moves at
+// their lower limit, upper limit or free (3^MPC_NU candidates) the first
+// move is an affine law, valid where the free moves stay within their limits
+// and the Lagrange multipliers of the others have the right sign.
+// host/acc_mpcgen keeps the regions that the operating range reaches, most
+// frequent first, and writes them with their laws to acc_mpc_table.c for
+// each control-rate level. Mpc_Law() tests the regions in order (rows
+// a·x + b ≤ 0, normalised to max |a| = 1) and evaluates the law of the first
+// that holds. A state in none of them (outside the sampled range) gets the
+// unconstrained law, clamped to the limits.
+//
+// Cost: one affine law of MPC_NX terms plus the region search, at most every
+// row of the level's table (row_qty × MPC_NX multiply-adds, printed in
+// acc_mpc_table.c and measured by host/bench_mpc).
+
+#define MPC_NX                3u      // e, a, u₋
+#define MPC_NU                4u      // Free moves
+#define MPC_BLOCK_0           1u      // Move lengths in TIMER_PERIOD_MS (scaled to the level's period)
+#define MPC_BLOCK_1           2u
+#define MPC_BLOCK_2           4u
+#define MPC_BLOCK_3           8u
+#define MPC_Q_E               64.0    // Speed error weight per (m/s)² s
+#define MPC_R_DU              0.25    // Request change weight per (m/s²)²
+#define MPC_ROW_TOL           1e-4    // Row slack, so neighbouring regions overlap by rounding
+
+#define MPC_TABLE_QTY         RATE_LEVEL_QTY  // One table per control-rate level (fixed rate: RATE_LEVEL_MID)
+
+typedef struct {
+    ACC_Value_t a[MPC_NX];          // a·x + b ≤ 0
+    ACC_Value_t b;
+} ACC_MpcRow_t;
+
+typedef struct {
+    ACC_Value_t K[MPC_NX];          // u = K·x + k (m/s²)
+    ACC_Value_t k;
+    uint16_t    row;                // First row in the table's rows
+    uint16_t    rows;
+} ACC_MpcRegion_t;
+
+typedef struct {
+    uint32_t               period_ms;
+    ACC_Value_t            phi;             // exp(-T / MPC_LAG_S): acceleration model
+    uint16_t               region_qty;
+    uint16_t               row_qty;
+    const ACC_MpcRegion_t *region;          // Most frequent first
+    const ACC_MpcRow_t    *row;
+    ACC_MpcRegion_t        free;            // Unconstrained law (fallback, no rows)
+} ACC_MpcTable_t;
+
+extern const ACC_MpcTable_t MpcTables[MPC_TABLE_QTY];
+
+// dM(n) tracking Vset (km/h) from Vn (km/h) at control-rate level 'level'
+// (RATE_LEVEL_MID without ACC_RATE_ADAPT_EN). dM_prev: the previous frame's
+// dM(n); *p_a: modelled acceleration, advanced by one frame (0 on engage).
+ACC_Value_t Mpc_Law(uint8_t level, ACC_Value_t Vset, ACC_Value_t Vn, ACC_Value_t dM_prev,
+                    ACC_Value_t *p_a);
+
+// Region lookup only: u (m/s²) for state x; the region index, or region_qty
+// for the fallback, in *p_region (host tools)
+ACC_Value_t Mpc_Lookup(const ACC_MpcTable_t *p_tbl, const ACC_Value_t x[MPC_NX], uint32_t *p_region);
+
+#endif // ACC_MPC_H
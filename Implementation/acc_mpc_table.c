@@ -0,0 +1,278 @@
+#include "acc_mpc.h"
+
+// Explicit MPC regions (see acc_mpc.h)
+// Generated by host/acc_mpcgen from acc_config.h and acc_mpc.h, do not edit
+// (make -C host mpcgen)
+//
+// level  T ms  moves (frames)   regions  rows  worst-case lookup (multiply-adds)
+//   0       20    5 10 20 40         12      72   219
+//   1      100    1  2  4  8         12      72   219
+//   2      200    1  1  2  4         10      59   180
+
+#if ACC_MPC_EN
+
+static const ACC_MpcRow_t MpcRows0[72] = {
+    { { ACC_VALUE(-1), ACC_VALUE(0.267578544), ACC_VALUE(-0.033607355) }, ACC_VALUE(1.64664253) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.277362805), ACC_VALUE(0) }, ACC_VALUE(1.71158138) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.288119288), ACC_VALUE(0) }, ACC_VALUE(2.01321272) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.29509934), ACC_VALUE(0) }, ACC_VALUE(2.47672223) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.218203717), ACC_VALUE(0.118035622) }, ACC_VALUE(-0.771406914) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.218203717), ACC_VALUE(-0.118035622) }, ACC_VALUE(-2.46828212) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.2487735), ACC_VALUE(-0.00474179568) }, ACC_VALUE(-0.764740028) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.2487735), ACC_VALUE(0.00474179568) }, ACC_VALUE(-2.44694809) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.417195459), ACC_VALUE(-0.139414319) }, ACC_VALUE(-3.6087804) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.417195459), ACC_VALUE(0.139414319) }, ACC_VALUE(-11.5478773) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.160482311), ACC_VALUE(-0.00920192764) }, ACC_VALUE(-4.83535678) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.160482311), ACC_VALUE(0.00920192764) }, ACC_VALUE(-15.4729217) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.267578544), ACC_VALUE(0.033607355) }, ACC_VALUE(5.26947609) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.277362805), ACC_VALUE(0) }, ACC_VALUE(5.4772804) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.288119288), ACC_VALUE(0) }, ACC_VALUE(6.44250072) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.29509934), ACC_VALUE(0) }, ACC_VALUE(7.92573112) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249490235), ACC_VALUE(-0.0556961142) }, ACC_VALUE(1.10106462) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.262931698), ACC_VALUE(0) }, ACC_VALUE(1.0890342) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.279464869), ACC_VALUE(0) }, ACC_VALUE(1.43851707) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.29509934), ACC_VALUE(0) }, ACC_VALUE(-2.47692223) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.29509934), ACC_VALUE(0) }, ACC_VALUE(-1.29782754) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249490235), ACC_VALUE(0.0556961142) }, ACC_VALUE(3.52362677) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.262931698), ACC_VALUE(0) }, ACC_VALUE(3.48512942) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.279464869), ACC_VALUE(0) }, ACC_VALUE(4.60347463) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.29509934), ACC_VALUE(0) }, ACC_VALUE(4.15118136) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.29509934), ACC_VALUE(0) }, ACC_VALUE(-7.92593112) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220152464), ACC_VALUE(0.110208869) }, ACC_VALUE(2.46672213) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247592862), ACC_VALUE(0) }, ACC_VALUE(2.44757203) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.279464869), ACC_VALUE(0) }, ACC_VALUE(1.02229706) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.279464869), ACC_VALUE(0) }, ACC_VALUE(-4.60367463) },
+    { { ACC_VALUE(0.243925803), ACC_VALUE(-1), ACC_VALUE(0) }, ACC_VALUE(-25.8343347) },
+    { { ACC_VALUE(-0.243925803), ACC_VALUE(1), ACC_VALUE(0) }, ACC_VALUE(-199.133093) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220152464), ACC_VALUE(0.110208869) }, ACC_VALUE(-0.770981917) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220152464), ACC_VALUE(-0.110208869) }, ACC_VALUE(-2.26219781) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.2487735), ACC_VALUE(0.00474179568) }, ACC_VALUE(0.764540028) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307129669), ACC_VALUE(-0.0514041943) }, ACC_VALUE(-1.75016558) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307129669), ACC_VALUE(0.0514041943) }, ACC_VALUE(-3.50156347) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.632458473), ACC_VALUE(-0.13443013) }, ACC_VALUE(-55.1278788) },
+    { { ACC_VALUE(1), ACC_VALUE(0.632458473), ACC_VALUE(0.13443013) }, ACC_VALUE(-147.566704) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220152464), ACC_VALUE(-0.110208869) }, ACC_VALUE(0.770781917) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247592862), ACC_VALUE(0) }, ACC_VALUE(0.76479751) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.279464869), ACC_VALUE(0) }, ACC_VALUE(-1.43871707) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.279464869), ACC_VALUE(0) }, ACC_VALUE(-2.1426605) },
+    { { ACC_VALUE(0.243925803), ACC_VALUE(-1), ACC_VALUE(0) }, ACC_VALUE(-62.2291603) },
+    { { ACC_VALUE(-0.243925803), ACC_VALUE(1), ACC_VALUE(0) }, ACC_VALUE(-162.738267) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249490235), ACC_VALUE(0.0556961142) }, ACC_VALUE(-1.10126462) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249490235), ACC_VALUE(-0.0556961142) }, ACC_VALUE(-0.908878493) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.267735205), ACC_VALUE(0.019903837) }, ACC_VALUE(1.08473494) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307129669), ACC_VALUE(0.0514041943) }, ACC_VALUE(1.74996558) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.343004155), ACC_VALUE(-0.0584995487) }, ACC_VALUE(-3.92182283) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.343004155), ACC_VALUE(0.0584995487) }, ACC_VALUE(-3.81746666) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.218203717), ACC_VALUE(0.118035622) }, ACC_VALUE(2.46808212) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247592862), ACC_VALUE(0) }, ACC_VALUE(-0.639884966) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247592862), ACC_VALUE(0) }, ACC_VALUE(-2.44777203) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.30943743), ACC_VALUE(0) }, ACC_VALUE(-0.318037169) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.30943743), ACC_VALUE(0) }, ACC_VALUE(-6.63109396) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.155601945), ACC_VALUE(0) }, ACC_VALUE(-5.03549378) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.155601945), ACC_VALUE(0) }, ACC_VALUE(-16.98984) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.218203717), ACC_VALUE(-0.118035622) }, ACC_VALUE(0.771206914) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247592862), ACC_VALUE(0) }, ACC_VALUE(-0.76499751) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247592862), ACC_VALUE(0) }, ACC_VALUE(-2.32265949) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.30943743), ACC_VALUE(0) }, ACC_VALUE(-2.07228561) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.30943743), ACC_VALUE(0) }, ACC_VALUE(-4.87684552) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.155601945), ACC_VALUE(0) }, ACC_VALUE(-5.30939373) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.155601945), ACC_VALUE(0) }, ACC_VALUE(-16.71594) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220152464), ACC_VALUE(0.110208869) }, ACC_VALUE(-0.566257589) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220152464), ACC_VALUE(-0.110208869) }, ACC_VALUE(-2.46692213) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.2487735), ACC_VALUE(-0.00474179568) }, ACC_VALUE(2.44674809) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307129669), ACC_VALUE(-0.0514041943) }, ACC_VALUE(0.348580798) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307129669), ACC_VALUE(0.0514041943) }, ACC_VALUE(-5.60030984) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.632458473), ACC_VALUE(-0.13443013) }, ACC_VALUE(-26.2855908) },
+    { { ACC_VALUE(1), ACC_VALUE(0.632458473), ACC_VALUE(0.13443013) }, ACC_VALUE(-176.408992) },
+};
+
+static const ACC_MpcRegion_t MpcRegions0[12] = {
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 0u, 4u },     // 126998 samples
+    { { ACC_VALUE(3.2412519), ACC_VALUE(-0.707253212), ACC_VALUE(0.382583186) }, ACC_VALUE(0), 4u, 8u },     // 91458 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 12u, 4u },     // 67741 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 16u, 5u },     // 37276 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 21u, 5u },     // 19853 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 26u, 6u },     // 18546 samples
+    { { ACC_VALUE(3.46194204), ACC_VALUE(-0.762155071), ACC_VALUE(0.381536718) }, ACC_VALUE(-0.168748514), 32u, 7u },     // 16449 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 39u, 6u },     // 11002 samples
+    { { ACC_VALUE(5.22402846), ACC_VALUE(-1.30334409), ACC_VALUE(0.290958085) }, ACC_VALUE(-3.25251529), 45u, 6u },     // 4849 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 51u, 7u },     // 4549 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 58u, 7u },     // 983 samples
+    { { ACC_VALUE(3.46194204), ACC_VALUE(-0.762155071), ACC_VALUE(0.381536718) }, ACC_VALUE(0.539995244), 65u, 7u },     // 296 samples
+};
+
+static const ACC_MpcRow_t MpcRows1[72] = {
+    { { ACC_VALUE(-1), ACC_VALUE(0.268591351), ACC_VALUE(-0.032497342) }, ACC_VALUE(1.69313802) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.278143929), ACC_VALUE(0) }, ACC_VALUE(1.76193872) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.288628242), ACC_VALUE(0) }, ACC_VALUE(2.06607578) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.295441006), ACC_VALUE(0) }, ACC_VALUE(2.54199232) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.218328651), ACC_VALUE(0.118044312) }, ACC_VALUE(-0.771804521) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.218328651), ACC_VALUE(-0.118044312) }, ACC_VALUE(-2.46955447) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249026648), ACC_VALUE(-0.00486328384) }, ACC_VALUE(-0.765493346) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249026648), ACC_VALUE(0.00486328384) }, ACC_VALUE(-2.44935871) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.418478056), ACC_VALUE(-0.140236883) }, ACC_VALUE(-3.62041009) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.418478056), ACC_VALUE(0.140236883) }, ACC_VALUE(-11.5850923) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.165670869), ACC_VALUE(-0.00564771911) }, ACC_VALUE(-5.0016771) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.165670869), ACC_VALUE(0.00564771911) }, ACC_VALUE(-16.0051467) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.268591351), ACC_VALUE(0.032497342) }, ACC_VALUE(5.41826167) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.278143929), ACC_VALUE(0) }, ACC_VALUE(5.63842389) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.288628242), ACC_VALUE(0) }, ACC_VALUE(6.6116625) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.295441006), ACC_VALUE(0) }, ACC_VALUE(8.13459543) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249940829), ACC_VALUE(-0.0550709056) }, ACC_VALUE(1.10350006) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.263292065), ACC_VALUE(0) }, ACC_VALUE(1.09215792) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.27961735), ACC_VALUE(0) }, ACC_VALUE(1.43660546) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.295441006), ACC_VALUE(0) }, ACC_VALUE(-2.54219232) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.295441006), ACC_VALUE(0) }, ACC_VALUE(-1.44580223) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249940829), ACC_VALUE(0.0550709056) }, ACC_VALUE(3.53142018) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.263292065), ACC_VALUE(0) }, ACC_VALUE(3.49512533) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.27961735), ACC_VALUE(0) }, ACC_VALUE(4.59735749) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.295441006), ACC_VALUE(0) }, ACC_VALUE(4.14680088) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.295441006), ACC_VALUE(0) }, ACC_VALUE(-8.13479543) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220335342), ACC_VALUE(0.110009994) }, ACC_VALUE(2.46803429) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247811971), ACC_VALUE(0) }, ACC_VALUE(2.44995782) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.27961735), ACC_VALUE(0) }, ACC_VALUE(1.03195667) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.27961735), ACC_VALUE(0) }, ACC_VALUE(-4.59755749) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.730627149), ACC_VALUE(0) }, ACC_VALUE(-33.3628646) },
+    { { ACC_VALUE(1), ACC_VALUE(0.730627149), ACC_VALUE(0) }, ACC_VALUE(-221.233833) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220335342), ACC_VALUE(0.110009994) }, ACC_VALUE(-0.771391967) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220335342), ACC_VALUE(-0.110009994) }, ACC_VALUE(-2.25809645) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249026648), ACC_VALUE(0.00486328384) }, ACC_VALUE(0.765293346) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307344103), ACC_VALUE(-0.0514527091) }, ACC_VALUE(-1.74802562) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307344103), ACC_VALUE(0.0514527091) }, ACC_VALUE(-3.4851467) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.239814228), ACC_VALUE(-0.0567786079) }, ACC_VALUE(-33.0551679) },
+    { { ACC_VALUE(1), ACC_VALUE(0.239814228), ACC_VALUE(0.0567786079) }, ACC_VALUE(-90.1386072) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220335342), ACC_VALUE(-0.110009994) }, ACC_VALUE(0.771191967) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247811971), ACC_VALUE(0) }, ACC_VALUE(0.76554307) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.27961735), ACC_VALUE(0) }, ACC_VALUE(-1.43680546) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.27961735), ACC_VALUE(0) }, ACC_VALUE(-2.12879535) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.730627149), ACC_VALUE(0) }, ACC_VALUE(-69.1356417) },
+    { { ACC_VALUE(1), ACC_VALUE(0.730627149), ACC_VALUE(0) }, ACC_VALUE(-185.461056) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249940829), ACC_VALUE(0.0550709056) }, ACC_VALUE(-1.10370006) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.249940829), ACC_VALUE(-0.0550709056) }, ACC_VALUE(-0.895046644) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.268180936), ACC_VALUE(0.0201655166) }, ACC_VALUE(1.08800472) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307344103), ACC_VALUE(0.0514527091) }, ACC_VALUE(1.74782562) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.343931207), ACC_VALUE(-0.0586898657) }, ACC_VALUE(-4.07521447) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.343931207), ACC_VALUE(0.0586898657) }, ACC_VALUE(-4.16263079) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.218328651), ACC_VALUE(0.118044312) }, ACC_VALUE(2.46935447) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247811971), ACC_VALUE(0) }, ACC_VALUE(-0.637494885) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247811971), ACC_VALUE(0) }, ACC_VALUE(-2.45015782) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.309804528), ACC_VALUE(0) }, ACC_VALUE(-0.313899135) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.309804528), ACC_VALUE(0) }, ACC_VALUE(-6.63570132) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.163024914), ACC_VALUE(0) }, ACC_VALUE(-5.12891154) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.163024914), ACC_VALUE(0) }, ACC_VALUE(-16.9334559) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.218328651), ACC_VALUE(-0.118044312) }, ACC_VALUE(0.771604521) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.247811971), ACC_VALUE(0) }, ACC_VALUE(-0.76574307) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.247811971), ACC_VALUE(0) }, ACC_VALUE(-2.32190964) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.309804528), ACC_VALUE(0) }, ACC_VALUE(-2.07372541) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.309804528), ACC_VALUE(0) }, ACC_VALUE(-4.87587504) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.163024914), ACC_VALUE(0) }, ACC_VALUE(-5.29177373) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.163024914), ACC_VALUE(0) }, ACC_VALUE(-16.7705937) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.220335342), ACC_VALUE(0.110009994) }, ACC_VALUE(-0.561254125) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.220335342), ACC_VALUE(-0.110009994) }, ACC_VALUE(-2.46823429) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.249026648), ACC_VALUE(-0.00486328384) }, ACC_VALUE(2.44915871) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307344103), ACC_VALUE(-0.0514527091) }, ACC_VALUE(0.360289658) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307344103), ACC_VALUE(0.0514527091) }, ACC_VALUE(-5.59346198) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.239814228), ACC_VALUE(-0.0567786079) }, ACC_VALUE(-17.4174578) },
+    { { ACC_VALUE(1), ACC_VALUE(0.239814228), ACC_VALUE(0.0567786079) }, ACC_VALUE(-105.776317) },
+};
+
+static const ACC_MpcRegion_t MpcRegions1[12] = {
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 0u, 4u },     // 125812 samples
+    { { ACC_VALUE(3.2395819), ACC_VALUE(-0.707293548), ACC_VALUE(0.382414217) }, ACC_VALUE(0), 4u, 8u },     // 91457 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 12u, 4u },     // 66708 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 16u, 5u },     // 38596 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 21u, 5u },     // 20922 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 26u, 6u },     // 18480 samples
+    { { ACC_VALUE(3.46616055), ACC_VALUE(-0.763717668), ACC_VALUE(0.3813123) }, ACC_VALUE(-0.173421785), 32u, 7u },     // 16391 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 39u, 6u },     // 10940 samples
+    { { ACC_VALUE(5.25381768), ACC_VALUE(-1.31314355), ACC_VALUE(0.289332498) }, ACC_VALUE(-3.29811349), 45u, 6u },     // 4858 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 51u, 7u },     // 4561 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 58u, 7u },     // 985 samples
+    { { ACC_VALUE(3.46616055), ACC_VALUE(-0.763717668), ACC_VALUE(0.3813123) }, ACC_VALUE(0.554949713), 65u, 7u },     // 290 samples
+};
+
+static const ACC_MpcRow_t MpcRows2[59] = {
+    { { ACC_VALUE(-1), ACC_VALUE(0.275049312), ACC_VALUE(-0.0150073182) }, ACC_VALUE(1.88467051) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.285016614), ACC_VALUE(0) }, ACC_VALUE(2.05835275) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.292282839), ACC_VALUE(0) }, ACC_VALUE(2.37208624) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.297005697), ACC_VALUE(0) }, ACC_VALUE(2.86414911) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.227416302), ACC_VALUE(0.0645723829) }, ACC_VALUE(-0.70469088) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.227416302), ACC_VALUE(-0.0645723829) }, ACC_VALUE(-2.25479082) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.28162375), ACC_VALUE(-0.0343004986) }, ACC_VALUE(-1.12514594) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.28162375), ACC_VALUE(0.0343004986) }, ACC_VALUE(-3.600247) },
+    { { ACC_VALUE(0.421644833), ACC_VALUE(-1), ACC_VALUE(-0.702939091) }, ACC_VALUE(-18.7185647) },
+    { { ACC_VALUE(-0.421644833), ACC_VALUE(1), ACC_VALUE(0.702939091) }, ACC_VALUE(-59.899187) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.201992806), ACC_VALUE(0.0168316351) }, ACC_VALUE(-6.66350538) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.201992806), ACC_VALUE(-0.0168316351) }, ACC_VALUE(-21.3229972) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.275049312), ACC_VALUE(0.0150073182) }, ACC_VALUE(6.03116562) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.285016614), ACC_VALUE(0) }, ACC_VALUE(6.5869488) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.292282839), ACC_VALUE(0) }, ACC_VALUE(7.59089597) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.297005697), ACC_VALUE(0) }, ACC_VALUE(9.16549714) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.259740705), ACC_VALUE(-0.0254708407) }, ACC_VALUE(1.2017506) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.274030176), ACC_VALUE(0) }, ACC_VALUE(1.31994496) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.285544064), ACC_VALUE(0) }, ACC_VALUE(1.66998997) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.297005697), ACC_VALUE(0) }, ACC_VALUE(-2.86434911) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.297005697), ACC_VALUE(0) }, ACC_VALUE(-1.3741044) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.236012365), ACC_VALUE(-0.0488934024) }, ACC_VALUE(0.771165448) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.262818366), ACC_VALUE(0) }, ACC_VALUE(0.979083716) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.285544064), ACC_VALUE(0) }, ACC_VALUE(-1.67018997) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.285544064), ACC_VALUE(0) }, ACC_VALUE(-1.8763717) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.019925055), ACC_VALUE(0) }, ACC_VALUE(-30.1560816) },
+    { { ACC_VALUE(1), ACC_VALUE(0.019925055), ACC_VALUE(0) }, ACC_VALUE(-82.7997168) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.259740705), ACC_VALUE(0.0254708407) }, ACC_VALUE(3.84582191) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.274030176), ACC_VALUE(0) }, ACC_VALUE(4.22404388) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.285544064), ACC_VALUE(0) }, ACC_VALUE(5.34418791) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.297005697), ACC_VALUE(0) }, ACC_VALUE(4.92724363) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.297005697), ACC_VALUE(0) }, ACC_VALUE(-9.16569714) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.236012365), ACC_VALUE(0.0488934024) }, ACC_VALUE(2.46794943) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.262818366), ACC_VALUE(0) }, ACC_VALUE(3.13328789) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.285544064), ACC_VALUE(0) }, ACC_VALUE(1.79782624) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.285544064), ACC_VALUE(0) }, ACC_VALUE(-5.34438791) },
+    { { ACC_VALUE(-1), ACC_VALUE(-0.019925055), ACC_VALUE(0) }, ACC_VALUE(-16.4565572) },
+    { { ACC_VALUE(1), ACC_VALUE(0.019925055), ACC_VALUE(0) }, ACC_VALUE(-96.4992412) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.227416302), ACC_VALUE(0.0645723829) }, ACC_VALUE(2.25459082) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.262818366), ACC_VALUE(0) }, ACC_VALUE(0.0473358805) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.262818366), ACC_VALUE(0) }, ACC_VALUE(-3.13348789) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307371588), ACC_VALUE(0) }, ACC_VALUE(0.515145296) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307371588), ACC_VALUE(0) }, ACC_VALUE(-7.46790776) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.207249537), ACC_VALUE(0) }, ACC_VALUE(-5.75193029) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.207249537), ACC_VALUE(0) }, ACC_VALUE(-16.4479386) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.236012365), ACC_VALUE(0.0488934024) }, ACC_VALUE(-0.771365448) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.236012365), ACC_VALUE(-0.0488934024) }, ACC_VALUE(-1.71884177) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.28162375), ACC_VALUE(0.0343004986) }, ACC_VALUE(1.12494594) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.467035488), ACC_VALUE(-0.179152609) }, ACC_VALUE(-4.96361507) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.467035488), ACC_VALUE(0.179152609) }, ACC_VALUE(-11.5773367) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.0576830895), ACC_VALUE(-0.0148259924) }, ACC_VALUE(-20.7779834) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.0576830895), ACC_VALUE(0.0148259924) }, ACC_VALUE(-57.9261827) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.227416302), ACC_VALUE(-0.0645723829) }, ACC_VALUE(0.70449088) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.262818366), ACC_VALUE(0) }, ACC_VALUE(-0.979283716) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.262818366), ACC_VALUE(0) }, ACC_VALUE(-2.1068683) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.307371588), ACC_VALUE(0) }, ACC_VALUE(-2.33378992) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.307371588), ACC_VALUE(0) }, ACC_VALUE(-4.61897254) },
+    { { ACC_VALUE(-1), ACC_VALUE(0.207249537), ACC_VALUE(0) }, ACC_VALUE(-5.14004957) },
+    { { ACC_VALUE(1), ACC_VALUE(-0.207249537), ACC_VALUE(0) }, ACC_VALUE(-17.0598193) },
+};
+
+static const ACC_MpcRegion_t MpcRegions2[10] = {
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 0u, 4u },     // 120382 samples
+    { { ACC_VALUE(3.54815833), ACC_VALUE(-0.806909044), ACC_VALUE(0.229113038) }, ACC_VALUE(0), 4u, 8u },     // 95120 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 12u, 4u },     // 61715 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 16u, 5u },     // 36851 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 21u, 6u },     // 25437 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 27u, 5u },     // 20834 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 32u, 6u },     // 17021 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(-8), 38u, 7u },     // 11511 samples
+    { { ACC_VALUE(4.21685525), ACC_VALUE(-0.995229978), ACC_VALUE(0.2061764) }, ACC_VALUE(-0.752314751), 45u, 7u },     // 6850 samples
+    { { ACC_VALUE(0), ACC_VALUE(0), ACC_VALUE(0) }, ACC_VALUE(2.5), 52u, 7u },     // 4279 samples
+};
+
+const ACC_MpcTable_t MpcTables[MPC_TABLE_QTY] = {
+    { 20u, ACC_VALUE(0.935506985), 12u, 72u, MpcRegions0, MpcRows0,
+      { { ACC_VALUE(3.2412519), ACC_VALUE(-0.707253212), ACC_VALUE(0.382583186) }, ACC_VALUE(0), 0u, 0u } },
+    { 100u, ACC_VALUE(0.716531311), 12u, 72u, MpcRegions1, MpcRows1,
+      { { ACC_VALUE(3.2395819), ACC_VALUE(-0.707293548), ACC_VALUE(0.382414217) }, ACC_VALUE(0), 0u, 0u } },
+    { 200u, ACC_VALUE(0.513417119), 10u, 59u, MpcRegions2, MpcRows2,
+      { { ACC_VALUE(3.54815833), ACC_VALUE(-0.806909044), ACC_VALUE(0.229113038) }, ACC_VALUE(0), 0u, 0u } },
+};
+
+#endif // ACC_MPC_EN
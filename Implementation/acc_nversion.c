@@ -0,0 +1,124 @@
+#include "acc_nversion.h"
+#include "acc_config.h"
+#include "acc_control.h"
+#include <stdbool.h>
+
+// N-Version Control (see acc_nversion.h)
+
+#if ACC_NVERSION_EN
+
+static inline ACC_Value_t NVersion_Mul(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Mul(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline ACC_Value_t NVersion_Add(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Add(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline ACC_Value_t NVersion_Sub(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Sub(a, b);
+#else
+    return a - b;
+#endif
+}
+
+// |a - b| ≤ NVERSION_TOL (false for a NaN in the float build)
+static inline bool NVersion_Near(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    int64_t d = (int64_t)a - (int64_t)b;
+
+    return d <= (int64_t)ACC_VALUE(NVERSION_TOL) && d >= -(int64_t)ACC_VALUE(NVERSION_TOL);
+#else
+    float d = a - b;
+
+    return d <= ACC_VALUE(NVERSION_TOL) && d >= -ACC_VALUE(NVERSION_TOL);
+#endif
+}
+
+ACC_Value_t NVersion_LawB(ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                          ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                          ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                          ACC_Value_t *p_Vset)
+{
+    ACC_Value_t Vset_ramp = NVersion_Sub(*p_Vset, deltaV);
+    ACC_Value_t Vset = (Xn < Xset) ? Vset_ramp : Vcruise;          // Equations 4 / 1
+    ACC_Value_t K = NVersion_Add(NVersion_Add(K1, K2), K3);
+    ACC_Value_t feedback;
+
+    // Equations 2-3 with the gains summed: Vset enters once
+    feedback = NVersion_Add(NVersion_Add(NVersion_Mul(K1, Vn), NVersion_Mul(K2, Vn1)),
+                            NVersion_Mul(K3, Vn2));
+    *p_Vset = Vset;
+    return NVersion_Sub(NVersion_Mul(K, Vset), feedback);
+}
+
+ACC_Value_t NVersion_LawC(ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                          ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                          ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                          ACC_Value_t *p_Vset)
+{
+    bool clear = !(Xset > Xn);                                      // Gap at or above Xset
+    ACC_Value_t Vset = clear ? Vcruise : NVersion_Sub(*p_Vset, deltaV);
+    ACC_Value_t e = NVersion_Sub(Vset, Vn);
+    ACC_Value_t dM;
+
+    // Equations 2-3 about the newest sample: e(n-1) = e(n) + (Vn - Vn1), ...
+    dM = NVersion_Mul(K3, NVersion_Sub(Vn, Vn2));
+    dM = NVersion_Add(dM, NVersion_Mul(K2, NVersion_Sub(Vn, Vn1)));
+    dM = NVersion_Add(dM, NVersion_Mul(NVersion_Add(K3, NVersion_Add(K2, K1)), e));
+    *p_Vset = Vset;
+    return dM;
+}
+
+ACC_Value_t NVersion_Vote(const ACC_Value_t dM[NVERSION_QTY], const ACC_Value_t Vset[NVERSION_QTY],
+                          ACC_Value_t *p_Vset, uint8_t *p_out)
+{
+    uint8_t ab = (uint8_t)NVersion_Near(dM[0], dM[1]);
+    uint8_t ac = (uint8_t)NVersion_Near(dM[0], dM[2]);
+    uint8_t bc = (uint8_t)NVersion_Near(dM[1], dM[2]);
+    // Bit v: version v agrees with neither other one (all three: no pair agrees)
+    uint8_t out = (uint8_t)(((ab | ac) ^ 1u) | (((ab | bc) ^ 1u) << 1) | (((ac | bc) ^ 1u) << 2));
+    uint8_t pick = out & 1u;        // A unless A is outvoted, then B (agrees with C)
+
+    *p_out = out;
+    *p_Vset = (out != NVERSION_NONE) ? Vset[pick] : *p_Vset;
+    return (out != NVERSION_NONE) ? dM[pick] : ACC_VALUE(0.0);
+}
+
+ACC_Value_t NVersion_Law(ACC_NVersion_t *p_nv,
+                         ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                         ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                         ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                         ACC_Value_t *p_Vset)
+{
+    ACC_Value_t dM[NVERSION_QTY];
+    ACC_Value_t Vset[NVERSION_QTY] = { *p_Vset, *p_Vset, *p_Vset };
+    ACC_Value_t dM_n;
+    uint8_t out;
+
+    dM[0] = Control_Law(Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3, &Vset[0]);
+    dM[1] = NVersion_LawB(Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3, &Vset[1]);
+    dM[2] = NVersion_LawC(Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3, &Vset[2]);
+    dM_n = NVersion_Vote(dM, Vset, p_Vset, &out);
+
+    p_nv->votes++;
+    p_nv->masked += (out != 0u && out != NVERSION_NONE);
+    p_nv->failed += (out == NVERSION_NONE);
+    p_nv->last = out;
+    return dM_n;
+}
+
+#endif // ACC_NVERSION_EN
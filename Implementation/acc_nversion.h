@@ -0,0 +1,61 @@
+#ifndef ACC_NVERSION_H
+#define ACC_NVERSION_H
+
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include <stdint.h>
+
+// N-Version Control (ACC_NVERSION_EN)
+//
+// Control_Task computes Equations 1-4 three times on the same snapshot, with
+// three separately written forms of the law:
+//   A  Control_Law() (acc_control.c): errors first, then Equation 3
+//   B  gains first: (K1+K2+K3)·Vset - (K1·Vn + K2·Vn1 + K3·Vn2)
+//   C  about the newest sample: (K1+K2+K3)·(Vset-Vn) + K2·(Vn-Vn1) + K3·(Vn-Vn2)
+// and votes on dM. The forms round differently, so two versions agree when
+// their dM are within NVERSION_TOL, not bit for bit. A version that agrees
+// with neither other one is outvoted; the frame still gets the majority's
+// dM and Vset (A's, or B's when A is outvoted), and Control_Task raises
+// FAULT_DETECTED_FLAG. Without any agreeing pair the output is neutral (0)
+// and Vset is kept. A NaN never agrees, so a version gone NaN is outvoted.
+//
+// With all three in agreement the output is A's, bit for bit: the task set
+// computes what it computes without N-version control.
+//
+// Nothing is allocated and the voter has no data-dependent branch: three
+// compares, a mask and two selects (host/bench_nversion for the cost).
+
+#define NVERSION_QTY    3u
+#define NVERSION_NONE   0x07u       // Vote mask: every version outvoted (no majority)
+
+typedef struct {
+    uint32_t votes;
+    uint32_t masked;        // One version outvoted, majority output
+    uint32_t failed;        // No majority, neutral output
+    uint8_t  last;          // Outvoted versions of the last vote (bit v: version v)
+} ACC_NVersion_t;
+
+// Versions B and C (A is Control_Law()), same contract as Control_Law()
+ACC_Value_t NVersion_LawB(ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                          ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                          ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                          ACC_Value_t *p_Vset);
+ACC_Value_t NVersion_LawC(ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                          ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                          ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                          ACC_Value_t *p_Vset);
+
+// Votes the versions' dM and Vset: returns dM, *p_Vset the majority's Vset
+// (unchanged without a majority), *p_out the outvoted versions
+ACC_Value_t NVersion_Vote(const ACC_Value_t dM[NVERSION_QTY], const ACC_Value_t Vset[NVERSION_QTY],
+                          ACC_Value_t *p_Vset, uint8_t *p_out);
+
+// The three versions and the vote, counted in *p_nv (last: outvoted versions);
+// same contract as Control_Law()
+ACC_Value_t NVersion_Law(ACC_NVersion_t *p_nv,
+                         ACC_Value_t Xn, ACC_Value_t Xset, ACC_Value_t Vcruise, ACC_Value_t deltaV,
+                         ACC_Value_t Vn, ACC_Value_t Vn1, ACC_Value_t Vn2,
+                         ACC_Value_t K1, ACC_Value_t K2, ACC_Value_t K3,
+                         ACC_Value_t *p_Vset);
+
+#endif // ACC_NVERSION_H
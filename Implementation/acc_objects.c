@@ -5,35 +5,85 @@
 
 // Kernel Objects
 OS_SEM TimerSemaphore;
-OS_SEM FlowControlSemaphore;
-OS_MUTEX ParamMutex;
-OS_Q ControlActuatorQueue;
 OS_FLAG_GRP EventFlagGroup;
-OS_MEM MessagePartition;
-
-// Watchdog Timer
-OS_TMR WatchdogTimer;
 
 // Task Control Blocks
 OS_TCB SetupTCB;
+#if ACC_CYCLIC_EXEC
+OS_TCB FrameTCB;
+#else
 OS_TCB SensorsTCB;
 OS_TCB ControlTCB;
 OS_TCB ActuatorTCB;
+#endif
 OS_TCB DisplayTCB;
+#if ACC_TRACE_EN
+OS_TCB TraceTCB;
+#endif
+#if ACC_TELEMETRY_EN
+OS_TCB TelemTCB;
+#endif
 
 // Task Stacks
 CPU_STK SetupStk[STK_SIZE_SETUP];
+#if ACC_CYCLIC_EXEC
+CPU_STK FrameStk[STK_SIZE_FRAME];
+#else
 CPU_STK SensorsStk[STK_SIZE_SENSORS];
 CPU_STK ControlStk[STK_SIZE_CONTROL];
 CPU_STK ActuatorStk[STK_SIZE_ACTUATOR];
+#endif
 CPU_STK DisplayStk[STK_SIZE_DISPLAY];
+#if ACC_TRACE_EN
+CPU_STK TraceStk[STK_SIZE_TRACE];
+#endif
+#if ACC_TELEMETRY_EN
+CPU_STK TelemStk[STK_SIZE_TELEM];
+#endif
+
+// Control → Actuator Latest-Value Mailbox
+ACC_Mailbox_t ControlActuatorMailbox;
+
+// LCD Shadow (Display_Task)
+ACC_Display_t DisplayPanel;
+
+#if ACC_RATE_ADAPT_EN
+// Control-Rate State (Sensors stage; level read by Control for its timeout)
+ACC_Rate_t RateCtl = { RATE_LEVEL_FAST };
+#endif
+
+#if ACC_KALMAN_EN
+// Gap / Relative-Velocity Estimator (Sensors stage)
+ACC_Kalman_t Estimator;
+#endif
+
+// Per-Job Deadline Monitor (judged by the Sensors stage, completed by the Actuator stage)
+ACC_Deadline_t DeadlineMon;
+
+#if ACC_CALIB_EN
+// Calibration Sets (written by the calibration writer, swapped in by Control)
+ACC_Calib_t Calibration;
+#endif
+
+#if ACC_NVERSION_EN
+// N-Version Vote Counts (Control stage)
+ACC_NVersion_t NVersion;
+#endif
+
+#if ACC_RECOVERY_EN
+// Checkpoints and Rollback Budget (Control stage / Setup_Task)
+ACC_Recovery_t Recovery;
+#endif
 
-// Message Buffer Backing Store
-float MessageBufferArray[3];
+#if ACC_MODE_EN
+// Criticality Mode and Stage Budgets (hard stages / Display_Task / Setup_Task)
+ACC_Mode_t ModeMgr;
+#endif
 
-// Watchdog Heartbeat Flags
-volatile bool control_beat = false;
-volatile bool actuator_beat = false;
+#if ACC_TELEMETRY_EN
+// Per-Frame Telemetry Ring (Control stage → Telem_Task)
+ACC_TelemRing_t Telemetry;
+#endif
 
 // Parameter Memory Block Instance
 ACC_Parameters_t Parameters;
@@ -1,26 +1,69 @@
 #ifndef ACC_PARAMS_H
 #define ACC_PARAMS_H
 
+#include "os.h"
+#include "acc_config.h"
+#include "acc_fixed.h"
 #include <stdint.h>
 
 // Parameter Memory Block Structure
+// Values are ACC_Value_t: float, or Q16.16 with ACC_FIXED_POINT (acc_fixed.h)
+//
+// One block per writer, each with its own seqlock (see acc_seqlock.h) and
+// aligned to its own ACC_CACHE_LINE: a store by one writer never invalidates
+// the line another core is reading or writing. With the hard tasks on one core
+// and Display/Setup on the other (dual-core partition), the sensor block moves
+// from the hard core to Display once per frame, the configuration block from
+// Setup to the hard core only when it changes, and the control block never
+// leaves the hard core.
+//
+// seq: odd while a write is in progress; 32 bits so a reader can never miss a
+// full wrap between its two reads. First member, so the alignment applies to
+// the block and sizeof() rounds up to whole lines.
+
+// Written by the Sensors stage only
 typedef struct {
-    uint8_t seq;              // Sequence counter (fresh-data guarantee)
-                              // Note: uint8_t wraps quickly (0-255), which is fine for freshness check
-                              // If computing deltas, consider uint16_t
-    uint8_t ACC01;            // ACC-on-off flag
-    float K1, K2, K3;         // Controller parameters
-    float Vcruise;            // Set cruise speed
-    float Vset;               // Current cycle speed reference
-    float Xset;               // Minimum safe distance
-    float Xn;                 // Current distance (nth cycle)
-    float Vn;                 // Current speed (nth cycle)
-    float Vn1;                // Speed at cycle (n-1)
-    float Vn2;                // Speed at cycle (n-2)
-    float dMn;                // Manipulated variable
-    float deltaV;             // Speed reduction parameter (for Equation 4)
-} ACC_Parameters_t;
+    _Alignas(ACC_CACHE_LINE) volatile uint32_t seq;
+    ACC_Value_t Xn;               // Current distance (nth cycle)
+    ACC_Value_t Vn;               // Current speed (nth cycle)
+    ACC_Value_t Vn1;              // Speed at cycle (n-1)
+    ACC_Value_t Vn2;              // Speed at cycle (n-2)
+    ACC_Value_t Xe;               // Estimated gap (ACC_KALMAN_EN, acc_kalman.h)
+    ACC_Value_t Vr;               // Estimated relative velocity, m/s (< 0: closing in)
+    ACC_Value_t Ve;               // Estimated speed
+    ACC_Value_t Al;               // Estimated lead acceleration (KALMAN_LEAD_ACCEL)
+    uint8_t rate;                 // Control-rate level Vn was sampled at (ACC_RATE_ADAPT_EN, acc_rate.h)
+    CPU_TS release;               // ISR release of the frame Vn was sampled in (acc_deadline.h)
+    uint32_t rollback;            // config.rollback the history was last restarted for (ACC_RECOVERY_EN)
+} ACC_SensorParams_t;
 
-#endif // ACC_PARAMS_H
+// Written by the Control stage only
+typedef struct {
+    _Alignas(ACC_CACHE_LINE) volatile uint32_t seq;
+    ACC_Value_t dMn;              // Manipulated variable
+    ACC_Value_t Vset;             // Current cycle speed reference
+    ACC_Value_t Amodel;           // Modelled ego acceleration, m/s² (ACC_LAW_MPC, acc_mpc.h)
+    uint32_t engage;              // config.engage Vset was last restarted for
+    uint32_t rollback;            // config.rollback the state was last restored for (ACC_RECOVERY_EN)
+} ACC_ControlParams_t;
 
+// Written by Setup_Task (and main() before the kernel starts)
+typedef struct {
+    _Alignas(ACC_CACHE_LINE) volatile uint32_t seq;
+    uint8_t ACC01;                // ACC-on-off flag
+    uint32_t engage;              // Engagements so far: Control restarts Vset from Vcruise on a change
+    uint32_t rollback;            // Rollbacks so far: Control restores a checkpoint on a change (acc_recovery.h)
+    ACC_Value_t K1, K2, K3;       // Controller parameters
+    ACC_Value_t Vcruise;          // Set cruise speed
+    ACC_Value_t Xset;             // Minimum safe distance
+    ACC_Value_t deltaV;           // Speed reduction parameter (for Equation 4)
+    uint8_t law;                  // ACC_LAW_EQ3 or ACC_LAW_MPC (acc_mpc.h)
+} ACC_ConfigParams_t;
 
+typedef struct {
+    ACC_SensorParams_t  sensor;
+    ACC_ControlParams_t control;
+    ACC_ConfigParams_t  config;
+} ACC_Parameters_t;
+
+#endif // ACC_PARAMS_H
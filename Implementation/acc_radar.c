@@ -0,0 +1,131 @@
+#include "acc_radar.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Multi-Target Radar (see acc_radar.h)
+
+#if ACC_RADAR_EN
+
+#if ACC_OVERSAMPLE_EN
+#error "ACC_RADAR_EN replaces the single distance sensor that ACC_OVERSAMPLE_EN filters"
+#endif
+
+#define RADAR_KEY_NONE   UINT32_MAX
+
+#if ACC_FIXED_POINT
+
+// Q16.16 products with 64-bit intermediates: ranges up to RADAR_RANGE_MAX_M
+// squared do not fit Q16.16, so no intermediate is stored in 32 bits
+#define RADAR_QMUL(a, b)       (((int64_t)(a) * (int64_t)(b)) >> ACC_Q_FRAC_BITS)
+
+static ACC_Value_t Radar_Select_Fixed(const ACC_RadarFrame_t *p_frame, ACC_Value_t Vn, ACC_RadarLead_t *p_lead)
+{
+    int32_t x_tbl[RADAR_TRACKS_MAX];
+    int64_t v, half_k;                          // Ego m/s (Q16.16), κ/2 (Q32.32)
+    uint32_t best = RADAR_KEY_NONE;
+    uint32_t count = p_frame->count;
+    uint32_t i;
+
+    v = RADAR_QMUL(Vn, ACC_Q_CONST(1.0 / 3.6));
+    if (v < ACC_Q_CONST(RADAR_V_MIN_KMH / 3.6))
+    {
+        v = ACC_Q_CONST(RADAR_V_MIN_KMH / 3.6);
+    }
+    half_k = ((int64_t)p_frame->yaw_rate * ((int64_t)1 << 32)) / v / 2;
+
+    for (i = 0u; i < RADAR_TRACKS_MAX; i++)
+    {
+        int64_t r = p_frame->range[i];
+        int64_t a = p_frame->azimuth[i];
+        int64_t a2 = RADAR_QMUL(a, a);
+        int64_t c = ACC_Q_ONE - RADAR_QMUL(a2 / 2, ACC_Q_ONE - a2 / 12);
+        int64_t s = RADAR_QMUL(a, ACC_Q_ONE - RADAR_QMUL(a2 / 6, ACC_Q_ONE - a2 / 20));
+        int64_t x = RADAR_QMUL(r, c);
+        int64_t dy = RADAR_QMUL(r, s) - RADAR_QMUL((half_k * x) >> 32, x);
+        int64_t gate = ACC_Q_CONST(RADAR_LANE_HALF_M) + RADAR_QMUL(ACC_Q_CONST(RADAR_GATE_GROW), x);
+        uint32_t in = (uint32_t)(i < count) & (uint32_t)(x > ACC_Q_CONST(RADAR_X_MIN_M)) &
+                      (uint32_t)(dy < gate) & (uint32_t)(dy > -gate);
+        uint32_t key = ((uint32_t)x & ~RADAR_IDX_MASK) | i | (in - 1u);     // Out of path: RADAR_KEY_NONE
+
+        x_tbl[i] = (int32_t)x;
+        best = (key < best) ? key : best;
+    }
+
+    p_lead->found = best != RADAR_KEY_NONE;
+    if (!p_lead->found)
+    {
+        p_lead->idx = 0u;
+        p_lead->x = ACC_Q_CONST(RADAR_RANGE_MAX_M);
+        p_lead->range_rate = 0;
+        return p_lead->x;
+    }
+    p_lead->idx = best & RADAR_IDX_MASK;
+    p_lead->x = x_tbl[p_lead->idx];
+    p_lead->range_rate = p_frame->range_rate[p_lead->idx];
+    return p_lead->x;
+}
+
+#else
+
+static ACC_Value_t Radar_Select_Float(const ACC_RadarFrame_t *p_frame, ACC_Value_t Vn, ACC_RadarLead_t *p_lead)
+{
+    float x_tbl[RADAR_TRACKS_MAX];
+    float v = Vn / 3.6f;
+    float half_k;
+    uint32_t best = RADAR_KEY_NONE;
+    uint32_t count = p_frame->count;
+    uint32_t i;
+
+    if (v < (float)RADAR_V_MIN_KMH / 3.6f)
+    {
+        v = (float)RADAR_V_MIN_KMH / 3.6f;
+    }
+    half_k = 0.5f * p_frame->yaw_rate / v;
+
+    for (i = 0u; i < RADAR_TRACKS_MAX; i++)
+    {
+        float r = p_frame->range[i];
+        float a = p_frame->azimuth[i];
+        float a2 = a * a;
+        float c = 1.0f - 0.5f * a2 * (1.0f - a2 * (1.0f / 12.0f));
+        float s = a * (1.0f - a2 * (1.0f / 6.0f) * (1.0f - a2 * (1.0f / 20.0f)));
+        float x = r * c;
+        float dy = r * s - half_k * x * x;
+        float gate = (float)RADAR_LANE_HALF_M + (float)RADAR_GATE_GROW * x;
+        uint32_t in = (uint32_t)(i < count) & (uint32_t)(x > (float)RADAR_X_MIN_M) &
+                      (uint32_t)(dy < gate) & (uint32_t)(dy > -gate);
+        uint32_t bits;
+        uint32_t key;
+
+        memcpy(&bits, &x, sizeof(bits));
+        key = (bits & ~RADAR_IDX_MASK) | i | (in - 1u);     // Out of path: RADAR_KEY_NONE
+        x_tbl[i] = x;
+        best = (key < best) ? key : best;
+    }
+
+    p_lead->found = best != RADAR_KEY_NONE;
+    if (!p_lead->found)
+    {
+        p_lead->idx = 0u;
+        p_lead->x = (float)RADAR_RANGE_MAX_M;
+        p_lead->range_rate = 0.0f;
+        return p_lead->x;
+    }
+    p_lead->idx = best & RADAR_IDX_MASK;
+    p_lead->x = x_tbl[p_lead->idx];
+    p_lead->range_rate = p_frame->range_rate[p_lead->idx];
+    return p_lead->x;
+}
+
+#endif
+
+ACC_Value_t Radar_SelectLead(const ACC_RadarFrame_t *p_frame, ACC_Value_t Vn, ACC_RadarLead_t *p_lead)
+{
+#if ACC_FIXED_POINT
+    return Radar_Select_Fixed(p_frame, Vn, p_lead);
+#else
+    return Radar_Select_Float(p_frame, Vn, p_lead);
+#endif
+}
+
+#endif // ACC_RADAR_EN
@@ -0,0 +1,59 @@
+#ifndef ACC_RADAR_H
+#define ACC_RADAR_H
+
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Multi-Target Radar (ACC_RADAR_EN)
+//
+// The radar reports up to RADAR_TRACKS_MAX tracked objects per frame as a
+// structure of arrays (range, range rate, azimuth), plus the ego yaw rate at
+// the time of the frame. Radar_SelectLead() picks the lead vehicle in the
+// predicted ego path:
+//
+//   path: y = κ/2 · x², κ = yaw rate / ego speed (constant-curvature arc)
+//   track: x = r·cos θ, y = r·sin θ (small-angle polynomials, |θ| < 0.6 rad)
+//   in path: x > RADAR_X_MIN_M and |y - κ/2 · x²| < RADAR_LANE_HALF_M + RADAR_GATE_GROW · x
+//   lead: the in-path track with the smallest x
+//
+// Every slot is evaluated, valid or not, with no data-dependent branch: the
+// cost is the same for 1 or 64 tracks, and the float loop vectorizes where
+// the target has SIMD (host: 4 slots per instruction). The nearest track is
+// found with one unsigned minimum over keys that hold the bits of x
+// (non-negative, so their order is the order of x) with the slot index in the
+// low 6 bits; a slot out of path gets the all-ones key.
+//
+// Units: range m (longitudinal and lateral m), range rate m/s (negative:
+// closing), azimuth rad (positive: left), yaw rate rad/s (positive: left).
+// Values are ACC_Value_t; with ACC_FIXED_POINT the selection runs in integer
+// arithmetic.
+
+#define RADAR_IDX_BITS   6u
+#define RADAR_IDX_MASK   ((1u << RADAR_IDX_BITS) - 1u)
+
+#if RADAR_TRACKS_MAX > (1u << RADAR_IDX_BITS)
+#error "RADAR_TRACKS_MAX must fit in RADAR_IDX_BITS"
+#endif
+
+typedef struct {
+    _Alignas(ACC_CACHE_LINE) ACC_Value_t range[RADAR_TRACKS_MAX];    // Slots at and above count are ignored
+    ACC_Value_t range_rate[RADAR_TRACKS_MAX];
+    ACC_Value_t azimuth[RADAR_TRACKS_MAX];
+    uint32_t    count;                          // Valid tracks (0 .. RADAR_TRACKS_MAX)
+    ACC_Value_t yaw_rate;                       // Ego yaw rate at the frame
+} ACC_RadarFrame_t;
+
+typedef struct {
+    bool        found;                          // An in-path track exists
+    uint32_t    idx;                            // Its slot
+    ACC_Value_t x;                              // Longitudinal distance (m)
+    ACC_Value_t range_rate;                     // m/s
+} ACC_RadarLead_t;
+
+// Lead vehicle of the frame for ego speed Vn (km/h). Returns its longitudinal
+// distance as Xn, or RADAR_RANGE_MAX_M (free road) if no track is in path.
+ACC_Value_t Radar_SelectLead(const ACC_RadarFrame_t *p_frame, ACC_Value_t Vn, ACC_RadarLead_t *p_lead);
+
+#endif // ACC_RADAR_H
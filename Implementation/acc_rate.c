@@ -0,0 +1,183 @@
+#include "acc_rate.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Adaptive Control Rate (see acc_rate.h)
+
+#if ACC_RATE_ADAPT_EN
+
+#define RATE_TAPS             3u
+
+const uint32_t RatePeriodsMs[RATE_LEVEL_QTY] = {
+    RATE_PERIOD_FAST_MS, RATE_PERIOD_MID_MS, RATE_PERIOD_SLOW_MS
+};
+
+static ACC_RateLevel_t RateLevels[RATE_LEVEL_QTY];
+
+// num / den as a value (integer-only on the Q16.16 build)
+static ACC_Value_t Rate_Ratio(uint32_t num, uint32_t den)
+{
+#if ACC_FIXED_POINT
+    return (acc_q_t)(((int64_t)num << ACC_Q_FRAC_BITS) / den);
+#else
+    return (float)num / (float)den;
+#endif
+}
+
+static inline ACC_Value_t Rate_Mul(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Mul(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline ACC_Value_t Rate_Add(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Add(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline ACC_Value_t Rate_Sub(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return Q_Sub(a, b);
+#else
+    return a - b;
+#endif
+}
+
+static inline ACC_Value_t Rate_Avg2(ACC_Value_t a, ACC_Value_t b)
+{
+#if ACC_FIXED_POINT
+    return (acc_q_t)(((int64_t)a + b) >> 1);
+#else
+    return (a + b) * 0.5f;
+#endif
+}
+
+void Rate_Init(void)
+{
+    uint32_t l, i;
+
+    memset(RateLevels, 0, sizeof(RateLevels));
+    for (l = 0u; l < RATE_LEVEL_QTY; l++)
+    {
+        ACC_RateLevel_t *p_lvl = &RateLevels[l];
+        const uint32_t T = RatePeriodsMs[l];
+
+        // Tap i sits at lag i × TIMER_PERIOD_MS = (i × TIMER_PERIOD_MS / T) taps of T
+        for (i = 0u; i < RATE_TAPS; i++)
+        {
+            uint32_t lag = i * TIMER_PERIOD_MS;
+            uint32_t j = lag / T;
+            uint32_t rem = lag % T;
+
+            if (j >= RATE_TAPS - 1u)
+            {
+                p_lvl->gain[RATE_TAPS - 1u][i] = ACC_VALUE(1.0);
+            }
+            else
+            {
+                p_lvl->gain[j][i] = Rate_Ratio(T - rem, T);
+                p_lvl->gain[j + 1u][i] = Rate_Ratio(rem, T);
+            }
+        }
+        p_lvl->ratio = Rate_Ratio(T, TIMER_PERIOD_MS);
+        p_lvl->per_s = Rate_Ratio(1000u, T);
+    }
+}
+
+void Rate_Reset(ACC_Rate_t *p_rate)
+{
+    memset(p_rate, 0, sizeof(*p_rate));
+    p_rate->level = RATE_LEVEL_FAST;
+}
+
+bool Rate_Update(ACC_Rate_t *p_rate, ACC_Value_t Xn, ACC_Value_t Vn, ACC_Value_t Xset)
+{
+    const ACC_Value_t near = Rate_Mul(Xset, ACC_VALUE(RATE_NEAR_FACTOR));
+    const bool crawl = Vn < ACC_VALUE(RATE_CRAWL_KMH);
+    bool closing_in;
+    uint8_t want;
+
+    // Closing speed from successive samples, smoothed over about two frames
+    if (p_rate->valid)
+    {
+        ACC_Value_t dX = Rate_Sub(p_rate->Xprev, Xn);
+
+        p_rate->closing = Rate_Avg2(p_rate->closing, Rate_Mul(dX, RateLevels[p_rate->level].per_s));
+    }
+    p_rate->Xprev = Xn;
+    p_rate->valid = true;
+    p_rate->frames[p_rate->level]++;
+    closing_in = p_rate->closing > ACC_VALUE(RATE_CLOSING_MPS);
+
+    if (closing_in &&
+        (Xn < Xset || Xn < Rate_Mul(p_rate->closing, ACC_VALUE(RATE_TTC_FAST_S)) || (crawl && Xn < near)))
+    {
+        want = RATE_LEVEL_FAST;
+    }
+    else if (Xn < near ||
+             (closing_in && Xn < Rate_Mul(p_rate->closing, ACC_VALUE(RATE_TTC_MID_S))) ||
+             crawl)
+    {
+        want = RATE_LEVEL_MID;
+    }
+    else
+    {
+        want = RATE_LEVEL_SLOW;
+    }
+
+    if (want < p_rate->level)
+    {
+        // Faster at once
+        p_rate->level = want;
+        p_rate->dwell_ms = 0u;
+        p_rate->switches++;
+        return true;
+    }
+    if (want > p_rate->level)
+    {
+        // Slower, one level at a time, once the condition has held
+        p_rate->dwell_ms += RatePeriodsMs[p_rate->level];
+        if (p_rate->dwell_ms >= RATE_DWELL_MS)
+        {
+            p_rate->level++;
+            p_rate->dwell_ms = 0u;
+            p_rate->switches++;
+            return true;
+        }
+        return false;
+    }
+    p_rate->dwell_ms = 0u;
+    return false;
+}
+
+void Rate_ScaleGains(uint8_t level, ACC_Value_t *p_K1, ACC_Value_t *p_K2, ACC_Value_t *p_K3,
+                     ACC_Value_t *p_deltaV)
+{
+    const ACC_RateLevel_t *p_lvl = &RateLevels[level];
+    const ACC_Value_t K[RATE_TAPS] = { *p_K1, *p_K2, *p_K3 };
+    ACC_Value_t out[RATE_TAPS];
+    uint32_t i, j;
+
+    for (j = 0u; j < RATE_TAPS; j++)
+    {
+        out[j] = ACC_VALUE(0.0);
+        for (i = 0u; i < RATE_TAPS; i++)
+        {
+            out[j] = Rate_Add(out[j], Rate_Mul(p_lvl->gain[j][i], K[i]));
+        }
+    }
+    *p_K1 = out[0];
+    *p_K2 = out[1];
+    *p_K3 = out[2];
+    *p_deltaV = Rate_Mul(*p_deltaV, p_lvl->ratio);
+}
+
+#endif // ACC_RATE_ADAPT_EN
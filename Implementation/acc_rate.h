@@ -0,0 +1,72 @@
+#ifndef ACC_RATE_H
+#define ACC_RATE_H
+
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Adaptive Control Rate (ACC_RATE_ADAPT_EN)
+//
+// The frame period moves between RATE_LEVEL_QTY levels (RATE_PERIOD_*_MS in
+// acc_config.h) with the traffic situation, judged by Sensors_Task on every
+// sample:
+//   FAST  closing in (gap shrinking by more than RATE_CLOSING_MPS) and either
+//         inside Xset, time to collision below RATE_TTC_FAST_S, or crawling
+//         (below RATE_CRAWL_KMH) with a lead within RATE_NEAR_FACTOR × Xset
+//   MID   lead within RATE_NEAR_FACTOR × Xset, time to collision below
+//         RATE_TTC_MID_S, or crawling
+//   SLOW  otherwise (open road or a lead far ahead and not closing in)
+// A faster level is taken at once; a slower one only after its condition has
+// held for RATE_DWELL_MS, and one level at a time. The hardware timer, the
+// Control timeout and the frame deadline follow the level together
+// (FRAME_PERIOD_MS, acc_config.h).
+//
+// Gains: dM(n) is an acceleration request, so K1 + K2 + K3 (per km/h of
+// error) does not depend on the sample time. The taps weight the speed error
+// at lags 0, T and 2T of TIMER_PERIOD_MS; at another period each tap is moved
+// to the same lag in time, split linearly between the two nearest taps and
+// clamped at the oldest. The static gain is unchanged and the error window
+// keeps its span as far as three taps reach. deltaV is a Vset step per frame
+// and is scaled by T / TIMER_PERIOD_MS, keeping the ramp in km/h per second.
+
+#define RATE_LEVEL_QTY        3u
+#define RATE_LEVEL_FAST       0u
+#define RATE_LEVEL_MID        1u
+#define RATE_LEVEL_SLOW       2u
+
+#define RATE_TTC_FAST_S       4       // Time to collision (s) that needs the fast rate
+#define RATE_TTC_MID_S        10
+#define RATE_NEAR_FACTOR      2       // Lead within 2 × Xset counts as near
+#define RATE_CRAWL_KMH        30      // Stop-and-go speed
+#define RATE_CLOSING_MPS      1       // Closing in: gap shrinking faster than sensor noise
+
+typedef struct {
+    ACC_Value_t gain[3][3];         // Tap i of TIMER_PERIOD_MS to tap j: gain[j][i]
+    ACC_Value_t ratio;              // Period / TIMER_PERIOD_MS (deltaV scale)
+    ACC_Value_t per_s;              // 1000 / period (closing speed per frame → m/s)
+} ACC_RateLevel_t;
+
+typedef struct {
+    uint8_t     level;              // Level in force (its period is RatePeriodMs)
+    uint32_t    dwell_ms;           // Time the slower level's condition has held
+    ACC_Value_t Xprev;              // Previous distance sample
+    ACC_Value_t closing;            // Closing speed, m/s (smoothed, > 0: gap shrinking)
+    bool        valid;              // Xprev holds a sample of this engagement
+    uint32_t    switches;           // Level changes
+    uint32_t    frames[RATE_LEVEL_QTY];     // Frames sampled at each level
+} ACC_Rate_t;
+
+extern const uint32_t RatePeriodsMs[RATE_LEVEL_QTY];
+
+void Rate_Init(void);                               // Builds the per-level gain tables
+void Rate_Reset(ACC_Rate_t *p_rate);                // ACC engaged: FAST, no history
+
+// Judges the new sample; returns true if the level changed (the caller
+// reprograms the frame timer for the new period)
+bool Rate_Update(ACC_Rate_t *p_rate, ACC_Value_t Xn, ACC_Value_t Vn, ACC_Value_t Xset);
+
+// Gains of TIMER_PERIOD_MS moved to the sample period of a level
+void Rate_ScaleGains(uint8_t level, ACC_Value_t *p_K1, ACC_Value_t *p_K2, ACC_Value_t *p_K3,
+                     ACC_Value_t *p_deltaV);
+
+#endif // ACC_RATE_H
@@ -0,0 +1,112 @@
+#include "acc_recovery.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Checkpoint / Rollback Recovery (see acc_recovery.h)
+
+#if ACC_RECOVERY_EN
+
+#define RECOVERY_CHECK_SEED   0x5A17C0DEu   // Also makes an all-zero slot fail
+
+static inline uint32_t Recovery_Rotl(uint32_t x, uint32_t r)
+{
+    return (x << r) | (x >> (32u - r));
+}
+
+uint32_t Recovery_Check(const ACC_Checkpoint_t *p_ckpt)
+{
+    uint32_t w[5];
+    uint32_t h = RECOVERY_CHECK_SEED;
+    uint32_t i;
+
+    w[0] = p_ckpt->engage;
+    w[1] = p_ckpt->frame;
+    memcpy(&w[2], &p_ckpt->Vset, sizeof(w[2]));
+    memcpy(&w[3], &p_ckpt->dMn, sizeof(w[3]));
+    memcpy(&w[4], &p_ckpt->Amodel, sizeof(w[4]));
+    // MurmurHash3 (x86, 32-bit) over the words: every step is one-to-one,
+    // so a single flipped bit always changes the result, and the rotations
+    // spread high bits down, so several flips cancel out only by chance
+    // (they can in a plain xor or FNV-style check: two flips of bit 31)
+    for (i = 0u; i < 5u; i++)
+    {
+        uint32_t k = w[i] * 0xCC9E2D51u;
+
+        k = Recovery_Rotl(k, 15) * 0x1B873593u;
+        h = Recovery_Rotl(h ^ k, 13) * 5u + 0xE6546B64u;
+    }
+    h ^= (uint32_t)sizeof(w);
+    h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+void Recovery_Init(ACC_Recovery_t *p_rec)
+{
+    memset(p_rec, 0, sizeof(*p_rec));
+}
+
+void Recovery_Frame(ACC_Recovery_t *p_rec, uint32_t engage, bool doubt,
+                    ACC_Value_t Vset, ACC_Value_t dMn, ACC_Value_t Amodel)
+{
+    ACC_Checkpoint_t *p_ckpt;
+
+    p_rec->frames++;
+    if (doubt || (p_rec->frames % RECOVERY_CKPT_FRAMES) != 0u)
+    {
+        return;
+    }
+    p_ckpt = &p_rec->ring[p_rec->head];
+    p_ckpt->engage = engage;
+    p_ckpt->frame = p_rec->frames;
+    p_ckpt->Vset = Vset;
+    p_ckpt->dMn = dMn;
+    p_ckpt->Amodel = Amodel;
+    p_ckpt->check = Recovery_Check(p_ckpt);
+    p_rec->head = (p_rec->head + 1u) % RECOVERY_CKPT_QTY;
+    p_rec->taken++;
+}
+
+bool Recovery_Restore(ACC_Recovery_t *p_rec, uint32_t engage, ACC_Checkpoint_t *p_ckpt)
+{
+    uint32_t i;
+
+    // Newest first: the slot before head
+    for (i = 1u; i <= RECOVERY_CKPT_QTY; i++)
+    {
+        const ACC_Checkpoint_t *p_slot = &p_rec->ring[(p_rec->head + RECOVERY_CKPT_QTY - i) % RECOVERY_CKPT_QTY];
+
+        if (Recovery_Check(p_slot) != p_slot->check)
+        {
+            p_rec->invalid++;
+            continue;
+        }
+        if (p_slot->engage != engage)
+        {
+            break;      // Older slots are older engagements too
+        }
+        *p_ckpt = *p_slot;
+        p_rec->restored++;
+        return true;
+    }
+    p_rec->restarted++;
+    return false;
+}
+
+bool Recovery_Allow(ACC_Recovery_t *p_rec, OS_TICK now)
+{
+    OS_TICK *p_oldest = &p_rec->when[p_rec->rollbacks % RECOVERY_MAX_ROLLBACKS];
+
+    if (p_rec->rollbacks >= RECOVERY_MAX_ROLLBACKS &&
+        (OS_TICK)(now - *p_oldest) < (OS_TICK)MS_TO_TICKS(RECOVERY_WINDOW_MS))
+    {
+        p_rec->shutdowns++;
+        return false;
+    }
+    *p_oldest = now;
+    p_rec->rollbacks++;
+    return true;
+}
+
+#endif // ACC_RECOVERY_EN
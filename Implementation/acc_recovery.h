@@ -0,0 +1,79 @@
+#ifndef ACC_RECOVERY_H
+#define ACC_RECOVERY_H
+
+#include "os.h"
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Checkpoint / Rollback Recovery (ACC_RECOVERY_EN)
+//
+// Control keeps the last RECOVERY_CKPT_QTY checkpoints of its own state in a
+// ring: every RECOVERY_CKPT_FRAMES computed frames whose output was not in
+// doubt (no vote disagreement), it stores Vset, dMn and Amodel with the
+// engagement and a frame number, sealed by a check word. A checkpoint is a
+// few stores and one MurmurHash3 pass over five words.
+//
+// On DEADLINE_MISS_FLAG or FAULT_DETECTED_FLAG Setup_Task no longer turns
+// ACC off. Instead it:
+//   1. drops a command not yet applied (mailbox reset);
+//   2. clears the two flags;
+//   3. counts a rollback in the configuration block (config.rollback).
+// The timer keeps running. At the next release Sensors sees the new count:
+// it restarts the speed history from that sample and re-arms the deadline
+// monitor, so the faulty frames do not count against the new ones. Control
+// then restores the newest checkpoint of this engagement whose check word
+// holds. Without one it restarts as on engagement (Vset = Vcruise). The
+// frame is computed and applied as usual, so actuation resumes within one
+// frame of the fault.
+//
+// A fault that keeps coming back is not transient. More than
+// RECOVERY_MAX_ROLLBACKS rollbacks within RECOVERY_WINDOW_MS take the former
+// path: timer off, ACC off, and the driver must re-engage.
+
+typedef struct {
+    uint32_t    engage;             // Engagement it belongs to
+    uint32_t    frame;              // Control frame it was taken at
+    ACC_Value_t Vset;
+    ACC_Value_t dMn;
+    ACC_Value_t Amodel;             // MPC model state (0 without ACC_MPC_EN)
+    uint32_t    check;              // Check word of the fields above (fails on an unwritten slot)
+} ACC_Checkpoint_t;
+
+typedef struct {
+    // Control stage
+    ACC_Checkpoint_t ring[RECOVERY_CKPT_QTY];
+    uint32_t         head;          // Next slot to write
+    uint32_t         frames;        // Computed frames (frame number)
+    uint32_t         taken;         // Checkpoints stored
+    uint32_t         restored;      // Rollbacks served from a checkpoint
+    uint32_t         restarted;     // Rollbacks without a valid checkpoint
+    uint32_t         invalid;       // Checkpoints skipped on a failed check word
+
+    // Setup_Task
+    OS_TICK          when[RECOVERY_MAX_ROLLBACKS];  // Ticks of the last rollbacks
+    uint32_t         rollbacks;     // Rollbacks requested
+    uint32_t         shutdowns;     // Faults sent down the ACC-off path
+} ACC_Recovery_t;
+
+// Before the kernel starts
+void Recovery_Init(ACC_Recovery_t *p_rec);
+
+// Control stage: one computed frame; stores a checkpoint every
+// RECOVERY_CKPT_FRAMES frames unless the frame is in doubt
+void Recovery_Frame(ACC_Recovery_t *p_rec, uint32_t engage, bool doubt,
+                    ACC_Value_t Vset, ACC_Value_t dMn, ACC_Value_t Amodel);
+
+// Control stage: newest valid checkpoint of this engagement into *p_ckpt;
+// false if there is none
+bool Recovery_Restore(ACC_Recovery_t *p_rec, uint32_t engage, ACC_Checkpoint_t *p_ckpt);
+
+// Setup_Task: true if a rollback at tick now stays within the budget (and
+// counts it), false if the fault must turn ACC off
+bool Recovery_Allow(ACC_Recovery_t *p_rec, OS_TICK now);
+
+// Check word of a checkpoint (host tools)
+uint32_t Recovery_Check(const ACC_Checkpoint_t *p_ckpt);
+
+#endif // ACC_RECOVERY_H
@@ -0,0 +1,83 @@
+#ifndef ACC_SEQLOCK_H
+#define ACC_SEQLOCK_H
+
+#include "os.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Seqlocks
+//
+// Readers never block and never take a kernel object: they copy the fields
+// between two reads of the sequence counter and retry if it was odd (write in
+// progress) or changed (write completed meanwhile).
+//
+// Usage (reader):
+//     do {
+//         seq = Seq_ReadBegin(&obj.seq);
+//         ... copy fields ...
+//     } while (Seq_ReadRetry(&obj.seq, seq));
+//
+// Seq_WriteBegin()/Seq_WriteEnd() are for objects with exactly one writer
+// task that no reader can preempt on its own core. The Parameter Memory Block
+// (acc_params.h) has one block per writer: the sensor and control blocks are
+// written by the hard stages, above all of their readers, and use these
+// directly. A reader on the other core of a dual-core partition simply
+// retries until the writer's few stores are done.
+//
+// The configuration block is written by Setup_Task, below every reader, and
+// uses the Param_* wrappers instead, which lock the scheduler for the stores
+// in between: no task-level reader can be dispatched on that core while seq
+// is odd (it would spin on a preempted writer), and a reader on the other core
+// waits at most for the stores. Writers never wait for readers, so the hard
+// tasks are never blocked by Display_Task or Setup_Task.
+
+static inline uint32_t Seq_ReadBegin(const volatile uint32_t *p_seq)
+{
+    uint32_t seq = *p_seq;
+
+    // seq load completes before the field loads
+    atomic_thread_fence(memory_order_acquire);
+    return seq;
+}
+
+static inline bool Seq_ReadRetry(const volatile uint32_t *p_seq, uint32_t seq)
+{
+    // Field loads complete before seq is re-read
+    atomic_thread_fence(memory_order_acquire);
+    return (seq & 1u) != 0u || *p_seq != seq;
+}
+
+static inline void Seq_WriteBegin(volatile uint32_t *p_seq)
+{
+    *p_seq = *p_seq + 1u;                       // Odd: write in progress
+    // Odd seq is visible before any field store
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void Seq_WriteEnd(volatile uint32_t *p_seq)
+{
+    // Field stores are visible before seq becomes even again
+    atomic_thread_fence(memory_order_release);
+    *p_seq = *p_seq + 1u;                       // Even: object consistent
+}
+
+// Parameter Memory Block writer below its readers (replaces ParamMutex)
+
+static inline void Param_WriteBegin(volatile uint32_t *p_seq)
+{
+    OS_ERR err;
+
+    OSSchedLock(&err);
+    Seq_WriteBegin(p_seq);
+}
+
+static inline void Param_WriteEnd(volatile uint32_t *p_seq)
+{
+    OS_ERR err;
+
+    Seq_WriteEnd(p_seq);
+    OSSchedUnlock(&err);
+}
+
+#endif // ACC_SEQLOCK_H
@@ -0,0 +1,63 @@
+#include "acc_stack.h"
+#include "acc_types.h"
+#include "acc_config.h"
+
+// Stack Profiling (see acc_stack.h)
+
+#if ACC_STK_PROFILE_EN
+
+#define STACK_USE(tcb, macro)   { &(tcb), #macro, (macro), 0u, 0u }
+
+ACC_StackUse_t StackUse[] = {
+    STACK_USE(SetupTCB, STK_SIZE_SETUP),
+#if ACC_CYCLIC_EXEC
+    STACK_USE(FrameTCB, STK_SIZE_FRAME),
+#else
+    STACK_USE(SensorsTCB, STK_SIZE_SENSORS),
+    STACK_USE(ControlTCB, STK_SIZE_CONTROL),
+    STACK_USE(ActuatorTCB, STK_SIZE_ACTUATOR),
+#endif
+    STACK_USE(DisplayTCB, STK_SIZE_DISPLAY),
+#if ACC_TRACE_EN
+    STACK_USE(TraceTCB, STK_SIZE_TRACE),
+#endif
+#if ACC_TELEMETRY_EN
+    STACK_USE(TelemTCB, STK_SIZE_TELEM),
+#endif
+};
+
+const uint32_t StackUseQty = sizeof(StackUse) / sizeof(StackUse[0]);
+
+void Stack_Sample(void)
+{
+    OS_ERR err;
+    CPU_STK_SIZE free_stk, used;
+    uint32_t i;
+
+    for (i = 0u; i < StackUseQty; i++)
+    {
+        ACC_StackUse_t *p_use = &StackUse[i];
+
+        OSTaskStkChk(p_use->p_tcb, &free_stk, &used, &err);
+        if (err != OS_ERR_NONE)
+        {
+            continue;                                   // Not created (yet) or without STK_CHK
+        }
+        if (used > p_use->peak)
+        {
+            p_use->peak = used;
+        }
+        p_use->samples++;
+    }
+}
+
+CPU_STK_SIZE Stack_Suggest(CPU_STK_SIZE peak)
+{
+    CPU_STK_SIZE need = peak + (CPU_STK_SIZE)STK_ISR_NEST_MAX * STK_ISR_FRAME;
+
+    need = (need * (100u + STK_PROFILE_MARGIN_PCT) + 99u) / 100u;
+    need = (need + STK_PROFILE_ALIGN - 1u) / STK_PROFILE_ALIGN * STK_PROFILE_ALIGN;
+    return (need < STK_PROFILE_MIN) ? STK_PROFILE_MIN : need;
+}
+
+#endif // ACC_STK_PROFILE_EN
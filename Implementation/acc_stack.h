@@ -0,0 +1,38 @@
+#ifndef ACC_STACK_H
+#define ACC_STACK_H
+
+#include "os.h"
+#include <stdint.h>
+
+// Stack Profiling (ACC_STK_PROFILE_EN)
+//
+// Every task is created with OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, so
+// OSTaskStkChk() can count the words never written since creation: a
+// high-water mark, not a snapshot. Stack_Sample() runs it on every TCB of the
+// build from Display_Task (once per DISPLAY_PERIOD_MS) and keeps the peak
+// per task; a mark only grows, so sampling slowly loses nothing.
+//
+// Stack_Suggest() turns a peak into a size for acc_config.h:
+//   (peak + STK_ISR_NEST_MAX × STK_ISR_FRAME) × (100 + STK_PROFILE_MARGIN_PCT) / 100
+// rounded up to STK_PROFILE_ALIGN, at least STK_PROFILE_MIN. The ISR term
+// reserves the exception frames of the deepest interrupt nesting, which a
+// profiling run may never have hit on top of the deepest call path.
+//
+// On the target, read StackUse[] with the debugger after a stress drive; on
+// the host, make -C host stack writes the suggested acc_config.h.
+
+typedef struct {
+    OS_TCB       *p_tcb;
+    const char   *macro;            // STK_SIZE_* the task is created with
+    CPU_STK_SIZE  size;             // Configured size (CPU_STK)
+    CPU_STK_SIZE  peak;             // Highest used count seen (CPU_STK)
+    uint32_t      samples;          // OSTaskStkChk() calls that succeeded
+} ACC_StackUse_t;
+
+extern ACC_StackUse_t StackUse[];
+extern const uint32_t StackUseQty;
+
+void         Stack_Sample(void);                            // OSTaskStkChk() on every task, keeps the peaks
+CPU_STK_SIZE Stack_Suggest(CPU_STK_SIZE peak);              // Suggested STK_SIZE_* for a peak
+
+#endif // ACC_STACK_H
@@ -2,15 +2,552 @@
 #include "acc_config.h"
 #include "acc_hardware.h"
 #include "acc_params.h"
+#include "acc_seqlock.h"
+#include "acc_mailbox.h"
+#include "acc_control.h"
+#include "acc_trace.h"
+#include "acc_display.h"
+#include "acc_rate.h"
+#include "acc_deadline.h"
+#include "acc_stack.h"
+#include "acc_radar.h"
+#include "acc_kalman.h"
+#include "acc_mpc.h"
+#include "acc_calib.h"
+#include "acc_nversion.h"
+#include "acc_recovery.h"
+#include "acc_mode.h"
+#include "acc_telemetry.h"
 #include <stdbool.h>
 #include <stdint.h>
 
+// Frame Stages
+// The three steps of a frame, run by Sensors_Task, Control_Task and
+// Actuator_Task in turn, or back to back by Frame_Task (ACC_CYCLIC_EXEC)
+
+#if ACC_OVERSAMPLE_EN
+// Filters the newest oversampled block (fixed cost, see acc_acquire.h).
+// Returns false if no intact block was available this frame.
+static bool Frame_Acquire(ACC_Value_t *p_Xn, ACC_Value_t *p_Vn)
+{
+    const ACC_SensorBlock_t *p_blk;
+    uint32_t seq;
+    
+    p_blk = Read_Sensor_Block(&seq);
+    if (p_blk == NULL)
+    {
+        return false;
+    }
+    *p_Xn = Filter_Block(p_blk->dist);
+    *p_Vn = Filter_Block(p_blk->speed);
+    return Release_Sensor_Block(seq, *p_Xn, *p_Vn);
+}
+#endif
+
+#if ACC_RADAR_EN
+static ACC_RadarFrame_t RadarFrame;     // Sensors stage only (too large for its stack)
+#endif
+
+// Sensors stage: judge the previous frame's deadline, read the sensors,
+// update the parameter memory block (release: this frame's ISR post time)
+static void Frame_Sense(CPU_TS release)
+{
+    OS_ERR err;
+    ACC_Value_t Xn_local, Vn_local;
+#if ACC_RADAR_EN
+    ACC_RadarLead_t lead;
+#endif
+#if (ACC_RATE_ADAPT_EN && !ACC_CALIB_EN) || ACC_RECOVERY_EN
+    uint32_t seq;
+#endif
+#if ACC_RATE_ADAPT_EN
+    ACC_Value_t Xset;
+    uint8_t rate;
+#endif
+#if ACC_KALMAN_EN
+    ACC_Estimate_t est;
+#endif
+#if ACC_MODE_EN
+    CPU_TS start = OS_TS_GET();     // Stage time against its budget (acc_mode.h)
+#endif
+#if ACC_RECOVERY_EN
+    uint32_t rollback;
+    
+    // Rollback requested by Setup_Task since the last frame: the verdicts of
+    // the faulty frames are dropped (acc_recovery.h)
+    do
+    {
+        seq = Seq_ReadBegin(&Parameters.config.seq);
+        rollback = Parameters.config.rollback;
+    } while (Seq_ReadRetry(&Parameters.config.seq, seq));
+    if (rollback != Parameters.sensor.rollback)
+    {
+        Deadline_Rearm(&DeadlineMon);
+#if ACC_KALMAN_EN
+        Kalman_Reset(&Estimator);   // Restarts from this sample
+#endif
+    }
+#endif
+    
+    // Previous frame met its deadline? Raise DeadlineMiss once (m,k) fails
+    if (Deadline_Release(&DeadlineMon, release, DEADLINE_MS_TO_TS(FRAME_DEADLINE_MS)))
+    {
+        OSFlagPost(&EventFlagGroup,
+                  (OS_FLAGS)DEADLINE_MISS_FLAG,
+                  OS_OPT_POST_FLAG_SET,
+                  &err);
+    }
+#if ACC_MODE_EN
+    // Back to normal criticality once every stage has been quiet for a while
+    (void)Mode_Release(&ModeMgr);
+#endif
+    
+    // Read sensors (hardware I/O)
+    TRACE(TRACE_RING_SENSORS, TRACE_EV_READ_BEGIN);
+#if ACC_OVERSAMPLE_EN
+    if (!Frame_Acquire(&Xn_local, &Vn_local))
+    {
+        // Acquisition stalled or overran: one direct sample this frame
+        Xn_local = Read_Distance_Sensor();
+        Vn_local = Read_Speed_Sensor();
+    }
+#elif ACC_RADAR_EN
+    // Track list and yaw rate of the newest radar frame; the lead vehicle in
+    // the predicted path gives Xn (constant cost for any number of tracks)
+    Vn_local = Read_Speed_Sensor();
+    Read_Radar_Frame(&RadarFrame);
+    Xn_local = Radar_SelectLead(&RadarFrame, Vn_local, &lead);
+    Release_Radar_Frame(Xn_local, Vn_local);
+#else
+    Xn_local = Read_Distance_Sensor();
+    Vn_local = Read_Speed_Sensor();
+#endif
+    TRACE(TRACE_RING_SENSORS, TRACE_EV_READ_END);
+    
+#if ACC_RATE_ADAPT_EN
+    // Judge the sample for the control rate; a new level applies from this
+    // release on, while this sample keeps the level it was taken at
+#if ACC_CALIB_EN
+    Xset = Calibration.active->img.Xset;    // Set of Control's last frame (same core)
+#else
+    do
+    {
+        seq = Seq_ReadBegin(&Parameters.config.seq);
+        Xset = Parameters.config.Xset;
+    } while (Seq_ReadRetry(&Parameters.config.seq, seq));
+#endif
+    rate = RateCtl.level;
+    if (Rate_Update(&RateCtl, Xn_local, Vn_local, Xset))
+    {
+        Hardware_Timer_SetPeriod(FRAME_PERIOD_MS);  // Control's timeout and the deadline follow
+    }
+#endif
+    
+#if ACC_KALMAN_EN
+    // Estimate over the period the sample was taken at (fixed cost, no
+    // allocation; budget in acc_kalman.h)
+#if ACC_RATE_ADAPT_EN
+    Kalman_Step(&Estimator, Xn_local, Vn_local, rate, &est);
+#else
+    Kalman_Step(&Estimator, Xn_local, Vn_local, 0u, &est);
+#endif
+#endif
+    
+    // Update the sensor block with fresh-data guarantee
+    // Seqlock write: seq odd → write → seq even (sole writer, above all of
+    // its readers: no scheduler lock)
+    // Speed history shift: Vn2 ← Vn1 ← Vn ← Vn_local (correct order)
+    TRACE(TRACE_RING_SENSORS, TRACE_EV_PARAM_BEGIN);
+    Seq_WriteBegin(&Parameters.sensor.seq);
+    Parameters.sensor.Vn2 = Parameters.sensor.Vn1;  // Shift: Vn1 → Vn2
+    Parameters.sensor.Vn1 = Parameters.sensor.Vn;   // Shift: Vn → Vn1
+    Parameters.sensor.Vn = Vn_local;                // New value
+    Parameters.sensor.Xn = Xn_local;                // New distance
+#if ACC_RECOVERY_EN
+    if (rollback != Parameters.sensor.rollback)
+    {
+        Parameters.sensor.Vn1 = Vn_local;           // Rolled back: the history
+        Parameters.sensor.Vn2 = Vn_local;           // restarts from this sample
+        Parameters.sensor.rollback = rollback;
+    }
+#endif
+#if ACC_KALMAN_EN
+    Parameters.sensor.Xe = est.Xe;                  // Estimate from this sample
+    Parameters.sensor.Vr = est.Vr;
+    Parameters.sensor.Ve = est.Ve;
+    Parameters.sensor.Al = est.Al;
+#endif
+#if ACC_RATE_ADAPT_EN
+    Parameters.sensor.rate = rate;                  // Sample period of Vn
+#endif
+    Parameters.sensor.release = release;            // Frame the sample belongs to
+    Seq_WriteEnd(&Parameters.sensor.seq);
+    TRACE(TRACE_RING_SENSORS, TRACE_EV_PARAM_END);
+#if ACC_MODE_EN
+    Mode_Charge(&ModeMgr, MODE_STAGE_SENSORS, OS_TS_GET() - start);
+#endif
+}
+
+// Control stage: compute dM(n) from a snapshot of the parameter memory block
+// (*p_release: the frame it belongs to). Returns false (nothing to actuate)
+// unless ACC_ON and SafeToActuate are set.
+static bool Frame_Control(ACC_Value_t *p_dM, CPU_TS *p_release)
+{
+    OS_ERR err;
+    
+    // Local variables for calculations
+    ACC_Value_t Xn, Vn, Vn1, Vn2, Vset, Xset, Vcruise;
+    ACC_Value_t K1, K2, K3, deltaV;
+    ACC_Value_t dM_n;        // Manipulated variable
+    CPU_TS release;          // ISR release of the sample's frame
+    uint32_t engage;         // Engagement the configuration belongs to
+    uint32_t seq;            // Sequence counter read
+    OS_FLAGS flags;          // Event flags
+#if ACC_MPC_EN
+    ACC_Value_t dM_prev, Amodel;    // Previous output and modelled acceleration
+    uint8_t law;             // Equation 3 or MPC
+#endif
+#if ACC_RATE_ADAPT_EN
+    uint8_t rate;            // Control-rate level of the sample
+#endif
+#if ACC_KALMAN_EN
+    ACC_Value_t Xe, Vr;      // Estimated gap and relative velocity
+#endif
+#if ACC_CALIB_EN
+    const ACC_CalibSet_t *p_cal;    // Calibration set of this frame
+#endif
+#if ACC_RECOVERY_EN
+    uint32_t rollback;       // Rollbacks requested by Setup_Task
+    ACC_Checkpoint_t ckpt;   // Restored state
+    bool doubt = false;      // No checkpoint of this frame
+#endif
+#if ACC_MODE_EN
+    CPU_TS start = OS_TS_GET();     // Stage time against its budget
+#endif
+#if ACC_TELEMETRY_EN
+    uint32_t telem;          // TELEM_F_* of the frame record
+#endif
+    
+    // Check event flags: ACC_ON AND SafeToActuate (non-blocking check)
+    flags = OSFlagAccept(&EventFlagGroup,
+                        (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG),
+                        OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_NON_BLOCKING,
+                        &err);
+    
+    if (err != OS_ERR_NONE || 
+        (flags & (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG)) != 
+        (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG))
+    {
+        // ACC not enabled or not safe to actuate
+        // Skip control calculation, wait for next cycle
+        return false;
+    }
+    
+    // Read Phase: Lock-free snapshots of the sensor and configuration blocks
+    // Fresh-data guarantee: read seq₁ → copy → re-read seq; retry if a
+    // write was in progress (odd) or completed meanwhile (changed)
+    do
+    {
+        seq = Seq_ReadBegin(&Parameters.sensor.seq);
+        Xn = Parameters.sensor.Xn;
+        Vn = Parameters.sensor.Vn;
+        Vn1 = Parameters.sensor.Vn1;
+        Vn2 = Parameters.sensor.Vn2;
+#if ACC_KALMAN_EN
+        Xe = Parameters.sensor.Xe;
+        Vr = Parameters.sensor.Vr;
+#endif
+#if ACC_RATE_ADAPT_EN
+        rate = Parameters.sensor.rate;
+#endif
+        release = Parameters.sensor.release;
+    } while (Seq_ReadRetry(&Parameters.sensor.seq, seq));
+    
+    // Cache controller gains each cycle (to avoid stale params if updated at runtime)
+    do
+    {
+        seq = Seq_ReadBegin(&Parameters.config.seq);
+#if !ACC_CALIB_EN
+        Xset = Parameters.config.Xset;
+        Vcruise = Parameters.config.Vcruise;
+        K1 = Parameters.config.K1;      // Cache gains safely
+        K2 = Parameters.config.K2;
+        K3 = Parameters.config.K3;
+        deltaV = Parameters.config.deltaV;
+#endif
+        engage = Parameters.config.engage;
+#if ACC_MPC_EN
+        law = Parameters.config.law;
+#endif
+#if ACC_RECOVERY_EN
+        rollback = Parameters.config.rollback;
+#endif
+    } while (Seq_ReadRetry(&Parameters.config.seq, seq));
+#if ACC_CALIB_EN
+    // Frame boundary: a calibration set published since the last frame is
+    // taken with one atomic exchange and holds for the whole frame (no copy;
+    // the writer only ever fills the other buffer)
+    p_cal = Calib_Frame(&Calibration);
+    Xset = p_cal->img.Xset;
+    Vcruise = p_cal->img.Vcruise;
+    deltaV = p_cal->img.deltaV;
+#endif
+    
+    // Own block (no other writer): the ramp restarts from Vcruise on the
+    // first frame after each engagement
+    Vset = (Parameters.control.engage == engage) ? Parameters.control.Vset : Vcruise;
+#if ACC_MPC_EN
+    dM_prev = (Parameters.control.engage == engage) ? Parameters.control.dMn : ACC_VALUE(0.0);
+    Amodel = (Parameters.control.engage == engage) ? Parameters.control.Amodel : ACC_VALUE(0.0);
+#endif
+#if ACC_RECOVERY_EN
+    if (Parameters.control.engage == engage && Parameters.control.rollback != rollback)
+    {
+        // Rolled back: the newest valid checkpoint of this engagement, or a
+        // restart as on engagement without one
+        if (Recovery_Restore(&Recovery, engage, &ckpt))
+        {
+            Vset = ckpt.Vset;
+#if ACC_MPC_EN
+            dM_prev = ckpt.dMn;
+            Amodel = ckpt.Amodel;
+#endif
+        }
+        else
+        {
+            Vset = Vcruise;
+#if ACC_MPC_EN
+            dM_prev = ACC_VALUE(0.0);
+            Amodel = ACC_VALUE(0.0);
+#endif
+        }
+    }
+#endif
+    
+    // Compute Phase: Calculate dM(n) using control algorithm (outside the
+    // write section; Equations 1-4 in acc_control.c, float or Q16.16)
+    TRACE(TRACE_RING_CONTROL, TRACE_EV_CALC_BEGIN);
+#if ACC_CALIB_EN
+    // Gain schedule at the ego speed (linear between breakpoints)
+    Calib_Gains(p_cal, Vn, &K1, &K2, &K3);
+#endif
+#if ACC_RATE_ADAPT_EN
+    // Gains and Vset step of TIMER_PERIOD_MS moved to the sample's period
+    Rate_ScaleGains(rate, &K1, &K2, &K3, &deltaV);
+#endif
+#if ACC_MODE_EN
+    if (Mode_High(&ModeMgr))
+    {
+        // High criticality (acc_mode.h): Equation 3 on the current error
+        // with the summed gain, on the measured gap; no lookahead, vote or
+        // MPC this frame
+        dM_n = Control_LawDegraded(Xn, Xset, Vcruise, deltaV,
+                                   Vn,
+                                   K1, K2, K3,
+                                   &Vset);
+#if ACC_NVERSION_EN
+        NVersion.last = 0u;         // Nothing voted
+#endif
+    }
+    else
+#endif
+    {
+#if ACC_KALMAN_EN
+        // Equation 1/4 on the gap KALMAN_LOOKAHEAD_MS ahead: a lead closing in
+        // starts the Vset ramp before the gap itself is below Xset
+        Xn = Kalman_Lookahead(Xe, Vr);
+#endif
+#if ACC_NVERSION_EN
+        // Three versions of Equations 1-4 on this snapshot, voted: the
+        // majority's dM and Vset (neutral without one)
+        dM_n = NVersion_Law(&NVersion, Xn, Xset, Vcruise, deltaV,
+                            Vn, Vn1, Vn2,
+                            K1, K2, K3,
+                            &Vset);
+#else
+        dM_n = Control_Law(Xn, Xset, Vcruise, deltaV,
+                           Vn, Vn1, Vn2,
+                           K1, K2, K3,
+                           &Vset);
+#endif
+#if ACC_MPC_EN
+        if (law == ACC_LAW_MPC)
+        {
+            // Equation 3 replaced: the first move of the explicit MPC tracking
+            // this Vset within the request limits (bounded region lookup)
+#if ACC_RATE_ADAPT_EN
+            dM_n = Mpc_Law(rate, Vset, Vn, dM_prev, &Amodel);
+#else
+            dM_n = Mpc_Law(RATE_LEVEL_MID, Vset, Vn, dM_prev, &Amodel);
+#endif
+        }
+#endif
+    }
+    TRACE(TRACE_RING_CONTROL, TRACE_EV_CALC_END);
+#if ACC_NVERSION_EN
+    if (NVersion.last != 0u)
+    {
+        // A version disagreed: Setup_Task disengages ACC (or rolls back,
+        // ACC_RECOVERY_EN). This frame's output is still the majority's (or
+        // neutral)
+        OSFlagPost(&EventFlagGroup,
+                  (OS_FLAGS)FAULT_DETECTED_FLAG,
+                  OS_OPT_POST_FLAG_SET,
+                  &err);
+#if ACC_RECOVERY_EN
+        doubt = true;
+#endif
+    }
+#endif
+#if ACC_RECOVERY_EN
+    // Every RECOVERY_CKPT_FRAMES frames: checkpoint of the state this frame
+    // leaves (a few stores and a check word)
+#if ACC_MPC_EN
+    Recovery_Frame(&Recovery, engage, doubt, Vset, dM_n, Amodel);
+#else
+    Recovery_Frame(&Recovery, engage, doubt, Vset, dM_n, ACC_VALUE(0.0));
+#endif
+#endif
+#if ACC_TELEMETRY_EN
+    // Frame record for the telemetry stream (a few stores, never waits; the
+    // control block still holds the previous frame's engagement here)
+    telem = (Parameters.control.engage != engage) ? TELEM_F_ENGAGE : 0u;
+#if ACC_RECOVERY_EN
+    telem |= (Parameters.control.engage == engage && Parameters.control.rollback != rollback) ? TELEM_F_ROLLBACK : 0u;
+#endif
+#if ACC_MODE_EN
+    telem |= Mode_High(&ModeMgr) ? TELEM_F_DEGRADED : 0u;
+#endif
+#if ACC_NVERSION_EN
+    telem |= (NVersion.last != 0u) ? TELEM_F_OUTVOTED : 0u;
+#endif
+#if ACC_MPC_EN
+    telem |= (law == ACC_LAW_MPC && (telem & TELEM_F_DEGRADED) == 0u) ? TELEM_F_MPC : 0u;
+#endif
+#if ACC_RATE_ADAPT_EN
+    telem |= (uint32_t)rate << TELEM_F_RATE_SHIFT;
+#endif
+    Telem_Put(&Telemetry, telem, Xn, Vn, Vset, dM_n);
+#endif
+    
+    // Output Phase: Store dM(n) in the control block (sole writer)
+    TRACE(TRACE_RING_CONTROL, TRACE_EV_PARAM_BEGIN);
+    Seq_WriteBegin(&Parameters.control.seq);
+    Parameters.control.dMn = dM_n;
+    Parameters.control.Vset = Vset;  // Update Vset for next cycle
+#if ACC_MPC_EN
+    Parameters.control.Amodel = Amodel;
+#endif
+    Parameters.control.engage = engage;
+#if ACC_RECOVERY_EN
+    Parameters.control.rollback = rollback;
+#endif
+    Seq_WriteEnd(&Parameters.control.seq);
+    TRACE(TRACE_RING_CONTROL, TRACE_EV_PARAM_END);
+    
+#if ACC_MODE_EN
+    Mode_Charge(&ModeMgr, MODE_STAGE_CONTROL, OS_TS_GET() - start);
+#endif
+    
+    *p_dM = dM_n;
+    *p_release = release;
+    return true;
+}
+
+// Actuator stage: apply dM(n), re-checking the flags right before the output.
+// The frame completes with the output; it is stamped for the deadline monitor
+// just before the write, so whoever sees the output sees the job done.
+static void Frame_Actuate(ACC_Value_t dM, CPU_TS release)
+{
+    OS_ERR err;
+    OS_FLAGS flags;
+#if ACC_MODE_EN
+    CPU_TS start = OS_TS_GET();     // Stage time against its budget
+#endif
+    
+    // Check event flags: ACC_ON AND SafeToActuate (non-blocking check)
+    flags = OSFlagAccept(&EventFlagGroup,
+                        (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG),
+                        OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_NON_BLOCKING,
+                        &err);
+    
+    if (err == OS_ERR_NONE && 
+        (flags & (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG)) == 
+        (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG))
+    {
+        // Apply control value to actuators
+        TRACE(TRACE_RING_ACTUATOR, TRACE_EV_APPLY);
+        Deadline_Complete(&DeadlineMon, release, CPU_TS_Get32());
+        Apply_Throttle_Brake(dM);
+    }
+    else
+    {
+        // ACC not enabled or not safe, explicitly neutralize output
+        Deadline_Complete(&DeadlineMon, release, CPU_TS_Get32());
+        Apply_Throttle_Brake(ACC_VALUE(0.0));  // Neutral output (no acceleration/braking)
+    }
+#if ACC_MODE_EN
+    Mode_Charge(&ModeMgr, MODE_STAGE_ACTUATOR, OS_TS_GET() - start);
+#endif
+}
+
+#if ACC_CYCLIC_EXEC
+
+// Frame Task - time-triggered cyclic executive
+// Runs the whole frame as a fixed sequence after each timer release:
+// one dispatch and one kernel object (TimerSemaphore) per frame instead of
+// three of each. Display_Task and Setup_Task stay preemptible background tasks.
+void Frame_Task(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_TS release;
+    ACC_Value_t dM_n;
+    
+    while(1)
+    {
+        // Wait for the timer release (timeout: the frame did not come)
+        OSSemPend(&TimerSemaphore,
+                 MS_TO_TICKS(CONTROL_TIMEOUT_MS),  // Timeout = 1.5 × T_ISR (150ms)
+                 OS_OPT_PEND_BLOCKING,
+                 &ts,
+                 &err);
+        
+        // Check for timeout (deadline miss)
+        if (err == OS_ERR_TIMEOUT)
+        {
+            // Set deadline miss event flag
+            OSFlagPost(&EventFlagGroup,
+                      (OS_FLAGS)DEADLINE_MISS_FLAG,
+                      OS_OPT_POST_FLAG_SET,
+                      &err);
+            continue;  // Skip this cycle
+        }
+        else if (err != OS_ERR_NONE)
+        {
+            // Pend aborted by Setup_Task to re-arm the timeout when ACC engages
+            continue;
+        }
+        TRACE_AT(TRACE_RING_FRAME, TRACE_EV_RELEASE, ts);  // Release = ISR post time
+        TRACE(TRACE_RING_FRAME, TRACE_EV_START);
+        
+        // Static schedule: Sensors → Control → Actuator
+        Frame_Sense(ts);
+        if (Frame_Control(&dM_n, &release))
+        {
+            Frame_Actuate(dM_n, release);
+        }
+        TRACE(TRACE_RING_FRAME, TRACE_EV_END);
+    }
+}
+
+#else
+
 // Sensors Task - Pseudo-Code
 void Sensors_Task(void *p_arg)
 {
     OS_ERR err;
     CPU_TS ts;
-    float Xn_local, Vn_local;
     
     while(1)
     {
@@ -20,35 +557,18 @@ void Sensors_Task(void *p_arg)
                  OS_OPT_PEND_BLOCKING,
                  &ts,
                  &err);
+        TRACE_AT(TRACE_RING_SENSORS, TRACE_EV_RELEASE, ts);  // Release = ISR post time
+        TRACE(TRACE_RING_SENSORS, TRACE_EV_START);
         
-        // Read sensors (hardware I/O)
-        Xn_local = Read_Distance_Sensor();
-        Vn_local = Read_Speed_Sensor();
-        
-        // Update parameter memory block with fresh-data guarantee
-        OSMutexPend(&ParamMutex,
-                   0,
-                   OS_OPT_PEND_BLOCKING,
-                   &ts,
-                   &err);
-        
-        // Fresh-data guarantee: seq++ → write → seq++
-        // Speed history shift: Vn2 ← Vn1 ← Vn ← Vn_local (correct order)
-        Parameters.seq++;
-        Parameters.Vn2 = Parameters.Vn1;  // Shift: Vn1 → Vn2
-        Parameters.Vn1 = Parameters.Vn;   // Shift: Vn → Vn1
-        Parameters.Vn = Vn_local;         // New value
-        Parameters.Xn = Xn_local;         // New distance
-        Parameters.seq++;
-        
-        OSMutexPost(&ParamMutex,
-                   OS_OPT_POST_NONE,
-                   &err);
+        // Judge the previous frame, read sensors, update the parameter memory block
+        Frame_Sense(ts);
         
         // Signal Control task (task semaphore)
+        TRACE(TRACE_RING_SENSORS, TRACE_EV_POST);
         OSTaskSemPost(&ControlTCB,
                      OS_OPT_POST_NONE,
                      &err);
+        TRACE(TRACE_RING_SENSORS, TRACE_EV_END);
     }
 }
 
@@ -57,24 +577,16 @@ void Control_Task(void *p_arg)
 {
     OS_ERR err;
     CPU_TS ts;
-    OS_MSG_SIZE msg_size;
+    CPU_TS release;          // ISR release of this frame
+    ACC_Value_t dM_n;        // Manipulated variable
     
-    // Local variables for calculations
-    float Xn, Vn, Vn1, Vn2, Vset, Xset, Vcruise;
-    float K1, K2, K3, deltaV;
-    float e_n, e_n1, e_n2;  // Error values
-    float dM_n;              // Manipulated variable
-    uint8_t seq1, seq2;      // Sequence counter reads
-    OS_FLAGS flags;          // Event flags
-    float *msg_ptr;          // Message buffer pointer
-    
-    // Controller parameters will be read each cycle under mutex
+    // Controller parameters will be read each cycle from the parameter block
     // (to avoid stale params if updated at runtime)
     
     while(1)
     {
         // Wait for signal from Sensors task (with timeout in ticks)
-        OSTaskSemPend(MS_TO_TICKS(CONTROL_TIMEOUT_MS),  // Timeout = 90ms < T_ISR (100ms)
+        OSTaskSemPend(MS_TO_TICKS(CONTROL_TIMEOUT_MS),  // Timeout = 1.5 × T_ISR (150ms)
                      OS_OPT_PEND_BLOCKING,
                      &ts,
                      &err);
@@ -89,149 +601,31 @@ void Control_Task(void *p_arg)
                       &err);
             continue;  // Skip this cycle
         }
-        
-        // Check event flags: ACC_ON AND SafeToActuate (non-blocking check)
-        flags = OSFlagAccept(&EventFlagGroup,
-                            (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG),
-                            OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_NON_BLOCKING,
-                            &err);
-        
-        if (err != OS_ERR_NONE || 
-            (flags & (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG)) != 
-            (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG))
+        else if (err != OS_ERR_NONE)
         {
-            // ACC not enabled or not safe to actuate
-            // Skip control calculation, wait for next cycle
+            // Pend aborted by Setup_Task to re-arm the timeout when ACC engages
             continue;
         }
+        TRACE_AT(TRACE_RING_CONTROL, TRACE_EV_RELEASE, ts);  // Release = Sensors post time
+        TRACE(TRACE_RING_CONTROL, TRACE_EV_START);
         
-        // Read Phase: Acquire mutex and copy data with fresh-data check
-        OSMutexPend(&ParamMutex,
-                   0,
-                   OS_OPT_PEND_BLOCKING,
-                   &ts,
-                   &err);
-        
-        // Fresh-data guarantee: read seq₁ → copy → read seq₂
-        // Cache controller gains safely (read under mutex to avoid stale params)
-        seq1 = Parameters.seq;
-        Xn = Parameters.Xn;
-        Vn = Parameters.Vn;
-        Vn1 = Parameters.Vn1;
-        Vn2 = Parameters.Vn2;
-        Vset = Parameters.Vset;
-        Xset = Parameters.Xset;
-        Vcruise = Parameters.Vcruise;
-        K1 = Parameters.K1;      // Cache gains safely
-        K2 = Parameters.K2;
-        K3 = Parameters.K3;
-        deltaV = Parameters.deltaV;
-        seq2 = Parameters.seq;
-        
-        OSMutexPost(&ParamMutex,
-                   OS_OPT_POST_NONE,
-                   &err);
-        
-        // Fresh-Data Check: Accept only if seq₁ == seq₂ and even
-        if (seq1 != seq2 || (seq1 & 1) != 0)
+        // Flags check, snapshot, control law, dM(n)/Vset write-back
+        if (!Frame_Control(&dM_n, &release))
         {
-            // Data was partially updated, skip this cycle
-            // Optional: Could reuse last good sample here (store snapshot)
+            TRACE(TRACE_RING_CONTROL, TRACE_EV_END);
             continue;
         }
         
-        // Compute Phase: Calculate dM(n) using control algorithm (outside mutex)
-        // Control Algorithm Implementation
-        
-        if (Xn >= Xset)
-        {
-            // Equation 1: Vset = Vcruise
-            Vset = Vcruise;
-            
-            // Equation 2: Calculate errors
-            e_n = Vset - Vn;
-            e_n1 = Vset - Vn1;
-            e_n2 = Vset - Vn2;
-            
-            // Equation 3: Calculate manipulated variable
-            dM_n = K1 * e_n + K2 * e_n1 + K3 * e_n2;
-        }
-        else  // Xn < Xset
+        // Post to Actuator task via the latest-value mailbox (overwrites any
+        // command not yet applied; wake Actuator only if no wake-up is pending)
+        TRACE(TRACE_RING_CONTROL, TRACE_EV_POST);
+        if (Mailbox_Post(&ControlActuatorMailbox, dM_n, release))
         {
-            // Equation 4: Vset = Vset - deltaV
-            Vset = Vset - deltaV;
-            
-            // Equation 2: Calculate errors
-            e_n = Vset - Vn;
-            e_n1 = Vset - Vn1;
-            e_n2 = Vset - Vn2;
-            
-            // Equation 3: Calculate manipulated variable
-            dM_n = K1 * e_n + K2 * e_n1 + K3 * e_n2;
-        }
-        
-        // Output Phase: Store dM(n) in parameter memory block
-        OSMutexPend(&ParamMutex,
-                   0,
-                   OS_OPT_PEND_BLOCKING,
-                   &ts,
-                   &err);
-        
-        Parameters.dMn = dM_n;
-        Parameters.Vset = Vset;  // Update Vset for next cycle
-        
-        OSMutexPost(&ParamMutex,
-                   OS_OPT_POST_NONE,
-                   &err);
-        
-        // Post to Actuator task via message queue with flow control
-        // Wait for available queue slot (flow control)
-        OSSemPend(&FlowControlSemaphore,
-                 0,
-                 OS_OPT_PEND_BLOCKING,
-                 &ts,
-                 &err);
-        
-        // Allocate message buffer from memory partition
-        msg_ptr = (float*)OSMemGet(&MessagePartition,
-                                  &err);
-        
-        if (err == OS_ERR_NONE)
-        {
-            *msg_ptr = dM_n;  // Store dM(n) value
-            
-            // Post message to queue (with size parameter)
-            OSQPost(&ControlActuatorQueue,
-                   (void*)msg_ptr,
-                   sizeof(float),
-                   OS_OPT_POST_FIFO,
-                   &err);
-            
-            // Optional: Log soft error counter if post fails
-            if (err != OS_ERR_NONE)
-            {
-                // Error posting to queue, release semaphore and buffer
-                OSSemPost(&FlowControlSemaphore,
+            OSTaskSemPost(&ActuatorTCB,
                          OS_OPT_POST_NONE,
                          &err);
-                OSMemPut(&MessagePartition,
-                        (void*)msg_ptr,
-                        &err);
-            }
-            else
-            {
-                // Control task cycle completed successfully
-                control_beat = true;  // Set heartbeat flag
-            }
-        }
-        else
-        {
-            // Memory allocation failed, release semaphore
-            OSSemPost(&FlowControlSemaphore,
-                     OS_OPT_POST_NONE,
-                     &err);
-            // Optional: Log soft error counter
         }
+        TRACE(TRACE_RING_CONTROL, TRACE_EV_END);
     }
 }
 
@@ -240,105 +634,89 @@ void Actuator_Task(void *p_arg)
 {
     OS_ERR err;
     CPU_TS ts;
-    OS_MSG_SIZE msg_size;
-    float *dM_ptr;
-    OS_FLAGS flags;
+    ACC_Command_t cmd;
     
     while(1)
     {
-        // Wait for control command from Control task (with size parameter)
-        dM_ptr = (float*)OSQPend(&ControlActuatorQueue,
-                                 0,
-                                 OS_OPT_PEND_BLOCKING,
-                                 &msg_size,
-                                 &ts,
-                                 &err);
+        // Wait for the Control task's wake-up (task semaphore)
+        OSTaskSemPend(0,
+                     OS_OPT_PEND_BLOCKING,
+                     &ts,
+                     &err);
         
-        // Validate message received successfully
         if (err != OS_ERR_NONE)
         {
-            // Error receiving message, continue to next cycle
             continue;
         }
         
-        // Post to flow control semaphore (signal availability)
-        OSSemPost(&FlowControlSemaphore,
-                 OS_OPT_POST_NONE,
-                 &err);
-        
-        // Check event flags: ACC_ON AND SafeToActuate (non-blocking check)
-        flags = OSFlagAccept(&EventFlagGroup,
-                            (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG),
-                            OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_NON_BLOCKING,
-                            &err);
-        
-        if (err == OS_ERR_NONE && 
-            (flags & (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG)) == 
-            (ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG))
+        // Take the latest command until none is left (a wake-up that finds
+        // nothing: already applied or discarded by Setup_Task). Control may
+        // post while a command is applied, or between the copy and the taken
+        // store, and then skip the wake-up; the next take finds that command.
+        while (Mailbox_Take(&ControlActuatorMailbox, &cmd))
         {
-            // Apply control value to actuators
-            Apply_Throttle_Brake(*dM_ptr);
-        }
-        else
-        {
-            // ACC not enabled or not safe, explicitly neutralize output
-            Apply_Throttle_Brake(0.0f);  // Neutral output (no acceleration/braking)
+            TRACE_AT(TRACE_RING_ACTUATOR, TRACE_EV_RELEASE, ts);  // Release = Control post time
+            TRACE(TRACE_RING_ACTUATOR, TRACE_EV_START);
+            
+            // Flags check, then apply (or neutralize); completes the frame
+            Frame_Actuate(cmd.dM, cmd.ts);
+            TRACE(TRACE_RING_ACTUATOR, TRACE_EV_END);
+            
+            // Posted without a wake-up: released now
+            ts = OS_TS_GET();
         }
-        
-        // Return message buffer to memory partition
-        OSMemPut(&MessagePartition,
-                (void*)dM_ptr,
-                &err);
-        
-        // Actuator task cycle completed successfully
-        actuator_beat = true;  // Set heartbeat flag
     }
 }
 
+#endif // ACC_CYCLIC_EXEC
+
 // Display Task - Pseudo-Code
 void Display_Task(void *p_arg)
 {
     OS_ERR err;
-    CPU_TS ts;
-    float Xn, Vn;
-    uint8_t seq1, seq2;
+    ACC_Value_t Xn, Vn;
+    uint32_t seq;
     uint8_t ACC_status;
+#if ACC_MODE_EN
+    uint32_t periods = 0u;
+#endif
     
     while(1)
     {
-        // Wait 2 seconds (periodic delay)
-        OSTimeDlyHMSM(0, 0, 2, 0,
-                     OS_OPT_TIME_HMSM_NON_STRICT,
-                     &err);
-        
-        // Read parameter memory block with fresh-data guarantee
-        OSMutexPend(&ParamMutex,
-                   0,
-                   OS_OPT_PEND_BLOCKING,
-                   &ts,
-                   &err);
+        // Wait DISPLAY_PERIOD_MS (periodic delay)
+        OSTimeDly(MS_TO_TICKS(DISPLAY_PERIOD_MS),
+                  OS_OPT_TIME_PERIODIC,
+                  &err);
+#if ACC_MODE_EN
+        // High criticality: shed, one update per MODE_DISPLAY_DIVIDER periods
+        periods++;
+        if (Mode_High(&ModeMgr) && (periods % MODE_DISPLAY_DIVIDER) != 0u)
+        {
+            continue;
+        }
+#endif
         
-        // Fresh-data guarantee: read seq₁ → copy → read seq₂
-        seq1 = Parameters.seq;
-        Xn = Parameters.Xn;
-        Vn = Parameters.Vn;
-        ACC_status = Parameters.ACC01;
-        seq2 = Parameters.seq;
+        // Read the sensor and configuration blocks with fresh-data guarantee
+        // (lock-free, never delays the hard tasks' writes)
+        do
+        {
+            seq = Seq_ReadBegin(&Parameters.sensor.seq);
+            Xn = Parameters.sensor.Xn;
+            Vn = Parameters.sensor.Vn;
+        } while (Seq_ReadRetry(&Parameters.sensor.seq, seq));
+        do
+        {
+            seq = Seq_ReadBegin(&Parameters.config.seq);
+            ACC_status = Parameters.config.ACC01;
+        } while (Seq_ReadRetry(&Parameters.config.seq, seq));
         
-        OSMutexPost(&ParamMutex,
-                   OS_OPT_POST_NONE,
-                   &err);
+        // Display on LCD (only the cells that changed go over the bus)
+        (void)Display_Update(&DisplayPanel, Xn, Vn, ACC_status);
         
-        // Fresh-Data Check: Accept only if seq₁ == seq₂ and even
-        if (seq1 == seq2 && (seq1 & 1) == 0)
-        {
-            // Display on LCD
-            LCD_Display_Distance(Xn);
-            LCD_Display_Speed(Vn);
-            LCD_Display_ACC_Status(ACC_status);
-        }
-        // Else: skip display update (data was partially updated)
-        // Optional: Could reuse last good sample here
+#if ACC_STK_PROFILE_EN
+        // Stack high-water marks of every task (OSTaskStkChk)
+        Stack_Sample();
+#endif
     }
 }
 
@@ -348,23 +726,14 @@ void Setup_Task(void *p_arg)
     OS_ERR err;
     CPU_TS ts;
     OS_FLAGS flags;
+    OS_FLAGS wait_flags;
+    bool acc_engaged = false;
     
-    // Initialize parameter memory block defaults
-    OSMutexPend(&ParamMutex,
-               0,
-               OS_OPT_PEND_BLOCKING,
-               &ts,
-               &err);
-    
-    Parameters.seq = 0;
-    Parameters.ACC01 = 0;  // ACC OFF
-    Parameters.dMn = 0.0f;
-    Parameters.Vset = Parameters.Vcruise;
-    Parameters.deltaV = 5.0f;  // Initialize deltaV (example: 5 km/h reduction)
-    
-    OSMutexPost(&ParamMutex,
-               OS_OPT_POST_NONE,
-               &err);
+    // Initialize configuration block defaults
+    Param_WriteBegin(&Parameters.config.seq);
+    Parameters.config.ACC01 = 0;  // ACC OFF
+    // (gains, Xset, Vcruise and deltaV keep their main.c defaults so tuned values take effect)
+    Param_WriteEnd(&Parameters.config.seq);
     
     // Set event flags: ACC_OFF
     OSFlagPost(&EventFlagGroup,
@@ -376,20 +745,35 @@ void Setup_Task(void *p_arg)
     {
         // Monitor event flags (ACC_ON, ACC_OFF, DeadlineMiss, FaultDetected)
         // Note: Setup_Task uses OSFlagPend (blocking) since it's intentionally event-driven
+        // Wait only for the flags that change the current state: ACC_ON stays set
+        // while engaged, so pending on it then would return immediately (busy loop)
+        if (acc_engaged)
+        {
+            wait_flags = (OS_FLAGS)(ACC_OFF_FLAG | DEADLINE_MISS_FLAG | FAULT_DETECTED_FLAG);
+        }
+        else
+        {
+            wait_flags = (OS_FLAGS)ACC_ON_FLAG;
+        }
+        
         flags = OSFlagPend(&EventFlagGroup,
-                          (OS_FLAGS)(ACC_ON_FLAG | ACC_OFF_FLAG | 
-                                    DEADLINE_MISS_FLAG | FAULT_DETECTED_FLAG),
+                          wait_flags,
                          0,
                          OS_OPT_PEND_FLAG_SET_ANY,
                          &ts,
                          &err);
         
-        if (flags & ACC_ON_FLAG)
+        if (err != OS_ERR_NONE)
+        {
+            continue;
+        }
+        
+        if (!acc_engaged && (flags & ACC_ON_FLAG))
         {
             // ACC turned ON
-            // Clear DeadlineMiss flag
+            // Clear ACC_OFF, DeadlineMiss and FaultDetected flags (stale from the OFF period)
             OSFlagPost(&EventFlagGroup,
-                      (OS_FLAGS)DEADLINE_MISS_FLAG,
+                      (OS_FLAGS)(ACC_OFF_FLAG | DEADLINE_MISS_FLAG | FAULT_DETECTED_FLAG),
                       OS_OPT_POST_FLAG_CLR,
                       &err);
             
@@ -398,75 +782,93 @@ void Setup_Task(void *p_arg)
                     0,
                     &err);
             
-            // Initialize parameter memory block
-            OSMutexPend(&ParamMutex,
-                       0,
-                       OS_OPT_PEND_BLOCKING,
-                       &ts,
-                       &err);
+            // New engagement: Control restarts Vset from Vcruise on its first
+            // frame (the control block has a single writer)
+            Param_WriteBegin(&Parameters.config.seq);
+            Parameters.config.ACC01 = 1;  // ACC ON
+            Parameters.config.engage++;
+            Param_WriteEnd(&Parameters.config.seq);
             
-            Parameters.dMn = 0.0f;
-            Parameters.Vset = Parameters.Vcruise;
+            acc_engaged = true;
             
-            OSMutexPost(&ParamMutex,
-                       OS_OPT_POST_NONE,
-                       &err);
+#if ACC_RATE_ADAPT_EN
+            // Start at the fast rate until the first samples are judged
+            Rate_Reset(&RateCtl);
+#endif
+#if ACC_KALMAN_EN
+            // New engagement: the estimator restarts from the first sample
+            Kalman_Reset(&Estimator);
+#endif
+#if ACC_MODE_EN
+            // New engagement: normal criticality until a stage overruns
+            Mode_Reset(&ModeMgr);
+#endif
+            
+            // Re-arm Control's timeout so it counts from the first frame
+            // instead of from the OFF period
+#if ACC_CYCLIC_EXEC
+            OSSemPendAbort(&TimerSemaphore,
+                          OS_OPT_PEND_ABORT_1,
+                          &err);
+#else
+            OSTaskSemPendAbort(&ControlTCB,
+                              OS_OPT_POST_NONE,
+                              &err);
+#endif
+            
+            // Judge deadlines from the first frame on (the timer is still off,
+            // so no Sensors stage runs concurrently)
+            Deadline_Reset(&DeadlineMon);
+#if ACC_RATE_ADAPT_EN
+            Hardware_Timer_SetPeriod(FRAME_PERIOD_MS);  // Fast rate
+#endif
             
             // Enable timer interrupt
             Hardware_Timer_Enable();
         }
-        else if ((flags & ACC_OFF_FLAG) || 
-                 (flags & DEADLINE_MISS_FLAG) || 
-                 (flags & FAULT_DETECTED_FLAG))
+#if ACC_RECOVERY_EN
+        else if (acc_engaged && (flags & ACC_OFF_FLAG) == 0u &&
+                 Recovery_Allow(&Recovery, OSTimeGet(&err)))
+        {
+            // Deadline miss or fault within the rollback budget: ACC stays
+            // engaged and the timer keeps running; the next frame restarts
+            // from Control's last good checkpoint (acc_recovery.h)
+            // Below the hard tasks, no frame is in flight here: a command
+            // still untaken belongs to the faulty frame
+            Mailbox_Reset(&ControlActuatorMailbox);
+            OSFlagPost(&EventFlagGroup,
+                      (OS_FLAGS)(DEADLINE_MISS_FLAG | FAULT_DETECTED_FLAG),
+                      OS_OPT_POST_FLAG_CLR,
+                      &err);
+            Param_WriteBegin(&Parameters.config.seq);
+            Parameters.config.rollback++;
+            Param_WriteEnd(&Parameters.config.seq);
+        }
+#endif
+        else if (acc_engaged)
         {
             // ACC turned OFF or fault detected
             // Disable timer interrupt
             Hardware_Timer_Disable();
             
-            // Clear message queue (drain pending messages)
-            // Keep flow-control semaphore in sync
-            OS_MSG_SIZE msg_size;
-            void *p;
-            while (1)
-            {
-                p = OSQPend(&ControlActuatorQueue,
-                           0u,
-                           OS_OPT_PEND_NON_BLOCKING,
-                           &msg_size,
-                           &ts,
-                           &err);
-                
-                if (p == NULL || err == OS_ERR_PEND_WOULD_BLOCK)
-                {
-                    // Queue is empty
-                    break;
-                }
-                
-                // Return buffer to memory partition
-                OSMemPut(&MessagePartition,
-                        p,
-                        &err);
-                
-                // Post to flow control semaphore (keep in sync)
-                OSSemPost(&FlowControlSemaphore,
-                         OS_OPT_POST_NONE,
-                         &err);
-            }
-            
-            // Set dM = 0
-            OSMutexPend(&ParamMutex,
-                       0,
-                       OS_OPT_PEND_BLOCKING,
-                       &ts,
-                       &err);
+            // Discard any command not yet applied (O(1) mailbox reset). A
+            // wake-up still pending stays: the Actuator finds nothing and
+            // pends again, where clearing it could strand a command posted
+            // without one
+            Mailbox_Reset(&ControlActuatorMailbox);
             
-            Parameters.dMn = 0.0f;
+            // ACC OFF (no new dM is computed from here on)
+            Param_WriteBegin(&Parameters.config.seq);
+            Parameters.config.ACC01 = 0;  // ACC OFF
+            Param_WriteEnd(&Parameters.config.seq);
             
-            OSMutexPost(&ParamMutex,
-                       OS_OPT_POST_NONE,
-                       &err);
+            acc_engaged = false;
             
-            // Set event flags: ACC_OFF
+            // Set event flags: ACC_OFF (and drop ACC_ON so the driver must re-engage)
+            OSFlagPost(&EventFlagGroup,
+                      (OS_FLAGS)ACC_ON_FLAG,
+                      OS_OPT_POST_FLAG_CLR,
+                      &err);
             OSFlagPost(&EventFlagGroup,
                       (OS_FLAGS)ACC_OFF_FLAG,
                       OS_OPT_POST_FLAG_SET,
@@ -474,27 +876,3 @@ void Setup_Task(void *p_arg)
         }
     }
 }
-
-// Watchdog Timer Callback
-void Watchdog_Timer_Callback(void *p_arg)
-{
-    OS_ERR err;
-    
-    // Check heartbeat flags: both Control and Actuator must complete each cycle
-    if (!(control_beat && actuator_beat))
-    {
-        // Deadline miss detected - one or both tasks didn't complete
-        OSFlagPost(&EventFlagGroup,
-                  (OS_FLAGS)DEADLINE_MISS_FLAG,
-                  OS_OPT_POST_FLAG_SET,
-                  &err);
-    }
-    
-    // Reset heartbeat flags for next period
-    control_beat = false;
-    actuator_beat = false;
-    
-    // Note: Timer is OS_OPT_TMR_PERIODIC, so no need to restart
-    // Timer automatically restarts after callback completes
-}
-
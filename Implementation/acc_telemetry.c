@@ -0,0 +1,193 @@
+#include "acc_telemetry.h"
+#include "acc_config.h"
+#include <string.h>
+
+// Per-Frame Telemetry (see acc_telemetry.h)
+//
+// The codec is built in every configuration: the host decoder and
+// bench_telemetry use it without the ring or the task.
+
+// Q16.16 of a value (float builds round, fixed-point builds pass through)
+static inline int32_t Telem_Q(ACC_Value_t v)
+{
+#if ACC_FIXED_POINT
+    return v;
+#else
+    return Q_FromFloat(v);
+#endif
+}
+
+static inline uint32_t Telem_PutVarint(uint8_t *p_out, uint32_t v)
+{
+    uint32_t n = 0u;
+
+    while (v >= 0x80u)
+    {
+        p_out[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    p_out[n++] = (uint8_t)v;
+    return n;
+}
+
+// Returns the bytes used, 0 if incomplete or longer than a 32-bit varint
+static inline uint32_t Telem_GetVarint(const uint8_t *p_in, uint32_t len, uint32_t *p_v)
+{
+    uint32_t v = 0u;
+    uint32_t n;
+
+    for (n = 0u; n < len && n < TELEM_VARINT_MAX; n++)
+    {
+        v |= (uint32_t)(p_in[n] & 0x7Fu) << (7u * n);
+        if ((p_in[n] & 0x80u) == 0u)
+        {
+            *p_v = v;
+            return n + 1u;
+        }
+    }
+    return 0u;
+}
+
+// Zigzag: small magnitudes of either sign to small unsigned values
+static inline uint32_t Telem_Zigzag(uint32_t r)
+{
+    return (r << 1) ^ (0u - (r >> 31));
+}
+
+static inline uint32_t Telem_Unzigzag(uint32_t z)
+{
+    return (z >> 1) ^ (0u - (z & 1u));
+}
+
+// Linear prediction from the two previous values (wraps, as the residual does)
+static inline uint32_t Telem_Predict(const ACC_TelemCodec_t *p_codec, uint32_t i)
+{
+    return 2u * (uint32_t)p_codec->v1[i] - (uint32_t)p_codec->v2[i];
+}
+
+void Telem_CodecInit(ACC_TelemCodec_t *p_codec)
+{
+    memset(p_codec, 0, sizeof(*p_codec));
+    p_codec->seq = 0xFFFFFFFFu;         // The first record is seq 0 (no gap)
+}
+
+void Telem_Header(uint8_t p_out[TELEM_HDR_BYTES])
+{
+    memcpy(p_out, TELEM_MAGIC, 8u);
+    p_out[8] = (uint8_t)TELEM_VERSION;
+    p_out[9] = (uint8_t)ACC_Q_FRAC_BITS;
+    p_out[10] = (uint8_t)(TIMER_PERIOD_MS & 0xFFu);
+    p_out[11] = (uint8_t)((TIMER_PERIOD_MS >> 8) & 0xFFu);
+}
+
+bool Telem_HeaderOk(const uint8_t *p_in, uint32_t len, uint16_t *p_period_ms)
+{
+    if (len < TELEM_HDR_BYTES || memcmp(p_in, TELEM_MAGIC, 8u) != 0 ||
+        p_in[8] != TELEM_VERSION || p_in[9] != ACC_Q_FRAC_BITS)
+    {
+        return false;
+    }
+    *p_period_ms = (uint16_t)(p_in[10] | (p_in[11] << 8));
+    return true;
+}
+
+uint32_t Telem_Encode(ACC_TelemCodec_t *p_codec, const ACC_TelemRec_t *p_rec, uint8_t *p_out)
+{
+    int32_t v[TELEM_VALUES];
+    uint32_t n, i;
+
+    v[0] = Telem_Q(p_rec->Xn);
+    v[1] = Telem_Q(p_rec->Vn);
+    v[2] = Telem_Q(p_rec->Vset);
+    v[3] = Telem_Q(p_rec->dMn);
+
+    n = Telem_PutVarint(p_out, p_rec->seq - p_codec->seq - 1u);
+    n += Telem_PutVarint(&p_out[n], p_rec->flags ^ p_codec->flags);
+    for (i = 0u; i < TELEM_VALUES; i++)
+    {
+        n += Telem_PutVarint(&p_out[n], Telem_Zigzag((uint32_t)v[i] - Telem_Predict(p_codec, i)));
+        p_codec->v2[i] = p_codec->v1[i];
+        p_codec->v1[i] = v[i];
+    }
+    p_codec->seq = p_rec->seq;
+    p_codec->flags = p_rec->flags;
+    return n;
+}
+
+uint32_t Telem_Decode(ACC_TelemCodec_t *p_codec, const uint8_t *p_in, uint32_t len, ACC_TelemFrame_t *p_frame)
+{
+    uint32_t field[2u + TELEM_VALUES];
+    uint32_t n = 0u, used, i;
+
+    // Every field first: a record cut off changes no state
+    for (i = 0u; i < 2u + TELEM_VALUES; i++)
+    {
+        used = Telem_GetVarint(&p_in[n], len - n, &field[i]);
+        if (used == 0u)
+        {
+            return 0u;
+        }
+        n += used;
+    }
+    p_frame->seq = p_codec->seq + 1u + field[0];
+    p_frame->flags = p_codec->flags ^ field[1];
+    for (i = 0u; i < TELEM_VALUES; i++)
+    {
+        p_frame->v[i] = (int32_t)(Telem_Predict(p_codec, i) + Telem_Unzigzag(field[2u + i]));
+        p_codec->v2[i] = p_codec->v1[i];
+        p_codec->v1[i] = p_frame->v[i];
+    }
+    p_codec->seq = p_frame->seq;
+    p_codec->flags = p_frame->flags;
+    return n;
+}
+
+#if ACC_TELEMETRY_EN
+
+#include "acc_hardware.h"
+
+// Drain state (Telem_Task only): a whole ring encoded per write
+static ACC_TelemRing_t *TelemRing;
+static ACC_TelemCodec_t TelemCodec;
+static uint8_t          TelemBuf[TELEM_RING_SIZE * TELEM_ENC_MAX];
+
+void Telem_Init(ACC_TelemRing_t *p_ring)
+{
+    memset(p_ring, 0, sizeof(*p_ring));
+    TelemRing = p_ring;
+    Telem_CodecInit(&TelemCodec);
+}
+
+// Telem Task - drains the ring every TELEM_DRAIN_PERIOD_MS
+void Telem_Task(void *p_arg)
+{
+    OS_ERR err;
+    uint32_t head, tail, n;
+
+    Telem_Header(TelemBuf);
+    Telemetry_Write(TelemBuf, TELEM_HDR_BYTES);
+    while (1)
+    {
+        OSTimeDly(MS_TO_TICKS(TELEM_DRAIN_PERIOD_MS),
+                  OS_OPT_TIME_PERIODIC,
+                  &err);
+
+        head = TelemRing->head;
+        // Records are complete up to head
+        atomic_thread_fence(memory_order_acquire);
+        n = 0u;
+        for (tail = TelemRing->tail; tail != head; tail++)
+        {
+            n += Telem_Encode(&TelemCodec, &TelemRing->rec[tail & (TELEM_RING_SIZE - 1u)], &TelemBuf[n]);
+        }
+        // Slots free for the producer once read
+        atomic_thread_fence(memory_order_release);
+        TelemRing->tail = tail;
+        if (n > 0u)
+        {
+            Telemetry_Write(TelemBuf, n);
+        }
+    }
+}
+
+#endif // ACC_TELEMETRY_EN
@@ -0,0 +1,121 @@
+#ifndef ACC_TELEMETRY_H
+#define ACC_TELEMETRY_H
+
+#include "os.h"
+#include "acc_config.h"
+#include "acc_fixed.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-Frame Telemetry (ACC_TELEMETRY_EN)
+//
+// Control puts one record per computed frame (Xn, Vn, Vset, dM, flags and a
+// sequence number) into a single-producer/single-consumer ring: a few stores
+// and a head update, no kernel call, no wait. A full ring drops the record;
+// its sequence number is used anyway, so the gap shows in the stream.
+// Telem_Task (below every other application task) drains the ring every
+// TELEM_DRAIN_PERIOD_MS, encodes the records and hands the bytes to
+// Telemetry_Write() (acc_hardware.h: UART on the target, a file or pipe on
+// the host).
+//
+// Stream: a header (TELEM_HDR_BYTES), then one encoded record after the other, no
+// framing. Each field is an unsigned LEB128 varint (7 bits per byte, low
+// first, high bit set on all but the last byte) of its difference to the
+// previous record:
+//   seq           seq - previous seq - 1 (0 unless records were dropped)
+//   flags         flags XOR previous flags
+//   Xn Vn Vset dM Q16.16, zigzag of the value minus its linear prediction
+//                 from the two previous records (2 * prev - prev2)
+// The first record is predicted from zeros. Float builds send the values
+// rounded to Q16.16 (1/65536), fixed-point builds bit for bit. A steady
+// frame encodes in about a third of the raw record.
+
+#define TELEM_MAGIC           "ACCTELEM"
+#define TELEM_VERSION         1u
+
+#define TELEM_VALUES          4u        // Xn, Vn, Vset, dM
+#define TELEM_VARINT_MAX      5u        // Bytes of a 32-bit varint
+#define TELEM_ENC_MAX         ((2u + TELEM_VALUES) * TELEM_VARINT_MAX)   // Bytes of one record, worst case
+
+// Record flags
+#define TELEM_F_ENGAGE        0x01u     // First frame of an engagement
+#define TELEM_F_ROLLBACK      0x02u     // Restarted from a checkpoint (ACC_RECOVERY_EN)
+#define TELEM_F_DEGRADED      0x04u     // Degraded law, high criticality (ACC_MODE_EN)
+#define TELEM_F_OUTVOTED      0x08u     // The versions disagreed (ACC_NVERSION_EN)
+#define TELEM_F_MPC           0x10u     // MPC law in place of Equation 3 (ACC_MPC_EN)
+#define TELEM_F_RATE_SHIFT    8u        // Control-rate level (ACC_RATE_ADAPT_EN), 2 bits
+#define TELEM_F_RATE_MASK     (0x3u << TELEM_F_RATE_SHIFT)
+
+typedef struct {
+    uint32_t    seq;                    // Frames computed since start, drops included
+    uint32_t    flags;                  // TELEM_F_*
+    ACC_Value_t Xn;                     // Gap used by Equations 1/4 (m; the lookahead gap with ACC_KALMAN_EN)
+    ACC_Value_t Vn;                     // Speed (km/h)
+    ACC_Value_t Vset;                   // Set speed after Equations 1/4 (km/h)
+    ACC_Value_t dMn;                    // Output of the frame
+} ACC_TelemRec_t;
+
+// Stream header: TELEM_MAGIC (8 bytes, no NUL), TELEM_VERSION (1 byte), the
+// fraction bits of the values (1 byte, 16), TIMER_PERIOD_MS of the sender
+// (2 bytes, little-endian)
+#define TELEM_HDR_BYTES       12u
+
+typedef struct {
+    volatile uint32_t head;             // Written by the producer only
+    volatile uint32_t tail;             // Written by Telem_Task only
+    uint32_t          seq;              // Producer: next sequence number
+    volatile uint32_t drops;            // Records lost to a full ring
+    ACC_TelemRec_t    rec[TELEM_RING_SIZE];
+} ACC_TelemRing_t;
+
+// Encoder / decoder state: the two previous records
+typedef struct {
+    uint32_t seq;
+    uint32_t flags;
+    int32_t  v1[TELEM_VALUES];
+    int32_t  v2[TELEM_VALUES];
+} ACC_TelemCodec_t;
+
+// Decoded record (values in Q16.16)
+typedef struct {
+    uint32_t seq;
+    uint32_t flags;
+    int32_t  v[TELEM_VALUES];           // Xn, Vn, Vset, dM
+} ACC_TelemFrame_t;
+
+// Producer (Control stage only)
+static inline void Telem_Put(ACC_TelemRing_t *p_ring, uint32_t flags,
+                             ACC_Value_t Xn, ACC_Value_t Vn, ACC_Value_t Vset, ACC_Value_t dMn)
+{
+    uint32_t head = p_ring->head;
+    uint32_t seq = p_ring->seq++;
+
+    if (head - p_ring->tail >= TELEM_RING_SIZE)
+    {
+        p_ring->drops++;
+        return;
+    }
+    p_ring->rec[head & (TELEM_RING_SIZE - 1u)] = (ACC_TelemRec_t){ seq, flags, Xn, Vn, Vset, dMn };
+    // Record is visible before the new head
+    atomic_thread_fence(memory_order_release);
+    p_ring->head = head + 1u;
+}
+
+#if ACC_TELEMETRY_EN
+void Telem_Init(ACC_TelemRing_t *p_ring);           // Before the kernel starts
+void Telem_Task(void *p_arg);
+#endif
+
+// Codec (Telem_Task; the host decoder and bench_telemetry)
+void Telem_CodecInit(ACC_TelemCodec_t *p_codec);
+void Telem_Header(uint8_t p_out[TELEM_HDR_BYTES]);
+// Encodes one record into p_out (TELEM_ENC_MAX bytes), returns the bytes used
+uint32_t Telem_Encode(ACC_TelemCodec_t *p_codec, const ACC_TelemRec_t *p_rec, uint8_t *p_out);
+// Decodes one record from len bytes at p_in; returns the bytes used, 0 if
+// the record is incomplete or malformed
+uint32_t Telem_Decode(ACC_TelemCodec_t *p_codec, const uint8_t *p_in, uint32_t len, ACC_TelemFrame_t *p_frame);
+// Checks a stream header; false if it is not one this decoder reads
+bool Telem_HeaderOk(const uint8_t *p_in, uint32_t len, uint16_t *p_period_ms);
+
+#endif // ACC_TELEMETRY_H
@@ -0,0 +1,343 @@
+#include "acc_trace.h"
+#include "acc_types.h"
+#include <stdbool.h>
+#include <string.h>
+
+// Per-Stage Execution Tracing (see acc_trace.h)
+
+#if ACC_TRACE_EN
+
+#define TRACE_TS_PER_US       (CPU_TS_TmrFreq_Hz / 1000000u)
+#define TRACE_TS_PERIOD       ((CPU_TS)TIMER_PERIOD_MS * (CPU_TS_TmrFreq_Hz / 1000u))
+#define TRACE_TIMELINE_SIZE   (2u * TRACE_RING_SIZE_SW)
+#define TRACE_TIMELINE_KEEP   16u     // Switches kept across drains at minimum
+#define TRACE_JOBS_MAX        (TRACE_TASK_QTY * TRACE_RING_SIZE_TASK / 2u)
+
+// Ring storage
+static ACC_TraceRec_t TraceRecTask[TRACE_RING_SWITCH][TRACE_RING_SIZE_TASK];
+static ACC_TraceRec_t TraceRecSwitch[TRACE_RING_SIZE_SW];
+
+ACC_TraceRing_t TraceRings[TRACE_RING_QTY];
+ACC_TraceHist_t TraceTaskHist[TRACE_TASK_QTY][TRACE_METRIC_QTY];
+ACC_TraceHist_t TraceStageHist[TRACE_STAGE_QTY];
+uint32_t        TraceJobs[TRACE_TASK_QTY];
+
+static OS_APP_HOOK_VOID TracePrevSwHook;
+
+#if ACC_CYCLIC_EXEC
+static const OS_PRIO TraceTaskPrio[TRACE_TASK_QTY] = { PRIO_FRAME };
+#else
+static const OS_PRIO TraceTaskPrio[TRACE_TASK_QTY] = { PRIO_SENSORS, PRIO_CONTROL, PRIO_ACTUATOR };
+#endif
+
+// Drain state (Trace_Task only)
+typedef struct {
+    CPU_TS release;
+    CPU_TS section;             // Begin of the open READ/PARAM/CALC section
+    bool   pending;             // RELEASE seen, END not yet
+} Trace_JobState_t;
+
+typedef struct {
+    CPU_TS  release;
+    CPU_TS  end;
+    uint8_t task;
+} Trace_Job_t;
+
+typedef struct {
+    CPU_TS   ts;
+    uint16_t prio;
+} Trace_Switch_t;
+
+static Trace_JobState_t TraceState[TRACE_TASK_QTY];
+static Trace_Job_t      TraceDone[TRACE_JOBS_MAX];
+static uint32_t         TraceDoneQty;
+static Trace_Switch_t   TraceTimeline[TRACE_TIMELINE_SIZE];
+static uint32_t         TraceTimelineQty;
+static CPU_TS           TraceIsrPrev;
+static bool             TraceIsrSeen;
+
+// Task-switch hook (kernel locked): who runs from now on
+static void Trace_SwHook(void)
+{
+    Trace_Put(&TraceRings[TRACE_RING_SWITCH], TRACE_EV_SWITCH,
+              (OSTCBHighRdyPtr != NULL) ? (uint16_t)OSTCBHighRdyPtr->Prio : (uint16_t)TRACE_PRIO_IDLE,
+              OS_TS_GET());
+    if (TracePrevSwHook != NULL)
+    {
+        TracePrevSwHook();
+    }
+}
+
+void Trace_Init(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < TRACE_RING_SWITCH; i++)
+    {
+        TraceRings[i].rec = TraceRecTask[i];
+        TraceRings[i].mask = TRACE_RING_SIZE_TASK - 1u;
+    }
+    TraceRings[TRACE_RING_SWITCH].rec = TraceRecSwitch;
+    TraceRings[TRACE_RING_SWITCH].mask = TRACE_RING_SIZE_SW - 1u;
+
+    // Chain any hook already installed (BSP / host harness)
+    TracePrevSwHook = OS_AppTaskSwHookPtr;
+    OS_AppTaskSwHookPtr = Trace_SwHook;
+}
+
+uint32_t Trace_Drops(void)
+{
+    uint32_t drops = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < TRACE_RING_QTY; i++)
+    {
+        drops += TraceRings[i].drops;
+    }
+    return drops;
+}
+
+static void Trace_HistAdd(ACC_TraceHist_t *p_hist, CPU_TS v)
+{
+    uint32_t us = v / TRACE_TS_PER_US;
+    uint32_t b = 0u;
+
+    while (us != 0u && b < TRACE_HIST_BUCKETS - 1u)
+    {
+        us >>= 1;
+        b++;
+    }
+    if (p_hist->count == 0u || v < p_hist->min)
+    {
+        p_hist->min = v;
+    }
+    if (v > p_hist->max)
+    {
+        p_hist->max = v;
+    }
+    p_hist->sum += v;
+    p_hist->count++;
+    p_hist->bucket[b]++;
+}
+
+// Copies the records present now; returns how many
+static uint32_t Trace_Take(ACC_TraceRing_t *p_ring, ACC_TraceRec_t *p_out, uint32_t max)
+{
+    uint32_t tail = p_ring->tail;
+    uint32_t head = p_ring->head;
+    uint32_t n = 0u;
+
+    // head is read before the records it covers
+    atomic_thread_fence(memory_order_acquire);
+    while (tail != head && n < max)
+    {
+        p_out[n++] = p_ring->rec[tail & p_ring->mask];
+        tail++;
+    }
+    // Records are copied before their slots are handed back
+    atomic_thread_fence(memory_order_release);
+    p_ring->tail = tail;
+    return n;
+}
+
+static void Trace_TaskRecords(uint8_t task, const ACC_TraceRec_t *p_rec, uint32_t n)
+{
+    Trace_JobState_t *p_st = &TraceState[task];
+    uint32_t i;
+
+    for (i = 0u; i < n; i++)
+    {
+        switch (p_rec[i].ev)
+        {
+            case TRACE_EV_RELEASE:
+                p_st->release = p_rec[i].ts;
+                p_st->pending = true;
+                break;
+
+            case TRACE_EV_END:
+                if (p_st->pending && TraceDoneQty < TRACE_JOBS_MAX)
+                {
+                    TraceDone[TraceDoneQty].release = p_st->release;
+                    TraceDone[TraceDoneQty].end = p_rec[i].ts;
+                    TraceDone[TraceDoneQty].task = task;
+                    TraceDoneQty++;
+                }
+                p_st->pending = false;
+                break;
+
+            case TRACE_EV_READ_BEGIN:
+            case TRACE_EV_PARAM_BEGIN:
+            case TRACE_EV_CALC_BEGIN:
+                p_st->section = p_rec[i].ts;
+                break;
+
+            case TRACE_EV_READ_END:
+                Trace_HistAdd(&TraceStageHist[TRACE_STAGE_READ], p_rec[i].ts - p_st->section);
+                break;
+
+            case TRACE_EV_PARAM_END:
+                Trace_HistAdd(&TraceStageHist[TRACE_STAGE_PARAM], p_rec[i].ts - p_st->section);
+                break;
+
+            case TRACE_EV_CALC_END:
+                Trace_HistAdd(&TraceStageHist[TRACE_STAGE_CALC], p_rec[i].ts - p_st->section);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+static void Trace_IsrRecords(const ACC_TraceRec_t *p_rec, uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0u; i < n; i++)
+    {
+        CPU_TS dt = p_rec[i].ts - TraceIsrPrev;
+        CPU_TS period = (p_rec[i].arg != 0u) ? (CPU_TS)p_rec[i].arg * (CPU_TS_TmrFreq_Hz / 1000u)
+                                             : TRACE_TS_PERIOD;
+
+        // Gaps longer than two periods are the timer being off (ACC disengaged)
+        if (TraceIsrSeen && dt < 2u * period)
+        {
+            Trace_HistAdd(&TraceStageHist[TRACE_STAGE_JITTER],
+                          (dt > period) ? dt - period : period - dt);
+        }
+        TraceIsrPrev = p_rec[i].ts;
+        TraceIsrSeen = true;
+    }
+}
+
+// Splits [release, end] by who was running: the task itself, a higher- or a
+// lower-priority task (blocking); idle/unknown segments count as neither
+static void Trace_JobMetrics(const Trace_Job_t *p_job)
+{
+    const OS_PRIO prio = TraceTaskPrio[p_job->task];
+    CPU_TS t = p_job->release;
+    CPU_TS exec = 0u, blocking = 0u;
+    uint32_t owner = TRACE_PRIO_IDLE;
+    uint32_t i;
+
+    for (i = 0u; i < TraceTimelineQty; i++)
+    {
+        const Trace_Switch_t *p_sw = &TraceTimeline[i];
+
+        if ((int32_t)(p_sw->ts - p_job->end) >= 0)
+        {
+            break;
+        }
+        if ((int32_t)(p_sw->ts - t) > 0)
+        {
+            CPU_TS seg = p_sw->ts - t;
+
+            if (owner == prio)
+            {
+                exec += seg;
+            }
+            else if (owner != TRACE_PRIO_IDLE && owner > prio)
+            {
+                blocking += seg;
+            }
+            t = p_sw->ts;
+        }
+        owner = p_sw->prio;
+    }
+    if (owner == prio)
+    {
+        exec += p_job->end - t;
+    }
+    else if (owner != TRACE_PRIO_IDLE && owner > prio)
+    {
+        blocking += p_job->end - t;
+    }
+
+    Trace_HistAdd(&TraceTaskHist[p_job->task][TRACE_METRIC_EXEC], exec);
+    Trace_HistAdd(&TraceTaskHist[p_job->task][TRACE_METRIC_RESPONSE], p_job->end - p_job->release);
+    Trace_HistAdd(&TraceTaskHist[p_job->task][TRACE_METRIC_BLOCKING], blocking);
+    TraceJobs[p_job->task]++;
+}
+
+// Drops switches no pending job can need: keeps the one in force at the
+// oldest pending release and at least the last TRACE_TIMELINE_KEEP
+static void Trace_TimelineTrim(void)
+{
+    uint32_t keep = (TraceTimelineQty > TRACE_TIMELINE_KEEP) ? TraceTimelineQty - TRACE_TIMELINE_KEEP : 0u;
+    uint32_t task, i;
+
+    for (task = 0u; task < TRACE_TASK_QTY; task++)
+    {
+        if (!TraceState[task].pending)
+        {
+            continue;
+        }
+        for (i = keep; i > 0u; i--)
+        {
+            if ((int32_t)(TraceTimeline[i].ts - TraceState[task].release) <= 0)
+            {
+                break;
+            }
+        }
+        keep = i;
+    }
+    if (keep > 0u)
+    {
+        memmove(&TraceTimeline[0], &TraceTimeline[keep], (TraceTimelineQty - keep) * sizeof(TraceTimeline[0]));
+        TraceTimelineQty -= keep;
+    }
+}
+
+static void Trace_Drain(void)
+{
+    static ACC_TraceRec_t rec[TRACE_RING_SIZE_SW];
+    uint32_t n, i;
+    uint8_t task;
+
+    // Job records first: every switch before an END read here is already in
+    // the switch ring when that ring is read next
+    TraceDoneQty = 0u;
+    for (task = 0u; task < TRACE_TASK_QTY; task++)
+    {
+        n = Trace_Take(&TraceRings[task], rec, TRACE_RING_SIZE_TASK);
+        Trace_TaskRecords(task, rec, n);
+    }
+    n = Trace_Take(&TraceRings[TRACE_RING_ISR], rec, TRACE_RING_SIZE_TASK);
+    Trace_IsrRecords(rec, n);
+
+    n = Trace_Take(&TraceRings[TRACE_RING_SWITCH], rec, TRACE_RING_SIZE_SW);
+    if (TraceTimelineQty + n > TRACE_TIMELINE_SIZE)
+    {
+        // Drain fell behind: restart the timeline from this batch
+        TraceTimelineQty = 0u;
+    }
+    for (i = 0u; i < n; i++)
+    {
+        TraceTimeline[TraceTimelineQty].ts = rec[i].ts;
+        TraceTimeline[TraceTimelineQty].prio = rec[i].arg;
+        TraceTimelineQty++;
+    }
+
+    for (i = 0u; i < TraceDoneQty; i++)
+    {
+        Trace_JobMetrics(&TraceDone[i]);
+    }
+    Trace_TimelineTrim();
+}
+
+// Trace Task - drains the rings every TRACE_DRAIN_PERIOD_MS
+void Trace_Task(void *p_arg)
+{
+    OS_ERR err;
+
+    while (1)
+    {
+        OSTimeDly(MS_TO_TICKS(TRACE_DRAIN_PERIOD_MS),
+                  OS_OPT_TIME_PERIODIC,
+                  &err);
+
+        Trace_Drain();
+    }
+}
+
+#endif // ACC_TRACE_EN
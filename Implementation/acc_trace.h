@@ -0,0 +1,138 @@
+#ifndef ACC_TRACE_H
+#define ACC_TRACE_H
+
+#include "os.h"
+#include "acc_config.h"
+#include <stdatomic.h>
+#include <stdint.h>
+
+// Per-Stage Execution Tracing (ACC_TRACE_EN in acc_config.h)
+//
+// Probes stamp CPU_TS into one lock-free single-producer/single-consumer
+// ring per producer: each hard task, the sensors ISR, and the task-switch
+// hook. A probe is a timestamp read, one 8-byte store and a head update; it
+// never blocks, never takes a kernel object and, if the ring is full, drops
+// the record and counts it. Trace_Task (lowest application priority) drains
+// the rings, rebuilds each job from its RELEASE/START/END records and the
+// switch timeline, and updates the histograms:
+//
+//   per hard task  EXEC      time the task itself ran between release and end
+//                  RESPONSE  end - release (release = pend timestamp, i.e. post time)
+//                  BLOCKING  time a lower-priority task ran between release and end
+//   per stage      Sensors read, Param write section, Control compute,
+//                  ISR release jitter (|inter-arrival - period|; the ISR record
+//                  carries the period in ms when the control rate adapts)
+//
+// With ACC_TRACE_EN 0 every probe compiles to nothing and no ring, task or
+// hook exists.
+
+#if ACC_TRACE_EN
+
+// Rings: hard tasks first so ring index == TRACE_TASK_*
+// (ACC_CYCLIC_EXEC: one hard task, every stage probes the Frame_Task ring)
+#if ACC_CYCLIC_EXEC
+#define TRACE_RING_FRAME      0u
+#define TRACE_RING_SENSORS    TRACE_RING_FRAME
+#define TRACE_RING_CONTROL    TRACE_RING_FRAME
+#define TRACE_RING_ACTUATOR   TRACE_RING_FRAME
+#define TRACE_TASK_QTY        1u
+#else
+#define TRACE_RING_SENSORS    0u
+#define TRACE_RING_CONTROL    1u
+#define TRACE_RING_ACTUATOR   2u
+#define TRACE_TASK_QTY        3u
+#endif
+#define TRACE_RING_ISR        TRACE_TASK_QTY
+#define TRACE_RING_SWITCH     (TRACE_TASK_QTY + 1u)
+#define TRACE_RING_QTY        (TRACE_TASK_QTY + 2u)
+
+// Events
+#define TRACE_EV_RELEASE      1u    // ts = post timestamp returned by the pend
+#define TRACE_EV_START        2u
+#define TRACE_EV_END          3u
+#define TRACE_EV_READ_BEGIN   4u    // Sensors hardware read
+#define TRACE_EV_READ_END     5u
+#define TRACE_EV_PARAM_BEGIN  6u    // Parameter Memory Block write section
+#define TRACE_EV_PARAM_END    7u
+#define TRACE_EV_CALC_BEGIN   8u    // Control law
+#define TRACE_EV_CALC_END     9u
+#define TRACE_EV_POST         10u   // Sensors → Control signal / Control → Actuator mailbox post
+#define TRACE_EV_APPLY        11u   // Apply_Throttle_Brake
+#define TRACE_EV_ISR          12u   // IRQ_sensors_ISR entry
+#define TRACE_EV_SWITCH       13u   // arg = priority of the task switched in
+
+#define TRACE_PRIO_IDLE       0xFFFFu   // Switch to idle (no task ready)
+
+// Histograms: bucket b counts values in [2^(b-1), 2^b) µs, bucket 0 is < 1 µs
+#define TRACE_HIST_BUCKETS    18u
+
+#define TRACE_METRIC_EXEC      0u
+#define TRACE_METRIC_RESPONSE  1u
+#define TRACE_METRIC_BLOCKING  2u
+#define TRACE_METRIC_QTY       3u
+
+#define TRACE_STAGE_READ       0u
+#define TRACE_STAGE_PARAM      1u
+#define TRACE_STAGE_CALC       2u
+#define TRACE_STAGE_JITTER     3u
+#define TRACE_STAGE_QTY        4u
+
+typedef struct {
+    CPU_TS   ts;
+    uint16_t ev;
+    uint16_t arg;
+} ACC_TraceRec_t;
+
+typedef struct {
+    volatile uint32_t head;         // Written by the producer only
+    volatile uint32_t tail;         // Written by Trace_Task only
+    volatile uint32_t drops;        // Records lost to a full ring
+    uint32_t          mask;         // Size - 1 (size is a power of 2)
+    ACC_TraceRec_t   *rec;
+} ACC_TraceRing_t;
+
+typedef struct {
+    uint32_t count;
+    CPU_TS   min;                   // CPU_TS counts
+    CPU_TS   max;
+    uint64_t sum;
+    uint32_t bucket[TRACE_HIST_BUCKETS];
+} ACC_TraceHist_t;
+
+extern ACC_TraceRing_t TraceRings[TRACE_RING_QTY];
+extern ACC_TraceHist_t TraceTaskHist[TRACE_TASK_QTY][TRACE_METRIC_QTY];
+extern ACC_TraceHist_t TraceStageHist[TRACE_STAGE_QTY];
+extern uint32_t        TraceJobs[TRACE_TASK_QTY];
+
+static inline void Trace_Put(ACC_TraceRing_t *p_ring, uint16_t ev, uint16_t arg, CPU_TS ts)
+{
+    uint32_t head = p_ring->head;
+
+    if (head - p_ring->tail > p_ring->mask)
+    {
+        p_ring->drops++;
+        return;
+    }
+    p_ring->rec[head & p_ring->mask] = (ACC_TraceRec_t){ ts, ev, arg };
+    // Record is visible before the new head
+    atomic_thread_fence(memory_order_release);
+    p_ring->head = head + 1u;
+}
+
+#define TRACE(ring, ev)           Trace_Put(&TraceRings[(ring)], (uint16_t)(ev), 0u, OS_TS_GET())
+#define TRACE_AT(ring, ev, ts)    Trace_Put(&TraceRings[(ring)], (uint16_t)(ev), 0u, (ts))
+#define TRACE_ARG(ring, ev, arg)  Trace_Put(&TraceRings[(ring)], (uint16_t)(ev), (uint16_t)(arg), OS_TS_GET())
+
+void Trace_Init(void);              // After OSInit(), before the hard tasks run
+void Trace_Task(void *p_arg);
+uint32_t Trace_Drops(void);
+
+#else
+
+#define TRACE(ring, ev)           ((void)0)
+#define TRACE_AT(ring, ev, ts)    ((void)0)
+#define TRACE_ARG(ring, ev, arg)  ((void)0)
+
+#endif // ACC_TRACE_EN
+
+#endif // ACC_TRACE_H
@@ -4,41 +4,101 @@
 #include "os.h"
 #include "acc_params.h"
 #include "acc_config.h"
+#include "acc_mailbox.h"
+#include "acc_display.h"
+#include "acc_rate.h"
+#include "acc_deadline.h"
+#include "acc_kalman.h"
+#include "acc_calib.h"
+#include "acc_nversion.h"
+#include "acc_recovery.h"
+#include "acc_mode.h"
+#include "acc_telemetry.h"
 
 // Forward declarations
 extern ACC_Parameters_t Parameters;
 
 // Kernel Objects
 extern OS_SEM TimerSemaphore;
-extern OS_SEM FlowControlSemaphore;
-extern OS_MUTEX ParamMutex;
-extern OS_Q ControlActuatorQueue;
 extern OS_FLAG_GRP EventFlagGroup;
-extern OS_MEM MessagePartition;
-
-// Watchdog Timer
-extern OS_TMR WatchdogTimer;
 
 // Task Control Blocks
 extern OS_TCB SetupTCB;
+#if ACC_CYCLIC_EXEC
+extern OS_TCB FrameTCB;
+#else
 extern OS_TCB SensorsTCB;
 extern OS_TCB ControlTCB;
 extern OS_TCB ActuatorTCB;
+#endif
 extern OS_TCB DisplayTCB;
+#if ACC_TRACE_EN
+extern OS_TCB TraceTCB;
+#endif
+#if ACC_TELEMETRY_EN
+extern OS_TCB TelemTCB;
+#endif
 
 // Task Stacks
 extern CPU_STK SetupStk[STK_SIZE_SETUP];
+#if ACC_CYCLIC_EXEC
+extern CPU_STK FrameStk[STK_SIZE_FRAME];
+#else
 extern CPU_STK SensorsStk[STK_SIZE_SENSORS];
 extern CPU_STK ControlStk[STK_SIZE_CONTROL];
 extern CPU_STK ActuatorStk[STK_SIZE_ACTUATOR];
+#endif
 extern CPU_STK DisplayStk[STK_SIZE_DISPLAY];
+#if ACC_TRACE_EN
+extern CPU_STK TraceStk[STK_SIZE_TRACE];
+#endif
+#if ACC_TELEMETRY_EN
+extern CPU_STK TelemStk[STK_SIZE_TELEM];
+#endif
+
+// Control → Actuator Latest-Value Mailbox
+extern ACC_Mailbox_t ControlActuatorMailbox;
+
+// LCD Shadow (Display_Task)
+extern ACC_Display_t DisplayPanel;
+
+#if ACC_RATE_ADAPT_EN
+// Control-Rate State (Sensors stage; level read by Control for its timeout)
+extern ACC_Rate_t RateCtl;
+#endif
+
+#if ACC_KALMAN_EN
+// Gap / Relative-Velocity Estimator (Sensors stage)
+extern ACC_Kalman_t Estimator;
+#endif
+
+// Per-Job Deadline Monitor (judged by the Sensors stage, completed by the Actuator stage)
+extern ACC_Deadline_t DeadlineMon;
+
+#if ACC_CALIB_EN
+// Calibration Sets (written by the calibration writer, swapped in by Control)
+extern ACC_Calib_t Calibration;
+#endif
+
+#if ACC_NVERSION_EN
+// N-Version Vote Counts (Control stage)
+extern ACC_NVersion_t NVersion;
+#endif
+
+#if ACC_RECOVERY_EN
+// Checkpoints and Rollback Budget (Control stage / Setup_Task)
+extern ACC_Recovery_t Recovery;
+#endif
 
-// Message Buffer Backing Store
-extern float MessageBufferArray[3];
+#if ACC_MODE_EN
+// Criticality Mode and Stage Budgets (hard stages / Display_Task / Setup_Task)
+extern ACC_Mode_t ModeMgr;
+#endif
 
-// Watchdog Heartbeat Flags
-extern volatile bool control_beat;
-extern volatile bool actuator_beat;
+#if ACC_TELEMETRY_EN
+// Per-Frame Telemetry Ring (Control stage → Telem_Task)
+extern ACC_TelemRing_t Telemetry;
+#endif
 
 #endif // ACC_TYPES_H
 
@@ -0,0 +1,499 @@
+#include "acc_hardware.h"
+#include "acc_config.h"
+#include "acc_host.h"
+#include "acc_log.h"
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Host Hardware Abstraction Layer
+// Replaces acc_hardware.c in the host build: the periodic hardware timer is
+// simulated from the OS tick and the sensors observe a minimal lead/ego
+// vehicle model driven by the actuator output.
+//
+// Environment:
+//   ACC_HOST_RECORD   file to record the drive to (acc_log.h image, mapped
+//                     shared so it can be read while the run is in progress);
+//                     replay it with acc_replay
+//   ACC_HOST_TELEMETRY file or FIFO for the telemetry stream (ACC_TELEMETRY_EN,
+//                     acc_telemetry.h); decode it with acc_telem
+//
+// With ACC_OVERSAMPLE_EN a sampling thread stands in for the timer-triggered
+// DMA: each frame release starts a block of ACC_OVERSAMPLE_N samples spread
+// over the frame, completed HOST_SAMPLE_MARGIN_NS before the next release.
+// Samples carry Gaussian noise and occasional distance spikes (multipath);
+// acc_host compares the raw and filtered errors against the noise-free model.
+//
+// With ACC_RADAR_EN the radar frame holds the lead straight ahead, a car in
+// the right lane and guard-rail posts on both sides of a straight road (yaw
+// rate 0), so the selected Xn is the model gap.
+
+void IRQ_sensors_ISR(void);
+
+#define HOST_FRAME_S          ((float)HostTimerPeriodMs / 1000.0f)
+#define HOST_LEAD_SPEED_KMH   95.0f     // Lead vehicle cruises slightly below Vcruise
+#define HOST_ACCEL_MAX        2.0f      // km/h per second per unit of dM, saturated below
+#define HOST_ACCEL_LIMIT      10.0f     // km/h per second
+
+static volatile bool HostTimerEnabled = false;
+static OS_TICK HostTimerTicks = 0u;
+static volatile uint32_t HostTimerPeriodMs = TIMER_PERIOD_MS;  // Hardware_Timer_SetPeriod (ACC_RATE_ADAPT_EN)
+
+#define HOST_TELEM_FIFO       (1u << 20)  // Telemetry bytes queued for the writer thread (power of 2)
+
+static float HostGap = 80.0f;           // m
+static float HostEgoSpeed = 90.0f;      // km/h
+
+#if ACC_OVERSAMPLE_EN
+#define HOST_NOISE_DIST_M     0.5f      // Distance noise (1 sigma)
+#define HOST_NOISE_SPEED_KMH  0.5f      // Speed noise (1 sigma)
+#define HOST_SPIKE_PROB       0.02f     // Share of distance samples that are spikes
+#define HOST_SPIKE_M          15.0f     // Spike size (either sign)
+#define HOST_SAMPLE_MARGIN_NS 1000000u  // Block complete 1 ms before the next release
+
+static ACC_PingPong_t HostPingPong;
+static sem_t HostSampleSem;             // Posted at every frame release
+static volatile CPU_TS64 HostReleaseTs; // Latest frame release (ns)
+static uint64_t HostNoiseRng = 1u;      // Sampling thread
+static uint64_t HostDirectRng = 2u;     // Direct reads (fallback path)
+
+static float Host_Uniform(uint64_t *p_rng)
+{
+    // xorshift64*
+    *p_rng ^= *p_rng >> 12;
+    *p_rng ^= *p_rng << 25;
+    *p_rng ^= *p_rng >> 27;
+    return (float)((*p_rng * 2685821657736338717ull) >> 40) / 16777216.0f;
+}
+
+static float Host_Gauss(uint64_t *p_rng, float sigma)
+{
+    float u1 = Host_Uniform(p_rng) + 1e-7f;
+    float u2 = Host_Uniform(p_rng);
+
+    return sigma * sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+static float Host_NoisyGap(uint64_t *p_rng)
+{
+    float x = HostGap + Host_Gauss(p_rng, HOST_NOISE_DIST_M);
+
+    if (Host_Uniform(p_rng) < HOST_SPIKE_PROB)
+    {
+        x += (Host_Uniform(p_rng) < 0.5f) ? HOST_SPIKE_M : -HOST_SPIKE_M;
+    }
+    return x;
+}
+
+static void *Host_SampleThread(void *p_arg)
+{
+    CPU_TS64 step;
+    struct timespec at;
+    CPU_TS64 t;
+    uint32_t i;
+
+    (void)p_arg;
+    for (;;)
+    {
+        while (sem_wait(&HostSampleSem) != 0)
+        {
+        }
+        PingPong_Restart(&HostPingPong);
+        step = ((CPU_TS64)HostTimerPeriodMs * 1000000u - HOST_SAMPLE_MARGIN_NS) / ACC_OVERSAMPLE_N;
+        for (i = 1u; i <= ACC_OVERSAMPLE_N; i++)
+        {
+            t = HostReleaseTs + i * step;
+            at.tv_sec = (time_t)(t / 1000000000u);
+            at.tv_nsec = (long)(t % 1000000000u);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &at, NULL);
+            PingPong_Put(&HostPingPong,
+                         ACC_VALUE_FROM_FLOAT(Host_NoisyGap(&HostNoiseRng)),
+                         ACC_VALUE_FROM_FLOAT(HostEgoSpeed + Host_Gauss(&HostNoiseRng, HOST_NOISE_SPEED_KMH)));
+        }
+    }
+    return NULL;
+}
+#endif
+
+// Drive recording (same hooks as ACC_RECORD_EN in acc_hardware.c)
+#define HOST_RECORD_SLACK     64u       // Frames released while the harness winds down
+
+static ACC_Log_t HostLog;
+static int HostLogFd = -1;
+static uint32_t HostLogBytes;
+static const char *HostLogPath;
+static OS_TICK HostLogEngageTick;
+static ACC_Value_t HostLogXn;
+
+static void Host_RecordClose(void)
+{
+    uint32_t count = HostLog.hdr->count;
+
+    munmap(HostLog.hdr, HostLogBytes);
+    if (ftruncate(HostLogFd, Log_Bytes(count)) != 0)
+    {
+        perror("acc_host: record");
+    }
+    close(HostLogFd);
+    printf("  recorded %u frames to %s (%u lost)\n", (unsigned)count, HostLogPath, (unsigned)HostLog.lost);
+}
+
+static void Host_RecordOpen(const char *path)
+{
+    void *p_mem;
+
+    HostLogBytes = Log_Bytes(AccHost_FramesMax() + HOST_RECORD_SLACK);
+    HostLogFd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (HostLogFd < 0 || ftruncate(HostLogFd, HostLogBytes) != 0)
+    {
+        perror(path);
+        exit(2);
+    }
+    p_mem = mmap(NULL, HostLogBytes, PROT_READ | PROT_WRITE, MAP_SHARED, HostLogFd, 0);
+    if (p_mem == MAP_FAILED)
+    {
+        perror(path);
+        exit(2);
+    }
+    (void)Log_Init(&HostLog, p_mem, HostLogBytes);
+    HostLogPath = path;
+    atexit(Host_RecordClose);
+}
+
+static void Host_RecordSample(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    OS_ERR err;
+    OS_TICK now;
+
+    if (HostLogPath == NULL)
+    {
+        return;
+    }
+    now = OSTimeGet(&err);
+    OSSchedLock(&err);
+    Log_Sample(&HostLog,
+               (uint32_t)(((now - HostLogEngageTick) * 1000u) / OS_CFG_TICK_RATE_HZ),
+               Xn, Vn);
+    OSSchedUnlock(&err);
+}
+
+static void Host_TimerTickHook(void)
+{
+    // Hardware timer period is TIMER_PERIOD_MS (or the control-rate level),
+    // phase-locked to the OS tick
+    if (HostTimerEnabled && ++HostTimerTicks >= MS_TO_TICKS(HostTimerPeriodMs))
+    {
+        HostTimerTicks = 0u;
+        AccHost_FrameRelease();
+        IRQ_sensors_ISR();
+        AccHost_FrameReleaseDone();
+#if ACC_OVERSAMPLE_EN
+        // Sampling timer is slaved to the frame timer: start the next block
+        HostReleaseTs = CPU_TS_Get64();
+        sem_post(&HostSampleSem);
+#endif
+    }
+}
+
+ACC_Value_t Read_Distance_Sensor(void)
+{
+    AccHost_StageStamp(ACC_HOST_STAGE_SENSORS);
+#if ACC_OVERSAMPLE_EN
+    HostLogXn = ACC_VALUE_FROM_FLOAT(Host_NoisyGap(&HostDirectRng));
+#else
+    HostLogXn = ACC_VALUE_FROM_FLOAT(HostGap);
+#endif
+    return HostLogXn;
+}
+
+ACC_Value_t Read_Speed_Sensor(void)
+{
+#if ACC_OVERSAMPLE_EN
+    ACC_Value_t Vn = ACC_VALUE_FROM_FLOAT(HostEgoSpeed + Host_Gauss(&HostDirectRng, HOST_NOISE_SPEED_KMH));
+#else
+    ACC_Value_t Vn = ACC_VALUE_FROM_FLOAT(HostEgoSpeed);
+#endif
+
+#if !ACC_RADAR_EN
+    Host_RecordSample(HostLogXn, Vn);
+#endif
+    return Vn;
+}
+
+#if ACC_RADAR_EN
+#define HOST_LANE_M           3.5f      // Lane width
+#define HOST_RAIL_M           2.75f     // Guard rails: 1 m beyond the lane edges
+#define HOST_RAIL_STEP_M      20.0f     // Post spacing
+
+static void Host_RadarTrack(ACC_RadarFrame_t *p_frame, float x, float y, float v_rel)
+{
+    uint32_t i = p_frame->count++;
+
+    p_frame->range[i] = ACC_VALUE_FROM_FLOAT(hypotf(x, y));
+    p_frame->azimuth[i] = ACC_VALUE_FROM_FLOAT(atan2f(y, x));
+    p_frame->range_rate[i] = ACC_VALUE_FROM_FLOAT(v_rel * cosf(atan2f(y, x)));
+}
+
+void Read_Radar_Frame(ACC_RadarFrame_t *p_frame)
+{
+    float v = HostEgoSpeed / 3.6f;
+    float x;
+
+    AccHost_StageStamp(ACC_HOST_STAGE_SENSORS);
+    p_frame->count = 0u;
+    p_frame->yaw_rate = ACC_VALUE(0.0);
+    Host_RadarTrack(p_frame, 0.6f * HostGap, -HOST_LANE_M, -10.0f / 3.6f);    // Right lane
+    for (x = HOST_RAIL_STEP_M / 2.0f;
+         x < (float)RADAR_RANGE_MAX_M && p_frame->count + 3u <= RADAR_TRACKS_MAX;
+         x += HOST_RAIL_STEP_M)
+    {
+        Host_RadarTrack(p_frame, x, HOST_RAIL_M, -v);
+        Host_RadarTrack(p_frame, x, -HOST_LANE_M - HOST_RAIL_M, -v);
+    }
+    if (HostGap < (float)RADAR_RANGE_MAX_M)
+    {
+        Host_RadarTrack(p_frame, HostGap, 0.0f, (HOST_LEAD_SPEED_KMH - HostEgoSpeed) / 3.6f);
+    }
+}
+
+void Release_Radar_Frame(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    Host_RecordSample(Xn, Vn);
+}
+#endif
+
+#if ACC_OVERSAMPLE_EN
+const ACC_SensorBlock_t *Read_Sensor_Block(uint32_t *p_seq)
+{
+    AccHost_StageStamp(ACC_HOST_STAGE_SENSORS);
+    return PingPong_Take(&HostPingPong, p_seq);
+}
+
+bool Release_Sensor_Block(uint32_t seq, ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    const ACC_SensorBlock_t *p_blk = &HostPingPong.buf[(seq - 1u) & 1u];
+    ACC_Value_t raw_x = p_blk->dist[ACC_OVERSAMPLE_N - 1u];     // Read before the intact check
+    ACC_Value_t raw_v = p_blk->speed[ACC_OVERSAMPLE_N - 1u];
+
+    if (!PingPong_Release(&HostPingPong, seq))
+    {
+        return false;
+    }
+    // Newest raw sample vs the filtered value, both against the noise-free plant
+    AccHost_AcquireSample(ACC_VALUE_TO_FLOAT(raw_x) - HostGap, ACC_VALUE_TO_FLOAT(Xn) - HostGap,
+                          ACC_VALUE_TO_FLOAT(raw_v) - HostEgoSpeed, ACC_VALUE_TO_FLOAT(Vn) - HostEgoSpeed);
+    Host_RecordSample(Xn, Vn);
+    return true;
+}
+#endif
+
+void Apply_Throttle_Brake(ACC_Value_t dM)
+{
+    float accel = ACC_VALUE_TO_FLOAT(dM) * HOST_ACCEL_MAX;
+
+    AccHost_StageStamp(ACC_HOST_STAGE_ACTUATOR);
+    if (HostLogPath != NULL)
+    {
+        OS_ERR err;
+
+        OSSchedLock(&err);
+        Log_Output(&HostLog, dM);
+        OSSchedUnlock(&err);
+    }
+
+    // Advance the plant by one frame
+    if (accel > HOST_ACCEL_LIMIT)
+    {
+        accel = HOST_ACCEL_LIMIT;
+    }
+    else if (accel < -HOST_ACCEL_LIMIT)
+    {
+        accel = -HOST_ACCEL_LIMIT;
+    }
+    HostEgoSpeed += accel * HOST_FRAME_S;
+    if (HostEgoSpeed < 0.0f)
+    {
+        HostEgoSpeed = 0.0f;
+    }
+    HostGap += (HOST_LEAD_SPEED_KMH - HostEgoSpeed) / 3.6f * HOST_FRAME_S;
+}
+
+void Hardware_Timer_ClearFlag(void)
+{
+    // Simulated timer has no status register
+}
+
+void Hardware_Timer_Enable(void)
+{
+    if (HostLogPath != NULL)
+    {
+        OS_ERR err;
+
+        HostLogEngageTick = OSTimeGet(&err);
+        OSSchedLock(&err);
+        Log_Engage(&HostLog);
+        OSSchedUnlock(&err);
+    }
+    HostTimerTicks = 0u;
+    HostTimerEnabled = true;
+}
+
+#if ACC_RATE_ADAPT_EN
+void Hardware_Timer_SetPeriod(uint32_t period_ms)
+{
+    HostTimerPeriodMs = period_ms;      // Ticks since the release count towards it
+}
+#endif
+
+void Hardware_Timer_Disable(void)
+{
+    HostTimerEnabled = false;
+    if (HostLogPath != NULL)
+    {
+        OS_ERR err;
+
+        OSSchedLock(&err);
+        Log_Flush(&HostLog);
+        OSSchedUnlock(&err);
+    }
+}
+
+#if ACC_TELEMETRY_EN
+// Telemetry: Telem_Task's bytes are copied into a FIFO and written to
+// ACC_HOST_TELEMETRY by a thread of their own, the way a UART DMA sends
+// them on the target, so a slow file or a full pipe never holds the
+// simulated CPU. A write that does not fit is dropped whole and counted.
+static pthread_mutex_t HostTelemLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  HostTelemCond = PTHREAD_COND_INITIALIZER;
+static uint8_t        *HostTelemFifo;
+static uint32_t        HostTelemHead;       // Bytes queued (total)
+static uint32_t        HostTelemTail;       // Bytes written (total, after the write)
+static FILE           *HostTelemFp;
+static uint32_t        HostTelemLost;       // Writes dropped on a full FIFO
+
+static void *Host_TelemThread(void *p_arg)
+{
+    uint32_t tail, n;
+
+    (void)p_arg;
+    pthread_mutex_lock(&HostTelemLock);
+    while (1)
+    {
+        while (HostTelemTail == HostTelemHead)
+        {
+            pthread_cond_wait(&HostTelemCond, &HostTelemLock);
+        }
+        tail = HostTelemTail;
+        n = HostTelemHead - tail;
+        if (n > HOST_TELEM_FIFO - tail % HOST_TELEM_FIFO)
+        {
+            n = HOST_TELEM_FIFO - tail % HOST_TELEM_FIFO;   // Up to the end of the buffer
+        }
+        pthread_mutex_unlock(&HostTelemLock);
+        (void)fwrite(&HostTelemFifo[tail % HOST_TELEM_FIFO], 1u, n, HostTelemFp);
+        (void)fflush(HostTelemFp);
+        pthread_mutex_lock(&HostTelemLock);
+        HostTelemTail = tail + n;
+        pthread_cond_broadcast(&HostTelemCond);
+    }
+    return NULL;
+}
+
+// At exit: everything queued is written
+static void Host_TelemClose(void)
+{
+    pthread_mutex_lock(&HostTelemLock);
+    while (HostTelemTail != HostTelemHead)
+    {
+        pthread_cond_wait(&HostTelemCond, &HostTelemLock);
+    }
+    pthread_mutex_unlock(&HostTelemLock);
+    if (HostTelemLost > 0u)
+    {
+        fprintf(stderr, "acc_host: %u telemetry writes lost (FIFO full)\n", (unsigned)HostTelemLost);
+    }
+}
+
+static void Host_TelemOpen(const char *path)
+{
+    pthread_t thread;
+
+    HostTelemFifo = malloc(HOST_TELEM_FIFO);
+    HostTelemFp = fopen(path, "wb");
+    if (HostTelemFifo == NULL || HostTelemFp == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+    if (pthread_create(&thread, NULL, Host_TelemThread, NULL) != 0)
+    {
+        perror("acc_host: telemetry thread");
+        exit(2);
+    }
+    atexit(Host_TelemClose);
+}
+
+void Telemetry_Write(const uint8_t *p_data, uint32_t len)
+{
+    uint32_t i;
+
+    if (HostTelemFp == NULL)
+    {
+        return;
+    }
+    pthread_mutex_lock(&HostTelemLock);
+    if (len > HOST_TELEM_FIFO - (HostTelemHead - HostTelemTail))
+    {
+        HostTelemLost++;
+    }
+    else
+    {
+        for (i = 0u; i < len; i++)
+        {
+            HostTelemFifo[(HostTelemHead + i) % HOST_TELEM_FIFO] = p_data[i];
+        }
+        HostTelemHead += len;
+        pthread_cond_broadcast(&HostTelemCond);
+    }
+    pthread_mutex_unlock(&HostTelemLock);
+}
+#endif
+
+void Hardware_Init(void)
+{
+    OS_AppTimeTickHookPtr = Host_TimerTickHook;
+    AccHost_Init();
+#if ACC_OVERSAMPLE_EN
+    {
+        pthread_t thread;
+
+        PingPong_Init(&HostPingPong);
+        AccHost_AcquireAttach(&HostPingPong);
+        if (sem_init(&HostSampleSem, 0, 0u) != 0 ||
+            pthread_create(&thread, NULL, Host_SampleThread, NULL) != 0)
+        {
+            perror("acc_host: sampling thread");
+            exit(2);
+        }
+    }
+#endif
+    if (getenv("ACC_HOST_RECORD") != NULL)
+    {
+        Host_RecordOpen(getenv("ACC_HOST_RECORD"));
+    }
+#if ACC_TELEMETRY_EN
+    if (getenv("ACC_HOST_TELEMETRY") != NULL)
+    {
+        Host_TelemOpen(getenv("ACC_HOST_TELEMETRY"));
+    }
+#endif
+}
+
+// LCD_Write: mock panel in acc_lcd_host.c
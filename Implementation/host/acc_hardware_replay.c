@@ -0,0 +1,116 @@
+#include "acc_hardware.h"
+#include "acc_replay.h"
+
+// Replay Hardware Abstraction Layer
+// Replaces acc_hardware.c in acc_replay: there is no frame timer (acc_replay.c
+// raises IRQ_sensors_ISR() itself), the sensors return the logged sample of
+// the frame being replayed and the actuator output is handed back for the
+// comparison instead of driving a plant. With ACC_OVERSAMPLE_EN every
+// sample of the block is the logged value, which the filter returns exactly;
+// with ACC_RADAR_EN the radar frame is one track straight ahead at the logged
+// distance, which the selection returns exactly.
+
+volatile ACC_Value_t ReplayXn;
+volatile ACC_Value_t ReplayVn;
+volatile bool ReplayTimerEnabled = false;
+
+ACC_Value_t Read_Distance_Sensor(void)
+{
+    return ReplayXn;
+}
+
+ACC_Value_t Read_Speed_Sensor(void)
+{
+    return ReplayVn;
+}
+
+#if ACC_OVERSAMPLE_EN
+static ACC_SensorBlock_t ReplayBlock;
+static uint32_t ReplaySeq;
+
+const ACC_SensorBlock_t *Read_Sensor_Block(uint32_t *p_seq)
+{
+    uint32_t i;
+
+    for (i = 0u; i < ACC_OVERSAMPLE_N; i++)
+    {
+        ReplayBlock.dist[i] = ReplayXn;
+        ReplayBlock.speed[i] = ReplayVn;
+    }
+    *p_seq = ++ReplaySeq;
+    return &ReplayBlock;
+}
+
+bool Release_Sensor_Block(uint32_t seq, ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    (void)seq;
+    (void)Xn;
+    (void)Vn;
+    return true;
+}
+#endif
+
+#if ACC_RADAR_EN
+void Read_Radar_Frame(ACC_RadarFrame_t *p_frame)
+{
+    p_frame->range[0] = ReplayXn;
+    p_frame->range_rate[0] = ACC_VALUE(0.0);
+    p_frame->azimuth[0] = ACC_VALUE(0.0);
+    p_frame->count = 1u;
+    p_frame->yaw_rate = ACC_VALUE(0.0);
+}
+
+void Release_Radar_Frame(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    (void)Xn;
+    (void)Vn;
+}
+#endif
+
+void Apply_Throttle_Brake(ACC_Value_t dM)
+{
+    Replay_Output(dM);
+}
+
+void Hardware_Timer_ClearFlag(void)
+{
+    // No timer
+}
+
+void Hardware_Timer_Enable(void)
+{
+    ReplayTimerEnabled = true;
+}
+
+#if ACC_RATE_ADAPT_EN
+void Hardware_Timer_SetPeriod(uint32_t period_ms)
+{
+    (void)period_ms;    // Frames are released back to back
+}
+#endif
+
+void Hardware_Timer_Disable(void)
+{
+    ReplayTimerEnabled = false;
+}
+
+void Hardware_Init(void)
+{
+    // Nothing to initialise
+}
+
+void LCD_Write(uint8_t row, uint8_t col, const char *p_text, uint8_t len)
+{
+    (void)row;  // No panel
+    (void)col;
+    (void)p_text;
+    (void)len;
+}
+
+#if ACC_TELEMETRY_EN
+void Telemetry_Write(const uint8_t *p_data, uint32_t len)
+{
+    (void)p_data;  // No telemetry link (acc_host writes the stream)
+    (void)len;
+}
+#endif
@@ -0,0 +1,273 @@
+#include "acc_hardware.h"
+#include "acc_config.h"
+#include "acc_sim.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Simulation Hardware Abstraction Layer
+// Replaces acc_hardware.c in acc_sim: the kernel runs on virtual time, the
+// frame timer is derived from the (virtual) tick and the sensors observe the
+// vehicle model of acc_plant.c, driven by the actuator output. With
+// ACC_OVERSAMPLE_EN the sensor block of a frame is filled across its ticks,
+// each sample taken from the plant state at that tick.
+//
+// With ACC_RADAR_EN the radar frame is built from the road geometry: lead,
+// other vehicle and guard-rail posts placed on arcs of the current road
+// curvature, within the radar's field of view, with the yaw rate of the ego
+// vehicle following the road (ACC_SIM_RADAR_STRAIGHT=1: reported as 0, for
+// comparison). Each frame's selected Xn is checked against the nearest
+// vehicle in the own lane; frames with a vehicle near the lane edge
+// (SIM_RADAR_EDGE_M) are ambiguous and not judged.
+
+void IRQ_sensors_ISR(void);
+
+#define SIM_TICK_MS   (1000u / OS_CFG_TICK_RATE_HZ)
+
+ACC_Plant_t SimPlant;
+volatile bool SimTimerEnabled = false;
+uint32_t SimFramesReleased;
+uint32_t SimFramesActuated;
+uint32_t SimHash = SIM_HASH_INIT;
+
+static OS_TICK SimTimerTicks = 0u;
+static uint32_t SimTimerPeriodMs = TIMER_PERIOD_MS;    // Hardware_Timer_SetPeriod (ACC_RATE_ADAPT_EN)
+
+#if ACC_RADAR_EN
+#define SIM_RADAR_FOV_RAD     0.35f     // Azimuth field of view (±)
+#define SIM_RADAR_RAIL_L_M    2.75f     // Guard rails: own lane on the left of two,
+#define SIM_RADAR_RAIL_R_M    -6.25f    // 1 m beyond the lane edges
+#define SIM_RADAR_RAIL_STEP_M 20.0f     // Post spacing
+#define SIM_RADAR_EDGE_M      0.3f      // Ambiguous within this of PLANT_IN_LANE_M
+#define SIM_RADAR_TOL_M       0.5f      // Selected Xn vs the true lead
+
+SimRadarStats_t SimRadar;
+static float SimRadarTruth;             // Longitudinal distance of the true lead (m)
+static bool SimRadarAmbiguous;
+#endif
+
+#if ACC_OVERSAMPLE_EN
+static ACC_PingPong_t SimPingPong;
+
+// Samples due by the end of tick n of the frame (n = 1 .. frame ticks)
+static void Sim_Sample(OS_TICK n)
+{
+    uint32_t due = (uint32_t)((n * ACC_OVERSAMPLE_N) / MS_TO_TICKS(SimTimerPeriodMs));
+
+    while (SimPingPong.fill < due)
+    {
+        PingPong_Put(&SimPingPong,
+                     ACC_VALUE_FROM_FLOAT(Plant_Distance(&SimPlant)),
+                     ACC_VALUE_FROM_FLOAT(Plant_Speed(&SimPlant)));
+        if (SimPingPong.fill == 0u)
+        {
+            break;      // Block complete
+        }
+    }
+}
+#endif
+
+static void Sim_Hash(float v)
+{
+    uint32_t w;
+    uint32_t i;
+
+    memcpy(&w, &v, sizeof(w));
+    for (i = 0u; i < 4u; i++)
+    {
+        SimHash = (SimHash ^ ((w >> (8u * i)) & 0xFFu)) * 16777619u;
+    }
+}
+
+static void Sim_TickHook(void)
+{
+    if (SimPlant.scn != NULL)
+    {
+        Plant_Step(&SimPlant, SIM_TICK_MS);
+    }
+    if (SimTimerEnabled)
+    {
+        ++SimTimerTicks;
+#if ACC_OVERSAMPLE_EN
+        Sim_Sample(SimTimerTicks);
+#endif
+        if (SimTimerTicks >= MS_TO_TICKS(SimTimerPeriodMs))
+        {
+            SimTimerTicks = 0u;
+            SimFramesReleased++;
+            IRQ_sensors_ISR();
+        }
+    }
+}
+
+ACC_Value_t Read_Distance_Sensor(void)
+{
+    return ACC_VALUE_FROM_FLOAT(Plant_Distance(&SimPlant));
+}
+
+ACC_Value_t Read_Speed_Sensor(void)
+{
+    return ACC_VALUE_FROM_FLOAT(Plant_Speed(&SimPlant));
+}
+
+#if ACC_RADAR_EN
+// Object at arc length s ahead and offset d from the own lane centre; returns
+// its longitudinal distance, or a negative value when outside the view
+static float Sim_RadarTrack(ACC_RadarFrame_t *p_frame, float s, float d, float v_obj)
+{
+    float k = SimPlant.curv;
+    float x = s, y = d;
+    float r, az;
+    uint32_t i;
+
+    if (k != 0.0f)
+    {
+        x = (1.0f / k - d) * sinf(k * s);
+        y = 1.0f / k - (1.0f / k - d) * cosf(k * s);
+    }
+    r = hypotf(x, y);
+    az = atan2f(y, x);
+    if (s <= 0.0f || r < (float)RADAR_X_MIN_M || r > (float)RADAR_RANGE_MAX_M ||
+        fabsf(az) > SIM_RADAR_FOV_RAD || p_frame->count >= RADAR_TRACKS_MAX)
+    {
+        return -1.0f;
+    }
+    i = p_frame->count++;
+    p_frame->range[i] = ACC_VALUE_FROM_FLOAT(r);
+    p_frame->azimuth[i] = ACC_VALUE_FROM_FLOAT(az);
+    p_frame->range_rate[i] = ACC_VALUE_FROM_FLOAT((v_obj - SimPlant.v) * cosf(az));
+    return x;
+}
+
+static void Sim_RadarVehicle(ACC_RadarFrame_t *p_frame, float s, float d, float v_obj)
+{
+    float x = Sim_RadarTrack(p_frame, s, d, v_obj);
+    float edge = fabsf(d) - PLANT_IN_LANE_M;
+
+    if (x < 0.0f)
+    {
+        return;
+    }
+    if (edge > -SIM_RADAR_EDGE_M && edge < SIM_RADAR_EDGE_M)
+    {
+        SimRadarAmbiguous = true;
+    }
+    else if (edge < 0.0f && x < SimRadarTruth)
+    {
+        SimRadarTruth = x;
+    }
+}
+
+void Read_Radar_Frame(ACC_RadarFrame_t *p_frame)
+{
+    float s0 = SIM_RADAR_RAIL_STEP_M - fmodf((float)SimPlant.stats.distance, SIM_RADAR_RAIL_STEP_M);
+    float s;
+
+    p_frame->count = 0u;
+    SimRadarTruth = (float)RADAR_RANGE_MAX_M;
+    SimRadarAmbiguous = false;
+    for (s = s0; s < (float)RADAR_RANGE_MAX_M; s += SIM_RADAR_RAIL_STEP_M)
+    {
+        (void)Sim_RadarTrack(p_frame, s, SIM_RADAR_RAIL_L_M, 0.0f);
+        (void)Sim_RadarTrack(p_frame, s, SIM_RADAR_RAIL_R_M, 0.0f);
+    }
+    if (SimPlant.other)
+    {
+        Sim_RadarVehicle(p_frame, SimPlant.other_gap, SimPlant.other_lat, SimPlant.other_v);
+    }
+    if (SimPlant.lead)
+    {
+        Sim_RadarVehicle(p_frame, SimPlant.gap, 0.0f, SimPlant.lead_v);
+    }
+    p_frame->yaw_rate = SimRadar.straight ? ACC_VALUE(0.0) : ACC_VALUE_FROM_FLOAT(SimPlant.v * SimPlant.curv);
+}
+
+void Release_Radar_Frame(ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    SimRadar.frames++;
+    if (SimRadarAmbiguous)
+    {
+        SimRadar.ambiguous++;
+    }
+    else if (fabsf(ACC_VALUE_TO_FLOAT(Xn) - SimRadarTruth) > SIM_RADAR_TOL_M)
+    {
+        SimRadar.wrong++;
+    }
+}
+#endif
+
+#if ACC_OVERSAMPLE_EN
+const ACC_SensorBlock_t *Read_Sensor_Block(uint32_t *p_seq)
+{
+    return PingPong_Take(&SimPingPong, p_seq);
+}
+
+bool Release_Sensor_Block(uint32_t seq, ACC_Value_t Xn, ACC_Value_t Vn)
+{
+    return PingPong_Release(&SimPingPong, seq);
+}
+#endif
+
+void Apply_Throttle_Brake(ACC_Value_t dM)
+{
+    float f = ACC_VALUE_TO_FLOAT(dM);
+
+    Plant_Request(&SimPlant, f);
+    SimFramesActuated++;
+    Sim_Hash(f);
+    Sim_Hash(SimPlant.v);
+}
+
+void Hardware_Timer_ClearFlag(void)
+{
+    // Simulated timer has no status register
+}
+
+void Hardware_Timer_Enable(void)
+{
+    SimTimerTicks = 0u;
+#if ACC_OVERSAMPLE_EN
+    PingPong_Restart(&SimPingPong);
+#endif
+    SimTimerEnabled = true;
+}
+
+#if ACC_RATE_ADAPT_EN
+void Hardware_Timer_SetPeriod(uint32_t period_ms)
+{
+    SimTimerPeriodMs = period_ms;
+}
+#endif
+
+void Hardware_Timer_Disable(void)
+{
+    SimTimerEnabled = false;
+}
+
+void Hardware_Init(void)
+{
+    OS_HostVirtualTime = true;
+    OS_AppTimeTickHookPtr = Sim_TickHook;
+#if ACC_RADAR_EN
+    SimRadar.straight = getenv("ACC_SIM_RADAR_STRAIGHT") != NULL && atoi(getenv("ACC_SIM_RADAR_STRAIGHT")) != 0;
+#endif
+#if ACC_OVERSAMPLE_EN
+    PingPong_Init(&SimPingPong);
+#endif
+}
+
+void LCD_Write(uint8_t row, uint8_t col, const char *p_text, uint8_t len)
+{
+    (void)row;  // No panel
+    (void)col;
+    (void)p_text;
+    (void)len;
+}
+
+#if ACC_TELEMETRY_EN
+void Telemetry_Write(const uint8_t *p_data, uint32_t len)
+{
+    (void)p_data;  // No telemetry link (acc_host writes the stream)
+    (void)len;
+}
+#endif
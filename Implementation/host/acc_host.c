@@ -0,0 +1,786 @@
+#include "acc_host.h"
+#include "bench_util.h"
+#include "acc_types.h"
+#include "acc_config.h"
+#include "acc_trace.h"
+#include "acc_lcd_host.h"
+#include "acc_stack_host.h"
+#include "acc_control.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Host harness
+// Engages ACC through a simulated driver-switch interrupt, collects one
+// latency sample per pipeline stage per frame and prints the distribution.
+//
+// Environment:
+//   ACC_HOST_FRAMES   number of frames to measure (default 100)
+//   ACC_HOST_WCET     file to write the measured execution times to, in the
+//                     format read by acc_rta (needs ACC_TRACE_EN)
+//   ACC_HOST_RECORD   file to record the drive to (acc_hardware_host.c)
+//   ACC_HOST_SUMMARY  file to write "key value" summary metrics to (make cyclic
+//                     compares the task-chain and cyclic-executive builds)
+//   ACC_HOST_FAULTS   number of FAULT_DETECTED_FLAG posts spread over the run
+//                     (make recovery compares ACC off with rollback)
+//   ACC_HOST_STRESS_US overload: Control_Law() takes this much longer in bursts
+//                     (make overload compares without and with the mode manager)
+
+#define ACC_HOST_FRAMES_DEFAULT   100u
+#define ACC_HOST_POLL_US          10000u
+#define ACC_HOST_FAULT_POLL_US    100u      // Waiting for the pipeline to resume after a fault
+#define ACC_HOST_FAULT_WAIT_US    2000000u  // ... at most (fault not recovered)
+#define ACC_HOST_STRESS_EVERY     50u       // Overload bursts: one every 50 frames ...
+#define ACC_HOST_STRESS_FRAMES    10u       // ... 10 frames long ...
+#define ACC_HOST_STRESS_FIRST     20u       // ... from frame 20 on
+
+typedef struct {
+    CPU_TS64 release;                           // ISR release time (ns)
+    CPU_TS64 stage[ACC_HOST_STAGE_QTY];         // 0 = stage not reached
+} AccHost_Frame_t;
+
+static AccHost_Frame_t *HostFrames;
+static CPU_INT32U HostFramesMax;
+static volatile CPU_INT32U HostFramesReleased;  // Frames released by the simulated IRQ
+static volatile CPU_INT32U HostFramesActuated;  // Frames that reached Apply_Throttle_Brake
+static CPU_TS64 HostIsrStart;                   // Current IRQ_sensors_ISR() entry
+static CPU_TS64 HostIsrCyclesMax;               // Longest IRQ_sensors_ISR() (ns)
+
+// Injected faults (ACC_HOST_FAULTS): fault → first output of a later release
+static CPU_INT32U HostFaults;
+static CPU_INT32U HostFaultsInjected;
+static CPU_INT32U HostFaultsRecovered;
+static CPU_INT32U HostFaultsReengaged;          // Recovered only after ACC off and re-engagement
+static CPU_INT64U *HostFaultNs;
+
+// Overload (ACC_HOST_STRESS_US) and the driver engaging again after ACC off
+static CPU_INT32U HostStressUs;
+static CPU_INT32U HostStressFrames;             // Full-law frames that took the extra time
+static CPU_INT32U HostAccOff;                   // ACC off while the run went on
+static CPU_INT32U HostMissJobs;                 // Deadline counts of the engagements before the
+static CPU_INT32U HostMissLate;                 // current one (Setup_Task resets the monitor)
+
+// Hard-task cost counters, sampled when ACC engages and at the end of the run
+#if ACC_CYCLIC_EXEC
+static OS_TCB *const HostHardTasks[] = { &FrameTCB };
+static const CPU_INT32U HostHardStkSize[] = { STK_SIZE_FRAME };
+#else
+static OS_TCB *const HostHardTasks[] = { &SensorsTCB, &ControlTCB, &ActuatorTCB };
+static const CPU_INT32U HostHardStkSize[] = { STK_SIZE_SENSORS, STK_SIZE_CONTROL, STK_SIZE_ACTUATOR };
+#endif
+#define HOST_HARD_TASK_QTY   (sizeof(HostHardTasks) / sizeof(HostHardTasks[0]))
+static CPU_TS64 HostCyclesStart[HOST_HARD_TASK_QTY];
+static CPU_INT32U HostCallsStart[HOST_HARD_TASK_QTY];
+static OS_CTX_SW_CTR HostCtxSwStart;
+
+#if ACC_OVERSAMPLE_EN
+// Oversampled acquisition: ping-pong counters and squared errors vs the plant
+static const ACC_PingPong_t *HostPingPong;
+static CPU_INT32U HostAcqBlocks;
+static double HostAcqSq[4];             // raw dist, filtered dist, raw speed, filtered speed
+#endif
+
+static AccHost_Frame_t *AccHost_CurrentFrame(void)
+{
+    CPU_INT32U n = HostFramesReleased;
+
+    if (n == 0u || n > HostFramesMax)
+    {
+        return NULL;
+    }
+    return &HostFrames[n - 1u];
+}
+
+#if !ACC_CYCLIC_EXEC
+// Task-switch hook: the first dispatch of Control_Task after Sensors_Task has
+// read the frame's data is the Control stage start (kernel locked, no OS calls)
+// (the cyclic executive has no Control dispatch: the stage is not stamped)
+static void AccHost_TaskSwHook(void)
+{
+    AccHost_Frame_t *p_frame;
+
+    if (OSTCBHighRdyPtr != &ControlTCB)
+    {
+        return;
+    }
+    p_frame = AccHost_CurrentFrame();
+    if (p_frame != NULL &&
+        p_frame->stage[ACC_HOST_STAGE_SENSORS] != 0u &&
+        p_frame->stage[ACC_HOST_STAGE_CONTROL] == 0u)
+    {
+        p_frame->stage[ACC_HOST_STAGE_CONTROL] = CPU_TS_Get64();
+    }
+}
+#endif
+
+void AccHost_Init(void)
+{
+    const char *env = getenv("ACC_HOST_FRAMES");
+
+    HostFramesMax = (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : ACC_HOST_FRAMES_DEFAULT;
+    HostFrames = calloc(HostFramesMax, sizeof(*HostFrames));
+    env = getenv("ACC_HOST_FAULTS");
+    HostFaults = (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : 0u;
+    HostFaultNs = calloc(HostFaults + 1u, sizeof(*HostFaultNs));
+    env = getenv("ACC_HOST_STRESS_US");
+    HostStressUs = (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : 0u;
+    if (HostFrames == NULL || HostFaultNs == NULL)
+    {
+        fprintf(stderr, "acc_host: cannot allocate %u frames\n", (unsigned)HostFramesMax);
+        exit(2);
+    }
+#if !ACC_CYCLIC_EXEC
+    OS_AppTaskSwHookPtr = AccHost_TaskSwHook;
+#endif
+}
+
+CPU_INT32U AccHost_FramesMax(void)
+{
+    return HostFramesMax;
+}
+
+// Called in interrupt context right before IRQ_sensors_ISR()
+void AccHost_FrameRelease(void)
+{
+    HostIsrStart = CPU_TS_Get64();
+    if (HostFramesReleased < HostFramesMax)
+    {
+        HostFrames[HostFramesReleased].release = HostIsrStart;
+    }
+    HostFramesReleased++;
+}
+
+// Called in interrupt context right after IRQ_sensors_ISR()
+void AccHost_FrameReleaseDone(void)
+{
+    CPU_TS64 dt = CPU_TS_Get64() - HostIsrStart;
+
+    if (dt > HostIsrCyclesMax)
+    {
+        HostIsrCyclesMax = dt;
+    }
+}
+
+// Overload: the full law burns HostStressUs in the burst frames. acc_host is
+// linked with --wrap for both variants, so the degraded law
+// (Control_LawDegraded()) and the host tools keep their cost.
+float __real_Control_Law_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                               float Vn, float Vn1, float Vn2,
+                               float K1, float K2, float K3,
+                               float *p_Vset);
+acc_q_t __real_Control_Law_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                                 acc_q_t Vn, acc_q_t Vn1, acc_q_t Vn2,
+                                 acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                                 acc_q_t *p_Vset);
+
+static void AccHost_Stress(void)
+{
+    CPU_INT32U frame = HostFramesReleased - 1u;
+    CPU_TS64 end;
+
+    if (HostStressUs == 0u || frame < ACC_HOST_STRESS_FIRST ||
+        (frame - ACC_HOST_STRESS_FIRST) % ACC_HOST_STRESS_EVERY >= ACC_HOST_STRESS_FRAMES)
+    {
+        return;
+    }
+    HostStressFrames++;
+    end = CPU_TS_Get64() + (CPU_TS64)HostStressUs * 1000u;
+    while (CPU_TS_Get64() < end)
+    {
+    }
+}
+
+float __wrap_Control_Law_Float(float Xn, float Xset, float Vcruise, float deltaV,
+                               float Vn, float Vn1, float Vn2,
+                               float K1, float K2, float K3,
+                               float *p_Vset)
+{
+    AccHost_Stress();
+    return __real_Control_Law_Float(Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3, p_Vset);
+}
+
+acc_q_t __wrap_Control_Law_Fixed(acc_q_t Xn, acc_q_t Xset, acc_q_t Vcruise, acc_q_t deltaV,
+                                 acc_q_t Vn, acc_q_t Vn1, acc_q_t Vn2,
+                                 acc_q_t K1, acc_q_t K2, acc_q_t K3,
+                                 acc_q_t *p_Vset)
+{
+    AccHost_Stress();
+    return __real_Control_Law_Fixed(Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3, p_Vset);
+}
+
+void AccHost_StageStamp(AccHost_Stage_t stage)
+{
+    AccHost_Frame_t *p_frame = AccHost_CurrentFrame();
+
+    if (p_frame == NULL || p_frame->stage[stage] != 0u)
+    {
+        return;
+    }
+    p_frame->stage[stage] = CPU_TS_Get64();
+    if (stage == ACC_HOST_STAGE_ACTUATOR)
+    {
+        HostFramesActuated++;
+    }
+}
+
+// Latency distribution of a stage from the ISR release, in us
+static void AccHost_StageStats(AccHost_Stage_t stage, Bench_Stats_t *p_stats)
+{
+    CPU_INT64U *lat = malloc(HostFramesMax * sizeof(*lat));
+    CPU_INT32U n = 0u;
+    CPU_INT32U i;
+
+    for (i = 0u; i < HostFramesMax && i < HostFramesReleased; i++)
+    {
+        if (HostFrames[i].stage[stage] != 0u)
+        {
+            lat[n++] = HostFrames[i].stage[stage] - HostFrames[i].release;
+        }
+    }
+    Bench_Stats(lat, n, 1000.0, p_stats);
+    free(lat);
+}
+
+#if ACC_OVERSAMPLE_EN
+void AccHost_AcquireAttach(const ACC_PingPong_t *p_pp)
+{
+    HostPingPong = p_pp;
+}
+
+void AccHost_AcquireSample(float raw_dx, float filt_dx, float raw_dv, float filt_dv)
+{
+    HostAcqBlocks++;
+    HostAcqSq[0] += (double)raw_dx * raw_dx;
+    HostAcqSq[1] += (double)filt_dx * filt_dx;
+    HostAcqSq[2] += (double)raw_dv * raw_dv;
+    HostAcqSq[3] += (double)filt_dv * filt_dv;
+}
+
+static void AccHost_ReportAcquire(void)
+{
+    double rms[4];
+    CPU_INT32U i;
+
+    for (i = 0u; i < 4u; i++)
+    {
+        rms[i] = (HostAcqBlocks > 0u) ? sqrt(HostAcqSq[i] / HostAcqBlocks) : 0.0;
+    }
+    printf("  acquisition %u samples/frame: %u blocks filtered, %u frames without a block, %u overruns\n",
+           (unsigned)ACC_OVERSAMPLE_N, (unsigned)HostAcqBlocks,
+           (unsigned)HostPingPong->missed, (unsigned)HostPingPong->overruns);
+    printf("    RMS error vs plant     raw     filtered   reduction\n");
+    printf("    distance (m)      %8.3f %12.3f %10.1fx\n", rms[0], rms[1], (rms[1] > 0.0) ? rms[0] / rms[1] : 0.0);
+    printf("    speed (km/h)      %8.3f %12.3f %10.1fx\n", rms[2], rms[3], (rms[3] > 0.0) ? rms[2] / rms[3] : 0.0);
+#if ACC_TRACE_EN
+    printf("    Sensors read + filter  max %.1f us, mean %.1f us\n",
+           (double)TraceStageHist[TRACE_STAGE_READ].max / 1000.0,
+           (TraceStageHist[TRACE_STAGE_READ].count > 0u) ?
+               (double)TraceStageHist[TRACE_STAGE_READ].sum / TraceStageHist[TRACE_STAGE_READ].count / 1000.0 : 0.0);
+#endif
+}
+#endif
+
+// Returns the worst-case latency of the stage in ns (0 if never reached)
+static CPU_TS64 AccHost_ReportStage(const char *label, AccHost_Stage_t stage)
+{
+    Bench_Stats_t stats;
+
+    AccHost_StageStats(stage, &stats);
+    Bench_PrintStatsRow(label, &stats);
+    return (CPU_TS64)(stats.max * 1000.0);
+}
+
+#if ACC_TRACE_EN
+static void AccHost_ReportHist(const char *label, const ACC_TraceHist_t *p_hist)
+{
+    CPU_INT32U b, last = 0u;
+
+    if (p_hist->count == 0u)
+    {
+        printf("    %-20s %8s\n", label, "-");
+        return;
+    }
+    printf("    %-20s %8u %10.1f %10.1f %10.1f   ",
+           label, (unsigned)p_hist->count,
+           (double)p_hist->min / 1000.0,
+           (double)p_hist->sum / p_hist->count / 1000.0,
+           (double)p_hist->max / 1000.0);
+    for (b = 0u; b < TRACE_HIST_BUCKETS; b++)
+    {
+        if (p_hist->bucket[b] != 0u)
+        {
+            last = b;
+        }
+    }
+    for (b = 0u; b <= last; b++)
+    {
+        printf("%s%u", (b == 0u) ? "" : " ", (unsigned)p_hist->bucket[b]);
+    }
+    printf("\n");
+}
+
+// Histograms built by Trace_Task from the trace rings
+static void AccHost_ReportTrace(void)
+{
+    static const char *const metric[TRACE_METRIC_QTY] = { "exec", "response", "blocking" };
+    static const char *const stage[TRACE_STAGE_QTY] = { "Sensors read", "Param write", "Control law", "ISR jitter" };
+    char label[32];
+    CPU_INT32U i, m;
+
+    printf("  trace (us; log2 buckets <1, [1,2), [2,4), ... us)  drops %u\n", (unsigned)Trace_Drops());
+    printf("    %-20s %8s %10s %10s %10s   %s\n", "", "count", "min", "mean", "max", "buckets");
+    for (i = 0u; i < TRACE_TASK_QTY; i++)
+    {
+        for (m = 0u; m < TRACE_METRIC_QTY; m++)
+        {
+            snprintf(label, sizeof(label), "%s %s", HostHardTasks[i]->NamePtr, metric[m]);
+            AccHost_ReportHist(label, &TraceTaskHist[i][m]);
+        }
+    }
+    for (i = 0u; i < TRACE_STAGE_QTY; i++)
+    {
+        AccHost_ReportHist(stage[i], &TraceStageHist[i]);
+    }
+}
+#endif
+
+// Deadline monitor since ACC engaged (ts units → us)
+static void AccHost_ReportDeadline(void)
+{
+    const ACC_Deadline_t *p_mon = &DeadlineMon;
+    const double us = 1e6 / (double)CPU_TS_TmrFreq_Hz;
+    CPU_INT32U done = p_mon->jobs - p_mon->unfinished;
+
+    printf("  deadline %u ms after release, (%u,%u)-firm: %u jobs, %u late, %u unfinished, "
+           "longest miss run %u, violations %u\n",
+           (unsigned)FRAME_DEADLINE_MS, (unsigned)DEADLINE_MK_M, (unsigned)DEADLINE_MK_K,
+           (unsigned)p_mon->jobs, (unsigned)p_mon->late, (unsigned)p_mon->unfinished,
+           (unsigned)p_mon->consec_max, (unsigned)p_mon->violations);
+    if (done > 0u)
+    {
+        printf("    lateness (us, < 0: slack)  worst %.1f, mean %.1f\n",
+               (double)p_mon->lateness_max * us, (double)p_mon->lateness_sum / done * us);
+    }
+}
+
+// Longest time between two consecutive outputs (ns)
+static CPU_TS64 AccHost_OutputGapMax(void)
+{
+    CPU_TS64 last = 0u, gap = 0u;
+    CPU_INT32U i;
+
+    for (i = 0u; i < HostFramesReleased && i < HostFramesMax; i++)
+    {
+        CPU_TS64 t = HostFrames[i].stage[ACC_HOST_STAGE_ACTUATOR];
+
+        if (t == 0u)
+        {
+            continue;
+        }
+        if (last != 0u && t - last > gap)
+        {
+            gap = t - last;
+        }
+        last = t;
+    }
+    return gap;
+}
+
+// Injected faults: fault → resumed output (us)
+static void AccHost_ReportFaults(void)
+{
+    Bench_Stats_t stats;
+
+    Bench_Stats(HostFaultNs, HostFaultsRecovered, 1000.0, &stats);
+#if ACC_RECOVERY_EN
+    printf("  faults injected %u: %u recovered (%u by rollback, %u after ACC off), "
+           "rollbacks %u, checkpoints %u restored / %u taken\n",
+           (unsigned)HostFaultsInjected, (unsigned)HostFaultsRecovered,
+           (unsigned)(HostFaultsRecovered - HostFaultsReengaged), (unsigned)HostFaultsReengaged,
+           (unsigned)Recovery.rollbacks, (unsigned)Recovery.restored, (unsigned)Recovery.taken);
+#else
+    printf("  faults injected %u: %u recovered after ACC off and an immediate re-engagement\n",
+           (unsigned)HostFaultsInjected, (unsigned)HostFaultsRecovered);
+#endif
+    if (HostFaultsRecovered > 0u)
+    {
+        Bench_PrintStatsHeader("latency from fault (us)");
+        Bench_PrintStatsRow("fault -> next output", &stats);
+    }
+    printf("  longest time without output %.1f us (longest frame period %u ms)\n",
+           (double)AccHost_OutputGapMax() / 1000.0, (unsigned)FRAME_PERIOD_MAX_MS);
+}
+
+// Deadline misses over every engagement of the run
+static void AccHost_ReportStress(void)
+{
+    CPU_INT32U jobs = HostMissJobs + DeadlineMon.jobs;
+    CPU_INT32U late = HostMissLate + DeadlineMon.late + DeadlineMon.unfinished;
+
+    printf("  overload: Control_Law() +%u us in %u frames; deadline missed by %u of %u jobs (%.1f %%), "
+           "ACC off %u times (engaged again at once)\n",
+           (unsigned)HostStressUs, (unsigned)HostStressFrames, (unsigned)late, (unsigned)jobs,
+           (jobs > 0u) ? (double)late / jobs * 100.0 : 0.0, (unsigned)HostAccOff);
+}
+
+#if ACC_MODE_EN
+static void AccHost_ReportMode(void)
+{
+    const double us = 1e6 / (double)CPU_TS_TmrFreq_Hz;
+
+    printf("  criticality mode: %u switches to HI (overruns sensors/control/actuator %u/%u/%u), "
+           "%u back to LO, %u frames in HI\n",
+           (unsigned)(ModeMgr.to_hi[MODE_STAGE_SENSORS] + ModeMgr.to_hi[MODE_STAGE_CONTROL] +
+                      ModeMgr.to_hi[MODE_STAGE_ACTUATOR]),
+           (unsigned)ModeMgr.overruns[MODE_STAGE_SENSORS], (unsigned)ModeMgr.overruns[MODE_STAGE_CONTROL],
+           (unsigned)ModeMgr.overruns[MODE_STAGE_ACTUATOR], (unsigned)ModeMgr.to_lo, (unsigned)ModeMgr.frames_hi);
+    printf("    longest stage (us)   sensors %.1f / %u, control %.1f / %u, actuator %.1f / %u budget\n",
+           (double)ModeMgr.worst[MODE_STAGE_SENSORS] * us, (unsigned)MODE_BUDGET_SENSORS_US,
+           (double)ModeMgr.worst[MODE_STAGE_CONTROL] * us, (unsigned)MODE_BUDGET_CONTROL_US,
+           (double)ModeMgr.worst[MODE_STAGE_ACTUATOR] * us, (unsigned)MODE_BUDGET_ACTUATOR_US);
+}
+#endif
+
+static void AccHost_Report(void)
+{
+    CPU_TS64 worst;
+    CPU_INT32U frames = (HostFramesReleased < HostFramesMax) ? HostFramesReleased : HostFramesMax;
+
+#if ACC_RATE_ADAPT_EN
+    printf("ACC host pipeline latency (T_ISR = %u..%u ms adaptive, tick = %u Hz)\n",
+           (unsigned)FRAME_PERIOD_MIN_MS, (unsigned)FRAME_PERIOD_MAX_MS, (unsigned)OS_CFG_TICK_RATE_HZ);
+#else
+    printf("ACC host pipeline latency (T_ISR = %u ms, tick = %u Hz)\n",
+           (unsigned)TIMER_PERIOD_MS, (unsigned)OS_CFG_TICK_RATE_HZ);
+#endif
+    printf("  frames released %u, actuated %u, context switches %u\n",
+           (unsigned)frames, (unsigned)HostFramesActuated, (unsigned)OSTaskCtxSwCtr);
+    Bench_PrintStatsHeader("latency from ISR (us)");
+#if ACC_CYCLIC_EXEC
+    AccHost_ReportStage("ISR -> Frame_Task sense", ACC_HOST_STAGE_SENSORS);
+    worst = AccHost_ReportStage("ISR -> Frame_Task apply (e2e)", ACC_HOST_STAGE_ACTUATOR);
+#else
+    AccHost_ReportStage("ISR -> Sensors_Task", ACC_HOST_STAGE_SENSORS);
+    AccHost_ReportStage("ISR -> Control_Task", ACC_HOST_STAGE_CONTROL);
+    worst = AccHost_ReportStage("ISR -> Actuator_Task (e2e)", ACC_HOST_STAGE_ACTUATOR);
+#endif
+    printf("  worst end-to-end %.1f us = %.3f %% of the %u ms frame budget\n",
+           (double)worst / 1000.0,
+           (double)worst / ((double)FRAME_PERIOD_MIN_MS * 1e6) * 100.0,
+           (unsigned)FRAME_PERIOD_MIN_MS);
+#if ACC_RATE_ADAPT_EN
+    printf("  rate levels: %u / %u / %u frames at %u / %u / %u ms, %u switches\n",
+           (unsigned)RateCtl.frames[RATE_LEVEL_FAST], (unsigned)RateCtl.frames[RATE_LEVEL_MID],
+           (unsigned)RateCtl.frames[RATE_LEVEL_SLOW], (unsigned)RATE_PERIOD_FAST_MS,
+           (unsigned)RATE_PERIOD_MID_MS, (unsigned)RATE_PERIOD_SLOW_MS, (unsigned)RateCtl.switches);
+#endif
+#if ACC_TELEMETRY_EN
+    printf("  telemetry: %u frame records put, %u dropped (ring full), %u drained by Telem_Task\n",
+           (unsigned)Telemetry.seq, (unsigned)Telemetry.drops, (unsigned)Telemetry.tail);
+#endif
+#if ACC_NVERSION_EN
+    printf("  n-version votes %u: %u with a version outvoted, %u without a majority (band %.3g)\n",
+           (unsigned)NVersion.votes, (unsigned)NVersion.masked, (unsigned)NVersion.failed, NVERSION_TOL);
+#endif
+    AccHost_ReportDeadline();
+    if (HostFaults > 0u)
+    {
+        AccHost_ReportFaults();
+    }
+    if (HostStressUs > 0u)
+    {
+        AccHost_ReportStress();
+    }
+#if ACC_MODE_EN
+    AccHost_ReportMode();
+#endif
+
+    if (HostFramesActuated > 0u)
+    {
+        CPU_INT32U i;
+
+        printf("  per actuated frame            %14s %14s\n", "kernel calls", "CPU time (ns)");
+        for (i = 0u; i < HOST_HARD_TASK_QTY; i++)
+        {
+            printf("    %-27s %14.2f %14.0f\n",
+                   HostHardTasks[i]->NamePtr,
+                   (double)(HostHardTasks[i]->KernelCallCtr - HostCallsStart[i]) / HostFramesActuated,
+                   (double)(HostHardTasks[i]->CyclesTotal - HostCyclesStart[i]) / HostFramesActuated);
+        }
+    }
+    printf("  display updates %u, bus bytes per update mean %.1f max %u (full redraw %u), mock LCD %s\n",
+           (unsigned)DisplayPanel.updates,
+           (DisplayPanel.updates > 0u) ? (double)DisplayPanel.bytes / DisplayPanel.updates : 0.0,
+           (unsigned)DisplayPanel.bytes_max, (unsigned)DISPLAY_FULL_BYTES,
+           LcdMock_Matches(&DisplayPanel) ? "matches the shadow" : "DIFFERS from the shadow");
+#if ACC_OVERSAMPLE_EN
+    AccHost_ReportAcquire();
+#endif
+#if ACC_TRACE_EN
+    AccHost_ReportTrace();
+#endif
+}
+
+#if ACC_TRACE_EN
+// Measured execution times for acc_rta (all ns, maxima over the run)
+static void AccHost_WriteWcet(const char *path)
+{
+    static const char *const metric[TRACE_METRIC_QTY] = { "exec", "response", "blocking" };
+    FILE *fp = fopen(path, "w");
+    CPU_INT32U i, m;
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "acc_host: cannot write %s\n", path);
+        return;
+    }
+    fprintf(fp, "# ACC measured execution times (acc_host, ns)\n");
+    fprintf(fp, "frames %u\n", (unsigned)HostFramesActuated);
+    for (i = 0u; i < TRACE_TASK_QTY; i++)
+    {
+        fprintf(fp, "task %s", HostHardTasks[i]->NamePtr);
+        for (m = 0u; m < TRACE_METRIC_QTY; m++)
+        {
+            fprintf(fp, " %s %u", metric[m], (unsigned)TraceTaskHist[i][m].max);
+        }
+        fprintf(fp, "\n");
+    }
+    fprintf(fp, "param_write %u\n", (unsigned)TraceStageHist[TRACE_STAGE_PARAM].max);
+    fprintf(fp, "isr exec %llu jitter %u\n",
+            (unsigned long long)HostIsrCyclesMax, (unsigned)TraceStageHist[TRACE_STAGE_JITTER].max);
+    fprintf(fp, "tick exec %llu\n", (unsigned long long)OSTickCyclesMax);
+    fclose(fp);
+    printf("  measured execution times written to %s\n", path);
+}
+#endif
+
+// Mean release period over the run (ns); the nominal one if too few frames
+static double AccHost_MeanPeriodNs(void)
+{
+    CPU_INT32U frames = (HostFramesReleased < HostFramesMax) ? HostFramesReleased : HostFramesMax;
+
+    if (frames < 2u)
+    {
+        return (double)TIMER_PERIOD_MS * 1e6;
+    }
+    return (double)(HostFrames[frames - 1u].release - HostFrames[0].release) / (frames - 1u);
+}
+
+// Side-by-side metrics for make cyclic (one "key value" per line; us, ns, %)
+static void AccHost_WriteSummary(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    Bench_Stats_t e2e, sense;
+    CPU_INT32U frames = (HostFramesActuated > 0u) ? HostFramesActuated : 1u;
+    CPU_INT64U calls = 0u, stk = 0u;
+    CPU_TS64 cpu = 0u;
+    CPU_INT32U i;
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "acc_host: cannot write %s\n", path);
+        return;
+    }
+    AccHost_StageStats(ACC_HOST_STAGE_ACTUATOR, &e2e);
+    AccHost_StageStats(ACC_HOST_STAGE_SENSORS, &sense);
+    for (i = 0u; i < HOST_HARD_TASK_QTY; i++)
+    {
+        calls += HostHardTasks[i]->KernelCallCtr - HostCallsStart[i];
+        cpu += HostHardTasks[i]->CyclesTotal - HostCyclesStart[i];
+        stk += HostHardStkSize[i] * sizeof(CPU_STK);
+    }
+    fprintf(fp, "hard_tasks %u\n", (unsigned)HOST_HARD_TASK_QTY);
+    fprintf(fp, "frames_actuated %u\n", (unsigned)HostFramesActuated);
+    fprintf(fp, "sense_latency_p50_us %.1f\n", sense.p50);
+    fprintf(fp, "e2e_latency_p50_us %.1f\n", e2e.p50);
+    fprintf(fp, "e2e_latency_p99_us %.1f\n", e2e.p99);
+    fprintf(fp, "e2e_latency_max_us %.1f\n", e2e.max);
+    fprintf(fp, "output_jitter_us %.1f\n", e2e.max - e2e.min);
+    fprintf(fp, "ctx_switches_per_frame %.2f\n", (double)(OSTaskCtxSwCtr - HostCtxSwStart) / frames);
+    fprintf(fp, "kernel_calls_per_frame %.2f\n", (double)calls / frames);
+    fprintf(fp, "cpu_ns_per_frame %.0f\n", (double)cpu / frames);
+    fprintf(fp, "cpu_load_pct %.4f\n", (double)cpu / frames / AccHost_MeanPeriodNs() * 100.0);
+    fprintf(fp, "stack_bytes_reserved %llu\n", (unsigned long long)stk);
+    fprintf(fp, "deadline_late %u\n", (unsigned)(DeadlineMon.late + DeadlineMon.unfinished));
+    fprintf(fp, "deadline_lateness_max_us %.1f\n", (double)DeadlineMon.lateness_max * 1e6 / CPU_TS_TmrFreq_Hz);
+    if (HostStressUs > 0u)
+    {
+        CPU_INT32U jobs = HostMissJobs + DeadlineMon.jobs;
+        CPU_INT32U late = HostMissLate + DeadlineMon.late + DeadlineMon.unfinished;
+
+        fprintf(fp, "stress_frames %u\n", (unsigned)HostStressFrames);
+        fprintf(fp, "deadline_jobs %u\n", (unsigned)jobs);
+        fprintf(fp, "deadline_missed %u\n", (unsigned)late);
+        fprintf(fp, "deadline_miss_pct %.2f\n", (jobs > 0u) ? (double)late / jobs * 100.0 : 0.0);
+        fprintf(fp, "acc_off %u\n", (unsigned)HostAccOff);
+    }
+#if ACC_MODE_EN
+    fprintf(fp, "mode_to_hi %u\n", (unsigned)(ModeMgr.to_hi[MODE_STAGE_SENSORS] + ModeMgr.to_hi[MODE_STAGE_CONTROL] +
+                                                ModeMgr.to_hi[MODE_STAGE_ACTUATOR]));
+    fprintf(fp, "mode_frames_hi %u\n", (unsigned)ModeMgr.frames_hi);
+#endif
+    if (HostFaults > 0u)
+    {
+        Bench_Stats_t fault;
+
+        Bench_Stats(HostFaultNs, HostFaultsRecovered, 1000.0, &fault);
+        fprintf(fp, "faults_injected %u\n", (unsigned)HostFaultsInjected);
+        fprintf(fp, "faults_recovered %u\n", (unsigned)HostFaultsRecovered);
+        fprintf(fp, "faults_acc_off %u\n", (unsigned)HostFaultsReengaged);
+        fprintf(fp, "fault_to_output_mean_us %.1f\n", fault.mean);
+        fprintf(fp, "fault_to_output_max_us %.1f\n", fault.max);
+        fprintf(fp, "output_gap_max_us %.1f\n", (double)AccHost_OutputGapMax() / 1000.0);
+    }
+    fclose(fp);
+    printf("  summary written to %s\n", path);
+}
+
+// Simulated driver switch: an interrupt that engages ACC
+// Driver switch: ACC on (interrupt context, like the switch ISR)
+static void AccHost_DriverSwitch(void)
+{
+    OS_ERR err;
+
+    OSIntEnter();
+    OSFlagPost(&EventFlagGroup, (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG), OS_OPT_POST_FLAG_SET, &err);
+    OSFlagPost(&EventFlagGroup, (OS_FLAGS)ACC_OFF_FLAG, OS_OPT_POST_FLAG_CLR, &err);
+    OSIntExit();
+}
+
+static void AccHost_DriverEngage(void)
+{
+    CPU_INT32U i;
+
+    for (i = 0u; i < HOST_HARD_TASK_QTY; i++)
+    {
+        HostCyclesStart[i] = HostHardTasks[i]->CyclesTotal;
+        HostCallsStart[i] = HostHardTasks[i]->KernelCallCtr;
+    }
+    HostCtxSwStart = OSTaskCtxSwCtr;
+    AccHost_DriverSwitch();
+}
+
+// Driver engages again after ACC off; the deadline counts of the engagement
+// that ended are kept (Setup_Task resets the monitor on engagement)
+static void AccHost_Reengage(void)
+{
+    HostMissJobs += DeadlineMon.jobs;
+    HostMissLate += DeadlineMon.late + DeadlineMon.unfinished;
+    HostAccOff++;
+    AccHost_DriverSwitch();
+}
+
+// First output of a frame released after t (0: none yet)
+static CPU_TS64 AccHost_OutputAfter(CPU_TS64 t, CPU_INT32U from)
+{
+    CPU_INT32U i;
+
+    for (i = from; i < HostFramesReleased && i < HostFramesMax; i++)
+    {
+        if (HostFrames[i].release > t && HostFrames[i].stage[ACC_HOST_STAGE_ACTUATOR] != 0u)
+        {
+            return HostFrames[i].stage[ACC_HOST_STAGE_ACTUATOR];
+        }
+    }
+    return 0u;
+}
+
+// Raises FAULT_DETECTED_FLAG at a spread phase of the frame, then waits for
+// the output to resume. A driver who re-engages as soon as ACC is off stands
+// in for the path without rollback.
+static void AccHost_InjectFault(void)
+{
+    OS_ERR err;
+    CPU_INT32U from = HostFramesReleased;
+    CPU_INT32U waited_us;
+    CPU_TS64 t_fault, t_out = 0u;
+    bool reengaged = false;
+
+    usleep((HostFaultsInjected * 37u % 100u) * TIMER_PERIOD_MS * 10u);
+    t_fault = CPU_TS_Get64();
+    OSIntEnter();
+    OSFlagPost(&EventFlagGroup, (OS_FLAGS)FAULT_DETECTED_FLAG, OS_OPT_POST_FLAG_SET, &err);
+    OSIntExit();
+    HostFaultsInjected++;
+
+    for (waited_us = 0u; waited_us < ACC_HOST_FAULT_WAIT_US && t_out == 0u; waited_us += ACC_HOST_FAULT_POLL_US)
+    {
+        usleep(ACC_HOST_FAULT_POLL_US);
+        if (!reengaged && (EventFlagGroup.Flags & ACC_OFF_FLAG) != 0u)
+        {
+            AccHost_Reengage();
+            reengaged = true;
+        }
+        t_out = AccHost_OutputAfter(t_fault, from);
+    }
+    if (t_out != 0u)
+    {
+        HostFaultNs[HostFaultsRecovered++] = t_out - t_fault;
+        HostFaultsReengaged += reengaged;
+    }
+}
+
+void App_OS_HostMain(void)
+{
+    // Allow twice the nominal run time before giving up on missing frames
+    CPU_INT64U budget_us = (CPU_INT64U)HostFramesMax * FRAME_PERIOD_MAX_MS * 2000u + 1000000u;
+    CPU_INT64U waited_us = 0u;
+
+    // Let Setup_Task initialise before the driver engages ACC
+    usleep(50000u);
+    AccHost_DriverEngage();
+
+    while (HostFramesReleased < HostFramesMax && waited_us < budget_us)
+    {
+        usleep(ACC_HOST_POLL_US);
+        waited_us += ACC_HOST_POLL_US;
+        // Overload: the driver keeps ACC engaged (a deadline miss turns it off)
+        if (HostStressUs > 0u && (EventFlagGroup.Flags & ACC_OFF_FLAG) != 0u)
+        {
+            AccHost_Reengage();
+        }
+        // Faults spread evenly over the run
+        if (HostFaultsInjected < HostFaults &&
+            HostFramesReleased >= (HostFaultsInjected + 1u) * HostFramesMax / (HostFaults + 1u))
+        {
+            AccHost_InjectFault();
+        }
+    }
+    // Let the last frame drain through the pipeline
+    usleep(FRAME_PERIOD_MAX_MS * 1000u / 2u);
+#if ACC_TRACE_EN
+    // ... and through one more trace drain
+    usleep(TRACE_DRAIN_PERIOD_MS * 1000u);
+#endif
+
+    AccHost_Report();
+#if ACC_TRACE_EN
+    if (getenv("ACC_HOST_WCET") != NULL)
+    {
+        AccHost_WriteWcet(getenv("ACC_HOST_WCET"));
+    }
+#endif
+    if (getenv("ACC_HOST_SUMMARY") != NULL)
+    {
+        AccHost_WriteSummary(getenv("ACC_HOST_SUMMARY"));
+    }
+#if ACC_STK_PROFILE_EN
+    if (!StackHost_Profile())
+    {
+        exit(1);
+    }
+#endif
+#if ACC_NVERSION_EN
+    // No fault is injected: the versions must always agree
+    if (NVersion.masked != 0u || NVersion.failed != 0u)
+    {
+        exit(1);
+    }
+#endif
+    // With faults injected, frames may be lost; every fault must be recovered
+    exit(((HostFaults > 0u) ? HostFaultsRecovered == HostFaultsInjected :
+          (HostStressUs > 0u) ? true : HostFramesActuated >= HostFramesMax) &&
+         LcdMock_Matches(&DisplayPanel) ? 0 : 1);
+}
@@ -0,0 +1,28 @@
+#ifndef ACC_HOST_H
+#define ACC_HOST_H
+
+#include "cpu.h"
+#include "acc_hardware.h"
+
+// Host harness: drives the ACC task set on the POSIX kernel shim and
+// measures the ISR → Sensors → Control → Actuator pipeline of every frame.
+
+// Pipeline stages stamped per frame (latency is measured from the ISR release)
+typedef enum {
+    ACC_HOST_STAGE_SENSORS = 0,     // Sensors_Task reads the first sensor
+    ACC_HOST_STAGE_CONTROL,         // Control_Task dispatched with the frame's data
+    ACC_HOST_STAGE_ACTUATOR,        // Actuator_Task applies the output
+    ACC_HOST_STAGE_QTY
+} AccHost_Stage_t;
+
+void AccHost_Init(void);
+CPU_INT32U AccHost_FramesMax(void);
+void AccHost_FrameRelease(void);
+void AccHost_FrameReleaseDone(void);
+void AccHost_StageStamp(AccHost_Stage_t stage);
+#if ACC_OVERSAMPLE_EN
+void AccHost_AcquireAttach(const ACC_PingPong_t *p_pp);
+void AccHost_AcquireSample(float raw_dx, float filt_dx, float raw_dv, float filt_dv);  // Errors vs the plant
+#endif
+
+#endif // ACC_HOST_H
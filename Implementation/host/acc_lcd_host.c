@@ -0,0 +1,26 @@
+#include "acc_lcd_host.h"
+#include "acc_hardware.h"
+#include <string.h>
+
+// Mock LCD (see acc_lcd_host.h)
+
+ACC_LcdMock_t LcdMock;
+
+void LCD_Write(uint8_t row, uint8_t col, const char *p_text, uint8_t len)
+{
+    LcdMock.writes++;
+    LcdMock.bytes += LCD_ADDR_BYTES + len;
+    if (row >= DISPLAY_ROWS || len == 0u || (uint32_t)col + len > DISPLAY_COLS)
+    {
+        LcdMock.errors++;
+        return;
+    }
+    memcpy(&LcdMock.cell[row][col], p_text, len);
+}
+
+bool LcdMock_Matches(const ACC_Display_t *p_disp)
+{
+    return LcdMock.errors == 0u &&
+           LcdMock.bytes == p_disp->bytes &&
+           memcmp(LcdMock.cell, p_disp->shadow, sizeof(LcdMock.cell)) == 0;
+}
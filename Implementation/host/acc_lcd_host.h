@@ -0,0 +1,24 @@
+#ifndef ACC_LCD_HOST_H
+#define ACC_LCD_HOST_H
+
+#include "acc_display.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Mock LCD (host): implements LCD_Write() on a character-cell image of the
+// panel and counts what crosses the bus, with the cost model of
+// acc_display.h (LCD_ADDR_BYTES per write plus one byte per cell).
+
+typedef struct {
+    char     cell[DISPLAY_ROWS][DISPLAY_COLS];
+    uint32_t writes;            // LCD_Write() calls
+    uint32_t bytes;             // Bus bytes (address commands + data)
+    uint32_t errors;            // Writes outside the panel
+} ACC_LcdMock_t;
+
+extern ACC_LcdMock_t LcdMock;
+
+// True when the panel shows exactly what the shadow says it shows
+bool LcdMock_Matches(const ACC_Display_t *p_disp);
+
+#endif // ACC_LCD_HOST_H
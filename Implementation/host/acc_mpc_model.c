@@ -0,0 +1,86 @@
+#include "acc_mpc_model.h"
+#include "acc_config.h"
+#include <math.h>
+#include <string.h>
+
+// Explicit MPC problem (see acc_mpc_model.h)
+
+static const uint32_t MpcModelBlocks[MPC_NU] = { MPC_BLOCK_0, MPC_BLOCK_1, MPC_BLOCK_2, MPC_BLOCK_3 };
+
+uint32_t MpcModel_PeriodMs(uint32_t level)
+{
+    static const uint32_t periods[RATE_LEVEL_QTY] = {
+        RATE_PERIOD_FAST_MS, RATE_PERIOD_MID_MS, RATE_PERIOD_SLOW_MS
+    };
+
+    return periods[level];
+}
+
+void MpcModel_Build(uint32_t period_ms, MpcModel_t *p_m)
+{
+    const double T = period_ms / 1000.0;
+    const double c1 = MPC_LAG_S * (1.0 - exp(-T / MPC_LAG_S));     // Speed gained from a, per frame
+    const double q = MPC_Q_E * T;
+    double Ae[MPC_NX] = { 1.0, 0.0, 0.0 }, Aa[MPC_NX] = { 0.0, 1.0, 0.0 };     // e, a = A·x + B·U
+    double Be[MPC_NU] = { 0.0 }, Ba[MPC_NU] = { 0.0 };
+    uint32_t j, f, i, k;
+
+    memset(p_m, 0, sizeof(*p_m));
+    p_m->period_ms = period_ms;
+    p_m->phi = exp(-T / MPC_LAG_S);
+    p_m->lb = MPC_ACCEL_MIN;
+    p_m->ub = MPC_ACCEL_MAX;
+
+    for (j = 0u; j < MPC_NU; j++)
+    {
+        // Move j held for its block: the same length of time at every period
+        p_m->block[j] = (uint32_t)lround((double)MpcModelBlocks[j] * TIMER_PERIOD_MS / period_ms);
+        if (p_m->block[j] == 0u)
+        {
+            p_m->block[j] = 1u;
+        }
+        for (f = 0u; f < p_m->block[j]; f++)
+        {
+            // Exact over the frame for a request held against the lag:
+            // e -= c1·a + (T - c1)·u, a = φ·a + (1 - φ)·u
+            for (i = 0u; i < MPC_NX; i++)
+            {
+                Ae[i] -= c1 * Aa[i];
+                Aa[i] *= p_m->phi;
+            }
+            for (k = 0u; k < MPC_NU; k++)
+            {
+                Be[k] -= c1 * Ba[k];
+                Ba[k] *= p_m->phi;
+            }
+            Be[j] -= T - c1;
+            Ba[j] += 1.0 - p_m->phi;
+
+            // q·T·e² at the end of the frame
+            for (k = 0u; k < MPC_NU; k++)
+            {
+                for (i = 0u; i < MPC_NU; i++)
+                {
+                    p_m->H[k][i] += q * Be[k] * Be[i];
+                }
+                for (i = 0u; i < MPC_NX; i++)
+                {
+                    p_m->F[i][k] += q * Ae[i] * Be[k];
+                }
+            }
+        }
+
+        // r·Δu² at the start of the move (u₋ = x[2] before the first)
+        p_m->H[j][j] += MPC_R_DU;
+        if (j == 0u)
+        {
+            p_m->F[2][0] -= MPC_R_DU;
+        }
+        else
+        {
+            p_m->H[j - 1u][j - 1u] += MPC_R_DU;
+            p_m->H[j][j - 1u] -= MPC_R_DU;
+            p_m->H[j - 1u][j] -= MPC_R_DU;
+        }
+    }
+}
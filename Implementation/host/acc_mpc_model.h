@@ -0,0 +1,28 @@
+#ifndef ACC_MPC_MODEL_H
+#define ACC_MPC_MODEL_H
+
+#include "acc_mpc.h"
+#include <stdint.h>
+
+// Explicit MPC problem of acc_mpc.h in double precision (host only:
+// acc_mpcgen builds the regions from it, bench_mpc solves it online as the
+// reference)
+//
+// Over the horizon the cost is U'·H·U + 2·x'·F·U + (terms without U), for
+// the moves U (m/s²) and the state x = (e, a, u₋), subject to lb ≤ U ≤ ub.
+
+typedef struct {
+    uint32_t period_ms;
+    uint32_t block[MPC_NU];             // Frames each move is held
+    double   phi;                       // exp(-T / MPC_LAG_S)
+    double   H[MPC_NU][MPC_NU];
+    double   F[MPC_NX][MPC_NU];
+    double   lb, ub;
+} MpcModel_t;
+
+void MpcModel_Build(uint32_t period_ms, MpcModel_t *p_m);
+
+// Period of control-rate level l (acc_rate.h), without acc_rate.c
+uint32_t MpcModel_PeriodMs(uint32_t level);
+
+#endif // ACC_MPC_MODEL_H
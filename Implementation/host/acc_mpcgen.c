@@ -0,0 +1,428 @@
+#include "acc_mpc_model.h"
+#include "acc_config.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Explicit MPC Table Generator (host tool)
+//
+// Writes acc_mpc_table.c: the piecewise-affine solution of the MPC problem
+// of acc_mpc.h for each control-rate level. For every combination of moves
+// at the lower limit, at the upper limit or free, the KKT conditions give
+//   free moves   U_F = -H_FF⁻¹ · (F_F'·x + H_FA·U_A), within [lb, ub]
+//   at a limit   gradient (H·U + F'·x)_i ≥ 0 at lb, ≤ 0 at ub
+// so U(x) = M·x + m and the region is a set of rows a·x + b ≤ 0. The QP is
+// strictly convex, so the regions of all 3^MPC_NU combinations partition the
+// state space. Regions that no sample of the operating range reaches are
+// dropped, and the rest are ordered by their sample count, so the common
+// regions are found first. Samples: e in ±MPCGEN_E_MAX (denser near 0),
+// a and u₋ within the limits.
+//
+// Usage: acc_mpcgen <out.c>     (make -C host mpcgen writes ../acc_mpc_table.c)
+// The output depends only on acc_config.h and acc_mpc.h: make -C host mpc
+// regenerates it and fails if the committed table is stale.
+
+#define MPCGEN_CAND        81u          // 3^MPC_NU
+#define MPCGEN_ROWS_MAX    (2u * MPC_NU)
+#define MPCGEN_SAMPLES     400000u
+#define MPCGEN_E_MAX       30.0         // m/s
+#define MPCGEN_EPS         1e-12
+
+typedef struct {
+    double a[MPC_NX];
+    double b;
+} MpcGenRow_t;
+
+typedef struct {
+    bool        valid;
+    double      K[MPC_NX];              // First move: K·x + k
+    double      k;
+    MpcGenRow_t row[MPCGEN_ROWS_MAX];
+    uint32_t    rows;
+    uint32_t    hits;
+    uint32_t    code;
+} MpcGenRegion_t;
+
+static MpcGenRegion_t MpcGenRegion[MPCGEN_CAND];
+static MpcGenRegion_t MpcGenKept[MPC_TABLE_QTY][MPCGEN_CAND];     // Reached, most frequent first
+static uint64_t MpcGenRng = 1u;
+
+static double MpcGen_Uniform(void)
+{
+    // xorshift64*
+    MpcGenRng ^= MpcGenRng >> 12;
+    MpcGenRng ^= MpcGenRng << 25;
+    MpcGenRng ^= MpcGenRng >> 27;
+    return (double)((MpcGenRng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+// Solves A·X = B in place for n unknowns and c right-hand sides (partial pivoting)
+static bool MpcGen_Solve(double A[MPC_NU][MPC_NU], double B[MPC_NU][MPC_NX + 1u], uint32_t n)
+{
+    uint32_t i, j, k, p;
+
+    for (i = 0u; i < n; i++)
+    {
+        p = i;
+        for (j = i + 1u; j < n; j++)
+        {
+            p = (fabs(A[j][i]) > fabs(A[p][i])) ? j : p;
+        }
+        if (fabs(A[p][i]) < MPCGEN_EPS)
+        {
+            return false;
+        }
+        for (k = 0u; k < MPC_NU; k++)
+        {
+            double t = A[i][k]; A[i][k] = A[p][k]; A[p][k] = t;
+        }
+        for (k = 0u; k <= MPC_NX; k++)
+        {
+            double t = B[i][k]; B[i][k] = B[p][k]; B[p][k] = t;
+        }
+        for (j = 0u; j < n; j++)
+        {
+            double f;
+
+            if (j == i)
+            {
+                continue;
+            }
+            f = A[j][i] / A[i][i];
+            for (k = i; k < n; k++)
+            {
+                A[j][k] -= f * A[i][k];
+            }
+            for (k = 0u; k <= MPC_NX; k++)
+            {
+                B[j][k] -= f * B[i][k];
+            }
+        }
+    }
+    for (i = 0u; i < n; i++)
+    {
+        for (k = 0u; k <= MPC_NX; k++)
+        {
+            B[i][k] /= A[i][i];
+        }
+    }
+    return true;
+}
+
+// Row a·x + b ≤ 0, normalised; false if it can never hold
+static bool MpcGen_AddRow(MpcGenRegion_t *p_reg, const double a[MPC_NX], double b)
+{
+    double n = 0.0;
+    uint32_t i;
+
+    for (i = 0u; i < MPC_NX; i++)
+    {
+        n = fmax(n, fabs(a[i]));
+    }
+    if (n < 1e-9)
+    {
+        return b <= 0.0;        // Constant row: always or never
+    }
+    for (i = 0u; i < MPC_NX; i++)
+    {
+        p_reg->row[p_reg->rows].a[i] = a[i] / n;
+    }
+    p_reg->row[p_reg->rows].b = b / n;
+    p_reg->rows++;
+    return true;
+}
+
+// Region of the combination 'code' (base-3 digit per move: 0 free, 1 lb, 2 ub)
+static void MpcGen_Region(const MpcModel_t *p_m, uint32_t code, MpcGenRegion_t *p_reg)
+{
+    double M[MPC_NU][MPC_NX + 1u];          // U = M·(x, 1)
+    double A[MPC_NU][MPC_NU], B[MPC_NU][MPC_NX + 1u];
+    uint32_t state[MPC_NU], fr[MPC_NU];
+    uint32_t nf = 0u, i, j, k, c = code;
+
+    memset(p_reg, 0, sizeof(*p_reg));
+    memset(M, 0, sizeof(M));
+    p_reg->code = code;
+    for (i = 0u; i < MPC_NU; i++, c /= 3u)
+    {
+        state[i] = c % 3u;
+        if (state[i] == 0u)
+        {
+            fr[nf++] = i;
+        }
+        else
+        {
+            M[i][MPC_NX] = (state[i] == 1u) ? p_m->lb : p_m->ub;
+        }
+    }
+
+    // Free moves: H_FF·U_F = -(F_F'·x + H_FA·U_A)
+    for (i = 0u; i < nf; i++)
+    {
+        for (j = 0u; j < nf; j++)
+        {
+            A[i][j] = p_m->H[fr[i]][fr[j]];
+        }
+        for (k = 0u; k < MPC_NX; k++)
+        {
+            B[i][k] = -p_m->F[k][fr[i]];
+        }
+        B[i][MPC_NX] = 0.0;
+        for (j = 0u; j < MPC_NU; j++)
+        {
+            B[i][MPC_NX] -= (state[j] != 0u) ? p_m->H[fr[i]][j] * M[j][MPC_NX] : 0.0;
+        }
+    }
+    if (nf > 0u && !MpcGen_Solve(A, B, nf))
+    {
+        return;
+    }
+    for (i = 0u; i < nf; i++)
+    {
+        memcpy(M[fr[i]], B[i], sizeof(M[0]));
+    }
+
+    for (i = 0u; i < MPC_NU; i++)
+    {
+        double a[MPC_NX], b;
+
+        if (state[i] == 0u)
+        {
+            // lb ≤ U_i(x) ≤ ub
+            for (k = 0u; k < MPC_NX; k++)
+            {
+                a[k] = M[i][k];
+            }
+            if (!MpcGen_AddRow(p_reg, a, M[i][MPC_NX] - p_m->ub))
+            {
+                return;
+            }
+            for (k = 0u; k < MPC_NX; k++)
+            {
+                a[k] = -M[i][k];
+            }
+            if (!MpcGen_AddRow(p_reg, a, p_m->lb - M[i][MPC_NX]))
+            {
+                return;
+            }
+            continue;
+        }
+        // Gradient g_i = H_i·U(x) + F_i'·x: ≥ 0 at lb (-g ≤ 0), ≤ 0 at ub
+        for (k = 0u; k < MPC_NX; k++)
+        {
+            a[k] = p_m->F[k][i];
+            for (j = 0u; j < MPC_NU; j++)
+            {
+                a[k] += p_m->H[i][j] * M[j][k];
+            }
+        }
+        b = 0.0;
+        for (j = 0u; j < MPC_NU; j++)
+        {
+            b += p_m->H[i][j] * M[j][MPC_NX];
+        }
+        if (state[i] == 1u)
+        {
+            for (k = 0u; k < MPC_NX; k++)
+            {
+                a[k] = -a[k];
+            }
+            b = -b;
+        }
+        if (!MpcGen_AddRow(p_reg, a, b))
+        {
+            return;
+        }
+    }
+    for (k = 0u; k < MPC_NX; k++)
+    {
+        p_reg->K[k] = M[0][k];
+    }
+    p_reg->k = M[0][MPC_NX];
+    p_reg->valid = true;
+}
+
+static bool MpcGen_Contains(const MpcGenRegion_t *p_reg, const double x[MPC_NX])
+{
+    uint32_t r;
+
+    for (r = 0u; r < p_reg->rows; r++)
+    {
+        const MpcGenRow_t *p_row = &p_reg->row[r];
+
+        if (p_row->a[0] * x[0] + p_row->a[1] * x[1] + p_row->a[2] * x[2] + p_row->b > 0.0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int MpcGen_ByHits(const void *pa, const void *pb)
+{
+    const MpcGenRegion_t *a = pa, *b = pb;
+
+    if (a->hits != b->hits)
+    {
+        return (a->hits > b->hits) ? -1 : 1;
+    }
+    return (a->code < b->code) ? -1 : 1;
+}
+
+static void MpcGen_Value(FILE *fp, double v)
+{
+    fprintf(fp, "ACC_VALUE(%.9g)", (fabs(v) < 1e-12) ? 0.0 : v);
+}
+
+static void MpcGen_Law(FILE *fp, const MpcGenRegion_t *p_reg)
+{
+    fprintf(fp, "{ ");
+    MpcGen_Value(fp, p_reg->K[0]);
+    fprintf(fp, ", ");
+    MpcGen_Value(fp, p_reg->K[1]);
+    fprintf(fp, ", ");
+    MpcGen_Value(fp, p_reg->K[2]);
+    fprintf(fp, " }, ");
+    MpcGen_Value(fp, p_reg->k);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t kept_qty[MPC_TABLE_QTY], row_qty[MPC_TABLE_QTY];
+    MpcGenRegion_t free_law[MPC_TABLE_QTY];
+    MpcModel_t model[MPC_TABLE_QTY];
+    FILE *fp;
+    uint32_t l, c;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: acc_mpcgen <out.c>\n");
+        return 2;
+    }
+
+    printf("acc_mpcgen: %u candidate regions per level, %u samples\n", (unsigned)MPCGEN_CAND, (unsigned)MPCGEN_SAMPLES);
+    for (l = 0u; l < MPC_TABLE_QTY; l++)
+    {
+        MpcModel_t *p_m = &model[l];
+        uint32_t n, rows = 0u, missed = 0u, multiple = 0u;
+
+        MpcModel_Build(MpcModel_PeriodMs(l), p_m);
+        for (c = 0u; c < MPCGEN_CAND; c++)
+        {
+            MpcGen_Region(p_m, c, &MpcGenRegion[c]);
+        }
+        free_law[l] = MpcGenRegion[0];
+
+        MpcGenRng = 1u;
+        for (n = 0u; n < MPCGEN_SAMPLES; n++)
+        {
+            double s = 2.0 * MpcGen_Uniform() - 1.0;
+            double x[MPC_NX];
+            uint32_t found = 0u;
+
+            x[0] = MPCGEN_E_MAX * s * s * s;
+            x[1] = p_m->lb + (p_m->ub - p_m->lb) * MpcGen_Uniform();
+            x[2] = p_m->lb + (p_m->ub - p_m->lb) * MpcGen_Uniform();
+            for (c = 0u; c < MPCGEN_CAND; c++)
+            {
+                if (MpcGenRegion[c].valid && MpcGen_Contains(&MpcGenRegion[c], x))
+                {
+                    if (found++ == 0u)
+                    {
+                        MpcGenRegion[c].hits++;
+                    }
+                }
+            }
+            missed += (found == 0u);
+            multiple += (found > 1u);
+        }
+        qsort(MpcGenRegion, MPCGEN_CAND, sizeof(MpcGenRegion[0]), MpcGen_ByHits);
+        for (c = 0u; c < MPCGEN_CAND && MpcGenRegion[c].hits > 0u; c++)
+        {
+            rows += MpcGenRegion[c].rows;
+        }
+        memcpy(MpcGenKept[l], MpcGenRegion, c * sizeof(MpcGenRegion[0]));
+        kept_qty[l] = c;
+        row_qty[l] = rows;
+        printf("  level %u (T %u ms): %u regions reached, %u rows; samples in no region %u, on a boundary %u\n",
+               (unsigned)l, (unsigned)p_m->period_ms, (unsigned)c, (unsigned)rows,
+               (unsigned)missed, (unsigned)multiple);
+    }
+
+    fp = fopen(argv[1], "w");
+    if (fp == NULL)
+    {
+        perror(argv[1]);
+        return 2;
+    }
+    fprintf(fp, "#include \"acc_mpc.h\"\n\n");
+    fprintf(fp, "// Explicit MPC regions (see acc_mpc.h)\n");
+    fprintf(fp, "// Generated by host/acc_mpcgen from acc_config.h and acc_mpc.h, do not edit\n");
+    fprintf(fp, "// (make -C host mpcgen)\n");
+    fprintf(fp, "//\n");
+    fprintf(fp, "// level  T ms  moves (frames)   regions  rows  worst-case lookup (multiply-adds)\n");
+    for (l = 0u; l < MPC_TABLE_QTY; l++)
+    {
+        const MpcModel_t *p_m = &model[l];
+
+        fprintf(fp, "//   %u    %5u   %2u %2u %2u %2u      %5u   %5u   %u\n",
+                (unsigned)l, (unsigned)p_m->period_ms,
+                (unsigned)p_m->block[0], (unsigned)p_m->block[1], (unsigned)p_m->block[2], (unsigned)p_m->block[3],
+                (unsigned)kept_qty[l], (unsigned)row_qty[l], (unsigned)((row_qty[l] + 1u) * MPC_NX));
+    }
+    fprintf(fp, "\n#if ACC_MPC_EN\n");
+
+    for (l = 0u; l < MPC_TABLE_QTY; l++)
+    {
+        const MpcGenRegion_t *p_kept = MpcGenKept[l];
+        uint32_t rows;
+
+        fprintf(fp, "\nstatic const ACC_MpcRow_t MpcRows%u[%u] = {\n", (unsigned)l, (unsigned)row_qty[l]);
+        for (c = 0u; c < kept_qty[l]; c++)
+        {
+            uint32_t r;
+
+            for (r = 0u; r < p_kept[c].rows; r++)
+            {
+                const MpcGenRow_t *p_row = &p_kept[c].row[r];
+
+                fprintf(fp, "    { { ");
+                MpcGen_Value(fp, p_row->a[0]);
+                fprintf(fp, ", ");
+                MpcGen_Value(fp, p_row->a[1]);
+                fprintf(fp, ", ");
+                MpcGen_Value(fp, p_row->a[2]);
+                fprintf(fp, " }, ");
+                MpcGen_Value(fp, p_row->b - MPC_ROW_TOL);
+                fprintf(fp, " },\n");
+            }
+        }
+        fprintf(fp, "};\n\nstatic const ACC_MpcRegion_t MpcRegions%u[%u] = {\n", (unsigned)l, (unsigned)kept_qty[l]);
+        for (c = 0u, rows = 0u; c < kept_qty[l]; c++)
+        {
+            fprintf(fp, "    { ");
+            MpcGen_Law(fp, &p_kept[c]);
+            fprintf(fp, ", %uu, %uu },     // %u samples\n", (unsigned)rows, (unsigned)p_kept[c].rows,
+                    (unsigned)p_kept[c].hits);
+            rows += p_kept[c].rows;
+        }
+        fprintf(fp, "};\n");
+    }
+
+    fprintf(fp, "\nconst ACC_MpcTable_t MpcTables[MPC_TABLE_QTY] = {\n");
+    for (l = 0u; l < MPC_TABLE_QTY; l++)
+    {
+        fprintf(fp, "    { %uu, ", (unsigned)model[l].period_ms);
+        MpcGen_Value(fp, model[l].phi);
+        fprintf(fp, ", %uu, %uu, MpcRegions%u, MpcRows%u,\n      { ", (unsigned)kept_qty[l], (unsigned)row_qty[l],
+                (unsigned)l, (unsigned)l);
+        MpcGen_Law(fp, &free_law[l]);
+        fprintf(fp, ", 0u, 0u } },\n");
+    }
+    fprintf(fp, "};\n\n#endif // ACC_MPC_EN\n");
+    fclose(fp);
+    return 0;
+}
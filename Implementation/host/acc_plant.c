@@ -0,0 +1,243 @@
+#include "acc_plant.h"
+#include <math.h>
+#include <string.h>
+
+// Longitudinal vehicle model (see acc_plant.h)
+
+#define KMH(v)   ((v) / 3.6f)
+
+// Cruising at Vcruise, a slower car cuts in 25 m ahead, then changes lanes again
+static const ACC_PlantEvent_t PlantCutIn[] = {
+    {     0u, PLANT_EV_GONE,    0.0f,  0.0f, 0.0f },
+    { 20000u, PLANT_EV_APPEAR, 25.0f, 80.0f, 0.0f },
+    { 45000u, PLANT_EV_GONE,    0.0f,  0.0f, 0.0f },
+};
+
+// Following at 90 km/h, the lead brakes at 7 m/s² down to 20 km/h and recovers
+static const ACC_PlantEvent_t PlantHardBrake[] = {
+    {     0u, PLANT_EV_APPEAR, 70.0f, 90.0f, 0.0f },
+    { 25000u, PLANT_EV_SPEED,  20.0f,  7.0f, 0.0f },
+    { 35000u, PLANT_EV_SPEED,  90.0f,  1.5f, 0.0f },
+};
+
+// Congested traffic: the lead stops, pulls away, slows, speeds up
+static const ACC_PlantEvent_t PlantStopAndGo[] = {
+    {     0u, PLANT_EV_APPEAR, 50.0f, 50.0f, 0.0f },
+    { 10000u, PLANT_EV_SPEED,   0.0f,  2.5f, 0.0f },
+    { 25000u, PLANT_EV_SPEED,  50.0f,  1.5f, 0.0f },
+    { 40000u, PLANT_EV_SPEED,  20.0f,  2.0f, 0.0f },
+    { 50000u, PLANT_EV_SPEED,  50.0f,  1.5f, 0.0f },
+};
+
+// Mixed drive: open highway, catching up with and following a slower car,
+// open road again, town traffic with stops, open road
+static const ACC_PlantEvent_t PlantDriveCycle[] = {
+    {      0u, PLANT_EV_GONE,     0.0f,  0.0f, 0.0f },
+    { 120000u, PLANT_EV_APPEAR, 150.0f, 80.0f, 0.0f },
+    { 200000u, PLANT_EV_SPEED,   65.0f,  0.5f, 0.0f },
+    { 280000u, PLANT_EV_GONE,     0.0f,  0.0f, 0.0f },
+    { 480000u, PLANT_EV_APPEAR,  60.0f, 50.0f, 0.0f },
+    { 500000u, PLANT_EV_SPEED,    0.0f,  2.0f, 0.0f },
+    { 520000u, PLANT_EV_SPEED,   30.0f,  1.5f, 0.0f },
+    { 550000u, PLANT_EV_SPEED,    0.0f,  2.0f, 0.0f },
+    { 570000u, PLANT_EV_SPEED,   50.0f,  1.5f, 0.0f },
+    { 620000u, PLANT_EV_GONE,     0.0f,  0.0f, 0.0f },
+};
+
+// Winding highway: following at 90 km/h through left and right 800 m curves,
+// passing a slower car in the right lane; guard rails on both sides
+static const ACC_PlantEvent_t PlantCurve[] = {
+    {     0u, PLANT_EV_APPEAR,  60.0f, 90.0f, 0.0f },
+    {     0u, PLANT_EV_OTHER,  120.0f, 75.0f, -3.5f },
+    {  5000u, PLANT_EV_CURVE,  800.0f,  0.0f, 0.0f },
+    { 20000u, PLANT_EV_CURVE,    0.0f,  0.0f, 0.0f },
+    { 25000u, PLANT_EV_OTHER,  120.0f, 75.0f, -3.5f },
+    { 30000u, PLANT_EV_CURVE, -800.0f,  0.0f, 0.0f },
+    { 45000u, PLANT_EV_CURVE,    0.0f,  0.0f, 0.0f },
+};
+
+// Following at 90 km/h, a car in the right lane merges in 30 m ahead, then
+// leaves again
+static const ACC_PlantEvent_t PlantMerge[] = {
+    {     0u, PLANT_EV_APPEAR,  70.0f, 90.0f, 0.0f },
+    {     0u, PLANT_EV_OTHER,   30.0f, 90.0f, -3.5f },
+    { 15000u, PLANT_EV_MERGE,    1.0f,  0.0f, 0.0f },
+    { 40000u, PLANT_EV_GONE,     0.0f,  0.0f, 0.0f },
+    { 40000u, PLANT_EV_APPEAR, 100.0f, 90.0f, 0.0f },
+};
+
+#define PLANT_EV_QTY(ev)   (uint32_t)(sizeof(ev) / sizeof((ev)[0]))
+
+const ACC_PlantScenario_t PlantScenarios[] = {
+    { "cut-in",       "car cuts in 25 m ahead at 80 km/h",         60000u, 100.0f, PlantCutIn,     PLANT_EV_QTY(PlantCutIn) },
+    { "hard-brake",   "lead brakes 90 -> 20 km/h at 7 m/s^2",       60000u,  90.0f, PlantHardBrake, PLANT_EV_QTY(PlantHardBrake) },
+    { "stop-and-go",  "lead 50 -> 0 -> 50 -> 20 -> 50 km/h",        60000u,  50.0f, PlantStopAndGo, PLANT_EV_QTY(PlantStopAndGo) },
+    { "drive-cycle",  "highway, following, town stops, highway",   900000u, 100.0f, PlantDriveCycle, PLANT_EV_QTY(PlantDriveCycle) },
+    { "curve",        "800 m curves, car in the right lane",        60000u,  90.0f, PlantCurve,     PLANT_EV_QTY(PlantCurve) },
+    { "merge",        "car merges in 30 m ahead at 90 km/h",        60000u,  90.0f, PlantMerge,     PLANT_EV_QTY(PlantMerge) },
+};
+const uint32_t PlantScenarioQty = sizeof(PlantScenarios) / sizeof(PlantScenarios[0]);
+
+static float Plant_Clamp(float v, float lo, float hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+static void Plant_Event(ACC_Plant_t *p_plant, const ACC_PlantEvent_t *p_ev)
+{
+    switch (p_ev->type)
+    {
+        case PLANT_EV_APPEAR:
+            p_plant->lead = true;
+            p_plant->gap = p_ev->a;
+            p_plant->lead_v = KMH(p_ev->b);
+            p_plant->lead_v_target = p_plant->lead_v;
+            p_plant->lead_rate = 0.0f;
+            break;
+        case PLANT_EV_SPEED:
+            p_plant->lead_v_target = KMH(p_ev->a);
+            p_plant->lead_rate = p_ev->b;
+            break;
+        case PLANT_EV_CURVE:
+            p_plant->curv = (p_ev->a != 0.0f) ? 1.0f / p_ev->a : 0.0f;
+            break;
+        case PLANT_EV_OTHER:
+            p_plant->other = p_ev->a > 0.0f;
+            p_plant->other_gap = p_ev->a;
+            p_plant->other_v = KMH(p_ev->b);
+            p_plant->other_lat = p_ev->c;
+            p_plant->other_lat_v = 0.0f;
+            break;
+        case PLANT_EV_MERGE:
+            p_plant->other_lat_v = p_ev->a;
+            break;
+        default:
+            p_plant->lead = false;
+            break;
+    }
+}
+
+void Plant_Init(ACC_Plant_t *p_plant, const ACC_PlantScenario_t *p_scn)
+{
+    memset(p_plant, 0, sizeof(*p_plant));
+    p_plant->scn = p_scn;
+    p_plant->v = KMH(p_scn->ego_kmh);
+    p_plant->stats.gap_min = PLANT_SENSOR_RANGE_M;
+    p_plant->stats.headway_min = 1e9f;
+}
+
+void Plant_Step(ACC_Plant_t *p_plant, uint32_t dt_ms)
+{
+    const ACC_PlantScenario_t *p_scn = p_plant->scn;
+    ACC_PlantStats_t *p_st = &p_plant->stats;
+    const float dt = (float)dt_ms / 1000.0f;
+    uint64_t cycle = p_plant->t_ms / p_scn->period_ms;
+    uint32_t t_in = (uint32_t)(p_plant->t_ms % p_scn->period_ms);
+    float a_res, jerk;
+
+    // Script events due at this point of the period
+    if (cycle != p_plant->cycle)
+    {
+        p_plant->cycle = cycle;
+        p_plant->ev_next = 0u;
+    }
+    while (p_plant->ev_next < p_scn->ev_qty && p_scn->ev[p_plant->ev_next].t_ms <= t_in)
+    {
+        Plant_Event(p_plant, &p_scn->ev[p_plant->ev_next++]);
+    }
+
+    // Ego: lagged tracking of the request, resistance, no reversing
+    jerk = fabsf(p_plant->a_req - p_plant->a) / (PLANT_LAG_S + dt);
+    if (jerk > p_st->jerk_max)
+    {
+        p_st->jerk_max = jerk;
+    }
+    p_plant->a += (p_plant->a_req - p_plant->a) * dt / (PLANT_LAG_S + dt);
+    a_res = (p_plant->v > 0.0f) ? PLANT_ROLL + PLANT_DRAG * p_plant->v * p_plant->v : 0.0f;
+    p_plant->v += (p_plant->a - a_res) * dt;
+    if (p_plant->v < 0.0f)
+    {
+        p_plant->v = 0.0f;
+    }
+    p_plant->stats.distance += (double)(p_plant->v * dt);
+
+    // Other vehicle: constant speed; merging, it replaces the lead (hidden
+    // behind it) once in the lane
+    if (p_plant->other)
+    {
+        float step = p_plant->other_lat_v * dt;
+
+        p_plant->other_gap += (p_plant->other_v - p_plant->v) * dt;
+        p_plant->other_lat += Plant_Clamp(-p_plant->other_lat, -step, step);
+        if (p_plant->other_lat < PLANT_IN_LANE_M && p_plant->other_lat > -PLANT_IN_LANE_M)
+        {
+            p_plant->other = false;
+            p_plant->lead = true;
+            p_plant->gap = p_plant->other_gap;
+            p_plant->lead_v = p_plant->other_v;
+            p_plant->lead_v_target = p_plant->lead_v;
+            p_plant->lead_rate = 0.0f;
+        }
+    }
+
+    // Lead: constant-rate speed change towards its target
+    if (p_plant->lead)
+    {
+        float dv = p_plant->lead_v_target - p_plant->lead_v;
+        float step = p_plant->lead_rate * dt;
+
+        p_plant->lead_v += Plant_Clamp(dv, -step, step);
+        p_plant->gap += (p_plant->lead_v - p_plant->v) * dt;
+        if (p_plant->gap <= 0.0f)
+        {
+            p_st->collisions++;
+            p_plant->lead = false;      // Scenario continues at the next appearance
+            p_plant->gap = 0.0f;
+        }
+        if (p_plant->gap < p_st->gap_min)
+        {
+            p_st->gap_min = p_plant->gap;
+        }
+        if (p_plant->v > 5.0f && p_plant->gap / p_plant->v < p_st->headway_min)
+        {
+            p_st->headway_min = p_plant->gap / p_plant->v;
+        }
+        if (p_plant->gap < 2.0f * p_plant->gap_ref)
+        {
+            float err = p_plant->gap - p_plant->gap_ref;
+
+            p_st->follow_s += (double)dt;
+            p_st->gap_err2 += (double)(err * err * dt);
+        }
+    }
+    if (-p_plant->a > p_st->decel_max)
+    {
+        p_st->decel_max = -p_plant->a;
+    }
+    if (p_plant->a > p_st->accel_max)
+    {
+        p_st->accel_max = p_plant->a;
+    }
+    if (p_plant->v * 3.6f > p_st->speed_max)
+    {
+        p_st->speed_max = p_plant->v * 3.6f;
+    }
+    p_plant->t_ms += dt_ms;
+}
+
+void Plant_Request(ACC_Plant_t *p_plant, float dM)
+{
+    p_plant->a_req = Plant_Clamp(dM * PLANT_ACCEL_PER_DM, -PLANT_DECEL_MAX, PLANT_ACCEL_MAX);
+}
+
+float Plant_Distance(const ACC_Plant_t *p_plant)
+{
+    float gap = p_plant->lead ? p_plant->gap : PLANT_SENSOR_RANGE_M;
+
+    return Plant_Clamp(gap, 0.0f, PLANT_SENSOR_RANGE_M);
+}
+
+float Plant_Speed(const ACC_Plant_t *p_plant)
+{
+    return p_plant->v * 3.6f;
+}
@@ -0,0 +1,95 @@
+#ifndef ACC_PLANT_H
+#define ACC_PLANT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Longitudinal vehicle model for the virtual-time simulation (acc_sim)
+//
+// Ego vehicle: dM(n) is an acceleration request (PLANT_ACCEL_PER_DM per
+// unit), limited to the traction/brake envelope and tracked by the powertrain
+// with a first-order lag; rolling resistance and aerodynamic drag act on top.
+// Lead vehicle: driven by a scripted scenario (appear at a gap / change speed
+// at a given rate / leave the lane), repeated every scenario period.
+// The distance sensor reports the bumper-to-bumper gap, or its range when no
+// vehicle is ahead.
+// Road and traffic for the multi-target radar (ACC_RADAR_EN): the road ahead
+// has the curvature of the current segment, and one other vehicle drives at
+// a lateral offset from the own lane centre (left +). A merging vehicle
+// becomes the lead once its offset is within PLANT_IN_LANE_M; the single
+// distance sensor only ever sees the lead.
+
+#define PLANT_ACCEL_PER_DM     (2.0f / 3.6f)   // m/s² per unit of dM (2 km/h per second)
+#define PLANT_ACCEL_MAX        2.5f            // m/s², traction limit
+#define PLANT_DECEL_MAX        8.0f            // m/s², brake limit
+#define PLANT_LAG_S            0.3f            // Powertrain/brake time constant
+#define PLANT_ROLL             0.1f            // m/s², rolling resistance
+#define PLANT_DRAG             0.0004f         // 1/m, aerodynamic drag coefficient (a = k v²)
+#define PLANT_SENSOR_RANGE_M   200.0f
+#define PLANT_IN_LANE_M        1.6f            // Vehicle centre this close to the lane centre: in the lane
+
+typedef enum {
+    PLANT_EV_APPEAR = 0,    // Lead appears at gap a (m) driving b (km/h): cut-in / new lead
+    PLANT_EV_SPEED,         // Lead changes speed to a (km/h) at b (m/s²)
+    PLANT_EV_GONE,          // Lead leaves the lane
+    PLANT_EV_CURVE,         // Road radius a (m, left +), 0: straight
+    PLANT_EV_OTHER,         // Other vehicle at gap a (m) driving b (km/h), offset c (m); a 0: none
+    PLANT_EV_MERGE          // Other vehicle moves towards the own lane at a (m/s)
+} ACC_PlantEvType_t;
+
+typedef struct {
+    uint32_t          t_ms;     // Offset into the scenario period
+    ACC_PlantEvType_t type;
+    float             a, b, c;
+} ACC_PlantEvent_t;
+
+typedef struct {
+    const char             *name;
+    const char             *desc;
+    uint32_t                period_ms;     // Script repeats with this period
+    float                   ego_kmh;       // Ego speed at the start
+    const ACC_PlantEvent_t *ev;            // Ordered by t_ms
+    uint32_t                ev_qty;
+} ACC_PlantScenario_t;
+
+typedef struct {
+    uint32_t collisions;
+    float    gap_min;           // m, while a lead is present
+    float    headway_min;       // s, gap / ego speed above 5 m/s
+    float    decel_max;         // m/s², ego
+    float    accel_max;         // m/s², ego
+    float    jerk_max;          // m/s³, ego
+    double   follow_s;          // Time following (lead within 2 × gap_ref)
+    double   gap_err2;          // ∫ (gap - gap_ref)² dt while following (m² s)
+    float    speed_max;         // km/h, ego
+    double   distance;          // m driven
+} ACC_PlantStats_t;
+
+typedef struct {
+    const ACC_PlantScenario_t *scn;
+    uint64_t t_ms;              // Simulated time
+    uint64_t cycle;             // Script repetitions started
+    uint32_t ev_next;           // Next script event in the current repetition
+    float    v, a;              // Ego speed (m/s), acceleration (m/s²)
+    float    a_req;             // Requested acceleration (m/s²), held between frames
+    float    gap_ref;           // Gap the controller keeps (m, Xset), for the tracking error
+    bool     lead;              // A vehicle is ahead
+    float    gap, lead_v;       // Bumper-to-bumper gap (m), lead speed (m/s)
+    float    lead_v_target, lead_rate;
+    float    curv;              // Road curvature (1/m, left +)
+    bool     other;             // Other vehicle present
+    float    other_gap, other_v;    // Gap (m), speed (m/s)
+    float    other_lat, other_lat_v;    // Offset (m, left +), merge speed (m/s)
+    ACC_PlantStats_t stats;
+} ACC_Plant_t;
+
+extern const ACC_PlantScenario_t PlantScenarios[];
+extern const uint32_t PlantScenarioQty;
+
+void  Plant_Init(ACC_Plant_t *p_plant, const ACC_PlantScenario_t *p_scn);
+void  Plant_Step(ACC_Plant_t *p_plant, uint32_t dt_ms);
+void  Plant_Request(ACC_Plant_t *p_plant, float dM);
+float Plant_Distance(const ACC_Plant_t *p_plant);      // Sensor reading (m)
+float Plant_Speed(const ACC_Plant_t *p_plant);         // Sensor reading (km/h)
+
+#endif // ACC_PLANT_H
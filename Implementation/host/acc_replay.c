@@ -0,0 +1,385 @@
+#include "acc_replay.h"
+#include "acc_log.h"
+#include "acc_types.h"
+#include "acc_config.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+// Drive replay
+// Maps a drive log recorded by the HAL (ACC_RECORD_EN, or acc_host with
+// ACC_HOST_RECORD), engages ACC and pushes every logged sample through the
+// real task set: IRQ_sensors_ISR() → Sensors_Task → Control_Task →
+// Actuator_Task. The next frame is released as soon as the previous one has
+// been applied, so the replay runs as fast as the pipeline allows instead of
+// at T_ISR; every applied dM is checked against the recorded one.
+//
+// A log recorded by a build with the same arithmetic (ACC_FIXED_POINT) must
+// replay bit-exact. A log from the other arithmetic is converted on load and
+// compared within ACC_REPLAY_TOL.
+//
+// Environment:
+//   ACC_REPLAY_LOG       drive log to replay
+//   ACC_REPLAY_GEN       no log: synthesise this many frames of an open-loop
+//                        drive instead (nothing to compare; pair with ACC_REPLAY_OUT)
+//   ACC_REPLAY_OUT       write the replayed drive (this build's dM) as a new log,
+//                        e.g. the reference for the next replay after an intended change
+//   ACC_REPLAY_SPEEDUP   pace frames at this multiple of real time (default 0:
+//                        as fast as possible)
+//   ACC_REPLAY_TOL       |dM| difference accepted (default 0: bit-exact; 5e-3 when
+//                        the log uses the other arithmetic)
+//
+// Exit status: 0 every output matches, 1 mismatch or stalled pipeline, 2 input error.
+
+void IRQ_sensors_ISR(void);
+
+#define REPLAY_FMT              (ACC_FIXED_POINT ? ACC_LOG_FMT_Q16_16 : ACC_LOG_FMT_FLOAT)
+#define REPLAY_TOL_CROSS        5e-3
+#define REPLAY_STALL_MS         1000u   // No output for a released frame within this time: stalled
+#define REPLAY_POLL_US          100u
+
+static sem_t ReplayDone;                // Posted by Replay_Output()
+static volatile ACC_Value_t ReplayDM;
+
+static ACC_Log_t ReplayOut;             // ACC_REPLAY_OUT image
+static int ReplayOutFd = -1;
+
+void Replay_Output(ACC_Value_t dM)
+{
+    // Actuator_Task context; acc_replay.c waits for this frame before the next
+    ReplayDM = dM;
+    sem_post(&ReplayDone);
+}
+
+static double Replay_Float(uint32_t fmt, ACC_Value_t raw)
+{
+    float f;
+    acc_q_t q;
+
+    if (fmt == ACC_LOG_FMT_FLOAT)
+    {
+        memcpy(&f, &raw, sizeof(f));
+        return f;
+    }
+    memcpy(&q, &raw, sizeof(q));
+    return Q_ToFloat(q);
+}
+
+// Logged value in this build's arithmetic
+static ACC_Value_t Replay_Value(uint32_t fmt, ACC_Value_t raw)
+{
+    if (fmt == REPLAY_FMT)
+    {
+        return raw;
+    }
+    return ACC_VALUE_FROM_FLOAT((float)Replay_Float(fmt, raw));
+}
+
+static double Replay_EnvDouble(const char *name, double dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL) ? atof(env) : dflt;
+}
+
+static const ACC_LogHdr_t *Replay_Map(const char *path)
+{
+    const ACC_LogHdr_t *p_hdr;
+    struct stat st;
+    void *p_mem;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        perror(path);
+        exit(2);
+    }
+    p_mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    p_hdr = (p_mem == MAP_FAILED) ? NULL : Log_Open(p_mem, (uint64_t)st.st_size);
+    if (p_hdr == NULL)
+    {
+        fprintf(stderr, "acc_replay: %s is not a drive log (version %u)\n", path, (unsigned)ACC_LOG_VERSION);
+        exit(2);
+    }
+    return p_hdr;
+}
+
+// Open-loop synthetic drive: ego speed and gap wander through slow cycles
+// with deterministic sensor noise; the lead vehicle brakes hard every 90 s
+static const ACC_LogHdr_t *Replay_Generate(uint32_t frames)
+{
+    const double two_pi = 6.283185307179586;
+    uint32_t bytes = Log_Bytes(frames);
+    ACC_Log_t log;
+    uint32_t seed = 12345u;
+    uint32_t i;
+    void *p_mem = malloc(bytes);
+
+    if (p_mem == NULL || !Log_Init(&log, p_mem, bytes))
+    {
+        fprintf(stderr, "acc_replay: cannot allocate %u frames\n", (unsigned)frames);
+        exit(2);
+    }
+    Log_Engage(&log);
+    for (i = 0u; i < frames; i++)
+    {
+        double t = (double)i * TIMER_PERIOD_MS / 1000.0;
+        double v = 90.0 + 15.0 * sin(two_pi * t / 600.0) + 4.0 * sin(two_pi * t / 37.0);
+        double x = 45.0 + 25.0 * sin(two_pi * t / 173.0);
+        double brake = fmod(t, 90.0);
+
+        if (brake < 6.0)
+        {
+            x -= 4.0 * brake;       // Lead brakes: gap closes ...
+        }
+        else if (brake < 12.0)
+        {
+            x -= 4.0 * (12.0 - brake);  // ... and reopens
+        }
+        seed = seed * 1664525u + 1013904223u;
+        x += ((double)(seed >> 16) / 65536.0 - 0.5) * 0.4;
+        seed = seed * 1664525u + 1013904223u;
+        v += ((double)(seed >> 16) / 65536.0 - 0.5) * 0.2;
+        Log_Sample(&log, i * TIMER_PERIOD_MS, ACC_VALUE_FROM_FLOAT((float)x), ACC_VALUE_FROM_FLOAT((float)v));
+    }
+    Log_Flush(&log);
+    return log.hdr;
+}
+
+static void Replay_OutOpen(const char *path, uint32_t frames)
+{
+    uint32_t bytes = Log_Bytes(frames);
+    void *p_mem;
+
+    ReplayOutFd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (ReplayOutFd < 0 || ftruncate(ReplayOutFd, bytes) != 0)
+    {
+        perror(path);
+        exit(2);
+    }
+    p_mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, ReplayOutFd, 0);
+    if (p_mem == MAP_FAILED)
+    {
+        perror(path);
+        exit(2);
+    }
+    (void)Log_Init(&ReplayOut, p_mem, bytes);
+}
+
+static bool Replay_WaitTimer(bool enabled)
+{
+    uint32_t waited_us = 0u;
+
+    while (ReplayTimerEnabled != enabled)
+    {
+        if (waited_us >= REPLAY_STALL_MS * 1000u)
+        {
+            return false;
+        }
+        usleep(REPLAY_POLL_US);
+        waited_us += REPLAY_POLL_US;
+    }
+    return true;
+}
+
+// Simulated driver switch (interrupt context), as in acc_host.c
+static bool Replay_Engage(bool engage)
+{
+    OS_ERR err;
+
+    OSIntEnter();
+    if (engage)
+    {
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG), OS_OPT_POST_FLAG_SET, &err);
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)ACC_OFF_FLAG, OS_OPT_POST_FLAG_CLR, &err);
+    }
+    else
+    {
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)ACC_OFF_FLAG, OS_OPT_POST_FLAG_SET, &err);
+    }
+    OSIntExit();
+    return Replay_WaitTimer(engage);
+}
+
+static bool Replay_WaitOutput(void)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += REPLAY_STALL_MS / 1000u;
+    while (sem_timedwait(&ReplayDone, &deadline) != 0)
+    {
+        if (errno != EINTR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void App_OS_HostMain(void)
+{
+    const char *path = getenv("ACC_REPLAY_LOG");
+    const char *gen = getenv("ACC_REPLAY_GEN");
+    const char *out = getenv("ACC_REPLAY_OUT");
+    const ACC_LogHdr_t *p_hdr;
+    const ACC_LogRec_t *p_rec;
+    double speedup = Replay_EnvDouble("ACC_REPLAY_SPEEDUP", 0.0);
+    double tol;
+    double diff_max = 0.0;
+    uint64_t drive_ms = 0u;         // Drive time of the frames released so far
+    uint64_t segment_ms = 0u;       // Drive time at the start of the current engagement
+    uint32_t compared = 0u, mismatches = 0u, first_bad = 0u;
+    uint32_t i;
+    CPU_TS64 t0, wall;
+    int status = 0;
+
+    if (path != NULL)
+    {
+        p_hdr = Replay_Map(path);
+    }
+    else if (gen != NULL && atoi(gen) > 0)
+    {
+        p_hdr = Replay_Generate((uint32_t)atoi(gen));
+        path = "(synthetic)";
+    }
+    else
+    {
+        fprintf(stderr, "acc_replay: set ACC_REPLAY_LOG=<drive log> or ACC_REPLAY_GEN=<frames>\n");
+        exit(2);
+    }
+    p_rec = Log_Records(p_hdr);
+    tol = Replay_EnvDouble("ACC_REPLAY_TOL", (p_hdr->value_format == REPLAY_FMT) ? 0.0 : REPLAY_TOL_CROSS);
+    if (p_hdr->period_ms != TIMER_PERIOD_MS)
+    {
+        printf("acc_replay: note: log recorded at T_ISR = %u ms, this build runs %u ms\n",
+               (unsigned)p_hdr->period_ms, (unsigned)TIMER_PERIOD_MS);
+    }
+    if (out != NULL)
+    {
+        Replay_OutOpen(out, p_hdr->count);
+    }
+    sem_init(&ReplayDone, 0, 0u);
+
+    // Let Setup_Task initialise before the driver engages ACC
+    usleep(50000u);
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < p_hdr->count; i++)
+    {
+        const ACC_LogRec_t *p = &p_rec[i];
+        ACC_Value_t Xn = Replay_Value(p_hdr->value_format, p->Xn);
+        ACC_Value_t Vn = Replay_Value(p_hdr->value_format, p->Vn);
+
+        if (i == 0u || (p->flags & ACC_LOG_F_ENGAGE) != 0u)
+        {
+            if ((i != 0u && !Replay_Engage(false)) || !Replay_Engage(true))
+            {
+                printf("acc_replay: ACC did not %s at frame %u\n", (i != 0u) ? "re-engage" : "engage", (unsigned)i);
+                status = 1;
+                break;
+            }
+            segment_ms = drive_ms;
+            if (out != NULL)
+            {
+                Log_Engage(&ReplayOut);
+            }
+        }
+        else if (!ReplayTimerEnabled)
+        {
+            printf("acc_replay: ACC disengaged itself before frame %u (deadline miss or fault)\n", (unsigned)i);
+            status = 1;
+            break;
+        }
+        drive_ms = segment_ms + p->t_ms;
+
+        if (speedup > 0.0)
+        {
+            CPU_TS64 due = t0 + (CPU_TS64)((double)drive_ms * 1e6 / speedup);
+            CPU_TS64 now = CPU_TS_Get64();
+
+            if (due > now)
+            {
+                usleep((useconds_t)((due - now) / 1000u));
+            }
+        }
+
+        // Release the frame
+        ReplayXn = Xn;
+        ReplayVn = Vn;
+        if (out != NULL)
+        {
+            Log_Sample(&ReplayOut, p->t_ms, Xn, Vn);
+        }
+        IRQ_sensors_ISR();
+        if (!Replay_WaitOutput())
+        {
+            printf("acc_replay: frame %u (t = %u ms) produced no output\n", (unsigned)i, (unsigned)p->t_ms);
+            status = 1;
+            break;
+        }
+        if (out != NULL)
+        {
+            Log_Output(&ReplayOut, ReplayDM);
+        }
+
+        if ((p->flags & ACC_LOG_F_ACTUATED) != 0u)
+        {
+            ACC_Value_t dM = ReplayDM;
+            double d = fabs(Replay_Float(REPLAY_FMT, dM) - Replay_Float(p_hdr->value_format, p->dM));
+            bool match = (tol > 0.0) ? (d <= tol)
+                                     : (p_hdr->value_format == REPLAY_FMT && memcmp(&dM, &p->dM, sizeof(dM)) == 0);
+
+            compared++;
+            if (d > diff_max)
+            {
+                diff_max = d;
+            }
+            if (!match && mismatches++ == 0u)
+            {
+                first_bad = i;
+            }
+        }
+    }
+    wall = CPU_TS_Get64() - t0;
+
+    printf("ACC drive replay: %s (%s, T_ISR = %u ms)\n", path,
+           (p_hdr->value_format == ACC_LOG_FMT_Q16_16) ? "Q16.16" : "float", (unsigned)p_hdr->period_ms);
+    printf("  frames replayed %u of %u, outputs compared %u, mismatches %u (tolerance %g, max |diff| %g)\n",
+           (unsigned)i, (unsigned)p_hdr->count, (unsigned)compared, (unsigned)mismatches, tol, diff_max);
+    if (mismatches != 0u)
+    {
+        const ACC_LogRec_t *p = &p_rec[first_bad];
+
+        printf("  first mismatch: frame %u, t = %u ms, Xn %.3f Vn %.3f, recorded dM %.6f\n",
+               (unsigned)first_bad, (unsigned)p->t_ms,
+               Replay_Float(p_hdr->value_format, p->Xn), Replay_Float(p_hdr->value_format, p->Vn),
+               Replay_Float(p_hdr->value_format, p->dM));
+        status = 1;
+    }
+    printf("  drive time %.1f s replayed in %.3f s wall = %.0fx real time (%.2f us per frame)\n",
+           (double)drive_ms / 1000.0, (double)wall / 1e9,
+           (wall > 0u) ? (double)drive_ms * 1e6 / (double)wall : 0.0,
+           (i > 0u) ? (double)wall / 1000.0 / i : 0.0);
+    if (out != NULL)
+    {
+        uint32_t count = ReplayOut.hdr->count;
+
+        munmap(ReplayOut.hdr, Log_Bytes(p_hdr->count));
+        if (ftruncate(ReplayOutFd, Log_Bytes(count)) != 0)
+        {
+            perror(out);
+        }
+        close(ReplayOutFd);
+        printf("  replayed drive written to %s (%u frames)\n", out, (unsigned)count);
+    }
+    exit(status);
+}
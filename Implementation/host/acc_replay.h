@@ -0,0 +1,17 @@
+#ifndef ACC_REPLAY_H
+#define ACC_REPLAY_H
+
+#include "acc_fixed.h"
+#include <stdbool.h>
+
+// Drive replay: acc_hardware_replay.c stands in for the HAL and feeds the
+// logged sensor samples to Sensors_Task; acc_replay.c releases the frames
+// and checks every applied output against the recording.
+
+extern volatile ACC_Value_t ReplayXn;       // Sample of the frame being released
+extern volatile ACC_Value_t ReplayVn;
+extern volatile bool ReplayTimerEnabled;    // Setup_Task enabled the frame timer (ACC engaged)
+
+void Replay_Output(ACC_Value_t dM);        // Actuator output of the current frame
+
+#endif // ACC_REPLAY_H
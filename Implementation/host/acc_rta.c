@@ -0,0 +1,1590 @@
+#include <ctype.h>
+#include <dirent.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Offline Response-Time Analysis (host tool)
+//
+// Builds the task model from the sources instead of the README:
+//   - acc_config.h / os_cfg.h: every #define (conditionals honoured), so
+//     priorities, periods and derived timeouts are evaluated as compiled;
+//   - main.c: the OSTaskCreate() table (name, entry, priority);
+//   - the task bodies (*.c next to main.c): how each job is released
+//     (OSSemPend on an ISR-posted semaphore, OSTaskSemPend posted by another
+//     task, OSTimeDly/OSTimeDlyHMSM, OSFlagPend), its pend timeout, whether it
+//     completes a frame for the deadline monitor (Deadline_Complete) and
+//     whether it runs non-preemptive sections
+//     (seqlock writer under OSSchedLock, OSMutexPend).
+// Execution times come from a file written by acc_host (ACC_HOST_WCET):
+//
+//   task <name> exec <ns> response <ns> blocking <ns>
+//   param_write <ns>          longest Parameter Memory Block write section
+//   isr exec <ns> jitter <ns> IRQ_sensors_ISR cost and release jitter
+//   tick exec <ns>            tick interrupt cost
+//
+// For every task with a period, fixed-priority response-time analysis with
+// release jitter (holistic: a task posted by another inherits the poster's
+// worst completion as jitter), blocking and interrupt overhead:
+//
+//   R = C + B + Σ_hp ⌈(R + Jj)/Tj⌉·Cj + ⌈R/Ttick⌉·Ctick + ⌈(R + Jisr)/Tisr⌉·Cisr
+//
+// except that a higher-priority task upstream in the same ISR chain has
+// finished its job of the frame before it posts, so only its releases one
+// or more periods later interfere: ⌊(J + R)/T⌋·Cj.
+//
+// B is the longer of the measured blocking and the longest non-preemptive
+// section of any lower-priority task (Setup_Task locks the scheduler for its
+// configuration block write, a few stores like the traced block writes, so
+// the longest of those is the section length). Tasks in the ISR chain must
+// complete within one TIMER_PERIOD_MS of the ISR, the task that completes the
+// frame within FRAME_DEADLINE_MS of it, and a pend timeout must not fire
+// before the next release.
+// The same analysis is then repeated with TIMER_PERIOD_MS overridden (all
+// macros derived from it follow) to find the shortest safe period.
+//
+// Usage: acc_rta [-m measured.txt] [-s srcdir] [-c acc_config.h] [-o os_cfg.h]
+//                [-k factor] [-w Task=us] [-D NAME=value]
+//   -k  multiplies every measured execution time (margin over measured maxima)
+//   -w  execution time for a task without measurements (e.g. Display)
+//   -D  overrides a macro (e.g. -D TIMER_PERIOD_MS=50)
+// Exit status: 0 schedulable as configured, 1 not schedulable, 2 input error.
+
+#define RTA_MACRO_MAX      512
+#define RTA_TASK_MAX       16
+#define RTA_SRC_MAX        32
+#define RTA_NAME_LEN       64
+#define RTA_EXPR_LEN       256
+#define RTA_HOLISTIC_ITER  32
+#define RTA_NS_PER_MS      1000000ll
+#define RTA_CALL_DEPTH     2           // Helper levels searched below a task body
+
+typedef struct {
+    char name[RTA_NAME_LEN];
+    char param[RTA_NAME_LEN];       // Function-like macro parameter ("" if none)
+    char body[RTA_EXPR_LEN];
+    bool function;
+} Rta_Macro_t;
+
+typedef enum {
+    RTA_REL_NONE = 0,               // No recognised blocking call
+    RTA_REL_ISR,                    // Semaphore posted by an ISR (TIMER_PERIOD_MS)
+    RTA_REL_TASK,                   // Task semaphore posted by another task
+    RTA_REL_PERIODIC,               // OSTimeDly / OSTimeDlyHMSM
+    RTA_REL_EVENT                   // Event flags (sporadic, no minimum inter-arrival)
+} Rta_Release_t;
+
+typedef struct {
+    char          name[RTA_NAME_LEN];
+    char          fn[RTA_NAME_LEN];
+    char          tcb[RTA_NAME_LEN];
+    int64_t       prio;
+    Rta_Release_t release;
+    int           pred;                         // RTA_REL_TASK: releasing task
+    char          period_expr[RTA_EXPR_LEN];    // RTA_REL_PERIODIC, in ticks
+    char          timeout_expr[RTA_EXPR_LEN];   // Pend timeout in ticks ("" or 0: none)
+    bool          completes;                    // Completes the frame (Deadline_Complete)
+    bool          section;                      // Has non-preemptive sections
+    bool          measured;
+    int64_t       C, B_meas;                    // ns
+
+    // Results of the last Rta_Analyse()
+    int64_t       T, J, R, W, D;
+    bool          ok, diverged;
+} Rta_Task_t;
+
+typedef struct {
+    int64_t isr_C, isr_J, tick_C, section;      // ns
+} Rta_Overhead_t;
+
+static Rta_Macro_t RtaMacros[RTA_MACRO_MAX];
+static int         RtaMacroQty;
+static Rta_Macro_t RtaUser[RTA_MACRO_MAX];     // -D on the command line
+static int         RtaUserQty;
+static Rta_Macro_t RtaSweep[1];                 // TIMER_PERIOD_MS under analysis
+static int         RtaSweepQty;
+static char       *RtaSrc[RTA_SRC_MAX];         // Preprocessed task sources
+static int         RtaSrcQty;
+static Rta_Task_t  RtaTasks[RTA_TASK_MAX];
+static int         RtaTaskQty;
+static Rta_Overhead_t RtaOvh;
+static bool        RtaEvalError;
+
+// ---------------------------------------------------------------------------
+// Source loading: comment stripping and a minimal preprocessor
+// ---------------------------------------------------------------------------
+
+static char *Rta_ReadFile(const char *path)
+{
+    FILE *fp = fopen(path, "rb");
+    char *buf;
+    long n;
+
+    if (fp == NULL)
+    {
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    n = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buf = malloc((size_t)n + 1u);
+    if (buf == NULL || fread(buf, 1u, (size_t)n, fp) != (size_t)n)
+    {
+        fclose(fp);
+        free(buf);
+        return NULL;
+    }
+    buf[n] = '\0';
+    fclose(fp);
+    return buf;
+}
+
+// Removes comments (keeping newlines) and joins continuation lines, in place
+static void Rta_StripComments(char *s)
+{
+    char *w = s;
+    char quote = 0;
+
+    while (*s != '\0')
+    {
+        if (quote != 0)
+        {
+            if (*s == '\\' && s[1] != '\0')
+            {
+                *w++ = *s++;
+            }
+            else if (*s == quote)
+            {
+                quote = 0;
+            }
+            *w++ = *s++;
+        }
+        else if (s[0] == '/' && s[1] == '/')
+        {
+            while (*s != '\0' && *s != '\n')
+            {
+                s++;
+            }
+        }
+        else if (s[0] == '/' && s[1] == '*')
+        {
+            s += 2;
+            while (*s != '\0' && !(s[0] == '*' && s[1] == '/'))
+            {
+                if (*s == '\n')
+                {
+                    *w++ = '\n';
+                }
+                s++;
+            }
+            if (*s != '\0')
+            {
+                s += 2;
+            }
+            *w++ = ' ';
+        }
+        else if (s[0] == '\\' && s[1] == '\n')
+        {
+            s += 2;
+        }
+        else
+        {
+            if (*s == '"' || *s == '\'')
+            {
+                quote = *s;
+            }
+            *w++ = *s++;
+        }
+    }
+    *w = '\0';
+}
+
+static Rta_Macro_t *Rta_FindIn(Rta_Macro_t *p_tbl, int qty, const char *name, size_t len)
+{
+    int i;
+
+    for (i = 0; i < qty; i++)
+    {
+        if (strlen(p_tbl[i].name) == len && strncmp(p_tbl[i].name, name, len) == 0)
+        {
+            return &p_tbl[i];
+        }
+    }
+    return NULL;
+}
+
+// Sweep value first, then -D, then the sources
+static Rta_Macro_t *Rta_Find(const char *name, size_t len)
+{
+    Rta_Macro_t *p_m = Rta_FindIn(RtaSweep, RtaSweepQty, name, len);
+
+    if (p_m == NULL)
+    {
+        p_m = Rta_FindIn(RtaUser, RtaUserQty, name, len);
+    }
+    return (p_m != NULL) ? p_m : Rta_FindIn(RtaMacros, RtaMacroQty, name, len);
+}
+
+static void Rta_Trim(char *s)
+{
+    size_t n = strlen(s);
+    char *p = s;
+
+    while (n > 0u && isspace((unsigned char)s[n - 1u]))
+    {
+        s[--n] = '\0';
+    }
+    while (isspace((unsigned char)*p))
+    {
+        p++;
+    }
+    memmove(s, p, strlen(p) + 1u);
+}
+
+// "NAME body" or "NAME(p) body" → table entry
+static void Rta_Define(Rta_Macro_t *p_tbl, int *p_qty, int max, const char *def)
+{
+    Rta_Macro_t m;
+    Rta_Macro_t *p_old;
+    const char *p = def;
+    size_t n = 0u;
+
+    memset(&m, 0, sizeof(m));
+    while (isspace((unsigned char)*p))
+    {
+        p++;
+    }
+    while ((isalnum((unsigned char)*p) || *p == '_') && n < RTA_NAME_LEN - 1u)
+    {
+        m.name[n++] = *p++;
+    }
+    if (n == 0u)
+    {
+        return;
+    }
+    if (*p == '(')
+    {
+        const char *close = strchr(p, ')');
+
+        if (close == NULL || (size_t)(close - p - 1) >= RTA_NAME_LEN)
+        {
+            return;
+        }
+        m.function = true;
+        memcpy(m.param, p + 1, (size_t)(close - p - 1));
+        Rta_Trim(m.param);
+        p = close + 1;
+    }
+    strncpy(m.body, p, RTA_EXPR_LEN - 1u);
+    Rta_Trim(m.body);
+
+    p_old = Rta_FindIn(p_tbl, *p_qty, m.name, strlen(m.name));
+    if (p_old != NULL)
+    {
+        *p_old = m;
+    }
+    else if (*p_qty < max)
+    {
+        p_tbl[(*p_qty)++] = m;
+    }
+}
+
+static int64_t Rta_Eval(const char *expr);
+
+// Runs #define/#undef/#if/#ifdef/#ifndef/#elif/#else/#endif over the text;
+// inactive lines and directives are blanked so offsets stay meaningful
+static void Rta_Preprocess(char *text)
+{
+    bool active[32] = { true };
+    bool taken[32] = { true };
+    int depth = 0;
+    char *line = text;
+
+    while (*line != '\0')
+    {
+        char *end = strchr(line, '\n');
+        char *p = line;
+        size_t len = (end != NULL) ? (size_t)(end - line) : strlen(line);
+        char dir[RTA_EXPR_LEN];
+
+        while (p < line + len && isspace((unsigned char)*p))
+        {
+            p++;
+        }
+        if (p < line + len && *p == '#')
+        {
+            size_t n = (size_t)(line + len - p - 1);
+            char *arg;
+
+            if (n >= sizeof(dir))
+            {
+                n = sizeof(dir) - 1u;
+            }
+            memcpy(dir, p + 1, n);
+            dir[n] = '\0';
+            Rta_Trim(dir);
+            arg = dir;
+            while (isalpha((unsigned char)*arg))
+            {
+                arg++;
+            }
+
+            if (strncmp(dir, "ifdef", 5) == 0 || strncmp(dir, "ifndef", 6) == 0)
+            {
+                bool def;
+
+                Rta_Trim(arg);
+                def = Rta_Find(arg, strlen(arg)) != NULL;
+                depth++;
+                taken[depth] = (dir[2] == 'd') ? def : !def;
+                active[depth] = active[depth - 1] && taken[depth];
+            }
+            else if (strncmp(dir, "if", 2) == 0 && !isalpha((unsigned char)dir[2]))
+            {
+                depth++;
+                taken[depth] = active[depth - 1] && Rta_Eval(arg) != 0;
+                active[depth] = active[depth - 1] && taken[depth];
+            }
+            else if (strncmp(dir, "elif", 4) == 0 && depth > 0)
+            {
+                bool now = !taken[depth] && active[depth - 1] && Rta_Eval(arg) != 0;
+
+                taken[depth] = taken[depth] || now;
+                active[depth] = now;
+            }
+            else if (strncmp(dir, "else", 4) == 0 && depth > 0)
+            {
+                active[depth] = active[depth - 1] && !taken[depth];
+                taken[depth] = true;
+            }
+            else if (strncmp(dir, "endif", 5) == 0 && depth > 0)
+            {
+                depth--;
+            }
+            else if (active[depth] && strncmp(dir, "define", 6) == 0)
+            {
+                Rta_Define(RtaMacros, &RtaMacroQty, RTA_MACRO_MAX, arg);
+            }
+            else if (active[depth] && strncmp(dir, "undef", 5) == 0)
+            {
+                Rta_Macro_t *p_m;
+
+                Rta_Trim(arg);
+                p_m = Rta_FindIn(RtaMacros, RtaMacroQty, arg, strlen(arg));
+                if (p_m != NULL)
+                {
+                    *p_m = RtaMacros[--RtaMacroQty];
+                }
+            }
+            memset(line, ' ', len);
+        }
+        else if (!active[depth])
+        {
+            memset(line, ' ', len);
+        }
+        line = (end != NULL) ? end + 1 : line + len;
+    }
+}
+
+static char *Rta_Load(const char *path)
+{
+    char *text = Rta_ReadFile(path);
+
+    if (text == NULL)
+    {
+        fprintf(stderr, "acc_rta: cannot read %s\n", path);
+        exit(2);
+    }
+    Rta_StripComments(text);
+    Rta_Preprocess(text);
+    return text;
+}
+
+// ---------------------------------------------------------------------------
+// Integer constant expressions (macros expanded, casts skipped)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const char *p;
+    int depth;
+} Rta_Parser_t;
+
+static int64_t Rta_ParseExpr(Rta_Parser_t *p_ps);
+
+static void Rta_Skip(Rta_Parser_t *p_ps)
+{
+    while (isspace((unsigned char)*p_ps->p))
+    {
+        p_ps->p++;
+    }
+}
+
+static size_t Rta_IdentLen(const char *p)
+{
+    size_t n = 0u;
+
+    if (!isalpha((unsigned char)*p) && *p != '_')
+    {
+        return 0u;
+    }
+    while (isalnum((unsigned char)p[n]) || p[n] == '_')
+    {
+        n++;
+    }
+    return n;
+}
+
+// Copies the balanced-parenthesis argument starting after '(' up to ')'
+static const char *Rta_ParenArg(const char *p, char *out, size_t size)
+{
+    int level = 1;
+    size_t n = 0u;
+
+    while (*p != '\0')
+    {
+        if (*p == '(')
+        {
+            level++;
+        }
+        else if (*p == ')' && --level == 0)
+        {
+            break;
+        }
+        if (n < size - 1u)
+        {
+            out[n++] = *p;
+        }
+        p++;
+    }
+    out[n] = '\0';
+    return (*p == ')') ? p + 1 : p;
+}
+
+// Body with every whole-word occurrence of param replaced by (arg)
+static void Rta_Substitute(const Rta_Macro_t *p_m, const char *arg, char *out, size_t size)
+{
+    const char *p = p_m->body;
+    size_t plen = strlen(p_m->param);
+    size_t n = 0u;
+
+    while (*p != '\0' && n < size - 1u)
+    {
+        size_t id = Rta_IdentLen(p);
+
+        if (id == plen && plen > 0u && strncmp(p, p_m->param, plen) == 0)
+        {
+            n += (size_t)snprintf(out + n, size - n, "(%s)", arg);
+            p += id;
+        }
+        else if (id > 0u)
+        {
+            n += (size_t)snprintf(out + n, size - n, "%.*s", (int)id, p);
+            p += id;
+        }
+        else
+        {
+            out[n++] = *p++;
+        }
+    }
+    out[(n < size) ? n : size - 1u] = '\0';
+}
+
+static int64_t Rta_EvalDepth(const char *expr, int depth)
+{
+    Rta_Parser_t ps = { expr, depth };
+    int64_t v;
+
+    if (depth > 32)
+    {
+        RtaEvalError = true;
+        return 0;
+    }
+    v = Rta_ParseExpr(&ps);
+    Rta_Skip(&ps);
+    if (*ps.p != '\0')
+    {
+        RtaEvalError = true;
+    }
+    return v;
+}
+
+static int64_t Rta_ParsePrimary(Rta_Parser_t *p_ps)
+{
+    size_t id;
+
+    Rta_Skip(p_ps);
+    if (*p_ps->p == '-')
+    {
+        p_ps->p++;
+        return -Rta_ParsePrimary(p_ps);
+    }
+    if (*p_ps->p == '!')
+    {
+        p_ps->p++;
+        return !Rta_ParsePrimary(p_ps);
+    }
+    if (isdigit((unsigned char)*p_ps->p))
+    {
+        char *end;
+        int64_t v = (int64_t)strtoll(p_ps->p, &end, 0);
+
+        p_ps->p = end;
+        while (*p_ps->p == 'u' || *p_ps->p == 'U' || *p_ps->p == 'l' || *p_ps->p == 'L')
+        {
+            p_ps->p++;
+        }
+        return v;
+    }
+    if (*p_ps->p == '(')
+    {
+        const char *q = p_ps->p + 1;
+        int64_t v;
+
+        // (TYPE) cast: a lone identifier that is not a macro
+        while (isspace((unsigned char)*q))
+        {
+            q++;
+        }
+        id = Rta_IdentLen(q);
+        if (id > 0u && Rta_Find(q, id) == NULL)
+        {
+            const char *r = q + id;
+
+            while (isspace((unsigned char)*r))
+            {
+                r++;
+            }
+            if (*r == ')')
+            {
+                p_ps->p = r + 1;
+                return Rta_ParsePrimary(p_ps);
+            }
+        }
+        p_ps->p++;
+        v = Rta_ParseExpr(p_ps);
+        Rta_Skip(p_ps);
+        if (*p_ps->p == ')')
+        {
+            p_ps->p++;
+        }
+        else
+        {
+            RtaEvalError = true;
+        }
+        return v;
+    }
+    id = Rta_IdentLen(p_ps->p);
+    if (id > 0u)
+    {
+        Rta_Macro_t *p_m;
+
+        if (id == 7u && strncmp(p_ps->p, "defined", 7u) == 0)
+        {
+            const char *q = p_ps->p + 7;
+            size_t n;
+            bool paren;
+
+            while (isspace((unsigned char)*q))
+            {
+                q++;
+            }
+            paren = (*q == '(');
+            q += paren ? 1 : 0;
+            while (isspace((unsigned char)*q))
+            {
+                q++;
+            }
+            n = Rta_IdentLen(q);
+            p_ps->p = q + n;
+            if (paren)
+            {
+                Rta_Skip(p_ps);
+                p_ps->p += (*p_ps->p == ')') ? 1 : 0;
+            }
+            return Rta_Find(q, n) != NULL;
+        }
+
+        p_m = Rta_Find(p_ps->p, id);
+        p_ps->p += id;
+        if (p_m == NULL)
+        {
+            RtaEvalError = true;
+            return 0;
+        }
+        if (p_m->function)
+        {
+            char arg[RTA_EXPR_LEN], body[2u * RTA_EXPR_LEN];
+
+            Rta_Skip(p_ps);
+            if (*p_ps->p != '(')
+            {
+                RtaEvalError = true;
+                return 0;
+            }
+            p_ps->p = Rta_ParenArg(p_ps->p + 1, arg, sizeof(arg));
+            Rta_Substitute(p_m, arg, body, sizeof(body));
+            return Rta_EvalDepth(body, p_ps->depth + 1);
+        }
+        return Rta_EvalDepth(p_m->body, p_ps->depth + 1);
+    }
+    RtaEvalError = true;
+    return 0;
+}
+
+static int64_t Rta_ParseTerm(Rta_Parser_t *p_ps)
+{
+    int64_t v = Rta_ParsePrimary(p_ps);
+
+    while (1)
+    {
+        char op;
+        int64_t r;
+
+        Rta_Skip(p_ps);
+        op = *p_ps->p;
+        if (op != '*' && op != '/' && op != '%')
+        {
+            return v;
+        }
+        p_ps->p++;
+        r = Rta_ParsePrimary(p_ps);
+        if (op == '*')
+        {
+            v *= r;
+        }
+        else if (r == 0)
+        {
+            RtaEvalError = true;
+            return 0;
+        }
+        else
+        {
+            v = (op == '/') ? v / r : v % r;
+        }
+    }
+}
+
+static int64_t Rta_ParseExpr(Rta_Parser_t *p_ps)
+{
+    int64_t v = Rta_ParseTerm(p_ps);
+
+    while (1)
+    {
+        Rta_Skip(p_ps);
+        if (*p_ps->p == '+')
+        {
+            p_ps->p++;
+            v += Rta_ParseTerm(p_ps);
+        }
+        else if (*p_ps->p == '-')
+        {
+            p_ps->p++;
+            v -= Rta_ParseTerm(p_ps);
+        }
+        else
+        {
+            return v;
+        }
+    }
+}
+
+static int64_t Rta_Eval(const char *expr)
+{
+    return Rta_EvalDepth(expr, 0);
+}
+
+static int64_t Rta_EvalOrDie(const char *expr, const char *what)
+{
+    int64_t v;
+
+    RtaEvalError = false;
+    v = Rta_Eval(expr);
+    if (RtaEvalError)
+    {
+        fprintf(stderr, "acc_rta: cannot evaluate %s: %s\n", what, expr);
+        exit(2);
+    }
+    return v;
+}
+
+// ---------------------------------------------------------------------------
+// Task model from main.c and the task bodies
+// ---------------------------------------------------------------------------
+
+// Splits the call arguments starting after '('; returns the argument count
+static int Rta_CallArgs(const char *p, char args[][RTA_EXPR_LEN], int max)
+{
+    char all[4u * RTA_EXPR_LEN];
+    const char *q = all;
+    int n = 0;
+
+    Rta_ParenArg(p, all, sizeof(all));
+    while (n < max)
+    {
+        int level = 0;
+        size_t len = 0u;
+
+        while (*q != '\0' && !(level == 0 && *q == ','))
+        {
+            level += (*q == '(') ? 1 : (*q == ')') ? -1 : 0;
+            if (len < RTA_EXPR_LEN - 1u)
+            {
+                args[n][len++] = *q;
+            }
+            q++;
+        }
+        args[n][len] = '\0';
+        Rta_Trim(args[n]);
+        n++;
+        if (*q == '\0')
+        {
+            break;
+        }
+        q++;
+    }
+    return n;
+}
+
+// Body of function fn (from '{' to the matching '}', NUL-terminated copy)
+static char *Rta_FunctionBody(const char *fn)
+{
+    size_t len = strlen(fn);
+    int i;
+
+    for (i = 0; i < RtaSrcQty; i++)
+    {
+        const char *p = RtaSrc[i];
+
+        while ((p = strstr(p, fn)) != NULL)
+        {
+            const char *q = p + len;
+            char dummy[RTA_EXPR_LEN];
+
+            if ((p > RtaSrc[i] && (isalnum((unsigned char)p[-1]) || p[-1] == '_')) ||
+                Rta_IdentLen(q) > 0u)
+            {
+                p = q;
+                continue;
+            }
+            while (isspace((unsigned char)*q))
+            {
+                q++;
+            }
+            if (*q == '(')
+            {
+                q = Rta_ParenArg(q + 1, dummy, sizeof(dummy));
+                while (isspace((unsigned char)*q))
+                {
+                    q++;
+                }
+                if (*q == '{')
+                {
+                    const char *b = q;
+                    int level = 0;
+                    char *body;
+
+                    do
+                    {
+                        level += (*q == '{') ? 1 : (*q == '}') ? -1 : 0;
+                        q++;
+                    } while (*q != '\0' && level > 0);
+                    body = malloc((size_t)(q - b) + 1u);
+                    memcpy(body, b, (size_t)(q - b));
+                    body[q - b] = '\0';
+                    return body;
+                }
+            }
+            p += len;
+        }
+    }
+    return NULL;
+}
+
+// Index of the task whose body contains call(&object, or -1
+static int Rta_Poster(const char *call, const char *object)
+{
+    char pat[2u * RTA_NAME_LEN];
+    int i;
+
+    snprintf(pat, sizeof(pat), "%s(&%s", call, object);
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        char *body = Rta_FunctionBody(RtaTasks[i].fn);
+        bool found = body != NULL && strstr(body, pat) != NULL;
+
+        free(body);
+        if (found)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static const char *Rta_Earliest(const char *body, const char *const *calls, int n, int *p_which)
+{
+    const char *best = NULL;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        const char *p = strstr(body, calls[i]);
+
+        if (p != NULL && (best == NULL || p < best))
+        {
+            best = p;
+            *p_which = i;
+        }
+    }
+    return best;
+}
+
+static bool Rta_IsKeyword(const char *name)
+{
+    static const char *const kw[] = { "if", "while", "for", "switch", "return", "sizeof" };
+    size_t i;
+
+    for (i = 0u; i < sizeof(kw) / sizeof(kw[0]); i++)
+    {
+        if (strcmp(name, kw[i]) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether body, or a function it calls with a definition in the sources
+// (depth levels down), contains text: the frame stages are helpers shared by
+// the task bodies
+static bool Rta_Reaches(const char *body, const char *text, int depth)
+{
+    const char *p = body;
+
+    if (strstr(body, text) != NULL)
+    {
+        return true;
+    }
+    while (depth > 0 && *p != '\0')
+    {
+        size_t n = Rta_IdentLen(p);
+
+        if (n > 0u && (p == body || !(isalnum((unsigned char)p[-1]) || p[-1] == '_')) && p[n] == '(' &&
+            n < RTA_NAME_LEN)
+        {
+            char name[RTA_NAME_LEN];
+            char *callee;
+            bool found;
+
+            memcpy(name, p, n);
+            name[n] = '\0';
+            callee = Rta_IsKeyword(name) ? NULL : Rta_FunctionBody(name);
+            found = callee != NULL && Rta_Reaches(callee, text, depth - 1);
+            free(callee);
+            if (found)
+            {
+                return true;
+            }
+        }
+        p += (n > 0u) ? n : 1u;
+    }
+    return false;
+}
+
+static void Rta_ClassifyTask(Rta_Task_t *p_task)
+{
+    static const char *const calls[] = {
+        "OSSemPend(", "OSTaskSemPend(", "OSTimeDly(", "OSTimeDlyHMSM(", "OSFlagPend(", "OSQPend("
+    };
+    char args[8][RTA_EXPR_LEN];
+    char *body = Rta_FunctionBody(p_task->fn);
+    const char *p;
+    int which = -1;
+
+    if (body == NULL)
+    {
+        fprintf(stderr, "acc_rta: no definition of %s\n", p_task->fn);
+        exit(2);
+    }
+    p_task->completes = Rta_Reaches(body, "Deadline_Complete(", RTA_CALL_DEPTH);
+    p_task->section = Rta_Reaches(body, "Param_WriteBegin(", RTA_CALL_DEPTH) ||
+                      Rta_Reaches(body, "OSSchedLock(", RTA_CALL_DEPTH) ||
+                      Rta_Reaches(body, "OSMutexPend(", RTA_CALL_DEPTH);
+    p_task->pred = -1;
+
+    p = Rta_Earliest(body, calls, (int)(sizeof(calls) / sizeof(calls[0])), &which);
+    if (p != NULL)
+    {
+        int n = Rta_CallArgs(strchr(p, '(') + 1, args, 8);
+
+        switch (which)
+        {
+            case 0:     // OSSemPend(&sem, timeout, ...): ISR-posted unless a task posts it
+                p_task->pred = Rta_Poster("OSSemPost", args[0] + (args[0][0] == '&'));
+                p_task->release = (p_task->pred < 0) ? RTA_REL_ISR : RTA_REL_TASK;
+                snprintf(p_task->timeout_expr, RTA_EXPR_LEN, "%s", (n > 1) ? args[1] : "0");
+                break;
+
+            case 1:     // OSTaskSemPend(timeout, ...)
+                p_task->pred = Rta_Poster("OSTaskSemPost", p_task->tcb);
+                p_task->release = (p_task->pred < 0) ? RTA_REL_ISR : RTA_REL_TASK;
+                snprintf(p_task->timeout_expr, RTA_EXPR_LEN, "%s", args[0]);
+                break;
+
+            case 2:     // OSTimeDly(ticks, ...)
+                p_task->release = RTA_REL_PERIODIC;
+                snprintf(p_task->period_expr, RTA_EXPR_LEN, "%s", args[0]);
+                break;
+
+            case 3:     // OSTimeDlyHMSM(h, m, s, ms, ...)
+                p_task->release = RTA_REL_PERIODIC;
+                snprintf(p_task->period_expr, RTA_EXPR_LEN,
+                         "((((%.32s) * 3600 + (%.32s) * 60 + (%.32s)) * OS_CFG_TICK_RATE_HZ) + "
+                         "((%.32s) * OS_CFG_TICK_RATE_HZ + 500) / 1000)",
+                         args[0], args[1], args[2], args[3]);
+                break;
+
+            default:
+                p_task->release = RTA_REL_EVENT;
+                break;
+        }
+    }
+    free(body);
+}
+
+static void Rta_LoadModel(const char *main_path)
+{
+    char *text = Rta_Load(main_path);
+    char args[12][RTA_EXPR_LEN];
+    const char *p = text;
+
+    RtaSrc[RtaSrcQty++] = text;
+    while ((p = strstr(p, "OSTaskCreate(")) != NULL && RtaTaskQty < RTA_TASK_MAX)
+    {
+        Rta_Task_t *p_task = &RtaTasks[RtaTaskQty];
+        int n = Rta_CallArgs(p + strlen("OSTaskCreate("), args, 12);
+
+        p += strlen("OSTaskCreate(");
+        if (n < 5)
+        {
+            continue;
+        }
+        memset(p_task, 0, sizeof(*p_task));
+        snprintf(p_task->tcb, RTA_NAME_LEN, "%.63s", args[0] + (args[0][0] == '&'));
+        snprintf(p_task->name, RTA_NAME_LEN, "%.*s", (int)strlen(args[1]) - 2, args[1] + 1);
+        snprintf(p_task->fn, RTA_NAME_LEN, "%.63s", args[2]);
+        p_task->prio = Rta_EvalOrDie(args[4], p_task->name);
+        RtaTaskQty++;
+    }
+}
+
+static int Rta_ComparePrio(const void *a, const void *b)
+{
+    int64_t pa = ((const Rta_Task_t *)a)->prio;
+    int64_t pb = ((const Rta_Task_t *)b)->prio;
+
+    return (pa > pb) - (pa < pb);
+}
+
+static void Rta_LoadSources(const char *dir, const char *main_path)
+{
+    DIR *d = opendir(dir);
+    struct dirent *e;
+    char path[1024];
+
+    if (d == NULL)
+    {
+        fprintf(stderr, "acc_rta: cannot open %s\n", dir);
+        exit(2);
+    }
+    while ((e = readdir(d)) != NULL && RtaSrcQty < RTA_SRC_MAX)
+    {
+        size_t n = strlen(e->d_name);
+
+        snprintf(path, sizeof(path), "%s/%s", dir, e->d_name);
+        if (n > 2u && strcmp(e->d_name + n - 2u, ".c") == 0 && strcmp(path, main_path) != 0)
+        {
+            RtaSrc[RtaSrcQty++] = Rta_Load(path);
+        }
+    }
+    closedir(d);
+}
+
+// ---------------------------------------------------------------------------
+// Measurements
+// ---------------------------------------------------------------------------
+
+static Rta_Task_t *Rta_TaskByName(const char *name)
+{
+    int i;
+
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        if (strcmp(RtaTasks[i].name, name) == 0)
+        {
+            return &RtaTasks[i];
+        }
+    }
+    return NULL;
+}
+
+static void Rta_LoadMeasured(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[256];
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "acc_rta: cannot read %s\n", path);
+        exit(2);
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char name[RTA_NAME_LEN];
+        long long a, b, c;
+        Rta_Task_t *p_task;
+
+        if (sscanf(line, "task %63s exec %lld response %lld blocking %lld", name, &a, &b, &c) == 4)
+        {
+            p_task = Rta_TaskByName(name);
+            if (p_task != NULL)
+            {
+                p_task->C = a;
+                p_task->B_meas = c;
+                p_task->measured = true;
+            }
+        }
+        else if (sscanf(line, "param_write %lld", &a) == 1)
+        {
+            RtaOvh.section = a;
+        }
+        else if (sscanf(line, "isr exec %lld jitter %lld", &a, &b) == 2)
+        {
+            RtaOvh.isr_C = a;
+            RtaOvh.isr_J = b;
+        }
+        else if (sscanf(line, "tick exec %lld", &a) == 1)
+        {
+            RtaOvh.tick_C = a;
+        }
+    }
+    fclose(fp);
+}
+
+// ---------------------------------------------------------------------------
+// Analysis
+// ---------------------------------------------------------------------------
+
+static int64_t Rta_CeilDiv(int64_t a, int64_t b)
+{
+    return (a <= 0) ? 0 : (a + b - 1) / b;
+}
+
+static int64_t Rta_TickNs(void)
+{
+    return 1000000000ll / Rta_EvalOrDie("OS_CFG_TICK_RATE_HZ", "tick rate");
+}
+
+static int64_t Rta_Blocking(const Rta_Task_t *p_task)
+{
+    int64_t B = p_task->B_meas;
+    int j;
+
+    for (j = 0; j < RtaTaskQty; j++)
+    {
+        if (RtaTasks[j].prio > p_task->prio && RtaTasks[j].section && RtaOvh.section > B)
+        {
+            B = RtaOvh.section;
+        }
+    }
+    return B;
+}
+
+// Task a releases task b, directly or through other tasks
+static bool Rta_IsAncestor(int a, int b)
+{
+    int hops = 0;
+
+    while (RtaTasks[b].release == RTA_REL_TASK && RtaTasks[b].pred >= 0 && hops++ < RTA_TASK_MAX)
+    {
+        b = RtaTasks[b].pred;
+        if (b == a)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Response time of task i from its release (J of the others from the last pass)
+static void Rta_Response(int i, int64_t T_isr, int64_t tick)
+{
+    Rta_Task_t *p_task = &RtaTasks[i];
+    int64_t base = p_task->C + Rta_Blocking(p_task);
+    int64_t R = base;
+    int64_t limit = 10 * ((p_task->D > 0) ? p_task->D : p_task->T);
+
+    p_task->diverged = false;
+    while (1)
+    {
+        int64_t next = base + Rta_CeilDiv(R, tick) * RtaOvh.tick_C +
+                       Rta_CeilDiv(R + RtaOvh.isr_J, T_isr) * RtaOvh.isr_C;
+        int j;
+
+        for (j = 0; j < RtaTaskQty; j++)
+        {
+            const Rta_Task_t *p_hp = &RtaTasks[j];
+
+            if (p_hp->prio < p_task->prio && p_hp->measured && p_hp->T > 0)
+            {
+                if (Rta_IsAncestor(j, i))
+                {
+                    // Same frame's job already done: only its next releases (k·T on) count
+                    next += ((p_task->J + R) / p_hp->T) * p_hp->C;
+                }
+                else
+                {
+                    next += Rta_CeilDiv(R + p_hp->J, p_hp->T) * p_hp->C;
+                }
+            }
+        }
+        if (next == R)
+        {
+            break;
+        }
+        R = next;
+        if (R > limit)
+        {
+            p_task->diverged = true;
+            break;
+        }
+    }
+    p_task->R = R;
+    p_task->W = p_task->J + R;
+}
+
+typedef struct {
+    int64_t T_isr;
+    int64_t tick;
+    int64_t frame_D;            // Frame deadline after each ISR (0: no deadline monitor)
+    const Rta_Task_t *timeout_task;             // Task with the smallest timeout margin
+    int64_t timeout_fire;       // Earliest timeout expiry after the pend (ns)
+    int64_t timeout_next;       // Latest next release after the previous one (ns)
+    bool    rta_ok;             // ISR-chain tasks finish within the frame
+    bool    ok;                 // ... and every configured deadline/timeout holds
+    const char *why;            // First reason ok is false
+    double  util;
+} Rta_Result_t;
+
+static bool Rta_IsChain(const Rta_Task_t *p_task)
+{
+    int hops = 0;
+
+    while (p_task->release == RTA_REL_TASK && p_task->pred >= 0 && hops++ < RTA_TASK_MAX)
+    {
+        p_task = &RtaTasks[p_task->pred];
+    }
+    return p_task->release == RTA_REL_ISR;
+}
+
+static void Rta_Fail(Rta_Result_t *p_res, const char *why)
+{
+    if (p_res->ok)
+    {
+        p_res->ok = false;
+        p_res->why = why;
+    }
+}
+
+// Analyses the model with TIMER_PERIOD_MS = period_ms (0: as configured)
+static void Rta_Analyse(int64_t period_ms, Rta_Result_t *p_res)
+{
+    char val[48];
+    int iter, i;
+
+    RtaSweepQty = 0;
+    if (period_ms > 0)
+    {
+        snprintf(val, sizeof(val), "TIMER_PERIOD_MS %lld", (long long)period_ms);
+        Rta_Define(RtaSweep, &RtaSweepQty, 1, val);
+    }
+    memset(p_res, 0, sizeof(*p_res));
+    p_res->ok = true;
+    p_res->rta_ok = true;
+    p_res->tick = Rta_TickNs();
+    p_res->T_isr = Rta_EvalOrDie("TIMER_PERIOD_MS", "TIMER_PERIOD_MS") * RTA_NS_PER_MS;
+
+    // Deadline monitor: the frame is judged against its ISR release, so the
+    // deadline is exact (no tick rounding)
+    if (Rta_Eval("defined(FRAME_DEADLINE_MS)") != 0)
+    {
+        p_res->frame_D = Rta_EvalOrDie("FRAME_DEADLINE_MS", "FRAME_DEADLINE_MS") * RTA_NS_PER_MS;
+    }
+
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        Rta_Task_t *p_task = &RtaTasks[i];
+
+        p_task->J = p_task->R = p_task->W = 0;
+        p_task->T = p_task->D = 0;
+        p_task->diverged = false;
+        if (Rta_IsChain(p_task))
+        {
+            p_task->T = p_task->D = p_res->T_isr;
+            if (p_task->completes && p_res->frame_D > 0 && p_res->frame_D < p_task->D)
+            {
+                p_task->D = p_res->frame_D;
+            }
+        }
+        else if (p_task->release == RTA_REL_PERIODIC)
+        {
+            p_task->T = p_task->D = Rta_EvalOrDie(p_task->period_expr, p_task->name) * p_res->tick;
+        }
+    }
+
+    // Holistic iteration: a posted task's release jitter is its poster's
+    // worst completion, which in turn depends on interference
+    for (iter = 0; iter < RTA_HOLISTIC_ITER; iter++)
+    {
+        bool changed = false;
+
+        for (i = 0; i < RtaTaskQty; i++)
+        {
+            Rta_Task_t *p_task = &RtaTasks[i];
+            int64_t W = p_task->W;
+
+            if (!p_task->measured || p_task->T == 0)
+            {
+                continue;
+            }
+            if (p_task->release == RTA_REL_ISR)
+            {
+                p_task->J = RtaOvh.isr_J + RtaOvh.isr_C;
+            }
+            else if (p_task->release == RTA_REL_TASK)
+            {
+                p_task->J = RtaTasks[p_task->pred].W;
+            }
+            else
+            {
+                p_task->J = RtaOvh.tick_C;          // Readied at the end of the tick ISR
+            }
+            Rta_Response(i, p_res->T_isr, p_res->tick);
+            changed = changed || p_task->W != W;
+        }
+        if (!changed)
+        {
+            break;
+        }
+    }
+
+    p_res->util = (double)RtaOvh.tick_C / p_res->tick + (double)RtaOvh.isr_C / p_res->T_isr;
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        Rta_Task_t *p_task = &RtaTasks[i];
+        bool chain = Rta_IsChain(p_task);
+
+        if (!p_task->measured || p_task->T == 0)
+        {
+            p_task->ok = !chain;
+            if (chain)
+            {
+                p_res->rta_ok = false;
+                Rta_Fail(p_res, "hard task without execution time");
+            }
+            continue;
+        }
+        p_res->util += (double)p_task->C / p_task->T;
+        p_task->ok = !p_task->diverged && p_task->W <= p_task->D;
+        if (chain)
+        {
+            if (p_task->diverged || p_task->W > p_task->T)
+            {
+                p_res->rta_ok = false;
+                Rta_Fail(p_res, "frame overrun");
+            }
+            else if (!p_task->ok)
+            {
+                Rta_Fail(p_res, "frame completed after FRAME_DEADLINE_MS");
+            }
+        }
+
+        // Pend timeout: counted in ticks from the pend, so it can fire up to
+        // one tick early; the next release may come T + J after the last one
+        if (p_task->timeout_expr[0] != '\0')
+        {
+            int64_t ticks = Rta_EvalOrDie(p_task->timeout_expr, p_task->name);
+            int64_t fire = (ticks - 1) * p_res->tick;
+            int64_t next = p_task->T + p_task->J;
+
+            if (ticks > 0 && (p_res->timeout_task == NULL ||
+                              fire - next < p_res->timeout_fire - p_res->timeout_next))
+            {
+                p_res->timeout_task = p_task;
+                p_res->timeout_fire = fire;
+                p_res->timeout_next = next;
+            }
+            if (ticks > 0 && chain && fire < next)
+            {
+                Rta_Fail(p_res, "pend timeout before next release");
+            }
+            else if (ticks == 0 && chain && strcmp(p_task->timeout_expr, "0") != 0)
+            {
+                Rta_Fail(p_res, "pend timeout rounds to 0 ticks (waits forever)");
+            }
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Report
+// ---------------------------------------------------------------------------
+
+static void Rta_PrintUs(int64_t ns)
+{
+    printf(" %10.1f", (double)ns / 1000.0);
+}
+
+static void Rta_Report(const Rta_Result_t *p_res)
+{
+    int i;
+
+    printf("  ISR: C %.1f us, release jitter %.1f us; tick: C %.1f us every %lld ms; "
+           "non-preemptive section %.1f us\n",
+           RtaOvh.isr_C / 1000.0, RtaOvh.isr_J / 1000.0, RtaOvh.tick_C / 1000.0,
+           (long long)(p_res->tick / RTA_NS_PER_MS), RtaOvh.section / 1000.0);
+    printf("  %-10s %4s  %-12s %7s %10s %10s %10s %10s %10s %10s %10s\n",
+           "task", "prio", "released by", "T (ms)", "C (us)", "B (us)", "J (us)", "R (us)",
+           "J+R (us)", "D (us)", "slack (us)");
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        const Rta_Task_t *p_task = &RtaTasks[i];
+        const char *rel;
+
+        switch (p_task->release)
+        {
+            case RTA_REL_ISR:      rel = "ISR";                         break;
+            case RTA_REL_TASK:     rel = RtaTasks[p_task->pred].name;   break;
+            case RTA_REL_PERIODIC: rel = "time delay";                  break;
+            case RTA_REL_EVENT:    rel = "event flags";                 break;
+            default:               rel = "?";                           break;
+        }
+        printf("  %-10s %4lld  %-12s", p_task->name, (long long)p_task->prio, rel);
+        if (p_task->T == 0)
+        {
+            printf(" %7s  (sporadic: not analysed, not counted as interference)\n", "-");
+            continue;
+        }
+        printf(" %7lld", (long long)(p_task->T / RTA_NS_PER_MS));
+        if (!p_task->measured)
+        {
+            printf("  (no execution time: pass -w %s=us)\n", p_task->name);
+            continue;
+        }
+        Rta_PrintUs(p_task->C);
+        Rta_PrintUs(Rta_Blocking(p_task));
+        Rta_PrintUs(p_task->J);
+        if (p_task->diverged)
+        {
+            printf(" %10s  UNSCHEDULABLE\n", "> 10 D");
+            continue;
+        }
+        Rta_PrintUs(p_task->R);
+        Rta_PrintUs(p_task->W);
+        Rta_PrintUs(p_task->D);
+        Rta_PrintUs(p_task->D - p_task->W);
+        printf("%s%s\n", (p_task->completes && p_task->D < p_task->T) ? "  (D: frame deadline)" : "",
+               p_task->ok ? "" : "  MISS");
+    }
+    if (p_res->timeout_task != NULL)
+    {
+        printf("  %s pend timeout fires >= %.1f ms after the pend; next release <= %.1f ms after the last: "
+               "margin %.1f ms\n",
+               p_res->timeout_task->name,
+               (double)p_res->timeout_fire / RTA_NS_PER_MS,
+               (double)p_res->timeout_next / RTA_NS_PER_MS,
+               (double)(p_res->timeout_fire - p_res->timeout_next) / RTA_NS_PER_MS);
+    }
+    if (p_res->frame_D > 0)
+    {
+        printf("  frame deadline %.1f ms after each ISR (per-job monitor)\n",
+               (double)p_res->frame_D / RTA_NS_PER_MS);
+    }
+    printf("  utilisation (periodic tasks + ISR + tick) %.3f %%\n", p_res->util * 100.0);
+}
+
+// "Name=value" → name, value; false if malformed
+static bool Rta_SplitArg(const char *arg, char *name, double *p_val)
+{
+    const char *eq = strchr(arg, '=');
+
+    if (eq == NULL || eq == arg || (size_t)(eq - arg) >= RTA_NAME_LEN)
+    {
+        return false;
+    }
+    memcpy(name, arg, (size_t)(eq - arg));
+    name[eq - arg] = '\0';
+    *p_val = atof(eq + 1);
+    return true;
+}
+
+static void Rta_Usage(void)
+{
+    fprintf(stderr, "usage: acc_rta [-m measured.txt] [-s srcdir] [-c acc_config.h] [-o os_cfg.h]\n"
+                    "               [-k factor] [-w Task=us] [-D NAME=value]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *src = "..";
+    const char *config = NULL;
+    const char *os_cfg = "os_cfg.h";
+    const char *measured = NULL;
+    double factor = 1.0;
+    char path[1024], main_path[1024];
+    Rta_Result_t res;
+    int64_t period, min_ok = 0, min_rta = 0;
+    int i;
+
+    // Pass 1: paths and -D (needed before the sources are read)
+    for (i = 1; i < argc; i++)
+    {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc)
+        {
+            Rta_Usage();
+        }
+        switch (argv[i][1])
+        {
+            case 'm': measured = argv[++i];       break;
+            case 's': src = argv[++i];            break;
+            case 'c': config = argv[++i];         break;
+            case 'o': os_cfg = argv[++i];         break;
+            case 'k': factor = atof(argv[++i]);   break;
+            case 'w': i++;                        break;
+            case 'D':
+            {
+                char def[RTA_EXPR_LEN];
+                char *eq;
+
+                snprintf(def, sizeof(def), "%s", argv[++i]);
+                eq = strchr(def, '=');
+                if (eq != NULL)
+                {
+                    *eq = ' ';
+                }
+                Rta_Define(RtaUser, &RtaUserQty, RTA_MACRO_MAX, def);
+                break;
+            }
+            default:
+                Rta_Usage();
+        }
+    }
+
+    free(Rta_Load(os_cfg));
+    if (config == NULL)
+    {
+        snprintf(path, sizeof(path), "%s/acc_config.h", src);
+        config = path;
+    }
+    free(Rta_Load(config));
+    snprintf(main_path, sizeof(main_path), "%s/main.c", src);
+    Rta_LoadModel(main_path);
+    Rta_LoadSources(src, main_path);
+    qsort(RtaTasks, (size_t)RtaTaskQty, sizeof(RtaTasks[0]), Rta_ComparePrio);
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        Rta_ClassifyTask(&RtaTasks[i]);
+    }
+
+    // Pass 2: execution times
+    if (measured != NULL)
+    {
+        Rta_LoadMeasured(measured);
+    }
+    for (i = 1; i < argc; i += 2)
+    {
+        char name[RTA_NAME_LEN];
+        double us;
+        Rta_Task_t *p_task;
+
+        if (strcmp(argv[i], "-w") != 0)
+        {
+            continue;
+        }
+        p_task = Rta_SplitArg(argv[i + 1], name, &us) ? Rta_TaskByName(name) : NULL;
+        if (p_task == NULL)
+        {
+            fprintf(stderr, "acc_rta: -w %s: no such task\n", argv[i + 1]);
+            return 2;
+        }
+        p_task->C = (int64_t)(us * 1000.0);
+        p_task->B_meas = 0;
+        p_task->measured = true;
+    }
+    for (i = 0; i < RtaTaskQty; i++)
+    {
+        RtaTasks[i].C = (int64_t)(RtaTasks[i].C * factor);
+        RtaTasks[i].B_meas = (int64_t)(RtaTasks[i].B_meas * factor);
+    }
+    RtaOvh.isr_C = (int64_t)(RtaOvh.isr_C * factor);
+    RtaOvh.tick_C = (int64_t)(RtaOvh.tick_C * factor);
+    RtaOvh.section = (int64_t)(RtaOvh.section * factor);
+
+    // Shortest TIMER_PERIOD_MS (1 ms steps) with everything else derived as configured
+    Rta_Analyse(0, &res);
+    period = res.T_isr / RTA_NS_PER_MS;
+    for (i = 1; i <= period && (min_ok == 0 || min_rta == 0); i++)
+    {
+        Rta_Result_t r;
+
+        Rta_Analyse(i, &r);
+        if (min_ok == 0 && r.ok)
+        {
+            min_ok = i;
+        }
+        if (min_rta == 0 && r.rta_ok)
+        {
+            min_rta = i;
+        }
+    }
+
+    Rta_Analyse(0, &res);
+    printf("ACC response-time analysis (TIMER_PERIOD_MS = %lld, tick = %lld ms%s%s, WCET x %.2f)\n",
+           (long long)period, (long long)(res.tick / RTA_NS_PER_MS),
+           (measured != NULL) ? ", measured: " : ", no measurements", (measured != NULL) ? measured : "",
+           factor);
+    Rta_Report(&res);
+    printf("  schedulable as configured: %s%s%s\n", res.ok ? "yes" : "NO",
+           res.ok ? "" : " - ", res.ok ? "" : res.why);
+
+    printf("  minimum safe TIMER_PERIOD_MS:\n");
+    if (min_ok > 0)
+    {
+        printf("    %4lld ms  with the derived timeouts and frame deadline as configured\n", (long long)min_ok);
+    }
+    else
+    {
+        printf("    none <= %lld ms with the derived timeouts and frame deadline as configured\n", (long long)period);
+    }
+    if (min_rta > 0)
+    {
+        printf("    %4lld ms  response-time bound alone (hard tasks done within the frame)\n", (long long)min_rta);
+    }
+    if (min_ok > 0)
+    {
+        Rta_Result_t r;
+
+        // What breaks one tick below
+        if (min_ok > res.tick / RTA_NS_PER_MS)
+        {
+            int64_t below = min_ok - res.tick / RTA_NS_PER_MS;
+
+            Rta_Analyse(below, &r);
+            printf("    at %lld ms: %s\n", (long long)below, r.why);
+        }
+    }
+    return res.ok ? 0 : 1;
+}
@@ -0,0 +1,324 @@
+#include "acc_sim.h"
+#include "acc_types.h"
+#include "acc_config.h"
+#include "acc_stack_host.h"
+#include "acc_seqlock.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Virtual-time closed-loop simulation
+// Runs the unchanged task set on virtual time (OS_HostVirtualTime, set by
+// acc_hardware_sim.c): the tick, the IRQ_sensors_ISR frame timer,
+// Control's pend timeout and every OSTimeDly advance on the
+// simulated clock, and the next tick is delivered as soon as all tasks are
+// blocked. The actuator output drives the vehicle model of acc_plant.c, whose
+// state the sensors read back. For each scripted lead-vehicle scenario ACC is
+// engaged for the simulated duration; results do not depend on the host load
+// and repeat bit for bit (trajectory hash).
+//
+// Environment:
+//   ACC_SIM_SCENARIO   scenario to run (default: all, see acc_plant.c)
+//   ACC_SIM_SECONDS    simulated seconds per scenario (default 3600)
+//   ACC_SIM_SUMMARY    file to write the totals to
+//   ACC_SIM_RADAR_STRAIGHT  1: radar frames report yaw rate 0 (ACC_RADAR_EN)
+//   ACC_SIM_LAW        eq3 or mpc: speed-tracking law (ACC_MPC_EN, default
+//                      ACC_LAW_DEFAULT)
+//
+// Collisions, minimum gap and time headway, and peak deceleration judge the
+// control law and are reported per scenario, with the frame rate and the
+// hard tasks' host CPU time per simulated second (load). With
+// ACC_RATE_ADAPT_EN a second line gives the share of time at each
+// control-rate level; with ACC_RADAR_EN one gives the radar frames whose
+// selected lead was not the nearest vehicle in the own lane, which fail the
+// run unless the path prediction is disabled. ACC_SIM_SUMMARY=<file> writes the totals over the
+// scenarios run as key/value lines (make rate, make mpc), including the RMS
+// gap error while following (lead within twice Xset) and the peak
+// acceleration and jerk. The exit status judges the run:
+// 0 every released frame was actuated and ACC stayed engaged, 1 otherwise,
+// 2 unknown scenario.
+
+#define SIM_SECONDS_DEFAULT    3600u
+#define SIM_CHUNK_TICKS        OS_CFG_TICK_RATE_HZ     // Engagement checked every simulated second
+
+#if ACC_CYCLIC_EXEC
+static OS_TCB *const SimHardTasks[] = { &FrameTCB };
+#else
+static OS_TCB *const SimHardTasks[] = { &SensorsTCB, &ControlTCB, &ActuatorTCB };
+#endif
+#define SIM_HARD_TASK_QTY      (sizeof(SimHardTasks) / sizeof(SimHardTasks[0]))
+
+static uint32_t SimDisengaged;
+
+#if ACC_MPC_EN
+// ACC_SIM_LAW: every task is blocked between OS_HostTimeAdvance() calls, so
+// the host thread is the configuration block's only writer here
+static void Sim_Law(const char *law)
+{
+    uint8_t sel;
+
+    if (strcmp(law, "eq3") == 0)
+    {
+        sel = ACC_LAW_EQ3;
+    }
+    else if (strcmp(law, "mpc") == 0)
+    {
+        sel = ACC_LAW_MPC;
+    }
+    else
+    {
+        fprintf(stderr, "acc_sim: unknown law %s (eq3, mpc)\n", law);
+        exit(2);
+    }
+    Seq_WriteBegin(&Parameters.config.seq);
+    Parameters.config.law = sel;
+    Seq_WriteEnd(&Parameters.config.seq);
+}
+#endif
+
+// Totals over the scenarios run (ACC_SIM_SUMMARY)
+static struct {
+    uint64_t seconds;
+    uint64_t frames;
+    uint64_t cpu_ns;
+    uint32_t collisions;
+    float    gap_min;
+    float    decel_max;
+    float    accel_max;
+    float    jerk_max;
+    double   follow_s;
+    double   gap_err2;
+#if ACC_RATE_ADAPT_EN
+    uint64_t level_ms[RATE_LEVEL_QTY];
+    uint32_t switches;
+#endif
+#if ACC_RADAR_EN
+    uint64_t radar_frames;
+    uint32_t radar_wrong;
+#endif
+} SimTotal;
+
+static CPU_TS64 Sim_HardCpu(void)
+{
+    CPU_TS64 cpu = 0u;
+    uint32_t i;
+
+    for (i = 0u; i < SIM_HARD_TASK_QTY; i++)
+    {
+        cpu += SimHardTasks[i]->CyclesTotal;
+    }
+    return cpu;
+}
+
+// Simulated driver switch (interrupt context), as in acc_host.c
+static void Sim_Driver(bool engage)
+{
+    OS_ERR err;
+
+    OSIntEnter();
+    if (engage)
+    {
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG), OS_OPT_POST_FLAG_SET, &err);
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)ACC_OFF_FLAG, OS_OPT_POST_FLAG_CLR, &err);
+    }
+    else
+    {
+        OSFlagPost(&EventFlagGroup, (OS_FLAGS)ACC_OFF_FLAG, OS_OPT_POST_FLAG_SET, &err);
+    }
+    OSIntExit();
+    OS_HostTimeAdvance(0u);     // Let Setup_Task act on it
+}
+
+static bool Sim_Run(const ACC_PlantScenario_t *p_scn, uint32_t seconds, double *p_wall)
+{
+    const ACC_PlantStats_t *p_st = &SimPlant.stats;
+    uint32_t chunks = seconds * OS_CFG_TICK_RATE_HZ / SIM_CHUNK_TICKS;
+    CPU_TS64 t0, cpu;
+    double load;
+    bool ok;
+
+    Plant_Init(&SimPlant, p_scn);
+    SimPlant.gap_ref = ACC_VALUE_TO_FLOAT(Parameters.config.Xset);
+    SimFramesReleased = 0u;
+    SimFramesActuated = 0u;
+    SimDisengaged = 0u;
+    SimHash = SIM_HASH_INIT;
+#if ACC_RADAR_EN
+    SimRadar.frames = SimRadar.wrong = SimRadar.ambiguous = 0u;
+#endif
+
+    t0 = CPU_TS_Get64();
+    cpu = Sim_HardCpu();
+    Sim_Driver(true);
+    while (chunks-- > 0u)
+    {
+        OS_HostTimeAdvance(SIM_CHUNK_TICKS);
+        if (!SimTimerEnabled)
+        {
+            // Deadline monitor or fault dropped ACC: count it and re-engage
+            SimDisengaged++;
+            Sim_Driver(false);
+            Sim_Driver(true);
+        }
+    }
+    Sim_Driver(false);
+    *p_wall = (double)(CPU_TS_Get64() - t0) / 1e9;
+    cpu = Sim_HardCpu() - cpu;
+    load = (double)cpu / ((double)seconds * 1e9) * 100.0;
+
+    ok = SimDisengaged == 0u && SimFramesActuated == SimFramesReleased && SimFramesReleased > 0u;
+#if ACC_RADAR_EN
+    ok = ok && (SimRadar.wrong == 0u || SimRadar.straight);
+#endif
+    printf("  %-12s %6u %9u %8u %5u %5u %7.2f %6.2f %7.2f %6.1f  %08x %8.3f %7.0fx %6.2f %7.4f %s\n",
+           p_scn->name, (unsigned)seconds,
+           (unsigned)SimFramesReleased, (unsigned)(SimFramesReleased - SimFramesActuated),
+           (unsigned)SimDisengaged, (unsigned)p_st->collisions,
+           p_st->gap_min, (p_st->headway_min < 1e8f) ? p_st->headway_min : 0.0f,
+           p_st->decel_max, p_st->speed_max,
+           (unsigned)SimHash, *p_wall, (double)seconds / *p_wall,
+           (double)SimFramesReleased / seconds, load,
+           !ok ? "FAIL" : (p_st->collisions != 0u) ? "collision" : "ok");
+
+    SimTotal.seconds += seconds;
+    SimTotal.frames += SimFramesReleased;
+    SimTotal.cpu_ns += cpu;
+    SimTotal.collisions += p_st->collisions;
+    SimTotal.gap_min = (p_st->gap_min < SimTotal.gap_min) ? p_st->gap_min : SimTotal.gap_min;
+    SimTotal.decel_max = (p_st->decel_max > SimTotal.decel_max) ? p_st->decel_max : SimTotal.decel_max;
+    SimTotal.accel_max = (p_st->accel_max > SimTotal.accel_max) ? p_st->accel_max : SimTotal.accel_max;
+    SimTotal.jerk_max = (p_st->jerk_max > SimTotal.jerk_max) ? p_st->jerk_max : SimTotal.jerk_max;
+    SimTotal.follow_s += p_st->follow_s;
+    SimTotal.gap_err2 += p_st->gap_err2;
+#if ACC_RATE_ADAPT_EN
+    {
+        uint64_t level_ms[RATE_LEVEL_QTY], total_ms = 0u;
+        uint32_t l;
+
+        // Time at each level of this engagement (Setup_Task resets RateCtl on engage)
+        for (l = 0u; l < RATE_LEVEL_QTY; l++)
+        {
+            level_ms[l] = (uint64_t)RateCtl.frames[l] * RatePeriodsMs[l];
+            total_ms += level_ms[l];
+            SimTotal.level_ms[l] += level_ms[l];
+        }
+        SimTotal.switches += RateCtl.switches;
+        printf("    rate levels: %u ms %5.1f %%, %u ms %5.1f %%, %u ms %5.1f %% of the time, %u switches\n",
+               (unsigned)RatePeriodsMs[0], (double)level_ms[0] * 100.0 / total_ms,
+               (unsigned)RatePeriodsMs[1], (double)level_ms[1] * 100.0 / total_ms,
+               (unsigned)RatePeriodsMs[2], (double)level_ms[2] * 100.0 / total_ms,
+               (unsigned)RateCtl.switches);
+    }
+#endif
+#if ACC_RADAR_EN
+    SimTotal.radar_frames += SimRadar.frames;
+    SimTotal.radar_wrong += SimRadar.wrong;
+    printf("    radar (%s path): %u frames, %u lead mis-selected, %u ambiguous\n",
+           SimRadar.straight ? "straight" : "predicted", (unsigned)SimRadar.frames,
+           (unsigned)SimRadar.wrong, (unsigned)SimRadar.ambiguous);
+#endif
+    return ok;
+}
+
+static void Sim_Summary(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+#if ACC_RATE_ADAPT_EN
+    uint32_t l;
+#endif
+
+    if (fp == NULL)
+    {
+        perror(path);
+        exit(2);
+    }
+    fprintf(fp, "sim_seconds %llu\n", (unsigned long long)SimTotal.seconds);
+    fprintf(fp, "frames_per_s %.3f\n", (double)SimTotal.frames / SimTotal.seconds);
+    fprintf(fp, "cpu_ns_per_frame %.0f\n", (double)SimTotal.cpu_ns / SimTotal.frames);
+    fprintf(fp, "cpu_load_pct %.4f\n", (double)SimTotal.cpu_ns / ((double)SimTotal.seconds * 1e9) * 100.0);
+    fprintf(fp, "collisions %u\n", (unsigned)SimTotal.collisions);
+    fprintf(fp, "gap_min_m %.2f\n", SimTotal.gap_min);
+    fprintf(fp, "decel_max %.2f\n", SimTotal.decel_max);
+    fprintf(fp, "accel_max %.2f\n", SimTotal.accel_max);
+    fprintf(fp, "jerk_max %.2f\n", SimTotal.jerk_max);
+    fprintf(fp, "follow_pct %.1f\n", SimTotal.follow_s / (double)SimTotal.seconds * 100.0);
+    fprintf(fp, "gap_rms_m %.2f\n", (SimTotal.follow_s > 0.0) ? sqrt(SimTotal.gap_err2 / SimTotal.follow_s) : 0.0);
+#if ACC_RATE_ADAPT_EN
+    for (l = 0u; l < RATE_LEVEL_QTY; l++)
+    {
+        fprintf(fp, "time_at_%ums_pct %.1f\n", (unsigned)RatePeriodsMs[l],
+                (double)SimTotal.level_ms[l] / ((double)SimTotal.seconds * 1000.0) * 100.0);
+    }
+    fprintf(fp, "rate_switches %u\n", (unsigned)SimTotal.switches);
+#endif
+#if ACC_RADAR_EN
+    fprintf(fp, "radar_frames %llu\n", (unsigned long long)SimTotal.radar_frames);
+    fprintf(fp, "radar_misselected %u\n", (unsigned)SimTotal.radar_wrong);
+#endif
+    fclose(fp);
+}
+
+void App_OS_HostMain(void)
+{
+    const char *name = getenv("ACC_SIM_SCENARIO");
+    const char *env = getenv("ACC_SIM_SECONDS");
+    const char *summary = getenv("ACC_SIM_SUMMARY");
+    uint32_t seconds = (env != NULL && atoi(env) > 0) ? (uint32_t)atoi(env) : SIM_SECONDS_DEFAULT;
+    uint32_t i, runs = 0u, failed = 0u;
+    double wall, wall_total = 0.0;
+
+    SimTotal.gap_min = PLANT_SENSOR_RANGE_M;
+
+    // Let the tasks initialise (Setup_Task sets ACC_OFF)
+    OS_HostTimeAdvance(MS_TO_TICKS(TIMER_PERIOD_MS));
+#if ACC_MPC_EN
+    if (getenv("ACC_SIM_LAW") != NULL)
+    {
+        Sim_Law(getenv("ACC_SIM_LAW"));
+    }
+#endif
+
+    printf("ACC virtual-time simulation (T_ISR = %u ms, tick = %u Hz, %u s per scenario%s)\n",
+           (unsigned)TIMER_PERIOD_MS, (unsigned)OS_CFG_TICK_RATE_HZ, (unsigned)seconds,
+#if ACC_MPC_EN
+           (Parameters.config.law == ACC_LAW_MPC) ? ", MPC law" : ", Equation 3"
+#else
+           ""
+#endif
+           );
+    printf("  %-12s %6s %9s %8s %5s %5s %7s %6s %7s %6s  %8s %8s %8s %6s %7s\n",
+           "scenario", "sim s", "frames", "missed", "off", "coll", "gap min", "thw s",
+           "decel", "v max", "hash", "wall s", "speedup", "fr/s", "load %");
+    for (i = 0u; i < PlantScenarioQty; i++)
+    {
+        if (name != NULL && strcmp(name, "all") != 0 && strcmp(name, PlantScenarios[i].name) != 0)
+        {
+            continue;
+        }
+        if (!Sim_Run(&PlantScenarios[i], seconds, &wall))
+        {
+            failed++;
+        }
+        wall_total += wall;
+        runs++;
+    }
+    if (runs == 0u)
+    {
+        fprintf(stderr, "acc_sim: unknown scenario %s\n", name);
+        exit(2);
+    }
+    printf("  %u scenario(s), %u simulated s in %.3f s wall = %.0fx real time\n",
+           (unsigned)runs, (unsigned)(runs * seconds), wall_total, (double)(runs * seconds) / wall_total);
+    if (summary != NULL)
+    {
+        Sim_Summary(summary);
+    }
+#if ACC_STK_PROFILE_EN
+    if (!StackHost_Profile())
+    {
+        failed++;
+    }
+#endif
+    exit(failed == 0u ? 0 : 1);
+}
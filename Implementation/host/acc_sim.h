@@ -0,0 +1,31 @@
+#ifndef ACC_SIM_H
+#define ACC_SIM_H
+
+#include "acc_config.h"
+#include "acc_plant.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Virtual-time closed-loop simulation: acc_hardware_sim.c closes the loop
+// through the vehicle model, acc_sim.c runs the scenarios.
+
+extern ACC_Plant_t SimPlant;                // Stepped every tick once a scenario is set
+extern volatile bool SimTimerEnabled;       // Setup_Task enabled the frame timer (ACC engaged)
+extern uint32_t SimFramesReleased;
+extern uint32_t SimFramesActuated;
+extern uint32_t SimHash;                    // FNV-1a over every applied dM and the ego speed
+
+#define SIM_HASH_INIT   2166136261u
+
+#if ACC_RADAR_EN
+typedef struct {
+    uint32_t frames;            // Radar frames selected from
+    uint32_t wrong;             // Xn not the nearest vehicle in the own lane
+    uint32_t ambiguous;         // Vehicle near the lane edge: not judged
+    bool     straight;          // ACC_SIM_RADAR_STRAIGHT: yaw rate reported as 0
+} SimRadarStats_t;
+
+extern SimRadarStats_t SimRadar;
+#endif
+
+#endif // ACC_SIM_H
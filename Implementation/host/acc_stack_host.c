@@ -0,0 +1,233 @@
+#include "acc_stack_host.h"
+#include "acc_stack.h"
+#include "acc_config.h"
+#include "os.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Stack profile (host): see acc_stack_host.h
+//
+// Profile file, one line per measurement (CPU_STK, merged by maximum):
+//   isr <peak>                        tick thread (tick ISR, frame-timer ISR nested in its hook)
+//   task <STK_SIZE_*> <size> <peak>
+
+#if ACC_STK_PROFILE_EN
+
+#define STACK_HOST_MAX        16u
+#define STACK_HOST_LINE       256u
+
+typedef struct {
+    char         macro[64];
+    CPU_STK_SIZE size;
+    CPU_STK_SIZE peak;
+} StackHost_Entry_t;
+
+static StackHost_Entry_t StackHostTbl[STACK_HOST_MAX];
+static uint32_t          StackHostQty;
+static CPU_STK_SIZE      StackHostIsr;
+
+static StackHost_Entry_t *StackHost_Find(const char *macro)
+{
+    uint32_t i;
+
+    for (i = 0u; i < StackHostQty; i++)
+    {
+        if (strcmp(StackHostTbl[i].macro, macro) == 0)
+        {
+            return &StackHostTbl[i];
+        }
+    }
+    return NULL;
+}
+
+static void StackHost_Merge(const char *macro, CPU_STK_SIZE size, CPU_STK_SIZE peak)
+{
+    StackHost_Entry_t *p_ent = StackHost_Find(macro);
+
+    if (p_ent == NULL)
+    {
+        if (StackHostQty >= STACK_HOST_MAX)
+        {
+            return;
+        }
+        p_ent = &StackHostTbl[StackHostQty++];
+        snprintf(p_ent->macro, sizeof(p_ent->macro), "%s", macro);
+        p_ent->peak = 0u;
+    }
+    p_ent->size = size;
+    if (peak > p_ent->peak)
+    {
+        p_ent->peak = peak;
+    }
+}
+
+// Earlier runs' peaks (a missing file is an empty profile)
+static void StackHost_Load(const char *path)
+{
+    FILE *fp = fopen(path, "r");
+    char line[STACK_HOST_LINE];
+
+    if (fp == NULL)
+    {
+        return;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        char macro[64];
+        unsigned long size, peak;
+
+        if (sscanf(line, "task %63s %lu %lu", macro, &size, &peak) == 3)
+        {
+            StackHost_Merge(macro, (CPU_STK_SIZE)size, (CPU_STK_SIZE)peak);
+        }
+        else if (sscanf(line, "isr %lu", &peak) == 1 && peak > StackHostIsr)
+        {
+            StackHostIsr = (CPU_STK_SIZE)peak;
+        }
+    }
+    fclose(fp);
+}
+
+static bool StackHost_Save(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    uint32_t i;
+
+    if (fp == NULL)
+    {
+        perror(path);
+        return false;
+    }
+    fprintf(fp, "# ACC stack profile (CPU_STK high-water marks, merged over runs)\n");
+    fprintf(fp, "isr %lu\n", (unsigned long)StackHostIsr);
+    for (i = 0u; i < StackHostQty; i++)
+    {
+        fprintf(fp, "task %s %lu %lu\n", StackHostTbl[i].macro,
+                (unsigned long)StackHostTbl[i].size, (unsigned long)StackHostTbl[i].peak);
+    }
+    fclose(fp);
+    return true;
+}
+
+// Template with every profiled "#define STK_SIZE_* <n> // ..." line resized
+static bool StackHost_WriteConfig(const char *tmpl, const char *path)
+{
+    FILE *in = fopen(tmpl, "r");
+    FILE *out;
+    char line[STACK_HOST_LINE];
+
+    if (in == NULL)
+    {
+        perror(tmpl);
+        return false;
+    }
+    out = fopen(path, "w");
+    if (out == NULL)
+    {
+        perror(path);
+        fclose(in);
+        return false;
+    }
+    while (fgets(line, sizeof(line), in) != NULL)
+    {
+        char macro[64];
+        unsigned long size;
+        const StackHost_Entry_t *p_ent = NULL;
+
+        if (sscanf(line, "#define %63s %lu", macro, &size) == 2)
+        {
+            p_ent = StackHost_Find(macro);
+        }
+        if (p_ent != NULL && p_ent->peak > 0u)
+        {
+            fprintf(out, "#define %-21s %-7lu // Profiled: peak %lu + ISR reserve + %u%% (was %lu)\n",
+                    macro, (unsigned long)Stack_Suggest(p_ent->peak), (unsigned long)p_ent->peak,
+                    (unsigned)STK_PROFILE_MARGIN_PCT, size);
+        }
+        else
+        {
+            fputs(line, out);
+        }
+    }
+    fclose(in);
+    fclose(out);
+    return true;
+}
+
+bool StackHost_Profile(void)
+{
+    const char *profile = getenv("ACC_STK_PROFILE");
+    const char *config = getenv("ACC_STK_CONFIG");
+    const char *tmpl = getenv("ACC_STK_TEMPLATE");
+    CPU_STK_SIZE isr = OS_HostIsrStkUsed();
+    unsigned long cfg = 0u, sug = 0u;
+    bool ok = true;
+    uint32_t i;
+
+    if (profile != NULL)
+    {
+        StackHost_Load(profile);
+    }
+    Stack_Sample();
+    for (i = 0u; i < StackUseQty; i++)
+    {
+        StackHost_Merge(StackUse[i].macro, StackUse[i].size, StackUse[i].peak);
+    }
+    if (isr > StackHostIsr)
+    {
+        StackHostIsr = isr;
+    }
+
+    printf("ACC stack profile (CPU_STK = %u bytes; suggested = (peak + %u x %u ISR) + %u %%, multiple of %u)\n",
+           (unsigned)sizeof(CPU_STK), (unsigned)STK_ISR_NEST_MAX, (unsigned)STK_ISR_FRAME,
+           (unsigned)STK_PROFILE_MARGIN_PCT, (unsigned)STK_PROFILE_ALIGN);
+    printf("  %-20s %10s %8s %10s %8s\n", "", "configured", "peak", "suggested", "saved");
+    for (i = 0u; i < StackHostQty; i++)
+    {
+        const StackHost_Entry_t *p_ent = &StackHostTbl[i];
+
+        if (p_ent->peak == 0u)
+        {
+            printf("  %-20s %10lu %8s\n", p_ent->macro, (unsigned long)p_ent->size, "-");
+            continue;
+        }
+        printf("  %-20s %10lu %8lu %10lu %8ld\n", p_ent->macro, (unsigned long)p_ent->size,
+               (unsigned long)p_ent->peak, (unsigned long)Stack_Suggest(p_ent->peak),
+               (long)p_ent->size - (long)Stack_Suggest(p_ent->peak));
+    }
+    if (StackHostIsr > 0u)
+    {
+        printf("  %-20s %10s %8lu   (tick thread: tick ISR with the frame-timer ISR nested)\n",
+               "ISR", "", (unsigned long)StackHostIsr);
+    }
+
+    // RAM of this build's stacks: the tasks it creates
+    for (i = 0u; i < StackUseQty; i++)
+    {
+        const StackHost_Entry_t *p_ent = StackHost_Find(StackUse[i].macro);
+
+        cfg += StackUse[i].size;
+        sug += (p_ent != NULL && p_ent->peak > 0u) ? Stack_Suggest(p_ent->peak) : StackUse[i].size;
+    }
+    printf("  task stacks of this build: %lu -> %lu CPU_STK, %lu -> %lu bytes, saved %ld bytes (%.1f %%)\n",
+           cfg, sug, cfg * sizeof(CPU_STK), sug * sizeof(CPU_STK),
+           ((long)cfg - (long)sug) * (long)sizeof(CPU_STK),
+           (cfg > 0u) ? ((double)cfg - (double)sug) / (double)cfg * 100.0 : 0.0);
+
+    if (profile != NULL)
+    {
+        ok = StackHost_Save(profile) && ok;
+    }
+    if (config != NULL)
+    {
+        ok = StackHost_WriteConfig((tmpl != NULL) ? tmpl : "../acc_config.h", config) && ok;
+        if (ok)
+        {
+            printf("  suggested configuration written to %s\n", config);
+        }
+    }
+    return ok;
+}
+
+#endif // ACC_STK_PROFILE_EN
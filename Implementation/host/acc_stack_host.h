@@ -0,0 +1,19 @@
+#ifndef ACC_STACK_HOST_H
+#define ACC_STACK_HOST_H
+
+#include <stdbool.h>
+
+// Stack profile (host, ACC_STK_PROFILE_EN): takes a last Stack_Sample(),
+// merges the peaks into a profile file kept across runs (stress scenarios,
+// both hard-task structures), prints the sizing report and optionally writes
+// acc_config.h with the suggested STK_SIZE_* values.
+//
+// Environment:
+//   ACC_STK_PROFILE    profile file to merge into (default: report this run only)
+//   ACC_STK_CONFIG     suggested acc_config.h to write
+//   ACC_STK_TEMPLATE   acc_config.h to start from (default ../acc_config.h)
+//
+// Returns false if a file could not be read or written.
+bool StackHost_Profile(void);
+
+#endif // ACC_STACK_HOST_H
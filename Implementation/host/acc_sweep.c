@@ -0,0 +1,316 @@
+#include "acc_sweep.h"
+#include "acc_control.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__)
+#define SWEEP_X86   1
+#include <immintrin.h>
+#else
+#define SWEEP_X86   0
+#endif
+
+// Batch Evaluator (see acc_sweep.h)
+//
+// Every kernel runs the same frame for each candidate, in this order:
+//   Sensors:  Vn2 ← Vn1 ← Vn ← speed, Xn ← gap
+//   Control:  dMn, Vset ← Control_Law_Float(...)
+//   Actuator: accel = clamp(dMn × accel_gain, ±accel_limit)
+//             speed = max(speed + accel × dt, 0)
+//             gap  += (lead - speed) / 3.6 × dt
+//   Scores:   overshoot, min_gap, last_unsettled
+// max/min below follow the SIMD instruction semantics (second operand on a
+// tie or NaN) so the scalar kernel matches them bit for bit.
+
+#define SWEEP_FIELD_QTY   17u
+
+static void Sweep_Fields(ACC_Sweep_t *p_sweep, float **fields[SWEEP_FIELD_QTY])
+{
+    float **const all[SWEEP_FIELD_QTY] = {
+        &p_sweep->K1, &p_sweep->K2, &p_sweep->K3,
+        &p_sweep->Vcruise, &p_sweep->Vset, &p_sweep->Xset, &p_sweep->deltaV,
+        &p_sweep->Xn, &p_sweep->Vn, &p_sweep->Vn1, &p_sweep->Vn2, &p_sweep->dMn,
+        &p_sweep->gap, &p_sweep->speed,
+        &p_sweep->overshoot, &p_sweep->min_gap, &p_sweep->last_unsettled
+    };
+
+    memcpy(fields, all, sizeof(all));
+}
+
+int Sweep_Alloc(ACC_Sweep_t *p_sweep, uint32_t n)
+{
+    float **fields[SWEEP_FIELD_QTY];
+    size_t bytes;
+    uint32_t i;
+
+    memset(p_sweep, 0, sizeof(*p_sweep));
+    p_sweep->n = (n + ACC_SWEEP_LANES - 1u) / ACC_SWEEP_LANES * ACC_SWEEP_LANES;
+    bytes = ((size_t)p_sweep->n * sizeof(float) + ACC_SWEEP_ALIGN - 1u) / ACC_SWEEP_ALIGN * ACC_SWEEP_ALIGN;
+    Sweep_Fields(p_sweep, fields);
+    for (i = 0u; i < SWEEP_FIELD_QTY; i++)
+    {
+        *fields[i] = aligned_alloc(ACC_SWEEP_ALIGN, bytes);
+        if (*fields[i] == NULL)
+        {
+            Sweep_Free(p_sweep);
+            return -1;
+        }
+        memset(*fields[i], 0, bytes);
+    }
+    return 0;
+}
+
+void Sweep_Free(ACC_Sweep_t *p_sweep)
+{
+    float **fields[SWEEP_FIELD_QTY];
+    uint32_t i;
+
+    Sweep_Fields(p_sweep, fields);
+    for (i = 0u; i < SWEEP_FIELD_QTY; i++)
+    {
+        free(*fields[i]);
+    }
+    memset(p_sweep, 0, sizeof(*p_sweep));
+}
+
+void Sweep_Reset(ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi)
+{
+    uint32_t i;
+
+    // Same start as the target: main.c clears the speed history, Setup_Task
+    // loads Vset = Vcruise when ACC engages
+    for (i = lo; i < hi; i++)
+    {
+        p_sweep->Vset[i] = p_sweep->Vcruise[i];
+        p_sweep->Xn[i] = 0.0f;
+        p_sweep->Vn[i] = 0.0f;
+        p_sweep->Vn1[i] = 0.0f;
+        p_sweep->Vn2[i] = 0.0f;
+        p_sweep->dMn[i] = 0.0f;
+        p_sweep->gap[i] = p_scn->gap0;
+        p_sweep->speed[i] = p_scn->speed0;
+        p_sweep->overshoot[i] = 0.0f;
+        p_sweep->min_gap[i] = FLT_MAX;
+        p_sweep->last_unsettled[i] = -1.0f;
+    }
+}
+
+static inline float Sweep_Max(float a, float b)
+{
+    return (a > b) ? a : b;
+}
+
+static inline float Sweep_Min(float a, float b)
+{
+    return (a < b) ? a : b;
+}
+
+static void Sweep_RunScalar(ACC_Sweep_t *s, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi)
+{
+    uint32_t k, i;
+
+    for (k = 0u; k < p_scn->steps; k++)
+    {
+        const float lead = p_scn->lead_speed[k];
+        const float step = (float)k;
+
+        for (i = lo; i < hi; i++)
+        {
+            float accel, speed, gap;
+
+            // Sensors_Task
+            s->Vn2[i] = s->Vn1[i];
+            s->Vn1[i] = s->Vn[i];
+            s->Vn[i] = s->speed[i];
+            s->Xn[i] = s->gap[i];
+
+            // Control_Task
+            s->dMn[i] = Control_Law_Float(s->Xn[i], s->Xset[i], s->Vcruise[i], s->deltaV[i],
+                                          s->Vn[i], s->Vn1[i], s->Vn2[i],
+                                          s->K1[i], s->K2[i], s->K3[i],
+                                          &s->Vset[i]);
+
+            // Actuator_Task and vehicle model
+            accel = Sweep_Min(Sweep_Max(s->dMn[i] * p_scn->accel_gain, -p_scn->accel_limit), p_scn->accel_limit);
+            speed = Sweep_Max(s->speed[i] + accel * p_scn->dt, 0.0f);
+            gap = s->gap[i] + (lead - speed) / 3.6f * p_scn->dt;
+            s->speed[i] = speed;
+            s->gap[i] = gap;
+
+            s->overshoot[i] = Sweep_Max(s->overshoot[i], speed - s->Vcruise[i]);
+            s->min_gap[i] = Sweep_Min(s->min_gap[i], gap);
+            if (fabsf(speed - lead) > p_scn->settle_band)
+            {
+                s->last_unsettled[i] = step;
+            }
+        }
+    }
+}
+
+#if SWEEP_X86
+static void Sweep_RunSse(ACC_Sweep_t *s, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi)
+{
+    const __m128 gain = _mm_set1_ps(p_scn->accel_gain);
+    const __m128 limit = _mm_set1_ps(p_scn->accel_limit);
+    const __m128 nlimit = _mm_set1_ps(-p_scn->accel_limit);
+    const __m128 dt = _mm_set1_ps(p_scn->dt);
+    const __m128 kmh_per_mps = _mm_set1_ps(3.6f);
+    const __m128 band = _mm_set1_ps(p_scn->settle_band);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    uint32_t k, i;
+
+    for (k = 0u; k < p_scn->steps; k++)
+    {
+        const __m128 lead = _mm_set1_ps(p_scn->lead_speed[k]);
+        const __m128 step = _mm_set1_ps((float)k);
+
+        for (i = lo; i < hi; i += 4u)
+        {
+            __m128 Vn, Vn1, Xn, Vset, Vcruise, eq1, e_n, e_n1, e_n2, dM, accel, speed, gap, mask;
+
+            // Sensors_Task
+            Vn1 = _mm_load_ps(&s->Vn[i]);
+            _mm_store_ps(&s->Vn2[i], _mm_load_ps(&s->Vn1[i]));
+            _mm_store_ps(&s->Vn1[i], Vn1);
+            Vn = _mm_load_ps(&s->speed[i]);
+            _mm_store_ps(&s->Vn[i], Vn);
+            Xn = _mm_load_ps(&s->gap[i]);
+            _mm_store_ps(&s->Xn[i], Xn);
+
+            // Control_Task: Equation 1 where Xn >= Xset, else Equation 4
+            Vcruise = _mm_load_ps(&s->Vcruise[i]);
+            eq1 = _mm_cmpge_ps(Xn, _mm_load_ps(&s->Xset[i]));
+            Vset = _mm_sub_ps(_mm_load_ps(&s->Vset[i]), _mm_load_ps(&s->deltaV[i]));
+            Vset = _mm_or_ps(_mm_and_ps(eq1, Vcruise), _mm_andnot_ps(eq1, Vset));
+            _mm_store_ps(&s->Vset[i], Vset);
+
+            // Equations 2 and 3, summed in Control_Law_Float() order
+            e_n = _mm_sub_ps(Vset, Vn);
+            e_n1 = _mm_sub_ps(Vset, Vn1);
+            e_n2 = _mm_sub_ps(Vset, _mm_load_ps(&s->Vn2[i]));
+            dM = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_load_ps(&s->K1[i]), e_n),
+                                       _mm_mul_ps(_mm_load_ps(&s->K2[i]), e_n1)),
+                            _mm_mul_ps(_mm_load_ps(&s->K3[i]), e_n2));
+            _mm_store_ps(&s->dMn[i], dM);
+
+            // Actuator_Task and vehicle model
+            accel = _mm_min_ps(_mm_max_ps(_mm_mul_ps(dM, gain), nlimit), limit);
+            speed = _mm_max_ps(_mm_add_ps(Vn, _mm_mul_ps(accel, dt)), zero);
+            gap = _mm_add_ps(Xn, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(lead, speed), kmh_per_mps), dt));
+            _mm_store_ps(&s->speed[i], speed);
+            _mm_store_ps(&s->gap[i], gap);
+
+            _mm_store_ps(&s->overshoot[i], _mm_max_ps(_mm_load_ps(&s->overshoot[i]), _mm_sub_ps(speed, Vcruise)));
+            _mm_store_ps(&s->min_gap[i], _mm_min_ps(_mm_load_ps(&s->min_gap[i]), gap));
+            mask = _mm_cmpgt_ps(_mm_andnot_ps(sign, _mm_sub_ps(speed, lead)), band);
+            _mm_store_ps(&s->last_unsettled[i],
+                         _mm_or_ps(_mm_and_ps(mask, step), _mm_andnot_ps(mask, _mm_load_ps(&s->last_unsettled[i]))));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void Sweep_RunAvx2(ACC_Sweep_t *s, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi)
+{
+    const __m256 gain = _mm256_set1_ps(p_scn->accel_gain);
+    const __m256 limit = _mm256_set1_ps(p_scn->accel_limit);
+    const __m256 nlimit = _mm256_set1_ps(-p_scn->accel_limit);
+    const __m256 dt = _mm256_set1_ps(p_scn->dt);
+    const __m256 kmh_per_mps = _mm256_set1_ps(3.6f);
+    const __m256 band = _mm256_set1_ps(p_scn->settle_band);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+    uint32_t k, i;
+
+    for (k = 0u; k < p_scn->steps; k++)
+    {
+        const __m256 lead = _mm256_set1_ps(p_scn->lead_speed[k]);
+        const __m256 step = _mm256_set1_ps((float)k);
+
+        for (i = lo; i < hi; i += 8u)
+        {
+            __m256 Vn, Vn1, Xn, Vset, Vcruise, eq1, e_n, e_n1, e_n2, dM, accel, speed, gap, mask;
+
+            // Sensors_Task
+            Vn1 = _mm256_load_ps(&s->Vn[i]);
+            _mm256_store_ps(&s->Vn2[i], _mm256_load_ps(&s->Vn1[i]));
+            _mm256_store_ps(&s->Vn1[i], Vn1);
+            Vn = _mm256_load_ps(&s->speed[i]);
+            _mm256_store_ps(&s->Vn[i], Vn);
+            Xn = _mm256_load_ps(&s->gap[i]);
+            _mm256_store_ps(&s->Xn[i], Xn);
+
+            // Control_Task: Equation 1 where Xn >= Xset, else Equation 4
+            Vcruise = _mm256_load_ps(&s->Vcruise[i]);
+            eq1 = _mm256_cmp_ps(Xn, _mm256_load_ps(&s->Xset[i]), _CMP_GE_OQ);
+            Vset = _mm256_sub_ps(_mm256_load_ps(&s->Vset[i]), _mm256_load_ps(&s->deltaV[i]));
+            Vset = _mm256_blendv_ps(Vset, Vcruise, eq1);
+            _mm256_store_ps(&s->Vset[i], Vset);
+
+            // Equations 2 and 3, summed in Control_Law_Float() order (no FMA)
+            e_n = _mm256_sub_ps(Vset, Vn);
+            e_n1 = _mm256_sub_ps(Vset, Vn1);
+            e_n2 = _mm256_sub_ps(Vset, _mm256_load_ps(&s->Vn2[i]));
+            dM = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(&s->K1[i]), e_n),
+                                             _mm256_mul_ps(_mm256_load_ps(&s->K2[i]), e_n1)),
+                               _mm256_mul_ps(_mm256_load_ps(&s->K3[i]), e_n2));
+            _mm256_store_ps(&s->dMn[i], dM);
+
+            // Actuator_Task and vehicle model
+            accel = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(dM, gain), nlimit), limit);
+            speed = _mm256_max_ps(_mm256_add_ps(Vn, _mm256_mul_ps(accel, dt)), zero);
+            gap = _mm256_add_ps(Xn, _mm256_mul_ps(_mm256_div_ps(_mm256_sub_ps(lead, speed), kmh_per_mps), dt));
+            _mm256_store_ps(&s->speed[i], speed);
+            _mm256_store_ps(&s->gap[i], gap);
+
+            _mm256_store_ps(&s->overshoot[i],
+                            _mm256_max_ps(_mm256_load_ps(&s->overshoot[i]), _mm256_sub_ps(speed, Vcruise)));
+            _mm256_store_ps(&s->min_gap[i], _mm256_min_ps(_mm256_load_ps(&s->min_gap[i]), gap));
+            mask = _mm256_cmp_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(speed, lead)), band, _CMP_GT_OQ);
+            _mm256_store_ps(&s->last_unsettled[i], _mm256_blendv_ps(_mm256_load_ps(&s->last_unsettled[i]), step, mask));
+        }
+    }
+}
+#endif
+
+void Sweep_Run(ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi,
+               ACC_SweepIsa_t isa)
+{
+#if SWEEP_X86
+    if (isa == ACC_SWEEP_ISA_AVX2)
+    {
+        Sweep_RunAvx2(p_sweep, p_scn, lo, hi);
+        return;
+    }
+    if (isa == ACC_SWEEP_ISA_SSE)
+    {
+        Sweep_RunSse(p_sweep, p_scn, lo, hi);
+        return;
+    }
+#endif
+    Sweep_RunScalar(p_sweep, p_scn, lo, hi);
+}
+
+ACC_SweepIsa_t Sweep_IsaBest(void)
+{
+#if SWEEP_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return ACC_SWEEP_ISA_AVX2;
+    }
+    return ACC_SWEEP_ISA_SSE;
+#else
+    return ACC_SWEEP_ISA_SCALAR;
+#endif
+}
+
+const char *Sweep_IsaName(ACC_SweepIsa_t isa)
+{
+    static const char *const names[ACC_SWEEP_ISA_QTY] = { "scalar", "sse", "avx2" };
+
+    return (isa < ACC_SWEEP_ISA_QTY) ? names[isa] : "?";
+}
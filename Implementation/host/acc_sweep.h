@@ -0,0 +1,73 @@
+#ifndef ACC_SWEEP_H
+#define ACC_SWEEP_H
+
+#include <stdint.h>
+
+// Batch Evaluator for Gain Sweeps (host only)
+//
+// Runs the Control_Task law (Equations 1-4) for many parameter sets at
+// once, each closed around the same longitudinal ego/lead vehicle model, and
+// records the quantities the sweep driver scores. The Parameter Memory Block
+// is laid out as a structure of arrays (one array per ACC_Parameters_t field,
+// one lane per candidate) so the law runs 4 (SSE) or 8 (AVX2) candidates per
+// instruction.
+//
+// Bit compatibility: the SIMD kernels evaluate exactly the float operations
+// of Control_Law_Float() in the same order (no FMA contraction, branch
+// replaced by a select), and the scalar kernel calls Control_Law_Float()
+// itself, so every ISA produces bit-identical trajectories and scores.
+
+#define ACC_SWEEP_ALIGN   64u       // Lane arrays are cache-line aligned
+#define ACC_SWEEP_LANES   8u        // Candidate count is padded to this
+
+typedef enum {
+    ACC_SWEEP_ISA_SCALAR = 0,
+    ACC_SWEEP_ISA_SSE,
+    ACC_SWEEP_ISA_AVX2,
+    ACC_SWEEP_ISA_QTY
+} ACC_SweepIsa_t;
+
+// Shared scenario: lead-vehicle speed profile and initial conditions
+typedef struct {
+    uint32_t     steps;             // Control cycles simulated
+    float        dt;                // Cycle period (s), TIMER_PERIOD_MS
+    const float *lead_speed;        // Lead speed per cycle (km/h), steps entries
+    float        gap0;              // Initial gap (m)
+    float        speed0;            // Initial ego speed (km/h)
+    float        accel_gain;        // km/h per second per unit of dM
+    float        accel_limit;       // km/h per second
+    float        settle_band;       // |ego - lead| (km/h) counted as settled
+} ACC_SweepScenario_t;
+
+typedef struct {
+    uint32_t n;                     // Candidates (multiple of ACC_SWEEP_LANES)
+
+    // ACC_Parameters_t, structure of arrays
+    float *K1, *K2, *K3;
+    float *Vcruise, *Vset, *Xset, *deltaV;
+    float *Xn, *Vn, *Vn1, *Vn2, *dMn;
+
+    // Vehicle model state
+    float *gap;                     // m
+    float *speed;                   // Ego speed (km/h)
+
+    // Score inputs
+    float *overshoot;               // max(speed - Vcruise), km/h (0 if never above)
+    float *min_gap;                 // m
+    float *last_unsettled;          // Last cycle with |speed - lead| > settle_band (-1: none)
+} ACC_Sweep_t;
+
+int  Sweep_Alloc(ACC_Sweep_t *p_sweep, uint32_t n);
+void Sweep_Free(ACC_Sweep_t *p_sweep);
+
+// Loads initial state for candidates [lo, hi) (gains, Vcruise, Xset, deltaV set by the caller)
+void Sweep_Reset(ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi);
+
+// Simulates candidates [lo, hi) over the whole scenario; lo and hi multiples of ACC_SWEEP_LANES
+void Sweep_Run(ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn, uint32_t lo, uint32_t hi,
+               ACC_SweepIsa_t isa);
+
+ACC_SweepIsa_t Sweep_IsaBest(void);             // Widest ISA supported by this CPU
+const char    *Sweep_IsaName(ACC_SweepIsa_t isa);
+
+#endif // ACC_SWEEP_H
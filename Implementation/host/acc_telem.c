@@ -0,0 +1,158 @@
+#include "acc_telemetry.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Telemetry Stream Decoder (acc_telemetry.h)
+//
+//   acc_telem [-c] [stream]
+//
+// Reads a stream written by Telem_Task (a file, or stdin without an
+// argument: a FIFO or a UART capture) and prints a summary: records, records
+// lost to a full ring (sequence gaps), bytes per record against the raw
+// record, the range of each value and the frames with each flag. -c prints
+// every record as CSV instead (values in their units, flags in hex).
+// Exits non-zero on a stream it cannot read to the end.
+
+#define TELEM_READ_CHUNK      4096u
+#define TELEM_FLAG_QTY        5u
+
+static const char *const TelemNames[TELEM_VALUES] = { "Xn", "Vn", "Vset", "dM" };
+static const char *const TelemFlagNames[TELEM_FLAG_QTY] = { "engage", "rollback", "degraded", "outvoted", "mpc" };
+
+static void Telem_Usage(void)
+{
+    fprintf(stderr, "usage: acc_telem [-c] [stream]\n");
+    exit(2);
+}
+
+// Whole stream in memory (a run is a few hundred kB at most)
+static uint8_t *Telem_ReadAll(FILE *fp, uint32_t *p_len)
+{
+    uint8_t *buf = NULL;
+    size_t len = 0u, cap = 0u, n;
+
+    do
+    {
+        if (cap - len < TELEM_READ_CHUNK)
+        {
+            cap = (cap == 0u) ? 65536u : cap * 2u;
+            buf = realloc(buf, cap);
+            if (buf == NULL)
+            {
+                perror("acc_telem");
+                exit(2);
+            }
+        }
+        n = fread(&buf[len], 1u, TELEM_READ_CHUNK, fp);
+        len += n;
+    } while (n > 0u);
+    *p_len = (uint32_t)len;
+    return buf;
+}
+
+static double Telem_Value(int32_t q)
+{
+    return (double)q / (double)(1u << ACC_Q_FRAC_BITS);
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    bool csv = false;
+    FILE *fp = stdin;
+    uint8_t *buf;
+    uint32_t len, pos, used, records = 0u, i;
+    uint32_t flag_frames[TELEM_FLAG_QTY] = { 0u };
+    double vmin[TELEM_VALUES] = { 0.0 }, vmax[TELEM_VALUES] = { 0.0 };
+    uint16_t period_ms;
+    ACC_TelemCodec_t codec;
+    ACC_TelemFrame_t frame;
+    int a;
+
+    for (a = 1; a < argc; a++)
+    {
+        if (strcmp(argv[a], "-c") == 0)
+        {
+            csv = true;
+        }
+        else if (argv[a][0] == '-' || path != NULL)
+        {
+            Telem_Usage();
+        }
+        else
+        {
+            path = argv[a];
+        }
+    }
+    if (path != NULL && (fp = fopen(path, "rb")) == NULL)
+    {
+        perror(path);
+        return 2;
+    }
+    buf = Telem_ReadAll(fp, &len);
+    if (!Telem_HeaderOk(buf, len, &period_ms))
+    {
+        fprintf(stderr, "acc_telem: not a version %u telemetry stream\n", (unsigned)TELEM_VERSION);
+        return 1;
+    }
+
+    Telem_CodecInit(&codec);
+    if (csv)
+    {
+        printf("seq,flags,Xn,Vn,Vset,dM\n");
+    }
+    for (pos = TELEM_HDR_BYTES; pos < len; pos += used)
+    {
+        used = Telem_Decode(&codec, &buf[pos], len - pos, &frame);
+        if (used == 0u)
+        {
+            break;
+        }
+        records++;
+        for (i = 0u; i < TELEM_VALUES; i++)
+        {
+            double v = Telem_Value(frame.v[i]);
+
+            vmin[i] = (records == 1u || v < vmin[i]) ? v : vmin[i];
+            vmax[i] = (records == 1u || v > vmax[i]) ? v : vmax[i];
+        }
+        for (i = 0u; i < TELEM_FLAG_QTY; i++)
+        {
+            flag_frames[i] += (frame.flags >> i) & 1u;
+        }
+        if (csv)
+        {
+            printf("%u,0x%03x,%.5f,%.5f,%.5f,%.5f\n", (unsigned)frame.seq, (unsigned)frame.flags,
+                   Telem_Value(frame.v[0]), Telem_Value(frame.v[1]),
+                   Telem_Value(frame.v[2]), Telem_Value(frame.v[3]));
+        }
+    }
+    if (pos < len)
+    {
+        fprintf(stderr, "acc_telem: stream cut off or damaged at byte %u of %u\n", (unsigned)pos, (unsigned)len);
+        return 1;
+    }
+    if (csv)
+    {
+        return 0;
+    }
+
+    printf("Telemetry stream: %u ms frames, %u bytes\n", (unsigned)period_ms, (unsigned)len);
+    // Sequence numbers count every frame put, so the last one gives the
+    // frames sent and the gaps the records dropped on a full ring
+    printf("  records %u, lost %u, %.2f bytes per record (raw %u, %.0f %%)\n",
+           (unsigned)records, (records > 0u) ? (unsigned)(codec.seq + 1u - records) : 0u,
+           (records > 0u) ? (double)(len - TELEM_HDR_BYTES) / records : 0.0, (unsigned)sizeof(ACC_TelemRec_t),
+           (records > 0u) ? (double)(len - TELEM_HDR_BYTES) / records / sizeof(ACC_TelemRec_t) * 100.0 : 0.0);
+    for (i = 0u; i < TELEM_VALUES; i++)
+    {
+        printf("  %-5s %12.4f .. %.4f\n", TelemNames[i], vmin[i], vmax[i]);
+    }
+    printf("  frames flagged");
+    for (i = 0u; i < TELEM_FLAG_QTY; i++)
+    {
+        printf(" %s %u%s", TelemFlagNames[i], (unsigned)flag_frames[i], (i + 1u < TELEM_FLAG_QTY) ? "," : "\n");
+    }
+    return 0;
+}
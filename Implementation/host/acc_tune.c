@@ -0,0 +1,368 @@
+#include "acc_sweep.h"
+#include "acc_config.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Gain sweep driver
+//
+// Scores every combination of the grids below (plus the current main.c
+// defaults) on a lead-car scenario, using all SIMD widths the CPU supports
+// and a pool of worker threads. Each ISA's results are compared bit for bit
+// against the scalar kernel, which calls Control_Law_Float() itself; any
+// difference fails the run. The winner is printed as main.c initialisers.
+//
+// Score (lower is better), per candidate:
+//   settling time (s) after which |ego - lead| stays within the band
+//   + SWEEP_W_OVERSHOOT × speed overshoot above Vcruise (km/h)
+//   + SWEEP_W_GAP × how far the minimum gap fell below Xset (m)
+//   + SWEEP_COLLISION if the gap ever reached 0
+//
+// Environment:
+//   SWEEP_THREADS   worker threads (default: online CPUs)
+//   SWEEP_ISA       widest ISA to run: scalar | sse | avx2 (default: widest supported);
+//                   the scalar reference always runs
+//   SWEEP_SECONDS   scenario length (default 120)
+
+#define SWEEP_CHUNK          256u       // Candidates per work item (whole cache lines per array)
+#define SWEEP_W_OVERSHOOT    1.0f       // s per km/h
+#define SWEEP_W_GAP          2.0f       // s per m
+#define SWEEP_COLLISION      1.0e6f
+#define SWEEP_TOP            5u
+
+// Defaults from main.c (first candidate) and Host HAL initial conditions
+#define SWEEP_K1_DEFAULT     1.0f
+#define SWEEP_K2_DEFAULT     0.5f
+#define SWEEP_K3_DEFAULT     0.25f
+#define SWEEP_XSET_DEFAULT   50.0f
+#define SWEEP_DV_DEFAULT     5.0f
+#define SWEEP_VCRUISE        100.0f
+
+static const float SweepK1[] = { 0.05f, 0.1f, 0.2f, 0.3f, 0.5f, 0.75f, 1.0f, 1.5f };
+static const float SweepK2[] = { -1.0f, -0.5f, -0.25f, 0.0f, 0.1f, 0.25f, 0.5f, 0.75f };
+static const float SweepK3[] = { -0.25f, -0.1f, 0.0f, 0.1f, 0.25f, 0.5f };
+static const float SweepXset[] = { 30.0f, 40.0f, 50.0f, 60.0f, 70.0f };
+static const float SweepDeltaV[] = { 0.5f, 1.0f, 2.5f, 5.0f, 10.0f };
+
+#define SWEEP_QTY(a)   (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    ACC_Sweep_t               *p_sweep;
+    const ACC_SweepScenario_t *p_scn;
+    ACC_SweepIsa_t             isa;
+    atomic_uint                next;
+} Sweep_Job_t;
+
+static void *Sweep_Worker(void *p_arg)
+{
+    Sweep_Job_t *p_job = p_arg;
+    uint32_t lo, hi;
+
+    while ((lo = atomic_fetch_add(&p_job->next, SWEEP_CHUNK)) < p_job->p_sweep->n)
+    {
+        hi = (lo + SWEEP_CHUNK < p_job->p_sweep->n) ? lo + SWEEP_CHUNK : p_job->p_sweep->n;
+        Sweep_Reset(p_job->p_sweep, p_job->p_scn, lo, hi);
+        Sweep_Run(p_job->p_sweep, p_job->p_scn, lo, hi, p_job->isa);
+    }
+    return NULL;
+}
+
+// Returns the wall time in s
+static double Sweep_Parallel(ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn,
+                             ACC_SweepIsa_t isa, uint32_t threads)
+{
+    Sweep_Job_t job = { p_sweep, p_scn, isa, 0u };
+    pthread_t tid[64];
+    struct timespec t0, t1;
+    uint32_t i;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0u; i < threads; i++)
+    {
+        pthread_create(&tid[i], NULL, Sweep_Worker, &job);
+    }
+    for (i = 0u; i < threads; i++)
+    {
+        pthread_join(tid[i], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    return (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+}
+
+static void Sweep_Load(ACC_Sweep_t *p_sweep)
+{
+    uint32_t i = 0u, a, b, c, d, e;
+
+    // Candidate 0: current defaults
+    p_sweep->K1[i] = SWEEP_K1_DEFAULT;
+    p_sweep->K2[i] = SWEEP_K2_DEFAULT;
+    p_sweep->K3[i] = SWEEP_K3_DEFAULT;
+    p_sweep->Xset[i] = SWEEP_XSET_DEFAULT;
+    p_sweep->deltaV[i] = SWEEP_DV_DEFAULT;
+    i++;
+    for (a = 0u; a < SWEEP_QTY(SweepK1); a++)
+    for (b = 0u; b < SWEEP_QTY(SweepK2); b++)
+    for (c = 0u; c < SWEEP_QTY(SweepK3); c++)
+    for (d = 0u; d < SWEEP_QTY(SweepXset); d++)
+    for (e = 0u; e < SWEEP_QTY(SweepDeltaV); e++)
+    {
+        p_sweep->K1[i] = SweepK1[a];
+        p_sweep->K2[i] = SweepK2[b];
+        p_sweep->K3[i] = SweepK3[c];
+        p_sweep->Xset[i] = SweepXset[d];
+        p_sweep->deltaV[i] = SweepDeltaV[e];
+        i++;
+    }
+    // Padding lanes repeat the defaults and are never ranked
+    for (; i < p_sweep->n; i++)
+    {
+        p_sweep->K1[i] = SWEEP_K1_DEFAULT;
+        p_sweep->K2[i] = SWEEP_K2_DEFAULT;
+        p_sweep->K3[i] = SWEEP_K3_DEFAULT;
+        p_sweep->Xset[i] = SWEEP_XSET_DEFAULT;
+        p_sweep->deltaV[i] = SWEEP_DV_DEFAULT;
+    }
+    for (i = 0u; i < p_sweep->n; i++)
+    {
+        p_sweep->Vcruise[i] = SWEEP_VCRUISE;
+    }
+}
+
+// Lead car: cruises, brakes to 60 km/h, holds, returns to cruise
+static void Sweep_Scenario(ACC_SweepScenario_t *p_scn, float *lead, uint32_t steps)
+{
+    uint32_t k;
+
+    p_scn->steps = steps;
+    p_scn->dt = (float)TIMER_PERIOD_MS / 1000.0f;
+    p_scn->lead_speed = lead;
+    p_scn->gap0 = 80.0f;
+    p_scn->speed0 = 90.0f;
+    p_scn->accel_gain = 2.0f;
+    p_scn->accel_limit = 10.0f;
+    p_scn->settle_band = 2.0f;
+    for (k = 0u; k < steps; k++)
+    {
+        float t = (float)k * p_scn->dt;
+
+        if (t < 30.0f)
+        {
+            lead[k] = 95.0f;
+        }
+        else if (t < 40.0f)
+        {
+            lead[k] = 95.0f - 3.5f * (t - 30.0f);
+        }
+        else if (t < 70.0f)
+        {
+            lead[k] = 60.0f;
+        }
+        else if (t < 80.0f)
+        {
+            lead[k] = 60.0f + 3.5f * (t - 70.0f);
+        }
+        else
+        {
+            lead[k] = 95.0f;
+        }
+    }
+}
+
+static float Sweep_Score(const ACC_Sweep_t *p_sweep, const ACC_SweepScenario_t *p_scn, uint32_t i)
+{
+    float settle = (p_sweep->last_unsettled[i] + 1.0f) * p_scn->dt;
+    float gap_short = p_sweep->Xset[i] - p_sweep->min_gap[i];
+    float score = settle + SWEEP_W_OVERSHOOT * p_sweep->overshoot[i];
+
+    if (gap_short > 0.0f)
+    {
+        score += SWEEP_W_GAP * gap_short;
+    }
+    if (p_sweep->min_gap[i] <= 0.0f)
+    {
+        score += SWEEP_COLLISION;
+    }
+    return score;
+}
+
+// Shortest fixed-point decimal that reads back as the same float
+static const char *Sweep_Float(float f, char *buf, size_t len)
+{
+    int digits;
+
+    for (digits = 0; digits < 9; digits++)
+    {
+        snprintf(buf, len, "%.*f", digits, (double)f);
+        if (strtof(buf, NULL) == f)
+        {
+            break;
+        }
+    }
+    if (strchr(buf, '.') == NULL)
+    {
+        strncat(buf, ".0", len - strlen(buf) - 1u);
+    }
+    return buf;
+}
+
+static int Sweep_Same(const ACC_Sweep_t *p_a, const ACC_Sweep_t *p_b)
+{
+    const float *const a[] = { p_a->Vset, p_a->Xn, p_a->Vn, p_a->Vn1, p_a->Vn2, p_a->dMn,
+                               p_a->gap, p_a->speed, p_a->overshoot, p_a->min_gap, p_a->last_unsettled };
+    const float *const b[] = { p_b->Vset, p_b->Xn, p_b->Vn, p_b->Vn1, p_b->Vn2, p_b->dMn,
+                               p_b->gap, p_b->speed, p_b->overshoot, p_b->min_gap, p_b->last_unsettled };
+    uint32_t i;
+
+    for (i = 0u; i < SWEEP_QTY(a); i++)
+    {
+        if (memcmp(a[i], b[i], p_a->n * sizeof(float)) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static const float *SweepScores;
+
+static int Sweep_Compare(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    if (SweepScores[x] != SweepScores[y])
+    {
+        return (SweepScores[x] < SweepScores[y]) ? -1 : 1;
+    }
+    return (x > y) - (x < y);
+}
+
+static uint32_t Sweep_Env(const char *name, uint32_t dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (uint32_t)atoi(env) : dflt;
+}
+
+int main(void)
+{
+    const uint32_t qty = 1u + (uint32_t)(SWEEP_QTY(SweepK1) * SWEEP_QTY(SweepK2) * SWEEP_QTY(SweepK3) *
+                                         SWEEP_QTY(SweepXset) * SWEEP_QTY(SweepDeltaV));
+    ACC_Sweep_t sweep[ACC_SWEEP_ISA_QTY];
+    ACC_SweepScenario_t scn;
+    ACC_SweepIsa_t isa, isa_hi = Sweep_IsaBest();
+    const char *env_isa = getenv("SWEEP_ISA");
+    uint32_t threads = Sweep_Env("SWEEP_THREADS", (uint32_t)sysconf(_SC_NPROCESSORS_ONLN));
+    uint32_t steps = Sweep_Env("SWEEP_SECONDS", 120u) * 1000u / TIMER_PERIOD_MS;
+    uint32_t i, j, defaults_rank = 0u;
+    float *lead = malloc(steps * sizeof(float));
+    float *score = malloc(qty * sizeof(float));
+    uint32_t *order = malloc(qty * sizeof(uint32_t));
+    char buf[5][32];
+    int rc = 0;
+
+    if (threads > 64u)
+    {
+        threads = 64u;
+    }
+    if (env_isa != NULL)
+    {
+        for (isa = ACC_SWEEP_ISA_SCALAR; isa <= Sweep_IsaBest(); isa++)
+        {
+            if (strcmp(env_isa, Sweep_IsaName(isa)) == 0)
+            {
+                isa_hi = isa;
+            }
+        }
+    }
+
+    Sweep_Scenario(&scn, lead, steps);
+    printf("Gain sweep: %u candidates x %u cycles (%.0f s scenario), %u threads\n",
+           (unsigned)qty, (unsigned)steps, (double)steps * scn.dt, (unsigned)threads);
+
+    // Scalar reference first (Control_Law_Float), then each SIMD width against it
+    for (isa = ACC_SWEEP_ISA_SCALAR; isa <= isa_hi; isa++)
+    {
+        double secs;
+
+        if (Sweep_Alloc(&sweep[isa], qty) != 0)
+        {
+            fprintf(stderr, "acc_tune: out of memory\n");
+            return 2;
+        }
+        Sweep_Load(&sweep[isa]);
+        secs = Sweep_Parallel(&sweep[isa], &scn, isa, threads);
+        printf("  %-6s %8.3f s  %8.1f M candidate-cycles/s", Sweep_IsaName(isa), secs,
+               (double)sweep[isa].n * steps / secs / 1e6);
+        if (isa == ACC_SWEEP_ISA_SCALAR)
+        {
+            printf("  (reference)\n");
+        }
+        else if (Sweep_Same(&sweep[isa], &sweep[ACC_SWEEP_ISA_SCALAR]))
+        {
+            printf("  bit-identical to scalar\n");
+        }
+        else
+        {
+            printf("  MISMATCH vs scalar\n");
+            rc = 1;
+        }
+    }
+    isa = isa_hi;
+
+    // Rank all candidates; ties keep grid order
+    for (i = 0u; i < qty; i++)
+    {
+        score[i] = Sweep_Score(&sweep[isa], &scn, i);
+        order[i] = i;
+    }
+    SweepScores = score;
+    qsort(order, qty, sizeof(order[0]), Sweep_Compare);
+    for (i = 0u; i < qty; i++)
+    {
+        if (order[i] == 0u)
+        {
+            defaults_rank = i + 1u;
+        }
+    }
+
+    printf("  %-4s %7s %7s %7s %6s %6s %10s %9s %9s %9s\n",
+           "rank", "K1", "K2", "K3", "Xset", "dV", "overshoot", "min gap", "settle", "score");
+    for (j = 0u; j < SWEEP_TOP + 1u; j++)
+    {
+        uint32_t c = (j < SWEEP_TOP) ? order[j] : 0u;
+
+        if (j == SWEEP_TOP)
+        {
+            printf("  main.c defaults, rank %u of %u:\n", (unsigned)defaults_rank, (unsigned)qty);
+        }
+        printf("  %-4u %7.3f %7.3f %7.3f %6.1f %6.2f %10.2f %9.2f %9.1f %9.2f\n",
+               (unsigned)((j < SWEEP_TOP) ? j + 1u : defaults_rank),
+               (double)sweep[isa].K1[c], (double)sweep[isa].K2[c], (double)sweep[isa].K3[c],
+               (double)sweep[isa].Xset[c], (double)sweep[isa].deltaV[c],
+               (double)sweep[isa].overshoot[c], (double)sweep[isa].min_gap[c],
+               (double)((sweep[isa].last_unsettled[c] + 1.0f) * scn.dt), (double)score[c]);
+    }
+
+    // Same float values the sweep evaluated, so the winner behaves identically
+    printf("  main.c defaults for the winner:\n");
+    printf("    Parameters.config.K1 = ACC_VALUE(%s);\n", Sweep_Float(sweep[isa].K1[order[0]], buf[0], sizeof(buf[0])));
+    printf("    Parameters.config.K2 = ACC_VALUE(%s);\n", Sweep_Float(sweep[isa].K2[order[0]], buf[1], sizeof(buf[1])));
+    printf("    Parameters.config.K3 = ACC_VALUE(%s);\n", Sweep_Float(sweep[isa].K3[order[0]], buf[2], sizeof(buf[2])));
+    printf("    Parameters.config.Xset = ACC_VALUE(%s);\n", Sweep_Float(sweep[isa].Xset[order[0]], buf[3], sizeof(buf[3])));
+    printf("    Parameters.config.deltaV = ACC_VALUE(%s);\n", Sweep_Float(sweep[isa].deltaV[order[0]], buf[4], sizeof(buf[4])));
+
+    for (isa = ACC_SWEEP_ISA_SCALAR; isa <= isa_hi; isa++)
+    {
+        Sweep_Free(&sweep[isa]);
+    }
+    free(lead);
+    free(score);
+    free(order);
+    return rc;
+}
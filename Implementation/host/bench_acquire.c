@@ -0,0 +1,335 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_acquire.h"
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Oversampled acquisition: block filter check, noise reduction, cost and
+// ping-pong check
+//
+// 1. Check: Filter_Block() against a reference (sort-based median of 5,
+//    mean in double) on random blocks; a block of equal samples, and one
+//    with isolated spikes (never more than 2 in a median window), must
+//    filter to exactly the constant.
+// 2. Noise: RMS error of a single sample, of the plain block mean and of
+//    Filter_Block() for Gaussian noise with and without spikes.
+// 3. Cost: ns per Filter_Block() on constant, random, spiky and sorted data.
+//    The filter has no data-dependent branches, so the rows should agree.
+// 4. Ping-pong: a producer thread fills blocks of equal samples (block k
+//    holds k) while a consumer thread takes, reads and releases them like
+//    Sensors_Task, yielding halfway through every 4th read so the producer
+//    overwrites blocks under it. A block released intact must be whole and
+//    be the block taken; every take must end intact or as a counted overrun.
+//
+// Environment:
+//   BENCH_BLOCKS    blocks per check and noise row (default 200000)
+//   BENCH_ITER      Filter_Block() calls timed per data set (default 2000000)
+//   BENCH_SECONDS   ping-pong run time (default 2)
+//   BENCH_SEED      noise seed (default 1)
+
+#if ACC_OVERSAMPLE_EN
+
+#define BENCH_SET_QTY          64u      // Blocks per timed data set (cycled)
+#define BENCH_TOL              1e-4     // Reference tolerance (float rounding, Q16.16 halving)
+#define BENCH_LEVEL            60.0     // Mean of the noisy blocks
+
+static ACC_Value_t BenchSet[BENCH_SET_QTY][ACC_OVERSAMPLE_N];
+static CPU_INT64U BenchRng;
+
+static ACC_PingPong_t BenchPP;
+static volatile CPU_BOOLEAN BenchDone;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (double)((BenchRng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+static double Bench_Gauss(double sigma)
+{
+    double u1 = Bench_Uniform() + 1e-300;
+    double u2 = Bench_Uniform();
+
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Noisy block around BENCH_LEVEL: Gaussian sigma, spikes of +-15 with probability p_spike
+static void Bench_Block(ACC_Value_t x[ACC_OVERSAMPLE_N], double sigma, double p_spike)
+{
+    CPU_INT32U i;
+
+    for (i = 0u; i < ACC_OVERSAMPLE_N; i++)
+    {
+        double v = BENCH_LEVEL + Bench_Gauss(sigma);
+
+        if (Bench_Uniform() < p_spike)
+        {
+            v += (Bench_Uniform() < 0.5) ? 15.0 : -15.0;
+        }
+        x[i] = ACC_VALUE_FROM_FLOAT((float)v);
+    }
+}
+
+static double Bench_Reference(const ACC_Value_t x[ACC_OVERSAMPLE_N])
+{
+    double sum = 0.0;
+    CPU_INT32U i, j, k;
+
+    for (i = 0u; i < ACC_OVERSAMPLE_TAPS; i++)
+    {
+        double w[FILTER_MEDIAN_LEN];
+
+        for (j = 0u; j < FILTER_MEDIAN_LEN; j++)
+        {
+            w[j] = (double)ACC_VALUE_TO_FLOAT(x[i + j]);
+            for (k = j; k > 0u && w[k - 1u] > w[k]; k--)
+            {
+                double t = w[k];
+
+                w[k] = w[k - 1u];
+                w[k - 1u] = t;
+            }
+        }
+        sum += w[FILTER_MEDIAN_LEN / 2u];
+    }
+    return sum / ACC_OVERSAMPLE_TAPS;
+}
+
+static CPU_INT32U Bench_Check(CPU_INT32U blocks)
+{
+    ACC_Value_t x[ACC_OVERSAMPLE_N];
+    ACC_Value_t c = ACC_VALUE_FROM_FLOAT(87.3f);
+    double err, err_max = 0.0;
+    CPU_INT32U i, errors = 0u;
+
+    for (i = 0u; i < blocks; i++)
+    {
+        Bench_Block(x, 2.0, 0.05);
+        err = fabs((double)ACC_VALUE_TO_FLOAT(Filter_Block(x)) - Bench_Reference(x));
+        if (err > err_max)
+        {
+            err_max = err;
+        }
+        if (err > BENCH_TOL)
+        {
+            errors++;
+        }
+    }
+
+    for (i = 0u; i < ACC_OVERSAMPLE_N; i++)
+    {
+        x[i] = c;
+    }
+    if (Filter_Block(x) != c)
+    {
+        errors++;
+    }
+    for (i = 0u; i < ACC_OVERSAMPLE_N; i += 3u)
+    {
+        x[i] = ACC_VALUE_FROM_FLOAT((i % 2u == 0u) ? 250.0f : 0.0f);
+    }
+    if (Filter_Block(x) != c)
+    {
+        errors++;
+    }
+
+    printf("filter check: %u random blocks, max error %.2e (tolerance %.0e), constant and spiky blocks %s\n",
+           (unsigned)blocks, err_max, BENCH_TOL, (errors == 0u) ? "exact" : "FAIL");
+    return errors;
+}
+
+static void Bench_Noise(CPU_INT32U blocks)
+{
+    static const struct { const char *name; double sigma; double p_spike; } rows[] = {
+        { "gauss 0.5",             0.5, 0.00 },
+        { "gauss 0.5 + 2% spikes", 0.5, 0.02 },
+        { "gauss 0.5 + 5% spikes", 0.5, 0.05 },
+    };
+    ACC_Value_t x[ACC_OVERSAMPLE_N];
+    CPU_INT32U r, i, j;
+
+    printf("noise (%u blocks of %u samples, spikes +-15)\n", (unsigned)blocks, (unsigned)ACC_OVERSAMPLE_N);
+    printf("  %-22s %9s %9s %9s %9s\n", "input", "raw RMS", "mean RMS", "filt RMS", "reduction");
+    for (r = 0u; r < sizeof(rows) / sizeof(rows[0]); r++)
+    {
+        double se_raw = 0.0, se_mean = 0.0, se_filt = 0.0;
+
+        for (i = 0u; i < blocks; i++)
+        {
+            double sum = 0.0, e;
+
+            Bench_Block(x, rows[r].sigma, rows[r].p_spike);
+            for (j = 0u; j < ACC_OVERSAMPLE_N; j++)
+            {
+                sum += (double)ACC_VALUE_TO_FLOAT(x[j]);
+            }
+            e = (double)ACC_VALUE_TO_FLOAT(x[ACC_OVERSAMPLE_N - 1u]) - BENCH_LEVEL;
+            se_raw += e * e;
+            e = sum / ACC_OVERSAMPLE_N - BENCH_LEVEL;
+            se_mean += e * e;
+            e = (double)ACC_VALUE_TO_FLOAT(Filter_Block(x)) - BENCH_LEVEL;
+            se_filt += e * e;
+        }
+        printf("  %-22s %9.4f %9.4f %9.4f %8.1fx\n", rows[r].name,
+               sqrt(se_raw / blocks), sqrt(se_mean / blocks), sqrt(se_filt / blocks),
+               sqrt(se_raw / se_filt));
+    }
+}
+
+static void Bench_Cost(CPU_INT32U iter)
+{
+    static const char *names[] = { "constant", "random", "spiky 5%", "ascending", "descending" };
+    volatile ACC_Value_t sink = 0;
+    CPU_INT32U s, i, j;
+    CPU_TS64 t0;
+
+    printf("filter cost (%u calls per data set, %u taps + median of %u)\n",
+           (unsigned)iter, (unsigned)ACC_OVERSAMPLE_TAPS, (unsigned)FILTER_MEDIAN_LEN);
+    for (s = 0u; s < sizeof(names) / sizeof(names[0]); s++)
+    {
+        for (i = 0u; i < BENCH_SET_QTY; i++)
+        {
+            switch (s)
+            {
+                case 0u:  Bench_Block(BenchSet[i], 0.0, 0.0);   break;
+                case 1u:  Bench_Block(BenchSet[i], 20.0, 0.0);  break;
+                case 2u:  Bench_Block(BenchSet[i], 0.5, 0.05);  break;
+                default:
+                    for (j = 0u; j < ACC_OVERSAMPLE_N; j++)
+                    {
+                        BenchSet[i][j] = ACC_VALUE_FROM_FLOAT((float)((s == 3u) ? j : ACC_OVERSAMPLE_N - j));
+                    }
+                    break;
+            }
+        }
+        t0 = CPU_TS_Get64();
+        for (i = 0u; i < iter; i++)
+        {
+            sink += Filter_Block(BenchSet[i & (BENCH_SET_QTY - 1u)]);
+        }
+        printf("  %-12s %8.1f ns\n", names[s], (double)(CPU_TS_Get64() - t0) / iter);
+    }
+    (void)sink;
+}
+
+// Block k holds k in every sample (exact in both value types)
+static ACC_Value_t Bench_Seq(CPU_INT32U k)
+{
+    return ACC_VALUE_FROM_FLOAT((float)(k & 0x7FFFu));
+}
+
+static void *Bench_Producer(void *p_arg)
+{
+    CPU_INT32U n = 0u;
+
+    (void)p_arg;
+    while (!BenchDone)
+    {
+        ACC_Value_t v = Bench_Seq(BenchPP.done + 1u);
+
+        PingPong_Put(&BenchPP, v, v);
+        if ((++n % 13u) == 0u)
+        {
+            sched_yield();              // Let the consumer in on a single CPU too
+        }
+    }
+    return NULL;
+}
+
+static CPU_INT32U Bench_PingPong(CPU_INT32U seconds)
+{
+    pthread_t producer;
+    CPU_INT64U takes = 0u, intact = 0u;
+    CPU_INT32U errors = 0u;
+    CPU_TS64 t_end;
+
+    PingPong_Init(&BenchPP);
+    BenchDone = false;
+    pthread_create(&producer, NULL, Bench_Producer, NULL);
+    t_end = CPU_TS_Get64() + (CPU_TS64)seconds * 1000000000u;
+    while (CPU_TS_Get64() < t_end)
+    {
+        const ACC_SensorBlock_t *p_blk;
+        CPU_BOOLEAN whole = true;
+        ACC_Value_t first;
+        uint32_t seq;
+        CPU_INT32U i;
+
+        p_blk = PingPong_Take(&BenchPP, &seq);
+        if (p_blk == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+        takes++;
+        first = p_blk->dist[0];
+        for (i = 0u; i < ACC_OVERSAMPLE_N; i++)
+        {
+            whole = whole && p_blk->dist[i] == first && p_blk->speed[i] == first;
+            if ((takes % 4u) == 0u && (i % 4u) == 3u)
+            {
+                sched_yield();          // Slow read: let the producer overrun the block
+            }
+        }
+        if (PingPong_Release(&BenchPP, seq))
+        {
+            intact++;
+            if (!whole || first != Bench_Seq(seq))
+            {
+                errors++;
+            }
+        }
+    }
+    BenchDone = true;
+    pthread_join(producer, NULL);
+
+    if (intact + BenchPP.overruns != takes)
+    {
+        errors++;
+    }
+    printf("ping-pong check: %u blocks produced, %llu taken, %llu intact, %u overrun, %u errors\n",
+           (unsigned)BenchPP.done, (unsigned long long)takes, (unsigned long long)intact,
+           (unsigned)BenchPP.overruns, (unsigned)errors);
+    return errors;
+}
+
+int main(void)
+{
+    CPU_INT32U blocks = Bench_Env("BENCH_BLOCKS", 200000u);
+    CPU_INT32U errors;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    errors = Bench_Check(blocks);
+    Bench_Noise(blocks);
+    Bench_Cost(Bench_Env("BENCH_ITER", 2000000u));
+    errors += Bench_PingPong(Bench_Env("BENCH_SECONDS", 2u));
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("oversampled acquisition disabled (ACC_OVERSAMPLE_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_OVERSAMPLE_EN
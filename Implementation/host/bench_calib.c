@@ -0,0 +1,573 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_calib.h"
+#include "acc_params.h"
+#include "acc_seqlock.h"
+#include "bench_util.h"
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Calibration sets: table lookup, image checks, the double-buffer protocol,
+// and hot swaps under a writer running flat out
+//
+// 1. Interpolation: random tables (increasing breakpoints, gains within
+//    CALIB_K_MAX) at random ego speeds, below, inside and beyond the
+//    breakpoints. Calib_Gains() must agree with a double-precision reference
+//    within BENCH_TOL.
+// 2. Checks: every single-bit flip of a valid image must fail the CRC, and
+//    each out-of-range field (CRC recomputed) must fail the range check.
+//    Neither may change the set in force.
+// 3. Protocol: a random sequence of valid writes, rejected writes and frame
+//    boundaries against a model of what Control must see. The set Control
+//    holds must keep its version and CRC across every write.
+// 4. Hot swap: a writer thread (every BENCH_BAD_EVERY-th image damaged)
+//    and a Control thread on two pinned CPUs for BENCH_MS. Each frame takes
+//    its set with Calib_Frame(), looks up the gains, then re-checks the set's
+//    CRC: a set changed under Control is torn. Versions must never go back.
+//    Reports the frame-boundary cost (Calib_Frame + Calib_Gains) with the
+//    writer idle and busy.
+// 5. Cost: ns per frame for the former configuration snapshot (seqlock,
+//    six values) against Calib_Frame + Calib_Gains, and µs per Calib_Write.
+//
+// Environment:
+//   BENCH_SAMPLES   lookups checked (default 200000)
+//   BENCH_OPS       protocol steps (default 200000)
+//   BENCH_MS        hot-swap run time per writer mode (default 200)
+//   BENCH_ITER      frames timed for the cost (default 5000000)
+//   BENCH_SEED      random seed (default 1)
+
+#if ACC_CALIB_EN
+
+#define BENCH_BAD_EVERY    8u        // Writer: one damaged image in eight
+#define BENCH_LOOKUPS      4u        // Hot swap: gain lookups per frame
+#define BENCH_SET_QTY      4096u     // Speeds per timed set (power of 2)
+#if ACC_FIXED_POINT
+#define BENCH_TOL          5e-3      // Q16.16 slope: 2^-16 over a 30 km/h segment, K step ≤ 10
+#else
+#define BENCH_TOL          1e-4
+#endif
+
+static ACC_Calib_t BenchCal;
+static CPU_INT64U BenchRng;
+static int BenchCpu[2];
+static CPU_BOOLEAN BenchShared;                 // Only one CPU: threads time-share it
+
+// Hot swap
+static atomic_bool BenchStop;
+static atomic_bool BenchWriterBusy;
+static CPU_INT64U *BenchFrameNs;
+static CPU_INT32U BenchFrameMax;
+static CPU_INT32U BenchFrames, BenchTorn, BenchBack;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(CPU_INT64U *p_rng)
+{
+    // xorshift64*
+    *p_rng ^= *p_rng >> 12;
+    *p_rng ^= *p_rng << 25;
+    *p_rng ^= *p_rng >> 27;
+    return (double)((*p_rng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+// Valid random image: breakpoints 5..30 km/h apart from 0..30 km/h
+static void Bench_Image(ACC_CalibImage_t *p_img, uint32_t version, CPU_INT64U *p_rng)
+{
+    double v = 30.0 * Bench_Uniform(p_rng);
+    CPU_INT32U i;
+
+    memset(p_img, 0, sizeof(*p_img));
+    p_img->version = version;
+    p_img->Vcruise = ACC_VALUE_FROM_FLOAT((float)(CALIB_VCRUISE_MIN + (CALIB_VCRUISE_MAX - CALIB_VCRUISE_MIN) * Bench_Uniform(p_rng)));
+    p_img->Xset = ACC_VALUE_FROM_FLOAT((float)(CALIB_XSET_MIN + (CALIB_XSET_MAX - CALIB_XSET_MIN) * Bench_Uniform(p_rng)));
+    p_img->deltaV = ACC_VALUE_FROM_FLOAT((float)(CALIB_DELTAV_MAX * Bench_Uniform(p_rng)));
+    for (i = 0u; i < CALIB_POINTS; i++)
+    {
+        p_img->V[i] = ACC_VALUE_FROM_FLOAT((float)v);
+        p_img->K1[i] = ACC_VALUE_FROM_FLOAT((float)(CALIB_K_MAX * Bench_Uniform(p_rng)));
+        p_img->K2[i] = ACC_VALUE_FROM_FLOAT((float)(CALIB_K_MAX * Bench_Uniform(p_rng)));
+        p_img->K3[i] = ACC_VALUE_FROM_FLOAT((float)(CALIB_K_MAX * Bench_Uniform(p_rng)));
+        v += 5.0 + 25.0 * Bench_Uniform(p_rng);
+    }
+    p_img->crc = Calib_Crc(p_img);
+}
+
+// Piecewise linear over the stored breakpoints, ends held
+static double Bench_Ref(const ACC_CalibImage_t *p_img, const ACC_Value_t K[CALIB_POINTS], double vn)
+{
+    CPU_INT32U i;
+
+    if (vn <= ACC_VALUE_TO_FLOAT(p_img->V[0]))
+    {
+        return ACC_VALUE_TO_FLOAT(K[0]);
+    }
+    for (i = 0u; i + 1u < CALIB_POINTS; i++)
+    {
+        double v0 = ACC_VALUE_TO_FLOAT(p_img->V[i]), v1 = ACC_VALUE_TO_FLOAT(p_img->V[i + 1u]);
+
+        if (vn <= v1)
+        {
+            double t = (vn - v0) / (v1 - v0);
+
+            return ACC_VALUE_TO_FLOAT(K[i]) + t * (ACC_VALUE_TO_FLOAT(K[i + 1u]) - ACC_VALUE_TO_FLOAT(K[i]));
+        }
+    }
+    return ACC_VALUE_TO_FLOAT(K[CALIB_POINTS - 1u]);
+}
+
+// 1. Calib_Gains() against the reference
+static CPU_INT32U Bench_Interp(CPU_INT32U samples)
+{
+    ACC_CalibImage_t img;
+    double err_max = 0.0, err_sum = 0.0;
+    CPU_INT32U n;
+
+    for (n = 0u; n < samples; n++)
+    {
+        ACC_Value_t vn, K1, K2, K3;
+        double err;
+
+        if ((n & 63u) == 0u)
+        {
+            Bench_Image(&img, n, &BenchRng);
+            if (Calib_Write(&BenchCal, &img) != CALIB_OK)
+            {
+                printf("  valid image %u refused\n", (unsigned)n);
+                return 1u;
+            }
+            (void)Calib_Frame(&BenchCal);
+        }
+        vn = ACC_VALUE_FROM_FLOAT((float)(-10.0 + (CALIB_V_MAX + 20.0) * Bench_Uniform(&BenchRng)));
+        Calib_Gains(BenchCal.active, vn, &K1, &K2, &K3);
+        err = fabs(ACC_VALUE_TO_FLOAT(K1) - Bench_Ref(&img, img.K1, ACC_VALUE_TO_FLOAT(vn)));
+        err = fmax(err, fabs(ACC_VALUE_TO_FLOAT(K2) - Bench_Ref(&img, img.K2, ACC_VALUE_TO_FLOAT(vn))));
+        err = fmax(err, fabs(ACC_VALUE_TO_FLOAT(K3) - Bench_Ref(&img, img.K3, ACC_VALUE_TO_FLOAT(vn))));
+        err_sum += err;
+        err_max = fmax(err, err_max);
+    }
+    printf("  interpolation   %8u lookups    mean err %.2e  max err %.2e  %s\n",
+           (unsigned)samples, err_sum / samples, err_max, (err_max <= BENCH_TOL) ? "ok" : "FAIL");
+    return (err_max > BENCH_TOL);
+}
+
+// Writes *p_img and expects status; the set in force must not change
+static CPU_INT32U Bench_Refuse(ACC_CalibImage_t *p_img, ACC_CalibStatus_t expect)
+{
+    const ACC_CalibSet_t *p_before = Calib_Frame(&BenchCal);
+    uint32_t version = p_before->img.version;
+    ACC_CalibStatus_t status = Calib_Write(&BenchCal, p_img);
+
+    return (status != expect) || Calib_Frame(&BenchCal) != p_before ||
+           p_before->img.version != version;
+}
+
+// Damages one field of a copy of *p_good (CRC recomputed) and expects a refusal
+#define BENCH_RANGE(field, value)                                   \
+    do {                                                            \
+        img = *p_good;                                              \
+        img.field = (value);                                        \
+        img.crc = Calib_Crc(&img);                                  \
+        range += Bench_Refuse(&img, CALIB_ERR_RANGE);               \
+        range_qty++;                                                \
+    } while (0)
+
+// 2. Damaged and out-of-range images
+static CPU_INT32U Bench_Checks(const ACC_CalibImage_t *p_good)
+{
+    ACC_CalibImage_t img;
+    CPU_INT32U crc = 0u, crc_qty = 0u, range = 0u, range_qty = 0u;
+    size_t byte;
+    CPU_INT32U bit, i;
+
+    for (byte = 0u; byte < sizeof(img); byte++)
+    {
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            img = *p_good;
+            ((uint8_t *)&img)[byte] ^= (uint8_t)(1u << bit);
+            if (memcmp(&img, p_good, sizeof(img)) == 0)
+            {
+                continue;   // Padding: not part of the image
+            }
+            crc += Bench_Refuse(&img, CALIB_ERR_CRC);
+            crc_qty++;
+        }
+    }
+
+    BENCH_RANGE(Vcruise, ACC_VALUE(CALIB_VCRUISE_MIN - 1.0));
+    BENCH_RANGE(Vcruise, ACC_VALUE(CALIB_VCRUISE_MAX + 1.0));
+    BENCH_RANGE(Xset, ACC_VALUE(CALIB_XSET_MIN - 1.0));
+    BENCH_RANGE(Xset, ACC_VALUE(CALIB_XSET_MAX + 1.0));
+    BENCH_RANGE(deltaV, ACC_VALUE(-1.0));
+    BENCH_RANGE(deltaV, ACC_VALUE(CALIB_DELTAV_MAX + 1.0));
+    BENCH_RANGE(V[0], ACC_VALUE(-1.0));
+    BENCH_RANGE(V[CALIB_POINTS - 1u], ACC_VALUE(CALIB_V_MAX + 1.0));
+#if !ACC_FIXED_POINT
+    BENCH_RANGE(Xset, NAN);
+    BENCH_RANGE(K2[0], NAN);
+    BENCH_RANGE(V[1], NAN);
+#endif
+    for (i = 0u; i < CALIB_POINTS; i++)
+    {
+        BENCH_RANGE(K1[i], ACC_VALUE(-0.5));
+        BENCH_RANGE(K2[i], ACC_VALUE(CALIB_K_MAX + 0.5));
+        BENCH_RANGE(K3[i], ACC_VALUE(-0.5));
+        if (i + 1u < CALIB_POINTS)
+        {
+            // Breakpoint at or below the one before, or closer than the minimum step
+            BENCH_RANGE(V[i + 1u], p_good->V[i]);
+            BENCH_RANGE(V[i + 1u], p_good->V[i] + ACC_VALUE(CALIB_V_STEP_MIN / 2.0));
+        }
+    }
+    printf("  damaged images  %8u bit flips  refused %u\n", (unsigned)crc_qty, (unsigned)(crc_qty - crc));
+    printf("  out of range    %8u images     refused %u\n", (unsigned)range_qty, (unsigned)(range_qty - range));
+    return crc + range;
+}
+
+// 3. Random writes and frame boundaries against the expected versions
+static CPU_INT32U Bench_Protocol(CPU_INT32U ops)
+{
+    ACC_CalibImage_t img;
+    const ACC_CalibSet_t *p_held;
+    uint32_t version = 1000u, held, pending = 0u;   // 0: nothing pending
+    CPU_INT32U n, errors = 0u, writes = 0u, refused = 0u, frames = 0u;
+
+    p_held = Calib_Frame(&BenchCal);
+    held = p_held->img.version;
+    for (n = 0u; n < ops; n++)
+    {
+        double op = Bench_Uniform(&BenchRng);
+
+        if (op < 0.4)
+        {
+            Bench_Image(&img, ++version, &BenchRng);
+            errors += (Calib_Write(&BenchCal, &img) != CALIB_OK);
+            pending = version;
+            writes++;
+        }
+        else if (op < 0.6)
+        {
+            // Refused write: takes back (drops) the image pending, if any
+            Bench_Image(&img, ++version, &BenchRng);
+            img.crc ^= 1u;
+            errors += (Calib_Write(&BenchCal, &img) != CALIB_ERR_CRC);
+            pending = 0u;
+            refused++;
+        }
+        else
+        {
+            p_held = Calib_Frame(&BenchCal);
+            if (pending != 0u)
+            {
+                held = pending;
+                pending = 0u;
+            }
+            errors += (p_held->img.version != held);
+            frames++;
+        }
+        // The set Control holds is never written
+        errors += (p_held->img.version != held) || (Calib_Crc(&p_held->img) != p_held->img.crc);
+    }
+    printf("  protocol        %8u steps      %u writes, %u refused, %u frames, errors %u  %s\n",
+           (unsigned)ops, (unsigned)writes, (unsigned)refused, (unsigned)frames, (unsigned)errors,
+           (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// ---------------------------------------------------------------------------
+// 4. Hot swap
+// ---------------------------------------------------------------------------
+
+static void Bench_Pin(int cpu)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// First two CPUs this process may run on
+static void Bench_PickCpus(void)
+{
+    cpu_set_t set;
+    int n = 0;
+
+    BenchCpu[0] = BenchCpu[1] = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE && n < 2; cpu++)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                BenchCpu[n++] = cpu;
+            }
+        }
+    }
+    if (n < 2)
+    {
+        BenchCpu[1] = BenchCpu[0];
+    }
+    BenchShared = (n < 2);
+}
+
+static void *Bench_Writer(void *p_arg)
+{
+    CPU_INT64U rng = 0x9E3779B97F4A7C15ull;
+    ACC_CalibImage_t img;
+    uint32_t version = BenchCal.active->img.version;
+
+    (void)p_arg;
+    Bench_Pin(BenchCpu[1]);
+    while (!atomic_load_explicit(&BenchStop, memory_order_relaxed))
+    {
+        if (!atomic_load_explicit(&BenchWriterBusy, memory_order_relaxed))
+        {
+            sched_yield();
+            continue;
+        }
+        Bench_Image(&img, ++version, &rng);
+        if ((version % BENCH_BAD_EVERY) == 0u)
+        {
+            img.crc ^= 1u;
+        }
+        (void)Calib_Write(&BenchCal, &img);
+    }
+    return NULL;
+}
+
+// Control: frames flat out until run_ns has passed
+static void Bench_Control(CPU_INT64U run_ns)
+{
+    CPU_TS64 start = CPU_TS_Get64();
+    uint32_t last = BenchCal.active->img.version;
+    volatile ACC_Value_t sink = ACC_VALUE(0.0);
+    CPU_INT32U i;
+
+    BenchFrames = BenchTorn = BenchBack = 0u;
+    while (CPU_TS_Get64() - start < run_ns)
+    {
+        const ACC_CalibSet_t *p_set;
+        ACC_Value_t K1, K2, K3;
+        CPU_TS64 t0, t1;
+
+        t0 = CPU_TS_Get64();
+        p_set = Calib_Frame(&BenchCal);
+        Calib_Gains(p_set, ACC_VALUE_FROM_FLOAT((float)(BenchFrames & 255u)), &K1, &K2, &K3);
+        t1 = CPU_TS_Get64();
+        sink = sink + K1 + K2 + K3 + p_set->img.Xset;
+
+        // Rest of the frame: more lookups, then the set must still be whole
+        for (i = 1u; i < BENCH_LOOKUPS; i++)
+        {
+            Calib_Gains(p_set, ACC_VALUE_FROM_FLOAT((float)(i * 60u)), &K1, &K2, &K3);
+            sink = sink + K1;
+        }
+        BenchTorn += (Calib_Crc(&p_set->img) != p_set->img.crc);
+        BenchBack += (p_set->img.version < last);
+        last = p_set->img.version;
+        if (BenchFrames < BenchFrameMax)
+        {
+            BenchFrameNs[BenchFrames] = t1 - t0;
+        }
+        BenchFrames++;
+        if (BenchShared && (BenchFrames & 63u) == 0u)
+        {
+            sched_yield();
+        }
+    }
+    (void)sink;
+}
+
+static CPU_INT32U Bench_HotSwap(CPU_INT64U run_ns)
+{
+    pthread_t writer;
+    Bench_Stats_t stats[2];
+    CPU_INT32U frames[2], swaps[2], writes[2], rejected[2];
+    CPU_INT32U errors = 0u;
+    CPU_INT32U busy;
+
+    Bench_PickCpus();
+    printf("hot swap: Control on CPU %d, writer on CPU %d%s, %u ms per mode\n",
+           BenchCpu[0], BenchCpu[1],
+           BenchShared ? " (one CPU online: threads time-share it)" : "",
+           (unsigned)(run_ns / 1000000u));
+    atomic_store(&BenchStop, false);
+    atomic_store(&BenchWriterBusy, false);
+    pthread_create(&writer, NULL, Bench_Writer, NULL);
+    Bench_Pin(BenchCpu[0]);
+    for (busy = 0u; busy < 2u; busy++)
+    {
+        CPU_INT32U swaps0 = BenchCal.swaps, written0 = BenchCal.written, rejected0 = BenchCal.rejected;
+
+        atomic_store(&BenchWriterBusy, busy != 0u);
+        Bench_Control(run_ns);
+        atomic_store(&BenchWriterBusy, false);
+        frames[busy] = BenchFrames;
+        swaps[busy] = BenchCal.swaps - swaps0;
+        writes[busy] = BenchCal.written - written0;
+        rejected[busy] = BenchCal.rejected - rejected0;
+        Bench_Stats(BenchFrameNs, (BenchFrames < BenchFrameMax) ? BenchFrames : BenchFrameMax, 1.0, &stats[busy]);
+        errors += BenchTorn + BenchBack;
+        printf("  writer %-5s %9u frames  %7u swaps  %7u written  %6u refused  torn %u  back %u\n",
+               busy ? "busy" : "idle", (unsigned)frames[busy], (unsigned)swaps[busy],
+               (unsigned)writes[busy], (unsigned)rejected[busy], (unsigned)BenchTorn, (unsigned)BenchBack);
+    }
+    atomic_store(&BenchStop, true);
+    pthread_join(writer, NULL);
+    // Every valid image is either taken or dropped, never half seen
+    errors += (swaps[1] > writes[1]);
+
+    printf("frame boundary (Calib_Frame + Calib_Gains), ns incl. timer read\n");
+    Bench_PrintStatsHeader("writer");
+    Bench_PrintStatsRow("idle", &stats[0]);
+    Bench_PrintStatsRow("busy", &stats[1]);
+    return errors;
+}
+
+// ---------------------------------------------------------------------------
+// 5. Cost
+// ---------------------------------------------------------------------------
+
+static ACC_ConfigParams_t BenchConfig;
+static ACC_Value_t BenchSpeed[BENCH_SET_QTY];
+
+// Mean ns per frame: the former snapshot of the configuration block
+static double Bench_TimeSnapshot(CPU_INT32U iter)
+{
+    volatile ACC_Value_t sink = ACC_VALUE(0.0);
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        ACC_Value_t K1, K2, K3, Vcruise, Xset, deltaV;
+        uint32_t seq;
+
+        do
+        {
+            seq = Seq_ReadBegin(&BenchConfig.seq);
+            Xset = BenchConfig.Xset;
+            Vcruise = BenchConfig.Vcruise;
+            K1 = BenchConfig.K1;
+            K2 = BenchConfig.K2;
+            K3 = BenchConfig.K3;
+            deltaV = BenchConfig.deltaV;
+        } while (Seq_ReadRetry(&BenchConfig.seq, seq));
+        sink = sink + K1 + K2 + K3 + Vcruise + Xset + deltaV + BenchSpeed[i & (BENCH_SET_QTY - 1u)];
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+// Mean ns per frame: the set taken at the frame boundary, gains looked up
+static double Bench_TimeCalib(CPU_INT32U iter)
+{
+    volatile ACC_Value_t sink = ACC_VALUE(0.0);
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const ACC_CalibSet_t *p_set = Calib_Frame(&BenchCal);
+        ACC_Value_t K1, K2, K3;
+
+        Calib_Gains(p_set, BenchSpeed[i & (BENCH_SET_QTY - 1u)], &K1, &K2, &K3);
+        sink = sink + K1 + K2 + K3 + p_set->img.Vcruise + p_set->img.Xset + p_set->img.deltaV;
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+// Mean µs per accepted Calib_Write (copy, CRC, checks, publish)
+static double Bench_TimeWrite(void)
+{
+    ACC_CalibImage_t img;
+    CPU_TS64 t0, t1;
+    CPU_INT32U i, n = 20000u;
+
+    Bench_Image(&img, 1u, &BenchRng);
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < n; i++)
+    {
+        (void)Calib_Write(&BenchCal, &img);
+    }
+    t1 = CPU_TS_Get64();
+    return (double)(t1 - t0) / (double)n / 1000.0;
+}
+
+int main(void)
+{
+    CPU_INT32U samples = Bench_Env("BENCH_SAMPLES", 200000u);
+    CPU_INT32U ops = Bench_Env("BENCH_OPS", 200000u);
+    CPU_INT64U run_ns = (CPU_INT64U)Bench_Env("BENCH_MS", 200u) * 1000000u;
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 5000000u);
+    ACC_CalibImage_t img;
+    CPU_INT32U errors = 0u;
+    double snap, calib;
+    CPU_INT32U i;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Calibration sets: %u breakpoints, image %u bytes, set %u bytes, %s, tolerance %.0e\n",
+           (unsigned)CALIB_POINTS, (unsigned)sizeof(ACC_CalibImage_t), (unsigned)sizeof(ACC_CalibSet_t),
+           ACC_FIXED_POINT ? "Q16.16" : "float", BENCH_TOL);
+    Bench_Image(&img, 1u, &BenchRng);
+    if (Calib_Init(&BenchCal, &img) != CALIB_OK)
+    {
+        printf("FAIL: valid image refused by Calib_Init\n");
+        return 1;
+    }
+    errors += Bench_Interp(samples);
+    Bench_Image(&img, 2u, &BenchRng);
+    errors += Bench_Checks(&img);
+    errors += Bench_Protocol(ops);
+
+    BenchFrameMax = 4000000u;
+    BenchFrameNs = calloc(BenchFrameMax, sizeof(*BenchFrameNs));
+    errors += Bench_HotSwap(run_ns);
+    free(BenchFrameNs);
+
+    Calib_Flat(&img, 1u, ACC_VALUE(1.0), ACC_VALUE(0.5), ACC_VALUE(0.25),
+               ACC_VALUE(100.0), ACC_VALUE(50.0), ACC_VALUE(5.0));
+    (void)Calib_Init(&BenchCal, &img);
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        BenchSpeed[i] = ACC_VALUE_FROM_FLOAT((float)(150.0 * Bench_Uniform(&BenchRng)));
+    }
+    snap = Bench_TimeSnapshot(iter);
+    calib = Bench_TimeCalib(iter);
+    printf("cost, mean over %u frames\n", (unsigned)iter);
+    printf("  configuration snapshot (seqlock, 6 values)   %8.1f ns\n", snap);
+    printf("  Calib_Frame + Calib_Gains                    %8.1f ns  (%+.1f)\n", calib, calib - snap);
+    printf("  Calib_Write (writer side, per image)         %8.2f us\n", Bench_TimeWrite());
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("calibration sets disabled (ACC_CALIB_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_CALIB_EN
@@ -0,0 +1,154 @@
+#include "os.h"
+#include "acc_display.h"
+#include "acc_lcd_host.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Incremental LCD rendering: bus load per refresh period and rendering check
+//
+// Feeds Display_Update() a synthetic hour of noisy sensor readings (distance
+// and speed drifting sinusoidally with Gaussian noise, ACC toggling every
+// 5 minutes) at several refresh periods, with the mock LCD of acc_lcd_host.c
+// behind LCD_Write(). Per period it reports bus bytes per update and per
+// second against a full redraw at the same period and at DISPLAY_PERIOD_MS,
+// and how often a numeric field changed against plain rounding.
+//
+// Check, after every update:
+//   - the mock panel equals the shadow and received the bytes Display_Update
+//     counted (nothing sent is lost, nothing is sent twice);
+//   - the panel equals a from-scratch render of the shown values;
+//   - each shown value is within half a unit plus DISPLAY_HYST_TENTHS of the
+//     reading (plus half a tenth: readings are compared in rounded tenths).
+//
+// Environment:
+//   BENCH_SECONDS   simulated seconds per period (default 3600)
+//   BENCH_SEED      noise seed (default 1)
+
+static const CPU_INT32U BenchPeriodsMs[] = { 2000u, 1000u, 500u, 200u, 100u };
+
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (double)((BenchRng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+static double Bench_Gauss(double sigma)
+{
+    double u1 = Bench_Uniform() + 1e-300;
+    double u2 = Bench_Uniform();
+
+    return sigma * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+// Expected panel for the shown values
+static void Bench_Render(char out[DISPLAY_ROWS][DISPLAY_COLS + 1u], const ACC_Display_t *p_disp)
+{
+    snprintf(out[0], DISPLAY_COLS + 1u, "Dist %4d m  %3s", (int)p_disp->dist, (p_disp->status != 0u) ? "ON" : "OFF");
+    snprintf(out[1], DISPLAY_COLS + 1u, "Speed %4d km/h ", (int)p_disp->speed);
+}
+
+static bool Bench_Near(int32_t shown, float value)
+{
+    return fabsf((float)shown - value) <= 0.55f + (float)DISPLAY_HYST_TENTHS / 10.0f + 1e-3f;
+}
+
+static CPU_INT32U Bench_Period(CPU_INT32U period_ms, CPU_INT32U seconds)
+{
+    static ACC_Display_t disp;
+    char expect[DISPLAY_ROWS][DISPLAY_COLS + 1u];
+    CPU_INT32U updates = seconds * 1000u / period_ms;
+    CPU_INT32U i, row, errors = 0u;
+    CPU_INT32U changes = 0u, changes_round = 0u;
+    int32_t last_dist = 0, last_speed = 0, round_dist = 0, round_speed = 0;
+    CPU_TS64 t0, t_total = 0u;
+    double rate;
+
+    Display_Init(&disp);
+    memset(&LcdMock, 0, sizeof(LcdMock));
+    for (i = 0u; i < updates; i++)
+    {
+        double t = (double)i * period_ms / 1000.0;
+        float dist = (float)(50.0 + 20.0 * sin(2.0 * M_PI * t / 60.0) + Bench_Gauss(0.2));
+        float speed = (float)(90.0 + 10.0 * sin(2.0 * M_PI * t / 45.0) + Bench_Gauss(0.3));
+        uint8_t status = (uint8_t)(((CPU_INT32U)t / 300u) % 2u == 0u);
+        ACC_Value_t v_dist = ACC_VALUE_FROM_FLOAT(dist);
+        ACC_Value_t v_speed = ACC_VALUE_FROM_FLOAT(speed);
+
+        t0 = CPU_TS_Get64();
+        (void)Display_Update(&disp, v_dist, v_speed, status);
+        t_total += CPU_TS_Get64() - t0;
+
+        // Field changes, against plain rounding of the same readings
+        if (i > 0u)
+        {
+            changes += (disp.dist != last_dist) + (disp.speed != last_speed);
+            changes_round += ((int32_t)lrintf(dist) != round_dist) + ((int32_t)lrintf(speed) != round_speed);
+        }
+        last_dist = disp.dist;
+        last_speed = disp.speed;
+        round_dist = (int32_t)lrintf(dist);
+        round_speed = (int32_t)lrintf(speed);
+
+        Bench_Render(expect, &disp);
+        for (row = 0u; row < DISPLAY_ROWS; row++)
+        {
+            if (memcmp(LcdMock.cell[row], expect[row], DISPLAY_COLS) != 0)
+            {
+                errors++;
+            }
+        }
+        if (!LcdMock_Matches(&disp) ||
+            !Bench_Near(disp.dist, ACC_VALUE_TO_FLOAT(v_dist)) ||
+            !Bench_Near(disp.speed, ACC_VALUE_TO_FLOAT(v_speed)))
+        {
+            errors++;
+        }
+    }
+
+    rate = 1000.0 / period_ms;
+    printf("  %6u %8u %9.2f %6u %10.2f %10.2f %10.1f %9u %9u %s\n",
+           (unsigned)period_ms, (unsigned)updates,
+           (double)disp.bytes / updates, (unsigned)disp.bytes_max,
+           (double)disp.bytes / seconds, (double)DISPLAY_FULL_BYTES * rate,
+           (double)t_total / updates,
+           (unsigned)changes, (unsigned)changes_round,
+           (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+int main(void)
+{
+    CPU_INT32U seconds = Bench_Env("BENCH_SECONDS", 3600u);
+    CPU_INT32U i, errors = 0u;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("incremental LCD rendering (%ux%u cells, %u s per period, full redraw %u bytes = %.2f bytes/s at DISPLAY_PERIOD_MS %u)\n",
+           (unsigned)DISPLAY_ROWS, (unsigned)DISPLAY_COLS, (unsigned)seconds, (unsigned)DISPLAY_FULL_BYTES,
+           (double)DISPLAY_FULL_BYTES * 1000.0 / DISPLAY_PERIOD_MS, (unsigned)DISPLAY_PERIOD_MS);
+    printf("  %6s %8s %9s %6s %10s %10s %10s %9s %9s\n",
+           "T (ms)", "updates", "bytes/upd", "max", "bytes/s", "full B/s", "ns/update", "changes", "rounding");
+    for (i = 0u; i < sizeof(BenchPeriodsMs) / sizeof(BenchPeriodsMs[0]); i++)
+    {
+        errors += Bench_Period(BenchPeriodsMs[i], seconds);
+    }
+    if (errors != 0u)
+    {
+        printf("FAIL: %u rendering errors\n", (unsigned)errors);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include "os.h"
+#include "acc_control.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Q16.16 vs float control law: error bound check and per-cycle cost
+//
+// Check: drives Control_Law_Float() and Control_Law_Fixed() side by side over
+// long random sensor sequences (each with freshly drawn gains, Vcruise, Xset
+// and deltaV), carrying Vset from cycle to cycle exactly like Control_Task.
+// Inputs are drawn on the Q16.16 grid with magnitudes below 256, where a
+// float holds them exactly, so both variants see identical inputs and take
+// the same Equation 1/4 branch. Then per cycle:
+//   - Vset and the error terms are exact in both, so Vset must match exactly;
+//   - Q16.16 dM(n) is within 3 × 2^-17 of the exact value (one rounding per
+//     product, sums are exact), float within 3 × 2^-24 × Σ|Ki·ei| (product
+//     and sum roundings), so |dM_q - dM_f| must not exceed the sum of both.
+// Saturation is checked separately: out-of-range results must clamp to
+// ACC_Q_MAX/ACC_Q_MIN with the right sign, never wrap.
+//
+// Microbenchmark: ns per Control_Law call for each variant over a table of
+// precomputed inputs (calls cross a translation unit, so nothing is folded).
+//
+// Environment:
+//   BENCH_CYCLES   control cycles checked (default 2000000)
+//   BENCH_SEQ_LEN  cycles per random sequence (default 10000)
+//   BENCH_SEED     random seed (default 1)
+//   BENCH_ITER     calls per variant in the microbenchmark (default 20000000)
+
+#define BENCH_TABLE_SIZE   4096u     // Microbenchmark input sets (power of 2)
+
+typedef struct {
+    float Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3;
+} Bench_Input_t;
+
+typedef struct {
+    acc_q_t Xn, Xset, Vcruise, deltaV, Vn, Vn1, Vn2, K1, K2, K3;
+} Bench_InputQ_t;
+
+static CPU_INT64U BenchRng;
+
+static CPU_INT64U Bench_Rand(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return BenchRng * 2685821657736338717ull;
+}
+
+// Uniform value on the Q16.16 grid in [lo, hi) (|lo|, |hi| ≤ 256: exact in float)
+static float Bench_Grid(float lo, float hi)
+{
+    CPU_INT64U span = (CPU_INT64U)((hi - lo) * (float)ACC_Q_ONE);
+
+    return lo + (float)(Bench_Rand() % span) / (float)ACC_Q_ONE;
+}
+
+static acc_q_t Bench_Q(float f)
+{
+    return Q_FromFloat(f);
+}
+
+static void Bench_Draw(Bench_Input_t *p_in)
+{
+    p_in->K1 = Bench_Grid(0.0f, 4.0f);
+    p_in->K2 = Bench_Grid(0.0f, 2.0f);
+    p_in->K3 = Bench_Grid(0.0f, 1.0f);
+    p_in->Vcruise = Bench_Grid(30.0f, 130.0f);
+    p_in->Xset = Bench_Grid(20.0f, 80.0f);
+    p_in->deltaV = Bench_Grid(0.0f, 10.0f);
+    p_in->Vn = Bench_Grid(0.0f, 160.0f);
+    p_in->Vn1 = p_in->Vn;
+    p_in->Vn2 = p_in->Vn;
+    p_in->Xn = p_in->Xset;
+}
+
+// One sensor frame: speed random walk, gap around Xset (below it 3 in 8 frames)
+static void Bench_Step(Bench_Input_t *p_in)
+{
+    float Vn = p_in->Vn + Bench_Grid(-3.0f, 3.0f);
+
+    if (Vn < 0.0f)
+    {
+        Vn = 0.0f;
+    }
+    else if (Vn > 160.0f)
+    {
+        Vn = 160.0f;
+    }
+    p_in->Vn2 = p_in->Vn1;
+    p_in->Vn1 = p_in->Vn;
+    p_in->Vn = Vn;
+    p_in->Xn = p_in->Xset + Bench_Grid(-15.0f, 25.0f);
+}
+
+static CPU_INT32U Bench_CheckSaturation(void)
+{
+    acc_q_t Vset;
+    acc_q_t dM;
+    CPU_INT32U fails = 0u;
+
+    // Large positive error × large gain: clamps high
+    Vset = ACC_Q_CONST(0.0);
+    dM = Control_Law_Fixed(ACC_Q_CONST(100.0), ACC_Q_CONST(50.0), ACC_Q_CONST(30000.0), ACC_Q_CONST(5.0),
+                           ACC_Q_CONST(-30000.0), ACC_Q_CONST(-30000.0), ACC_Q_CONST(-30000.0),
+                           ACC_Q_CONST(100.0), ACC_Q_CONST(100.0), ACC_Q_CONST(100.0), &Vset);
+    fails += (dM != ACC_Q_MAX);
+
+    // Same with negative error: clamps low
+    dM = Control_Law_Fixed(ACC_Q_CONST(100.0), ACC_Q_CONST(50.0), ACC_Q_CONST(-30000.0), ACC_Q_CONST(5.0),
+                           ACC_Q_CONST(30000.0), ACC_Q_CONST(30000.0), ACC_Q_CONST(30000.0),
+                           ACC_Q_CONST(100.0), ACC_Q_CONST(100.0), ACC_Q_CONST(100.0), &Vset);
+    fails += (dM != ACC_Q_MIN);
+
+    // Vset ramp (Equation 4) stops at ACC_Q_MIN instead of wrapping positive
+    Vset = ACC_Q_MIN + ACC_Q_CONST(1.0);
+    (void)Control_Law_Fixed(ACC_Q_CONST(10.0), ACC_Q_CONST(50.0), ACC_Q_CONST(100.0), ACC_Q_CONST(5.0),
+                            ACC_Q_CONST(0.0), ACC_Q_CONST(0.0), ACC_Q_CONST(0.0),
+                            ACC_Q_CONST(1.0), ACC_Q_CONST(0.5), ACC_Q_CONST(0.25), &Vset);
+    fails += (Vset != ACC_Q_MIN);
+
+    // Primitives at the edges
+    fails += (Q_Add(ACC_Q_MAX, ACC_Q_ONE) != ACC_Q_MAX);
+    fails += (Q_Sub(ACC_Q_MIN, ACC_Q_ONE) != ACC_Q_MIN);
+    fails += (Q_Mul(ACC_Q_MIN, -ACC_Q_ONE) != ACC_Q_MAX);
+    fails += (Q_Mul(ACC_Q_CONST(-1.5), ACC_Q_CONST(2.0)) != ACC_Q_CONST(-3.0));
+    fails += (Q_Mul(1, ACC_Q_ONE / 2) != 1 || Q_Mul(-1, ACC_Q_ONE / 2) != -1);   // Half rounds away from zero
+    return fails;
+}
+
+static CPU_INT32U Bench_CheckBounds(CPU_INT32U cycles, CPU_INT32U seq_len)
+{
+    const double q_bound = 3.0 / (double)(2 * ACC_Q_ONE);
+    Bench_Input_t in;
+    float Vset_f = 0.0f;
+    acc_q_t Vset_q = 0;
+    double err, bound, sum_err = 0.0, max_err = 0.0, max_ratio = 0.0;
+    CPU_INT32U fails = 0u, ramps = 0u;
+    CPU_INT32U i;
+
+    for (i = 0u; i < cycles; i++)
+    {
+        float dM_f, e_n, e_n1, e_n2;
+        acc_q_t dM_q;
+
+        if (i % seq_len == 0u)
+        {
+            Bench_Draw(&in);
+            Vset_f = in.Vcruise;
+            Vset_q = Bench_Q(in.Vcruise);
+        }
+        Bench_Step(&in);
+        ramps += (in.Xn < in.Xset);
+
+        dM_f = Control_Law_Float(in.Xn, in.Xset, in.Vcruise, in.deltaV, in.Vn, in.Vn1, in.Vn2,
+                                 in.K1, in.K2, in.K3, &Vset_f);
+        dM_q = Control_Law_Fixed(Bench_Q(in.Xn), Bench_Q(in.Xset), Bench_Q(in.Vcruise), Bench_Q(in.deltaV),
+                                 Bench_Q(in.Vn), Bench_Q(in.Vn1), Bench_Q(in.Vn2),
+                                 Bench_Q(in.K1), Bench_Q(in.K2), Bench_Q(in.K3), &Vset_q);
+
+        e_n = Vset_f - in.Vn;
+        e_n1 = Vset_f - in.Vn1;
+        e_n2 = Vset_f - in.Vn2;
+        bound = q_bound + 3.0 * ldexp(1.0, -24) *
+                (fabs((double)in.K1 * e_n) + fabs((double)in.K2 * e_n1) + fabs((double)in.K3 * e_n2));
+        err = fabs((double)dM_q / (double)ACC_Q_ONE - (double)dM_f);
+
+        if (Q_ToFloat(Vset_q) != Vset_f || err > bound)
+        {
+            if (fails < 5u)
+            {
+                printf("  FAIL cycle %u: dM float %.7f fixed %.7f (|err| %.3g > %.3g) Vset float %.5f fixed %.5f\n",
+                       (unsigned)i, dM_f, Q_ToFloat(dM_q), err, bound, Vset_f, Q_ToFloat(Vset_q));
+            }
+            fails++;
+        }
+        sum_err += err;
+        if (err > max_err)
+        {
+            max_err = err;
+        }
+        if (err / bound > max_ratio)
+        {
+            max_ratio = err / bound;
+        }
+    }
+
+    printf("  %u cycles in %u sequences (%u Equation 4 ramps)\n",
+           (unsigned)cycles, (unsigned)((cycles + seq_len - 1u) / seq_len), (unsigned)ramps);
+    printf("  |dM fixed - dM float|: max %.3g, mean %.3g, worst %.0f %% of bound (Q LSB %.3g)\n",
+           max_err, sum_err / (double)cycles, max_ratio * 100.0, 1.0 / (double)ACC_Q_ONE);
+    return fails;
+}
+
+static void Bench_Cost(CPU_INT32U iter)
+{
+    static Bench_Input_t tbl[BENCH_TABLE_SIZE];
+    static Bench_InputQ_t tbl_q[BENCH_TABLE_SIZE];
+    volatile float sink_f = 0.0f;
+    volatile acc_q_t sink_q = 0;
+    float Vset_f = 100.0f;
+    acc_q_t Vset_q = ACC_Q_CONST(100.0);
+    CPU_TS64 t0, t_f, t_q;
+    Bench_Input_t in;
+    CPU_INT32U i;
+
+    Bench_Draw(&in);
+    for (i = 0u; i < BENCH_TABLE_SIZE; i++)
+    {
+        Bench_Step(&in);
+        tbl[i] = in;
+        tbl_q[i] = (Bench_InputQ_t){ Bench_Q(in.Xn), Bench_Q(in.Xset), Bench_Q(in.Vcruise), Bench_Q(in.deltaV),
+                                     Bench_Q(in.Vn), Bench_Q(in.Vn1), Bench_Q(in.Vn2),
+                                     Bench_Q(in.K1), Bench_Q(in.K2), Bench_Q(in.K3) };
+    }
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const Bench_Input_t *p = &tbl[i & (BENCH_TABLE_SIZE - 1u)];
+
+        sink_f = Control_Law_Float(p->Xn, p->Xset, p->Vcruise, p->deltaV, p->Vn, p->Vn1, p->Vn2,
+                                   p->K1, p->K2, p->K3, &Vset_f);
+        if ((i & (BENCH_TABLE_SIZE - 1u)) == 0u)
+        {
+            Vset_f = 100.0f;    // Keep the ramp in range
+        }
+    }
+    t_f = CPU_TS_Get64() - t0;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const Bench_InputQ_t *p = &tbl_q[i & (BENCH_TABLE_SIZE - 1u)];
+
+        sink_q = Control_Law_Fixed(p->Xn, p->Xset, p->Vcruise, p->deltaV, p->Vn, p->Vn1, p->Vn2,
+                                   p->K1, p->K2, p->K3, &Vset_q);
+        if ((i & (BENCH_TABLE_SIZE - 1u)) == 0u)
+        {
+            Vset_q = ACC_Q_CONST(100.0);
+        }
+    }
+    t_q = CPU_TS_Get64() - t0;
+
+    (void)sink_f;
+    (void)sink_q;
+    printf("  per-cycle cost over %u calls: float %.2f ns, Q16.16 %.2f ns\n",
+           (unsigned)iter, (double)t_f / iter, (double)t_q / iter);
+}
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+int main(void)
+{
+    CPU_INT32U fails;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u) * 0x9E3779B97F4A7C15ull;
+
+    printf("Control law: Q16.16 fixed point vs float\n");
+    fails = Bench_CheckSaturation();
+    printf("  saturation checks: %s\n", fails == 0u ? "ok" : "FAILED");
+    fails += Bench_CheckBounds(Bench_Env("BENCH_CYCLES", 2000000u), Bench_Env("BENCH_SEQ_LEN", 10000u));
+    Bench_Cost(Bench_Env("BENCH_ITER", 20000000u));
+
+    if (fails != 0u)
+    {
+        printf("  %u failures\n", (unsigned)fails);
+        return 1;
+    }
+    return 0;
+}
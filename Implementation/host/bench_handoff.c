@@ -0,0 +1,273 @@
+#include "os.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// The mailbox itself, with the consumer preempted inside Mailbox_Take() on
+// request (preempt case below)
+static void Bench_TakeHook(void);
+#define MAILBOX_TAKE_HOOK()     Bench_TakeHook()
+#include "../acc_mailbox.c"
+
+// Control → Actuator handoff benchmark: former queue path vs latest-value mailbox
+//
+// queue:   Control  OSSemPend(flow) + OSMemGet + OSQPost
+//          Actuator OSQPend + OSSemPost(flow) + OSMemPut
+// mailbox: Control  Mailbox_Post + OSTaskSemPost (only if no wake-up pending)
+//          Actuator OSTaskSemPend + Mailbox_Take
+//
+// A master task releases the Control-like task (PRIO 9) once per iteration and
+// waits for the Actuator-like task (PRIO 10) to finish, so every handoff runs
+// exactly as in one frame. Reported per handoff: kernel calls and ns spent in
+// the producer's post and in the consumer from wake-up to command in hand.
+//
+// preempt: the mailbox with Control released again from inside
+// Mailbox_Take(), between the copy and the taken store, as a late Actuator is
+// preempted by the next frame. Control posts the next command against a
+// stale taken and skips the wake-up; the Actuator must still apply it before
+// it pends again. Fails if a posted command is never applied or the Actuator
+// blocks with one outstanding (missed wake-up, BENCH_TIMEOUT_MS).
+//
+// reset:   as preempt, with Control discarding its own command right after
+// the post (Mailbox_Reset, as Setup_Task on ACC OFF / fault) before the
+// Actuator takes it. The preempted take copies the discarded command while
+// the next one is posted without a wake-up; the Actuator must drop the first,
+// apply the second, and be woken by the post of the next iteration.
+//
+// Environment:
+//   BENCH_ITER   handoffs per variant (default 20000)
+
+#define BENCH_PRIO_MASTER   4u
+#define BENCH_PRIO_CONTROL  9u
+#define BENCH_PRIO_ACTUATOR 10u
+#define BENCH_STK_SIZE      256u
+#define BENCH_Q_SIZE        3u
+#define BENCH_TIMEOUT_MS    1000u     // The master waits this long for the Actuator
+
+typedef enum {
+    BENCH_MODE_QUEUE = 0,
+    BENCH_MODE_MAILBOX,
+    BENCH_MODE_PREEMPT,
+    BENCH_MODE_RESET
+} Bench_Mode_t;
+
+static OS_TCB MasterTCB, ControlTCB, ActuatorTCB;
+static CPU_STK MasterStk[BENCH_STK_SIZE], ControlStk[BENCH_STK_SIZE], ActuatorStk[BENCH_STK_SIZE];
+
+static OS_SEM FlowControlSemaphore;
+static OS_Q ControlActuatorQueue;
+static OS_MEM MessagePartition;
+static ACC_Value_t MessageBufferArray[BENCH_Q_SIZE];
+static ACC_Mailbox_t ControlActuatorMailbox;
+
+static Bench_Mode_t BenchMode;
+static CPU_INT32U BenchIter;
+static CPU_INT32U BenchDone;
+static CPU_INT64U *BenchPostNs, *BenchRecvNs;
+static CPU_INT64U BenchPostCalls, BenchRecvCalls;
+static volatile ACC_Value_t BenchSink;
+static bool BenchPreempt;                   // Next take releases Control from inside
+static bool BenchFromTake;                  // Control released by Bench_TakeHook()
+static CPU_INT32U BenchPreempted, BenchApplied, BenchLastSeq;
+
+// Inside Mailbox_Take(), command copied, taken not stored yet
+static void Bench_TakeHook(void)
+{
+    OS_ERR err;
+
+    if (BenchPreempt)
+    {
+        BenchPreempt = false;
+        BenchPreempted++;
+        BenchFromTake = true;
+        OSTaskSemPost(&ControlTCB, OS_OPT_POST_NONE, &err);    // Control runs and posts now
+    }
+}
+
+static void Bench_ControlTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_TS64 t0;
+    CPU_INT32U calls0;
+    ACC_Value_t *msg_ptr;
+    ACC_Value_t dM = ACC_VALUE(0.0);
+
+    while (1)
+    {
+        OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        dM += ACC_VALUE(1.0);
+
+        calls0 = ControlTCB.KernelCallCtr;
+        t0 = CPU_TS_Get64();
+        if (BenchMode == BENCH_MODE_QUEUE)
+        {
+            OSSemPend(&FlowControlSemaphore, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+            msg_ptr = (ACC_Value_t *)OSMemGet(&MessagePartition, &err);
+            *msg_ptr = dM;
+            OSQPost(&ControlActuatorQueue, (void *)msg_ptr, sizeof(ACC_Value_t), OS_OPT_POST_FIFO, &err);
+        }
+        else
+        {
+            if (Mailbox_Post(&ControlActuatorMailbox, dM, ts))
+            {
+                OSTaskSemPost(&ActuatorTCB, OS_OPT_POST_NONE, &err);
+            }
+            if (BenchMode == BENCH_MODE_RESET && !BenchFromTake)
+            {
+                Mailbox_Reset(&ControlActuatorMailbox);     // Not taken yet: discarded
+            }
+            BenchFromTake = false;
+        }
+        BenchPostNs[BenchDone] = CPU_TS_Get64() - t0;
+        BenchPostCalls += ControlTCB.KernelCallCtr - calls0;
+    }
+}
+
+static void Bench_ActuatorTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_TS64 t0;
+    CPU_INT32U calls0;
+    OS_MSG_SIZE msg_size;
+    ACC_Command_t cmd;
+    ACC_Value_t *dM_ptr;
+
+    while (1)
+    {
+        calls0 = ActuatorTCB.KernelCallCtr;
+        if (BenchMode == BENCH_MODE_QUEUE)
+        {
+            dM_ptr = (ACC_Value_t *)OSQPend(&ControlActuatorQueue, 0, OS_OPT_PEND_BLOCKING, &msg_size, &ts, &err);
+            t0 = CPU_TS_Get64();
+            OSSemPost(&FlowControlSemaphore, OS_OPT_POST_NONE, &err);
+            BenchSink = *dM_ptr;
+            OSMemPut(&MessagePartition, (void *)dM_ptr, &err);
+        }
+        else if (BenchMode == BENCH_MODE_MAILBOX)
+        {
+            OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+            t0 = CPU_TS_Get64();
+            if (!Mailbox_Take(&ControlActuatorMailbox, &cmd))
+            {
+                continue;
+            }
+            BenchSink = cmd.dM;
+        }
+        else
+        {
+            // As Actuator_Task: take until none is left, then pend again
+            OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+            t0 = CPU_TS_Get64();
+            BenchPreempt = true;
+            while (Mailbox_Take(&ControlActuatorMailbox, &cmd))
+            {
+                BenchSink = cmd.dM;
+                BenchApplied++;
+                BenchLastSeq = cmd.seq;
+            }
+            BenchPreempt = false;
+            if (BenchLastSeq != ControlActuatorMailbox.posted)
+            {
+                continue;   // Master times out: the newest command was not applied
+            }
+        }
+        BenchRecvNs[BenchDone] = CPU_TS_Get64() - t0;
+        BenchRecvCalls += ActuatorTCB.KernelCallCtr - calls0;
+        BenchDone++;
+
+        OSTaskSemPost(&MasterTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+static CPU_INT32U Bench_Run(Bench_Mode_t mode, const char *label)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    Bench_Stats_t post, recv;
+    CPU_INT32U i, posted0 = ControlActuatorMailbox.posted;
+
+    BenchMode = mode;
+    BenchDone = 0u;
+    BenchPostCalls = 0u;
+    BenchRecvCalls = 0u;
+    BenchPreempted = 0u;
+    BenchApplied = 0u;
+    for (i = 0u; i < BenchIter; i++)
+    {
+        OSTaskSemPost(&ControlTCB, OS_OPT_POST_NONE, &err);
+        OSTaskSemPend(BENCH_TIMEOUT_MS * OS_CFG_TICK_RATE_HZ / 1000u, OS_OPT_PEND_BLOCKING, &ts, &err);
+        if (err != OS_ERR_NONE)
+        {
+            break;  // Actuator blocked with a command outstanding
+        }
+    }
+    if (mode == BENCH_MODE_PREEMPT || mode == BENCH_MODE_RESET)
+    {
+        CPU_INT32U posted = ControlActuatorMailbox.posted - posted0;
+        // preempt applies every command; reset drops the discarded half
+        CPU_INT32U expect = (mode == BENCH_MODE_RESET) ? posted / 2u : posted;
+        bool ok = (i == BenchIter) && (BenchPreempted == BenchIter) &&
+                  (BenchApplied == expect) && (BenchLastSeq == ControlActuatorMailbox.posted);
+
+        printf("  %s: %u takes preempted, %u commands posted, %u applied, newest applied %s, "
+               "missed wake-up %s  %s\n", label, (unsigned)BenchPreempted, (unsigned)posted,
+               (unsigned)BenchApplied, (BenchLastSeq == ControlActuatorMailbox.posted) ? "yes" : "no",
+               (i < BenchIter) ? "yes" : "no", ok ? "ok" : "FAIL");
+        return ok ? 0u : 1u;
+    }
+
+    Bench_Stats(BenchPostNs, BenchDone, 1.0, &post);
+    Bench_Stats(BenchRecvNs, BenchDone, 1.0, &recv);
+    printf("  %s: %.2f kernel calls per handoff (Control %.2f, Actuator %.2f)\n", label,
+           (double)(BenchPostCalls + BenchRecvCalls) / BenchDone,
+           (double)BenchPostCalls / BenchDone, (double)BenchRecvCalls / BenchDone);
+    Bench_PrintStatsRow("    Control post (ns)", &post);
+    Bench_PrintStatsRow("    Actuator receive (ns)", &recv);
+    return 0u;
+}
+
+static void Bench_MasterTask(void *p_arg)
+{
+    CPU_INT32U errors;
+
+    printf("Control -> Actuator handoff: queue + partition + flow semaphore vs mailbox (host shim)\n");
+    Bench_PrintStatsHeader("");
+    errors = Bench_Run(BENCH_MODE_QUEUE, "queue");
+    errors += Bench_Run(BENCH_MODE_MAILBOX, "mailbox");
+    errors += Bench_Run(BENCH_MODE_PREEMPT, "preempt");
+    errors += Bench_Run(BENCH_MODE_RESET, "reset");
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        exit(1);
+    }
+    exit(0);
+}
+
+int main(void)
+{
+    OS_ERR err;
+    const char *env = getenv("BENCH_ITER");
+
+    BenchIter = (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : 20000u;
+    BenchPostNs = calloc(BenchIter, sizeof(*BenchPostNs));
+    BenchRecvNs = calloc(BenchIter, sizeof(*BenchRecvNs));
+
+    OSInit(&err);
+    OSSemCreate(&FlowControlSemaphore, "Flow Ctrl Sem", BENCH_Q_SIZE, &err);
+    OSQCreate(&ControlActuatorQueue, "Ctrl Act Queue", BENCH_Q_SIZE, &err);
+    OSMemCreate(&MessagePartition, "Msg Partition", (void *)MessageBufferArray, BENCH_Q_SIZE, sizeof(ACC_Value_t), &err);
+    Mailbox_Init(&ControlActuatorMailbox);
+
+    OSTaskCreate(&MasterTCB, "Bench Master", Bench_MasterTask, 0, BENCH_PRIO_MASTER,
+                 &MasterStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&ControlTCB, "Bench Control", Bench_ControlTask, 0, BENCH_PRIO_CONTROL,
+                 &ControlStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&ActuatorTCB, "Bench Actuator", Bench_ActuatorTask, 0, BENCH_PRIO_ACTUATOR,
+                 &ActuatorStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+
+    OSStart(&err);
+    return 0;
+}
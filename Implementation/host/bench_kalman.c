@@ -0,0 +1,442 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_kalman.h"
+#if ACC_RATE_ADAPT_EN
+#include "acc_rate.h"
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Gap / relative-velocity estimator: accuracy on simulated noisy drives and
+// cost per step
+//
+// 1. Accuracy: four drives of BENCH_DRIVE_S, simulated in 10 ms steps and
+//    sampled at the control period (each control-rate level with
+//    ACC_RATE_ADAPT_EN), with KALMAN_SIGMA_X_M / KALMAN_SIGMA_V_KMH Gaussian
+//    noise on the samples:
+//      brake     lead at 100 km/h brakes at 6 m/s² to 40 km/h and pulls away
+//                again; the ego vehicle follows
+//      stop-go   lead speed swinging between 0 and 29 km/h every 20 s
+//      cut-in    a car cuts in 55 m closer and 10 km/h slower than the lead
+//      spikes    brake, with isolated +15 m distance spikes on 2% of samples
+//    RMS errors against the truth of the estimate and of the raw signal it
+//    replaces (Xn, Vn; the relative velocity as the difference of successive
+//    Xn), skipping the first 2 s and the 3 s after the cut-in. The estimate
+//    must beat the raw signal on all three, the cut-in must restart the filter
+//    once, every spike must be rejected without a restart, and the estimate
+//    must follow a double-precision Kalman filter with the full covariance
+//    update within BENCH_REF_TOL (the Q16.16 gain schedule assumes no
+//    skipped updates: BENCH_REF_TOL_SKIP on the spikes drive).
+// 2. Cost: ns per Kalman_Step() and of the double reference.
+//
+// Environment:
+//   BENCH_ITER      steps timed (default 5000000)
+//   BENCH_SEED      noise seed (default 1)
+
+#if ACC_KALMAN_EN
+
+#define BENCH_DRIVE_S      60.0
+#define BENCH_SIM_MS       10u       // Truth integration step
+#define BENCH_SETTLE_S     2.0       // Not scored after a start / the cut-in ...
+#define BENCH_CUTIN_S      20.0
+#define BENCH_CUTIN_SKIP_S 3.0       // ... and for this long after it
+#define BENCH_SPIKE_M      15.0
+#define BENCH_SAMPLES_MAX  (60u * 1000u / 20u + 1u)
+#define BENCH_SET_QTY      4096u     // Samples per timed set (power of 2)
+#if ACC_FIXED_POINT
+#define BENCH_REF_TOL      0.05      // m, m/s: gain schedule vs full update ...
+#define BENCH_REF_TOL_SKIP 0.25      // ... which it no longer matches after a rejected sample
+#else
+#define BENCH_REF_TOL      0.001
+#define BENCH_REF_TOL_SKIP BENCH_REF_TOL
+#endif
+
+enum { BENCH_BRAKE, BENCH_STOPGO, BENCH_CUTIN, BENCH_SPIKES, BENCH_DRIVE_QTY };
+
+static const char *const BenchDriveNames[BENCH_DRIVE_QTY] = { "brake", "stop-go", "cut-in", "spikes" };
+
+typedef struct {
+    double d, vl, ve;               // Truth: gap (m), lead and ego speed (m/s)
+    double Xn, Vn;                  // Samples (m, km/h)
+    bool   spike;
+    bool   scored;
+} BenchSample_t;
+
+// Double-precision reference: same model, gate and restart, full covariance
+// update on every step
+typedef struct {
+    double F[KALMAN_NX][KALMAN_NX];
+    double Q[KALMAN_NX][KALMAN_NX];
+    double x[KALMAN_NX];
+    double P[KALMAN_NX][KALMAN_NX];
+    bool   valid;
+    uint32_t outliers;
+} BenchRef_t;
+
+static BenchSample_t BenchDrive[BENCH_SAMPLES_MAX];
+static ACC_Value_t BenchXn[BENCH_SET_QTY], BenchVn[BENCH_SET_QTY];
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return ((double)((BenchRng * 2685821657736338717ull) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double Bench_Gauss(void)
+{
+    return sqrt(-2.0 * log(Bench_Uniform())) * cos(2.0 * M_PI * Bench_Uniform());
+}
+
+static CPU_INT32U Bench_PeriodMs(CPU_INT32U level)
+{
+#if ACC_RATE_ADAPT_EN
+    return RatePeriodsMs[level];
+#else
+    (void)level;
+    return TIMER_PERIOD_MS;
+#endif
+}
+
+static double Bench_Clamp(double v, double lo, double hi)
+{
+    return (v < lo) ? lo : (v > hi) ? hi : v;
+}
+
+// Truth of one drive sampled every period_ms; returns the sample count
+static CPU_INT32U Bench_Simulate(CPU_INT32U drive, CPU_INT32U period_ms)
+{
+    const double dt = BENCH_SIM_MS / 1000.0;
+    const CPU_INT32U per = period_ms / BENCH_SIM_MS;
+    double d = 50.0, vl = 100.0 / 3.6, ve = 100.0 / 3.6;
+    bool spike = false, cut = false;
+    CPU_INT32U n = 0u, k;
+
+    if (drive == BENCH_STOPGO)
+    {
+        d = 10.0;
+        vl = ve = 4.0;
+    }
+    else if (drive == BENCH_CUTIN)
+    {
+        d = 80.0;
+        vl = ve = 90.0 / 3.6;
+    }
+
+    for (k = 0u; n < BENCH_SAMPLES_MAX && (double)k * dt <= BENCH_DRIVE_S; k++)
+    {
+        double t = (double)k * dt;
+        double al = 0.0, ae;
+
+        if (k % per == 0u)
+        {
+            BenchSample_t *p = &BenchDrive[n++];
+
+            p->d = d;
+            p->vl = vl;
+            p->ve = ve;
+            p->Xn = d + KALMAN_SIGMA_X_M * Bench_Gauss();
+            p->Vn = ve * 3.6 + KALMAN_SIGMA_V_KMH * Bench_Gauss();
+            p->spike = drive == BENCH_SPIKES && !spike && Bench_Uniform() < 0.02;
+            if (p->spike)
+            {
+                p->Xn += BENCH_SPIKE_M;
+            }
+            spike = p->spike;
+            p->scored = t >= BENCH_SETTLE_S &&
+                        !(drive == BENCH_CUTIN && t >= BENCH_CUTIN_S && t < BENCH_CUTIN_S + BENCH_CUTIN_SKIP_S);
+        }
+
+        switch (drive)
+        {
+        case BENCH_BRAKE:
+        case BENCH_SPIKES:
+            al = (t >= 10.0 && vl > 40.0 / 3.6) ? -6.0 : (t >= 30.0 && vl < 100.0 / 3.6) ? 1.5 : 0.0;
+            break;
+        case BENCH_STOPGO:
+            al = 4.0 * 2.0 * M_PI / 20.0 * cos(2.0 * M_PI * t / 20.0);
+            break;
+        default:
+            if (!cut && t >= BENCH_CUTIN_S)
+            {
+                d -= 55.0;
+                vl -= 10.0 / 3.6;
+                cut = true;
+            }
+            break;
+        }
+        // Ego: follows at 5 m + 1.5 s
+        ae = Bench_Clamp(0.5 * (vl - ve) + 0.1 * (d - (5.0 + 1.5 * ve)), -6.0, 2.0);
+        d += (vl - ve) * dt + 0.5 * (al - ae) * dt * dt;
+        vl = fmax(vl + al * dt, 0.0);
+        ve = fmax(ve + ae * dt, 0.0);
+    }
+    return n;
+}
+
+static void Bench_RefInit(BenchRef_t *p_ref, CPU_INT32U period_ms)
+{
+    const double T = period_ms / 1000.0;
+    double gl[KALMAN_NX] = { 0.0 }, ge[KALMAN_NX] = { 0.0 };
+    CPU_INT32U i, j;
+
+    memset(p_ref, 0, sizeof(*p_ref));
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        p_ref->F[i][i] = 1.0;
+    }
+    p_ref->F[0][1] = T;
+    p_ref->F[0][2] = -T;
+    ge[0] = -0.5 * T * T;
+    ge[2] = T;
+#if KALMAN_LEAD_ACCEL
+    p_ref->F[0][3] = 0.5 * T * T;
+    p_ref->F[1][3] = T;
+    gl[0] = T * T * T / 6.0;
+    gl[1] = 0.5 * T * T;
+    gl[3] = T;
+#else
+    gl[0] = 0.5 * T * T;
+    gl[1] = T;
+#endif
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        for (j = 0u; j < KALMAN_NX; j++)
+        {
+            p_ref->Q[i][j] = KALMAN_SIGMA_LEAD * KALMAN_SIGMA_LEAD * gl[i] * gl[j] +
+                             KALMAN_SIGMA_EGO * KALMAN_SIGMA_EGO * ge[i] * ge[j];
+        }
+    }
+}
+
+static void Bench_RefUpdate(BenchRef_t *p_ref, CPU_INT32U m, double z, double r)
+{
+    double K[KALMAN_NX], Pm[KALMAN_NX];
+    double s = p_ref->P[m][m] + r, y = z - p_ref->x[m];
+    CPU_INT32U i, j;
+
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        Pm[i] = p_ref->P[m][i];
+        K[i] = Pm[i] / s;
+        p_ref->x[i] += K[i] * y;
+    }
+    for (i = 0u; i < KALMAN_NX; i++)
+    {
+        for (j = 0u; j < KALMAN_NX; j++)
+        {
+            p_ref->P[i][j] -= K[i] * Pm[j];
+        }
+    }
+}
+
+static void Bench_RefStep(BenchRef_t *p_ref, double Xn, double Vn)
+{
+    const double ve = Vn / 3.6;
+    const double r_x = KALMAN_SIGMA_X_M * KALMAN_SIGMA_X_M;
+    const double r_v = (KALMAN_SIGMA_V_KMH / 3.6) * (KALMAN_SIGMA_V_KMH / 3.6);
+    double x[KALMAN_NX] = { 0.0 }, FP[KALMAN_NX][KALMAN_NX] = { { 0.0 } };
+    CPU_INT32U i, j, k;
+
+    if (p_ref->valid)
+    {
+        for (i = 0u; i < KALMAN_NX; i++)
+        {
+            for (k = 0u; k < KALMAN_NX; k++)
+            {
+                x[i] += p_ref->F[i][k] * p_ref->x[k];
+                for (j = 0u; j < KALMAN_NX; j++)
+                {
+                    FP[i][j] += p_ref->F[i][k] * p_ref->P[k][j];
+                }
+            }
+        }
+        memcpy(p_ref->x, x, sizeof(x));
+        for (i = 0u; i < KALMAN_NX; i++)
+        {
+            for (j = 0u; j < KALMAN_NX; j++)
+            {
+                p_ref->P[i][j] = p_ref->Q[i][j];
+                for (k = 0u; k < KALMAN_NX; k++)
+                {
+                    p_ref->P[i][j] += FP[i][k] * p_ref->F[j][k];
+                }
+            }
+        }
+        if (fabs(Xn - p_ref->x[0]) <= KALMAN_GATE_M)
+        {
+            p_ref->outliers = 0u;
+            Bench_RefUpdate(p_ref, 0u, Xn, r_x);
+        }
+        else if (++p_ref->outliers >= 2u)
+        {
+            p_ref->valid = false;
+        }
+        if (p_ref->valid)
+        {
+            Bench_RefUpdate(p_ref, 2u, ve, r_v);
+            return;
+        }
+    }
+    // (Re)start from the sample
+    memset(p_ref->x, 0, sizeof(p_ref->x));
+    memset(p_ref->P, 0, sizeof(p_ref->P));
+    p_ref->x[0] = Xn;
+    p_ref->x[1] = p_ref->x[2] = ve;
+    p_ref->P[0][0] = r_x;
+    p_ref->P[1][1] = KALMAN_P0_VR * KALMAN_P0_VR;
+    p_ref->P[2][2] = r_v;
+#if KALMAN_LEAD_ACCEL
+    p_ref->P[3][3] = KALMAN_P0_AL * KALMAN_P0_AL;
+#endif
+    p_ref->valid = true;
+    p_ref->outliers = 0u;
+}
+
+static CPU_INT32U Bench_Accuracy(CPU_INT32U drive, CPU_INT32U level)
+{
+    const CPU_INT32U period_ms = Bench_PeriodMs(level);
+    const double T = period_ms / 1000.0;
+    CPU_INT32U count = Bench_Simulate(drive, period_ms);
+    CPU_INT32U spikes = 0u, scored = 0u, errors = 0u;
+    double sx_raw = 0.0, sx_est = 0.0, sr_raw = 0.0, sr_est = 0.0, sv_raw = 0.0, sv_est = 0.0;
+    double ref_max = 0.0;
+    ACC_Kalman_t kf;
+    BenchRef_t ref;
+    CPU_INT32U n;
+
+    Kalman_Reset(&kf);
+    Bench_RefInit(&ref, period_ms);
+    for (n = 0u; n < count; n++)
+    {
+        const BenchSample_t *p = &BenchDrive[n];
+        ACC_Estimate_t est;
+        double Xe, Vr, Ve;
+
+        Kalman_Step(&kf, ACC_VALUE_FROM_FLOAT((float)p->Xn), ACC_VALUE_FROM_FLOAT((float)p->Vn),
+                    (uint8_t)level, &est);
+        Bench_RefStep(&ref, p->Xn, p->Vn);
+        Xe = ACC_VALUE_TO_FLOAT(est.Xe);
+        Vr = ACC_VALUE_TO_FLOAT(est.Vr);
+        Ve = ACC_VALUE_TO_FLOAT(est.Ve);
+        spikes += p->spike ? 1u : 0u;
+        ref_max = fmax(ref_max, fmax(fabs(Xe - ref.x[0]), fabs(Vr - (ref.x[1] - ref.x[2]))));
+        if (!p->scored || p->spike || n == 0u || BenchDrive[n - 1u].spike)
+        {
+            continue;
+        }
+        scored++;
+        sx_raw += (p->Xn - p->d) * (p->Xn - p->d);
+        sx_est += (Xe - p->d) * (Xe - p->d);
+        sr_raw += pow((p->Xn - BenchDrive[n - 1u].Xn) / T - (p->vl - p->ve), 2.0);
+        sr_est += (Vr - (p->vl - p->ve)) * (Vr - (p->vl - p->ve));
+        sv_raw += (p->Vn - p->ve * 3.6) * (p->Vn - p->ve * 3.6);
+        sv_est += (Ve - p->ve * 3.6) * (Ve - p->ve * 3.6);
+    }
+
+    sx_raw = sqrt(sx_raw / scored);
+    sx_est = sqrt(sx_est / scored);
+    sr_raw = sqrt(sr_raw / scored);
+    sr_est = sqrt(sr_est / scored);
+    sv_raw = sqrt(sv_raw / scored);
+    sv_est = sqrt(sv_est / scored);
+    errors += (sx_est >= sx_raw) + (sr_est >= sr_raw) + (sv_est >= sv_raw) + (ref_max > ((drive == BENCH_SPIKES) ? BENCH_REF_TOL_SKIP : BENCH_REF_TOL));
+    errors += (kf.restarts != ((drive == BENCH_CUTIN) ? 1u : 0u));
+    errors += (kf.rejected != spikes + ((drive == BENCH_CUTIN) ? 1u : 0u));
+
+    printf("  %-8s %4u  %6.3f %6.3f   %7.3f %6.3f   %6.3f %6.3f   %8u %8u   %8.5f  %s\n",
+           BenchDriveNames[drive], (unsigned)period_ms, sx_raw, sx_est, sr_raw, sr_est, sv_raw, sv_est,
+           (unsigned)kf.restarts, (unsigned)kf.rejected, ref_max, (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+static double Bench_Time(bool reference, CPU_INT32U iter)
+{
+    ACC_Kalman_t kf;
+    ACC_Estimate_t est;
+    BenchRef_t ref;
+    volatile double sink = 0.0;
+    CPU_TS64 t0, t1;
+    CPU_INT32U count = Bench_Simulate(BENCH_STOPGO, TIMER_PERIOD_MS);
+    CPU_INT32U i;
+
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        BenchXn[i] = ACC_VALUE_FROM_FLOAT((float)BenchDrive[i % count].Xn);
+        BenchVn[i] = ACC_VALUE_FROM_FLOAT((float)BenchDrive[i % count].Vn);
+    }
+    Kalman_Reset(&kf);
+    Bench_RefInit(&ref, TIMER_PERIOD_MS);
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        CPU_INT32U j = i & (BENCH_SET_QTY - 1u);
+
+        if (reference)
+        {
+            Bench_RefStep(&ref, ACC_VALUE_TO_FLOAT(BenchXn[j]), ACC_VALUE_TO_FLOAT(BenchVn[j]));
+            sink += ref.x[0];
+        }
+        else
+        {
+            Kalman_Step(&kf, BenchXn[j], BenchVn[j], 0u, &est);
+            sink += ACC_VALUE_TO_FLOAT(est.Xe);
+        }
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+int main(void)
+{
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 5000000u);
+    CPU_INT32U errors = 0u;
+    CPU_INT32U drive, level;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    Kalman_Init();
+    printf("Gap / relative-velocity estimator: %u states, %s\n",
+           (unsigned)KALMAN_NX, ACC_FIXED_POINT ? "Q16.16 (gain schedule)" : "float (full update)");
+    printf("accuracy, RMS error after %.0f s (raw: Xn, successive Xn difference, Vn)\n", BENCH_SETTLE_S);
+    printf("  %-8s %4s  %13s   %14s   %13s   %8s %8s   %8s\n", "drive", "T ms",
+           "gap m raw/est", "rel m/s raw/est", "km/h raw/est", "restarts", "rejected", "|ref|");
+    for (level = 0u; level < KALMAN_LEVEL_QTY; level++)
+    {
+        for (drive = 0u; drive < BENCH_DRIVE_QTY; drive++)
+        {
+            errors += Bench_Accuracy(drive, level);
+        }
+    }
+    printf("cost, mean ns per step over %u steps\n", (unsigned)iter);
+    printf("  Kalman_Step                   %8.1f\n", Bench_Time(false, iter));
+    printf("  double reference (full P)     %8.1f\n", Bench_Time(true, iter / 10u));
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("gap / relative-velocity estimator disabled (ACC_KALMAN_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_KALMAN_EN
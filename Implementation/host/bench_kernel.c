@@ -0,0 +1,432 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_control.h"
+#include "acc_params.h"
+#include "acc_seqlock.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Kernel primitives and the Control stage: the call patterns of acc_tasks.c
+//
+// ns per operation on the host shim, min/p50/p90/p99/max/mean of every case:
+//   sem_wakeup       OSSemPost → OSSemPend returns in a higher-priority task
+//                    (IRQ_sensors_ISR → Sensors_Task on the Timer Semaphore;
+//                    posted from a task here, without the interrupt entry)
+//   sem_nowait       OSSemPost + OSSemPend in one task, count available
+//   tasksem_wakeup   OSTaskSemPost → OSTaskSemPend returns (Sensors → Control,
+//                    Control → Actuator)
+//   mutex            OSMutexPend + OSMutexPost, nobody else on the mutex (the
+//                    former ParamMutex section, empty)
+//   mutex_contended  OSMutexPend by a PRIO 9 task while a PRIO 20 task holds
+//                    it, until owned: priority inheritance, the holder's post
+//                    and two switches
+//   memq_roundtrip   OSMemGet + OSQPost → OSQPend returns in a higher-priority
+//                    task, through its OSMemPut (the former Control → Actuator
+//                    queue; bench_handoff compares it with the mailbox)
+//   flag_accept      OSFlagAccept of ACC_ON and SafeToActuate, both set (the
+//                    Control and Actuator stage check)
+//   flag_accept_miss the same with SafeToActuate clear
+//   control_law      Control_Law() on random snapshots (float or Q16.16)
+//   control_stage    seqlock snapshot of the sensor and configuration blocks,
+//                    Control_Law() and the control block write: the Control
+//                    stage without the flag check and the probes
+//   timestamp        CPU_TS_Get64() itself, the floor of every case
+//
+// The master task runs below every task it wakes, so a post switches to the
+// woken task at once, as the post of the interrupt does. Calls shorter than a
+// timestamp read are timed in batches of BENCH_BATCH; a sample is then the
+// mean of one batch.
+//
+// Environment:
+//   BENCH_ITER      samples per case (default 20000)
+//   BENCH_SEED      random seed of the control inputs (default 1)
+//   BENCH_OUT       file to write "key value" results to (make kernel; one
+//                   <case>_<stat>_ns line per statistic, for diffs across
+//                   commits)
+
+#define BENCH_PRIO_SEM      6u
+#define BENCH_PRIO_TASKSEM  7u
+#define BENCH_PRIO_QUEUE    8u
+#define BENCH_PRIO_CONTEND  9u
+#define BENCH_PRIO_MASTER   12u
+#define BENCH_PRIO_HOLDER   20u
+#define BENCH_STK_SIZE      256u
+#define BENCH_Q_SIZE        3u
+#define BENCH_BATCH         16u
+#define BENCH_INPUTS        1024u     // Random snapshots (power of 2)
+
+typedef enum {
+    BENCH_CASE_SEM_WAKEUP = 0,
+    BENCH_CASE_SEM_NOWAIT,
+    BENCH_CASE_TASKSEM_WAKEUP,
+    BENCH_CASE_MUTEX,
+    BENCH_CASE_MUTEX_CONTENDED,
+    BENCH_CASE_MEMQ_ROUNDTRIP,
+    BENCH_CASE_FLAG_ACCEPT,
+    BENCH_CASE_FLAG_ACCEPT_MISS,
+    BENCH_CASE_CONTROL_LAW,
+    BENCH_CASE_CONTROL_STAGE,
+    BENCH_CASE_TIMESTAMP,
+    BENCH_CASE_QTY
+} Bench_Case_t;
+
+static const char *const BenchKeys[BENCH_CASE_QTY] = {
+    "sem_wakeup", "sem_nowait", "tasksem_wakeup", "mutex", "mutex_contended", "memq_roundtrip",
+    "flag_accept", "flag_accept_miss", "control_law", "control_stage", "timestamp"
+};
+
+static OS_TCB MasterTCB, SemTCB, TaskSemTCB, QueueTCB, ContendTCB, HolderTCB;
+static CPU_STK MasterStk[BENCH_STK_SIZE], SemStk[BENCH_STK_SIZE], TaskSemStk[BENCH_STK_SIZE];
+static CPU_STK QueueStk[BENCH_STK_SIZE], ContendStk[BENCH_STK_SIZE], HolderStk[BENCH_STK_SIZE];
+
+static OS_SEM BenchSem, BenchSemLocal;
+static OS_MUTEX BenchMutex;
+static OS_Q BenchQueue;
+static OS_MEM BenchPartition;
+static ACC_Value_t BenchBlocks[BENCH_Q_SIZE];
+static OS_FLAG_GRP BenchFlags;
+
+// Parameter Memory Blocks as Control reads them, one per random snapshot
+static ACC_Parameters_t BenchParams[BENCH_INPUTS];
+
+static CPU_INT32U BenchIter;
+static CPU_INT32U BenchDone;
+static CPU_TS64 BenchT0;
+static CPU_INT64U *BenchNs;
+static Bench_Stats_t BenchResult[BENCH_CASE_QTY];
+static CPU_INT64U BenchRng;
+static volatile ACC_Value_t BenchSink;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static float Bench_Uniform(float lo, float hi)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return lo + (hi - lo) * (float)((BenchRng * 2685821657736338717ull) >> 40) / 16777216.0f;
+}
+
+// Woken by the master, one task per kernel object (each pends on its own
+// object only)
+static void Bench_SemTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    while (1)
+    {
+        (void)OSSemPend(&BenchSem, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchNs[BenchDone++] = CPU_TS_Get64() - BenchT0;
+    }
+}
+
+static void Bench_TaskSemTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    while (1)
+    {
+        (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchNs[BenchDone++] = CPU_TS_Get64() - BenchT0;
+    }
+}
+
+static void Bench_QueueTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    OS_MSG_SIZE msg_size;
+    ACC_Value_t *p_blk;
+
+    while (1)
+    {
+        p_blk = (ACC_Value_t *)OSQPend(&BenchQueue, 0, OS_OPT_PEND_BLOCKING, &msg_size, &ts, &err);
+        BenchSink = *p_blk;
+        OSMemPut(&BenchPartition, (void *)p_blk, &err);
+        BenchNs[BenchDone++] = CPU_TS_Get64() - BenchT0;
+    }
+}
+
+// Takes the mutex, then releases the contender, which blocks on it
+static void Bench_HolderTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    while (1)
+    {
+        (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        (void)OSTaskSemPost(&ContendTCB, OS_OPT_POST_NONE, &err);
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+    }
+}
+
+static void Bench_ContendTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_TS64 t0;
+
+    while (1)
+    {
+        (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        t0 = CPU_TS_Get64();
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchNs[BenchDone++] = CPU_TS_Get64() - t0;
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+        (void)OSTaskSemPost(&MasterTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+// Control stage compute block on one set of blocks (acc_tasks.c Frame_Control,
+// default build)
+static ACC_Value_t Bench_ControlStage(ACC_Parameters_t *p)
+{
+    ACC_Value_t Xn, Vn, Vn1, Vn2, Vset, Xset, Vcruise, K1, K2, K3, deltaV, dM_n;
+    uint32_t seq, engage;
+
+    do
+    {
+        seq = Seq_ReadBegin(&p->sensor.seq);
+        Xn = p->sensor.Xn;
+        Vn = p->sensor.Vn;
+        Vn1 = p->sensor.Vn1;
+        Vn2 = p->sensor.Vn2;
+    } while (Seq_ReadRetry(&p->sensor.seq, seq));
+    do
+    {
+        seq = Seq_ReadBegin(&p->config.seq);
+        Xset = p->config.Xset;
+        Vcruise = p->config.Vcruise;
+        K1 = p->config.K1;
+        K2 = p->config.K2;
+        K3 = p->config.K3;
+        deltaV = p->config.deltaV;
+        engage = p->config.engage;
+    } while (Seq_ReadRetry(&p->config.seq, seq));
+
+    Vset = (p->control.engage == engage) ? p->control.Vset : Vcruise;
+    dM_n = Control_Law(Xn, Xset, Vcruise, deltaV,
+                       Vn, Vn1, Vn2,
+                       K1, K2, K3,
+                       &Vset);
+
+    Seq_WriteBegin(&p->control.seq);
+    p->control.dMn = dM_n;
+    p->control.Vset = Vset;
+    p->control.engage = engage;
+    Seq_WriteEnd(&p->control.seq);
+    return dM_n;
+}
+
+// One batch of a case that runs in the master alone
+static void Bench_Batch(Bench_Case_t c, CPU_INT32U k)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_INT32U i;
+    ACC_Parameters_t *p;
+    ACC_Value_t Vset;
+    OS_FLAGS want = (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG);
+
+    for (i = 0u; i < BENCH_BATCH; i++)
+    {
+        switch (c)
+        {
+            case BENCH_CASE_SEM_NOWAIT:
+                (void)OSSemPost(&BenchSemLocal, OS_OPT_POST_NONE, &err);
+                (void)OSSemPend(&BenchSemLocal, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+                break;
+            case BENCH_CASE_MUTEX:
+                OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+                OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+                break;
+            case BENCH_CASE_FLAG_ACCEPT:
+            case BENCH_CASE_FLAG_ACCEPT_MISS:
+                BenchSink = (ACC_Value_t)OSFlagAccept(&BenchFlags, want,
+                                                      OS_OPT_PEND_FLAG_SET_ALL | OS_OPT_PEND_NON_BLOCKING,
+                                                      &err);
+                break;
+            case BENCH_CASE_CONTROL_LAW:
+                p = &BenchParams[(k * BENCH_BATCH + i) & (BENCH_INPUTS - 1u)];
+                Vset = p->control.Vset;
+                BenchSink = Control_Law(p->sensor.Xn, p->config.Xset, p->config.Vcruise, p->config.deltaV,
+                                        p->sensor.Vn, p->sensor.Vn1, p->sensor.Vn2,
+                                        p->config.K1, p->config.K2, p->config.K3,
+                                        &Vset);
+                break;
+            case BENCH_CASE_CONTROL_STAGE:
+                BenchSink = Bench_ControlStage(&BenchParams[(k * BENCH_BATCH + i) & (BENCH_INPUTS - 1u)]);
+                break;
+            default:
+                BenchSink = (ACC_Value_t)CPU_TS_Get64();
+                break;
+        }
+    }
+}
+
+static void Bench_Run(Bench_Case_t c)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_INT32U k;
+    ACC_Value_t *p_blk;
+    double div = 1.0;
+
+    BenchDone = 0u;
+    if (c == BENCH_CASE_FLAG_ACCEPT_MISS)
+    {
+        (void)OSFlagPost(&BenchFlags, (OS_FLAGS)SAFE_TO_ACTUATE_FLAG, OS_OPT_POST_FLAG_CLR, &err);
+    }
+    for (k = 0u; k < BenchIter; k++)
+    {
+        switch (c)
+        {
+            case BENCH_CASE_SEM_WAKEUP:
+                BenchT0 = CPU_TS_Get64();
+                (void)OSSemPost(&BenchSem, OS_OPT_POST_NONE, &err);
+                break;
+            case BENCH_CASE_TASKSEM_WAKEUP:
+                BenchT0 = CPU_TS_Get64();
+                (void)OSTaskSemPost(&TaskSemTCB, OS_OPT_POST_NONE, &err);
+                break;
+            case BENCH_CASE_MUTEX_CONTENDED:
+                // Holder (below the master) runs while the master waits
+                (void)OSTaskSemPost(&HolderTCB, OS_OPT_POST_NONE, &err);
+                (void)OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+                break;
+            case BENCH_CASE_MEMQ_ROUNDTRIP:
+                BenchT0 = CPU_TS_Get64();
+                p_blk = (ACC_Value_t *)OSMemGet(&BenchPartition, &err);
+                *p_blk = (ACC_Value_t)k;
+                OSQPost(&BenchQueue, (void *)p_blk, sizeof(ACC_Value_t), OS_OPT_POST_FIFO, &err);
+                break;
+            default:
+                BenchT0 = CPU_TS_Get64();
+                Bench_Batch(c, k);
+                BenchNs[BenchDone++] = CPU_TS_Get64() - BenchT0;
+                div = BENCH_BATCH;
+                break;
+        }
+    }
+    if (c == BENCH_CASE_FLAG_ACCEPT_MISS)
+    {
+        (void)OSFlagPost(&BenchFlags, (OS_FLAGS)SAFE_TO_ACTUATE_FLAG, OS_OPT_POST_FLAG_SET, &err);
+    }
+    Bench_Stats(BenchNs, BenchDone, div, &BenchResult[c]);
+}
+
+static void Bench_WriteResults(const char *path)
+{
+    FILE *fp = fopen(path, "w");
+    CPU_INT32U c;
+
+    if (fp == NULL)
+    {
+        fprintf(stderr, "bench_kernel: cannot write %s\n", path);
+        exit(1);
+    }
+    for (c = 0u; c < BENCH_CASE_QTY; c++)
+    {
+        const Bench_Stats_t *s = &BenchResult[c];
+
+        fprintf(fp, "%s_min_ns %.1f\n", BenchKeys[c], s->min);
+        fprintf(fp, "%s_p50_ns %.1f\n", BenchKeys[c], s->p50);
+        fprintf(fp, "%s_p90_ns %.1f\n", BenchKeys[c], s->p90);
+        fprintf(fp, "%s_p99_ns %.1f\n", BenchKeys[c], s->p99);
+        fprintf(fp, "%s_max_ns %.1f\n", BenchKeys[c], s->max);
+        fprintf(fp, "%s_mean_ns %.1f\n", BenchKeys[c], s->mean);
+    }
+    fclose(fp);
+    printf("  results written to %s\n", path);
+}
+
+static void Bench_MasterTask(void *p_arg)
+{
+    CPU_INT32U c;
+    bool fail = false;
+
+    printf("Kernel primitives and Control stage: ns per operation (host shim, %s)\n",
+           ACC_FIXED_POINT ? "Q16.16" : "float");
+    Bench_PrintStatsHeader("");
+    for (c = 0u; c < BENCH_CASE_QTY; c++)
+    {
+        Bench_Run((Bench_Case_t)c);
+        Bench_PrintStatsRow(BenchKeys[c], &BenchResult[c]);
+        fail = fail || (BenchResult[c].n != BenchIter);
+    }
+    if (getenv("BENCH_OUT") != NULL)
+    {
+        Bench_WriteResults(getenv("BENCH_OUT"));
+    }
+    if (fail)
+    {
+        // A wake-up that never came back
+        printf("FAIL\n");
+        exit(1);
+    }
+    exit(0);
+}
+
+int main(void)
+{
+    OS_ERR err;
+    CPU_INT32U i;
+
+    BenchIter = Bench_Env("BENCH_ITER", 20000u);
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    BenchNs = calloc(BenchIter, sizeof(*BenchNs));
+    for (i = 0u; i < BENCH_INPUTS; i++)
+    {
+        ACC_Parameters_t *p = &BenchParams[i];
+
+        // Gap 0-150 m, speeds 0-130 km/h with a ±2 km/h history, main.c settings
+        p->sensor.Xn = ACC_VALUE_FROM_FLOAT(Bench_Uniform(0.0f, 150.0f));
+        p->sensor.Vn = ACC_VALUE_FROM_FLOAT(Bench_Uniform(0.0f, 130.0f));
+        p->sensor.Vn1 = ACC_VALUE_FROM_FLOAT(ACC_VALUE_TO_FLOAT(p->sensor.Vn) + Bench_Uniform(-2.0f, 2.0f));
+        p->sensor.Vn2 = ACC_VALUE_FROM_FLOAT(ACC_VALUE_TO_FLOAT(p->sensor.Vn1) + Bench_Uniform(-2.0f, 2.0f));
+        p->config.Xset = ACC_VALUE(50.0);
+        p->config.Vcruise = ACC_VALUE(100.0);
+        p->config.deltaV = ACC_VALUE(5.0);
+        p->config.K1 = ACC_VALUE(1.0);
+        p->config.K2 = ACC_VALUE(0.5);
+        p->config.K3 = ACC_VALUE(0.25);
+        p->config.engage = 1u;
+        p->control.engage = 1u;
+        p->control.Vset = ACC_VALUE_FROM_FLOAT(Bench_Uniform(50.0f, 100.0f));
+    }
+
+    OSInit(&err);
+    OSSemCreate(&BenchSem, "Bench Sem", 0, &err);
+    OSSemCreate(&BenchSemLocal, "Bench Sem Local", 0, &err);
+    OSMutexCreate(&BenchMutex, "Bench Mutex", &err);
+    OSQCreate(&BenchQueue, "Bench Queue", BENCH_Q_SIZE, &err);
+    OSMemCreate(&BenchPartition, "Bench Partition", (void *)BenchBlocks, BENCH_Q_SIZE, sizeof(ACC_Value_t), &err);
+    OSFlagCreate(&BenchFlags, "Bench Flags", (OS_FLAGS)(ACC_ON_FLAG | SAFE_TO_ACTUATE_FLAG), &err);
+
+    OSTaskCreate(&MasterTCB, "Bench Master", Bench_MasterTask, 0, BENCH_PRIO_MASTER,
+                 &MasterStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&SemTCB, "Bench Sem Waiter", Bench_SemTask, 0, BENCH_PRIO_SEM,
+                 &SemStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&TaskSemTCB, "Bench Task Sem Waiter", Bench_TaskSemTask, 0, BENCH_PRIO_TASKSEM,
+                 &TaskSemStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&QueueTCB, "Bench Queue Waiter", Bench_QueueTask, 0, BENCH_PRIO_QUEUE,
+                 &QueueStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&ContendTCB, "Bench Contender", Bench_ContendTask, 0, BENCH_PRIO_CONTEND,
+                 &ContendStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&HolderTCB, "Bench Holder", Bench_HolderTask, 0, BENCH_PRIO_HOLDER,
+                 &HolderStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+
+    OSStart(&err);
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_mode.h"
+#include "acc_control.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Criticality mode manager: mode sequence, switch cost and the degraded law
+//
+// 1. Sequence: random releases and stage charges (one in twenty over its
+//    budget) against a model of the mode. After every step the mode must
+//    match: HI from the first overrun on, LO again at the release
+//    MODE_QUIET_FRAMES frames after the last one, and the switch counts
+//    must match the model's.
+// 2. Switch cost: ns per Mode_Charge() within the budget and over it (the
+//    LO → HI switch), per Mode_Release() in LO and in HI; mean and largest
+//    of BENCH_ITER calls each. The switch has no loop or wait, so its
+//    largest time is the host's noise, not the load.
+// 3. Degraded law: ns per Control_Law() and per Control_LawDegraded() on
+//    the same inputs.
+//
+// Environment:
+//   BENCH_OPS       sequence steps (default 1000000)
+//   BENCH_ITER      calls timed per case (default 1000000)
+//   BENCH_SEED      random seed (default 1)
+
+#if ACC_MODE_EN
+
+static ACC_Mode_t BenchMode;
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static CPU_INT32U Bench_Next(CPU_INT32U n)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (CPU_INT32U)(((BenchRng * 2685821657736338717ull) >> 32) % n);
+}
+
+// 1. Mode against a model
+static CPU_INT32U Bench_Sequence(CPU_INT32U ops)
+{
+    CPU_INT32U last[MODE_STAGE_QTY] = { 0u };       // Frame of the stage's last overrun
+    CPU_INT32U frame = 0u, to_hi = 0u, to_lo = 0u, errors = 0u, n, s;
+    bool high = false;
+
+    Mode_Init(&BenchMode);
+    for (n = 0u; n < ops; n++)
+    {
+        if (Bench_Next(4u) == 0u)
+        {
+            // Release: LO once no stage overran in the last MODE_QUIET_FRAMES
+            frame++;
+            if (high)
+            {
+                high = false;
+                for (s = 0u; s < MODE_STAGE_QTY; s++)
+                {
+                    high = high || (last[s] != 0u && frame - last[s] < MODE_QUIET_FRAMES);
+                }
+                to_lo += !high;
+            }
+            errors += (Mode_Release(&BenchMode) == MODE_HI) != high;
+        }
+        else if (frame > 0u)
+        {
+            CPU_INT32U stage = Bench_Next(MODE_STAGE_QTY);
+            CPU_TS budget = MODE_US_TO_TS(ModeBudgetUs[stage]);
+            bool over = (Bench_Next(20u) == 0u);
+
+            Mode_Charge(&BenchMode, stage, over ? budget + 1u + Bench_Next(budget) : Bench_Next(budget + 1u));
+            if (over)
+            {
+                last[stage] = frame;
+                to_hi += !high;
+                high = true;
+            }
+        }
+        errors += Mode_High(&BenchMode) != high;
+    }
+    errors += (BenchMode.to_hi[MODE_STAGE_SENSORS] + BenchMode.to_hi[MODE_STAGE_CONTROL] +
+               BenchMode.to_hi[MODE_STAGE_ACTUATOR] != to_hi) || (BenchMode.to_lo != to_lo);
+    printf("  sequence     %8u steps          %u frames, %u to HI, %u to LO, %u frames in HI, errors %u  %s\n",
+           (unsigned)ops, (unsigned)frame, (unsigned)to_hi, (unsigned)to_lo, (unsigned)BenchMode.frames_hi,
+           (unsigned)errors, (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// Mean and largest ns of one call, over iter calls
+static void Bench_Report(const char *name, CPU_TS64 total, CPU_TS64 max, CPU_INT32U iter)
+{
+    printf("  %-38s %8.1f ns   max %8.1f ns\n", name, (double)total / iter, (double)max);
+}
+
+// 2. Switch cost
+static void Bench_Switch(CPU_INT32U iter)
+{
+    CPU_TS budget = MODE_US_TO_TS(MODE_BUDGET_CONTROL_US);
+    CPU_TS64 t0, t1, total[4] = { 0u }, max[4] = { 0u };
+    CPU_INT32U i, c;
+
+    for (i = 0u; i < iter; i++)
+    {
+        // Within the budget, LO
+        Mode_Init(&BenchMode);
+        BenchMode.frame = 1u;
+        t0 = CPU_TS_Get64();
+        Mode_Charge(&BenchMode, MODE_STAGE_CONTROL, budget);
+        t1 = CPU_TS_Get64();
+        total[0] += t1 - t0;
+        max[0] = (t1 - t0 > max[0]) ? t1 - t0 : max[0];
+
+        // Release in LO
+        t0 = CPU_TS_Get64();
+        (void)Mode_Release(&BenchMode);
+        t1 = CPU_TS_Get64();
+        total[2] += t1 - t0;
+        max[2] = (t1 - t0 > max[2]) ? t1 - t0 : max[2];
+
+        // Over the budget: LO → HI
+        t0 = CPU_TS_Get64();
+        Mode_Charge(&BenchMode, MODE_STAGE_CONTROL, budget + 1u);
+        t1 = CPU_TS_Get64();
+        total[1] += t1 - t0;
+        max[1] = (t1 - t0 > max[1]) ? t1 - t0 : max[1];
+
+        // Release in HI (every stage checked, still HI)
+        t0 = CPU_TS_Get64();
+        (void)Mode_Release(&BenchMode);
+        t1 = CPU_TS_Get64();
+        total[3] += t1 - t0;
+        max[3] = (t1 - t0 > max[3]) ? t1 - t0 : max[3];
+    }
+    printf("switch cost, %u calls each (first timestamp to second)\n", (unsigned)iter);
+    for (c = 0u; c < 4u; c++)
+    {
+        static const char *const name[4] = {
+            "Mode_Charge, within the budget", "Mode_Charge, over it (LO -> HI)",
+            "Mode_Release, LO", "Mode_Release, HI"
+        };
+
+        Bench_Report(name[c], total[c], max[c], iter);
+    }
+}
+
+// 3. Full and degraded law
+static void Bench_Law(CPU_INT32U iter)
+{
+    ACC_Value_t Vset = ACC_VALUE(100.0);
+    volatile ACC_Value_t sink;
+    CPU_TS64 t0, t1, t2;
+    CPU_INT32U i;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        ACC_Value_t Xn = ACC_VALUE_FROM_FLOAT((float)(i % 1000u) * 0.1f);
+
+        sink = Control_Law(Xn, ACC_VALUE(50.0), ACC_VALUE(100.0), ACC_VALUE(2.0),
+                           ACC_VALUE(90.0), ACC_VALUE(89.0), ACC_VALUE(88.0),
+                           ACC_VALUE(0.5), ACC_VALUE(0.3), ACC_VALUE(0.1),
+                           &Vset);
+    }
+    t1 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        ACC_Value_t Xn = ACC_VALUE_FROM_FLOAT((float)(i % 1000u) * 0.1f);
+
+        sink = Control_LawDegraded(Xn, ACC_VALUE(50.0), ACC_VALUE(100.0), ACC_VALUE(2.0),
+                                   ACC_VALUE(90.0),
+                                   ACC_VALUE(0.5), ACC_VALUE(0.3), ACC_VALUE(0.1),
+                                   &Vset);
+    }
+    t2 = CPU_TS_Get64();
+    (void)sink;
+    printf("control law, mean over %u calls\n", (unsigned)iter);
+    printf("  %-38s %8.1f ns\n", "Control_Law", (double)(t1 - t0) / iter);
+    printf("  %-38s %8.1f ns\n", "Control_LawDegraded", (double)(t2 - t1) / iter);
+}
+
+int main(void)
+{
+    CPU_INT32U ops = Bench_Env("BENCH_OPS", 1000000u);
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 1000000u);
+    CPU_INT32U errors;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Criticality mode: budgets sensors/control/actuator %u/%u/%u us, LO after %u quiet frames\n",
+           (unsigned)MODE_BUDGET_SENSORS_US, (unsigned)MODE_BUDGET_CONTROL_US,
+           (unsigned)MODE_BUDGET_ACTUATOR_US, (unsigned)MODE_QUIET_FRAMES);
+    errors = Bench_Sequence(ops);
+    Bench_Switch(iter);
+    Bench_Law(iter);
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("criticality mode disabled (ACC_MODE_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_MODE_EN
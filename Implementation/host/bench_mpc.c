@@ -0,0 +1,257 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_control.h"
+#include "acc_mpc.h"
+#include "acc_mpc_model.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Explicit MPC: region tables against an online QP solution, and the cost
+// per control cycle
+//
+// 1. Accuracy: for each table of acc_mpc_table.c, random states over the
+//    operating range (speed error ±BENCH_E_MAX, acceleration and previous
+//    request within the limits) are looked up with Mpc_Lookup() and solved
+//    online in double precision (projected Gauss-Seidel on the QP of
+//    acc_mpc_model.c, to 1e-12). The first moves must agree within BENCH_TOL,
+//    stay within MPC_ACCEL_MIN..MPC_ACCEL_MAX, and no state of the range may
+//    fall through to the unconstrained fallback.
+// 2. Cost: ns per control cycle at RATE_LEVEL_MID for Equation 3 alone
+//    (Control_Law) and with Mpc_Law() after it, on states drawn as above
+//    (typical) and on the state of the sample that searched the most rows
+//    (worst case). The row count bounds the search: the table header gives
+//    the worst case in multiply-adds.
+//
+// Environment:
+//   BENCH_SAMPLES   states checked per table (default 200000)
+//   BENCH_ITER      cycles timed per variant (default 5000000)
+//   BENCH_SEED      random seed (default 1)
+
+#if ACC_MPC_EN
+
+#define BENCH_E_MAX        20.0      // m/s
+#define BENCH_SET_QTY      4096u     // Cycles per timed set (power of 2)
+#define BENCH_QP_SWEEPS    100000u
+#define BENCH_QP_EPS       1e-12
+#if ACC_FIXED_POINT
+#define BENCH_TOL          1e-3      // m/s²: Q16.16 coefficients and state
+#else
+#define BENCH_TOL          1e-4      // m/s²: printed coefficients, MPC_ROW_TOL overlap
+#endif
+
+typedef struct {
+    ACC_Value_t Vset, Vn, dM_prev, a;
+} BenchCycle_t;
+
+static BenchCycle_t BenchSet[BENCH_SET_QTY];
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (double)((BenchRng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+static void Bench_State(double x[MPC_NX])
+{
+    x[0] = BENCH_E_MAX * (2.0 * Bench_Uniform() - 1.0);
+    x[1] = MPC_ACCEL_MIN + (MPC_ACCEL_MAX - MPC_ACCEL_MIN) * Bench_Uniform();
+    x[2] = MPC_ACCEL_MIN + (MPC_ACCEL_MAX - MPC_ACCEL_MIN) * Bench_Uniform();
+}
+
+// First move of min U'·H·U + 2·x'·F·U over lb ≤ U ≤ ub
+static double Bench_Qp(const MpcModel_t *p_m, const double x[MPC_NX])
+{
+    double g[MPC_NU], U[MPC_NU] = { 0.0 };
+    CPU_INT32U i, j, k, sweep;
+
+    for (i = 0u; i < MPC_NU; i++)
+    {
+        g[i] = 0.0;
+        for (k = 0u; k < MPC_NX; k++)
+        {
+            g[i] += p_m->F[k][i] * x[k];
+        }
+    }
+    for (sweep = 0u; sweep < BENCH_QP_SWEEPS; sweep++)
+    {
+        double change = 0.0;
+
+        for (i = 0u; i < MPC_NU; i++)
+        {
+            double r = g[i], u;
+
+            for (j = 0u; j < MPC_NU; j++)
+            {
+                r += (j != i) ? p_m->H[i][j] * U[j] : 0.0;
+            }
+            u = -r / p_m->H[i][i];
+            u = (u < p_m->lb) ? p_m->lb : (u > p_m->ub) ? p_m->ub : u;
+            change = (fabs(u - U[i]) > change) ? fabs(u - U[i]) : change;
+            U[i] = u;
+        }
+        if (change < BENCH_QP_EPS)
+        {
+            break;
+        }
+    }
+    return U[0];
+}
+
+// Cycle inputs that give state x at Mpc_Law's lookup (Vn 80 km/h)
+static void Bench_Cycle(const double x[MPC_NX], double phi, BenchCycle_t *p_c)
+{
+    p_c->Vn = ACC_VALUE(80.0);
+    p_c->Vset = ACC_VALUE_FROM_FLOAT((float)(80.0 + 3.6 * x[0]));
+    p_c->dM_prev = ACC_VALUE_FROM_FLOAT((float)(x[2] / MPC_ACCEL_PER_DM));
+    p_c->a = ACC_VALUE_FROM_FLOAT((float)((x[1] - x[2]) / phi + x[2]));
+}
+
+// Returns the errors; *p_worst: the sample that searched the most rows
+static CPU_INT32U Bench_Accuracy(CPU_INT32U level, CPU_INT32U samples, double worst[MPC_NX])
+{
+    const ACC_MpcTable_t *p_tbl = &MpcTables[level];
+    MpcModel_t m;
+    double err_max = 0.0, err_sum = 0.0, rows_sum = 0.0;
+    CPU_INT32U n, r, fallback = 0u, outside = 0u, rows_max = 0u;
+    CPU_INT32U bytes = sizeof(*p_tbl) + p_tbl->region_qty * sizeof(ACC_MpcRegion_t) +
+                       p_tbl->row_qty * sizeof(ACC_MpcRow_t);
+
+    MpcModel_Build(p_tbl->period_ms, &m);
+    for (n = 0u; n < samples; n++)
+    {
+        double x[MPC_NX], err;
+        ACC_Value_t xv[MPC_NX], u;
+        CPU_INT32U region, rows = 0u;
+
+        Bench_State(x);
+        for (r = 0u; r < MPC_NX; r++)
+        {
+            xv[r] = ACC_VALUE_FROM_FLOAT((float)x[r]);
+            x[r] = ACC_VALUE_TO_FLOAT(xv[r]);
+        }
+        u = Mpc_Lookup(p_tbl, xv, &region);
+        err = fabs(ACC_VALUE_TO_FLOAT(u) - Bench_Qp(&m, x));
+        err_sum += err;
+        err_max = (err > err_max) ? err : err_max;
+        fallback += (region == p_tbl->region_qty);
+        outside += (u < ACC_VALUE(MPC_ACCEL_MIN) || u > ACC_VALUE(MPC_ACCEL_MAX));
+
+        // Rows searched: every row of the regions before, up to all of this one's
+        for (r = 0u; r < region && r < p_tbl->region_qty; r++)
+        {
+            rows += p_tbl->region[r].rows;
+        }
+        rows += (region < p_tbl->region_qty) ? p_tbl->region[region].rows : 0u;
+        rows_sum += rows;
+        if (rows > rows_max)
+        {
+            rows_max = rows;
+            worst[0] = x[0];
+            worst[1] = x[1];
+            worst[2] = x[2];
+        }
+    }
+    printf("  %5u %7u %5u %6u   %7.1f %6u   %9.6f %9.6f %8u %8u  %s\n",
+           (unsigned)p_tbl->period_ms, (unsigned)p_tbl->region_qty, (unsigned)p_tbl->row_qty,
+           (unsigned)bytes, rows_sum / samples, (unsigned)rows_max, err_sum / samples, err_max,
+           (unsigned)fallback, (unsigned)outside,
+           (err_max <= BENCH_TOL && fallback == 0u && outside == 0u) ? "ok" : "FAIL");
+    return (err_max > BENCH_TOL) + (fallback != 0u) + (outside != 0u);
+}
+
+// Mean ns per cycle: Control_Law, then Mpc_Law unless eq3_only
+static double Bench_Time(bool eq3_only, CPU_INT32U iter)
+{
+    volatile ACC_Value_t sink = ACC_VALUE(0.0);
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const BenchCycle_t *p_c = &BenchSet[i & (BENCH_SET_QTY - 1u)];
+        ACC_Value_t Vset = p_c->Vset, a = p_c->a, dM;
+
+        dM = Control_Law(ACC_VALUE(60.0), ACC_VALUE(50.0), ACC_VALUE(100.0), ACC_VALUE(2.0),
+                         p_c->Vn, p_c->Vn, p_c->Vn,
+                         ACC_VALUE(0.5), ACC_VALUE(0.1), ACC_VALUE(0.05),
+                         &Vset);
+        if (!eq3_only)
+        {
+            dM = Mpc_Law(RATE_LEVEL_MID, p_c->Vset, p_c->Vn, p_c->dM_prev, &a);
+        }
+        sink = sink + dM;
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+int main(void)
+{
+    CPU_INT32U samples = Bench_Env("BENCH_SAMPLES", 200000u);
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 5000000u);
+    CPU_INT32U errors = 0u;
+    double worst[MPC_TABLE_QTY][MPC_NX];
+    double eq3, typical, worst_ns;
+    CPU_INT32U l, i;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Explicit MPC: %u moves, state (e, a, u-), %s, tolerance %.0e m/s^2\n",
+           (unsigned)MPC_NU, ACC_FIXED_POINT ? "Q16.16" : "float", BENCH_TOL);
+    printf("accuracy against the online QP, %u states per table\n", (unsigned)samples);
+    printf("  %5s %7s %5s %6s   %7s %6s   %9s %9s %8s %8s\n", "T ms", "regions", "rows", "bytes",
+           "rows/st", "max", "mean err", "max err", "fallback", "limits");
+    for (l = 0u; l < MPC_TABLE_QTY; l++)
+    {
+        errors += Bench_Accuracy(l, samples, worst[l]);
+    }
+
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        double x[MPC_NX];
+
+        Bench_State(x);
+        Bench_Cycle(x, ACC_VALUE_TO_FLOAT(MpcTables[RATE_LEVEL_MID].phi), &BenchSet[i]);
+    }
+    eq3 = Bench_Time(true, iter);
+    typical = Bench_Time(false, iter);
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        Bench_Cycle(worst[RATE_LEVEL_MID], ACC_VALUE_TO_FLOAT(MpcTables[RATE_LEVEL_MID].phi), &BenchSet[i]);
+    }
+    worst_ns = Bench_Time(false, iter);
+    printf("cost, mean ns per control cycle over %u cycles (T %u ms table)\n",
+           (unsigned)iter, (unsigned)MpcTables[RATE_LEVEL_MID].period_ms);
+    printf("  Equation 3 (Control_Law)             %8.1f\n", eq3);
+    printf("  + Mpc_Law, typical states            %8.1f  (+%.1f)\n", typical, typical - eq3);
+    printf("  + Mpc_Law, most rows searched        %8.1f  (+%.1f)\n", worst_ns, worst_ns - eq3);
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("explicit MPC disabled (ACC_MPC_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_MPC_EN
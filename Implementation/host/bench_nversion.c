@@ -0,0 +1,250 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_control.h"
+#include "acc_nversion.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// N-version control: agreement of the three forms of Equations 1-4, the
+// voter under injected faults, and the cost per control cycle
+//
+// 1. Agreement: random snapshots over the operating range (gap 0..200 m,
+//    speeds 0..250 km/h, gains 0..10, the CALIB_* ranges for Xset, Vcruise
+//    and deltaV). Versions B and C must stay within a quarter of
+//    NVERSION_TOL of A, with the same Vset, and the vote must return A's
+//    dM and Vset bit for bit with no version outvoted.
+// 2. Faults: on each snapshot one version gets one bit flipped, in one of
+//    its eleven inputs or in its dM. The vote must either outvote exactly
+//    that version and return a fault-free version's dM and Vset, or (the
+//    flip changed dM by less than the band) accept and stay within
+//    2 × NVERSION_TOL of the fault-free dM. Reports how many were outvoted
+//    and how many were harmless.
+// 3. Cost: ns per control cycle for Control_Law alone and for
+//    NVersion_Law (three versions and the vote).
+//
+// Environment:
+//   BENCH_SAMPLES   snapshots checked (default 1000000)
+//   BENCH_ITER      cycles timed per variant (default 5000000)
+//   BENCH_SEED      random seed (default 1)
+
+#if ACC_NVERSION_EN
+
+#define BENCH_SET_QTY      4096u     // Snapshots per timed set (power of 2)
+#define BENCH_INPUT_QTY    11u       // Xn Xset Vcruise deltaV Vn Vn1 Vn2 K1 K2 K3 Vset
+
+typedef ACC_Value_t BenchSnap_t[BENCH_INPUT_QTY];
+
+static BenchSnap_t BenchSet[BENCH_SET_QTY];
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static CPU_INT64U Bench_Next(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return BenchRng * 2685821657736338717ull;
+}
+
+static double Bench_Uniform(double lo, double hi)
+{
+    return lo + (hi - lo) * (double)(Bench_Next() >> 11) / 9007199254740992.0;
+}
+
+static void Bench_Snap(BenchSnap_t s)
+{
+    double vn = Bench_Uniform(0.0, 250.0);
+
+    s[0] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, 200.0));
+    s[1] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(CALIB_XSET_MIN, CALIB_XSET_MAX));
+    s[2] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(CALIB_VCRUISE_MIN, CALIB_VCRUISE_MAX));
+    s[3] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, CALIB_DELTAV_MAX));
+    s[4] = ACC_VALUE_FROM_FLOAT((float)vn);
+    s[5] = ACC_VALUE_FROM_FLOAT((float)fmax(0.0, vn + Bench_Uniform(-10.0, 10.0)));
+    s[6] = ACC_VALUE_FROM_FLOAT((float)fmax(0.0, vn + Bench_Uniform(-20.0, 20.0)));
+    s[7] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, CALIB_K_MAX));
+    s[8] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, CALIB_K_MAX));
+    s[9] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, CALIB_K_MAX));
+    s[10] = ACC_VALUE_FROM_FLOAT((float)Bench_Uniform(0.0, 250.0));
+}
+
+// Version v on snapshot s: returns dM, *p_Vset
+static ACC_Value_t Bench_Version(CPU_INT32U v, const BenchSnap_t s, ACC_Value_t *p_Vset)
+{
+    *p_Vset = s[10];
+    switch (v)
+    {
+        case 0u:
+            return Control_Law(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], p_Vset);
+        case 1u:
+            return NVersion_LawB(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], p_Vset);
+        default:
+            return NVersion_LawC(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], p_Vset);
+    }
+}
+
+static void Bench_Flip(ACC_Value_t *p_v, CPU_INT32U bit)
+{
+    uint32_t u;
+
+    memcpy(&u, p_v, sizeof(u));
+    u ^= 1u << bit;
+    memcpy(p_v, &u, sizeof(u));
+}
+
+// Returns the errors
+static CPU_INT32U Bench_Check(CPU_INT32U samples)
+{
+    CPU_INT32U n, v, errors = 0u, disagree = 0u, wrong = 0u;
+    CPU_INT32U outvoted = 0u, harmless = 0u, nan_out = 0u;
+    double dev_max[NVERSION_QTY] = { 0.0 };
+
+    for (n = 0u; n < samples; n++)
+    {
+        BenchSnap_t s, f;
+        ACC_Value_t dM[NVERSION_QTY], Vset[NVERSION_QTY], dMf[NVERSION_QTY], Vsetf[NVERSION_QTY];
+        ACC_Value_t Vset_out, dM_out;
+        CPU_INT32U bad, slot, bit;
+        uint8_t out;
+
+        // 1. Fault-free
+        Bench_Snap(s);
+        for (v = 0u; v < NVERSION_QTY; v++)
+        {
+            dM[v] = Bench_Version(v, s, &Vset[v]);
+            dev_max[v] = fmax(dev_max[v], fabs(ACC_VALUE_TO_FLOAT(dM[v]) - ACC_VALUE_TO_FLOAT(dM[0])));
+            disagree += (Vset[v] != Vset[0]);
+        }
+        Vset_out = s[10];
+        dM_out = NVersion_Vote(dM, Vset, &Vset_out, &out);
+        disagree += (out != 0u) || (dM_out != dM[0]) || (Vset_out != Vset[0]);
+
+        // 2. One bit of one input or of the output of one version
+        bad = (CPU_INT32U)(Bench_Next() >> 33) % NVERSION_QTY;
+        slot = (CPU_INT32U)(Bench_Next() >> 33) % (BENCH_INPUT_QTY + 1u);
+        bit = (CPU_INT32U)(Bench_Next() >> 33) % 32u;
+        memcpy(f, s, sizeof(f));
+        if (slot < BENCH_INPUT_QTY)
+        {
+            Bench_Flip(&f[slot], bit);
+        }
+        for (v = 0u; v < NVERSION_QTY; v++)
+        {
+            dMf[v] = (v == bad) ? Bench_Version(v, f, &Vsetf[v]) : dM[v];
+            Vsetf[v] = (v == bad) ? Vsetf[v] : Vset[v];
+        }
+        if (slot == BENCH_INPUT_QTY)
+        {
+            Bench_Flip(&dMf[bad], bit);
+        }
+#if !ACC_FIXED_POINT
+        nan_out += isnan(dMf[bad]);
+#endif
+        Vset_out = s[10];
+        dM_out = NVersion_Vote(dMf, Vsetf, &Vset_out, &out);
+        if (out == (1u << bad))
+        {
+            CPU_INT32U good = (bad == 0u) ? 1u : 0u;
+
+            outvoted++;
+            wrong += (dM_out != dM[good]) || (Vset_out != Vset[good]);
+        }
+        else if (out == 0u)
+        {
+            harmless++;
+            wrong += !(fabs(ACC_VALUE_TO_FLOAT(dM_out) - ACC_VALUE_TO_FLOAT(dM[0])) <= 2.0 * NVERSION_TOL);
+        }
+        else
+        {
+            wrong++;
+        }
+    }
+    errors = disagree + wrong +
+             (dev_max[1] > NVERSION_TOL / 4.0) + (dev_max[2] > NVERSION_TOL / 4.0);
+    printf("  fault-free   %9u snapshots   max |dM - dM_A|  B %.2e  C %.2e   disagreements %u  %s\n",
+           (unsigned)samples, dev_max[1], dev_max[2], (unsigned)disagree,
+           (disagree == 0u && dev_max[1] <= NVERSION_TOL / 4.0 && dev_max[2] <= NVERSION_TOL / 4.0) ? "ok" : "FAIL");
+    printf("  one bit flip %9u faults      outvoted %u, harmless %u (NaN dM %u), wrong %u  %s\n",
+           (unsigned)samples, (unsigned)outvoted, (unsigned)harmless, (unsigned)nan_out, (unsigned)wrong,
+           (wrong == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// Mean ns per cycle: Control_Law alone or NVersion_Law
+static double Bench_Time(bool voted, CPU_INT32U iter)
+{
+    volatile ACC_Value_t sink = ACC_VALUE(0.0);
+    ACC_NVersion_t nv;
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    memset(&nv, 0, sizeof(nv));
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const ACC_Value_t *s = BenchSet[i & (BENCH_SET_QTY - 1u)];
+        ACC_Value_t Vset = s[10], dM;
+
+        if (voted)
+        {
+            dM = NVersion_Law(&nv, s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], &Vset);
+        }
+        else
+        {
+            dM = Control_Law(s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7], s[8], s[9], &Vset);
+        }
+        sink = sink + dM + Vset;
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+int main(void)
+{
+    CPU_INT32U samples = Bench_Env("BENCH_SAMPLES", 1000000u);
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 5000000u);
+    CPU_INT32U errors, i;
+    double single, voted;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("N-version control: %u versions of Equations 1-4, %s, agreement band %.3g\n",
+           (unsigned)NVERSION_QTY, ACC_FIXED_POINT ? "Q16.16" : "float", NVERSION_TOL);
+    errors = Bench_Check(samples);
+
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        Bench_Snap(BenchSet[i]);
+    }
+    single = Bench_Time(false, iter);
+    voted = Bench_Time(true, iter);
+    printf("cost, mean ns per control cycle over %u cycles\n", (unsigned)iter);
+    printf("  Control_Law                          %8.1f\n", single);
+    printf("  NVersion_Law (3 versions + vote)     %8.1f  (+%.1f, %.1fx)\n", voted, voted - single, voted / single);
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("N-version control disabled (ACC_NVERSION_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_NVERSION_EN
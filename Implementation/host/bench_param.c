@@ -0,0 +1,381 @@
+#include "os.h"
+#include "acc_params.h"
+#include "acc_seqlock.h"
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Parameter Memory Block access benchmark: ParamMutex vs seqlock
+//
+// 1. Uncontended cost of the Control_Task read (12 fields), the Control_Task
+//    write (dMn, Vset) and the Sensors_Task write (history shift + Xn) with
+//    each scheme, measured from one task with nothing else ready.
+//    The seqlock reads the sensor and configuration blocks (acc_params.h)
+//    and the writers publish their own block.
+// 2. Contention: a Control-like task (PRIO 9) is released by the tick while a
+//    Display-like reader (PRIO 20) and a Setup-like configuration writer
+//    (PRIO 21) hammer the block. Reports Control's release → snapshot latency and the time it
+//    spends blocked in OSMutexPend / retrying the seqlock read.
+//
+// Environment:
+//   BENCH_ITER      uncontended iterations per operation (default 200000)
+//   BENCH_RELEASES  Control releases per contended run (default 300)
+
+#define BENCH_PRIO_MASTER   4u
+#define BENCH_PRIO_CONTROL  9u
+#define BENCH_PRIO_DISPLAY  20u
+#define BENCH_PRIO_SETUP    21u
+#define BENCH_STK_SIZE      256u
+
+typedef enum {
+    BENCH_MODE_IDLE = 0,
+    BENCH_MODE_MUTEX,
+    BENCH_MODE_SEQLOCK
+} Bench_Mode_t;
+
+typedef struct {
+    float Xn, Vn, Vn1, Vn2, Vset, Xset, Vcruise, K1, K2, K3, deltaV;
+} Bench_Snapshot_t;
+
+static ACC_Parameters_t BenchParams;
+static OS_MUTEX BenchMutex;
+
+static OS_TCB MasterTCB, ControlTCB, DisplayTCB, SetupTCB;
+static CPU_STK MasterStk[BENCH_STK_SIZE], ControlStk[BENCH_STK_SIZE];
+static CPU_STK DisplayStk[BENCH_STK_SIZE], SetupStk[BENCH_STK_SIZE];
+
+static volatile Bench_Mode_t BenchMode = BENCH_MODE_IDLE;
+static volatile CPU_BOOLEAN BenchReleasing = false;
+static volatile CPU_TS64 BenchReleaseTS;
+
+static CPU_INT32U BenchReleasesMax;
+static CPU_INT32U BenchReleases;
+static CPU_INT64U *BenchLatency;            // release → snapshot (ns)
+static CPU_INT64U *BenchBlocked;            // time inside the acquire (ns)
+static CPU_INT64U BenchRetries;
+static volatile CPU_INT64U BenchDisplayReads, BenchSetupWrites;
+
+// ---------------------------------------------------------------------------
+// Access patterns as used by acc_tasks.c
+// ---------------------------------------------------------------------------
+
+static void Bench_CopySensor(Bench_Snapshot_t *p_snap)
+{
+    p_snap->Xn = BenchParams.sensor.Xn;
+    p_snap->Vn = BenchParams.sensor.Vn;
+    p_snap->Vn1 = BenchParams.sensor.Vn1;
+    p_snap->Vn2 = BenchParams.sensor.Vn2;
+}
+
+static void Bench_CopyConfig(Bench_Snapshot_t *p_snap)
+{
+    p_snap->Xset = BenchParams.config.Xset;
+    p_snap->Vcruise = BenchParams.config.Vcruise;
+    p_snap->K1 = BenchParams.config.K1;
+    p_snap->K2 = BenchParams.config.K2;
+    p_snap->K3 = BenchParams.config.K3;
+    p_snap->deltaV = BenchParams.config.deltaV;
+}
+
+// Returns the number of seqlock retries
+static CPU_INT32U Bench_Read(Bench_Mode_t mode, Bench_Snapshot_t *p_snap)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    CPU_INT32U retries = 0u;
+    uint32_t seq;
+
+    if (mode == BENCH_MODE_MUTEX)
+    {
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        Bench_CopySensor(p_snap);
+        Bench_CopyConfig(p_snap);
+        p_snap->Vset = BenchParams.control.Vset;
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+        return 0u;
+    }
+
+    seq = Seq_ReadBegin(&BenchParams.sensor.seq);
+    Bench_CopySensor(p_snap);
+    while (Seq_ReadRetry(&BenchParams.sensor.seq, seq))
+    {
+        retries++;
+        seq = Seq_ReadBegin(&BenchParams.sensor.seq);
+        Bench_CopySensor(p_snap);
+    }
+    seq = Seq_ReadBegin(&BenchParams.config.seq);
+    Bench_CopyConfig(p_snap);
+    while (Seq_ReadRetry(&BenchParams.config.seq, seq))
+    {
+        retries++;
+        seq = Seq_ReadBegin(&BenchParams.config.seq);
+        Bench_CopyConfig(p_snap);
+    }
+    p_snap->Vset = BenchParams.control.Vset;    // Own block
+    return retries;
+}
+
+static void Bench_WriteControl(Bench_Mode_t mode, float dMn, float Vset)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    if (mode == BENCH_MODE_MUTEX)
+    {
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchParams.control.dMn = dMn;
+        BenchParams.control.Vset = Vset;
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+        return;
+    }
+
+    Seq_WriteBegin(&BenchParams.control.seq);
+    BenchParams.control.dMn = dMn;
+    BenchParams.control.Vset = Vset;
+    Seq_WriteEnd(&BenchParams.control.seq);
+}
+
+static void Bench_WriteSensors(Bench_Mode_t mode, float Xn, float Vn)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    if (mode == BENCH_MODE_MUTEX)
+    {
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchParams.sensor.Vn2 = BenchParams.sensor.Vn1;
+        BenchParams.sensor.Vn1 = BenchParams.sensor.Vn;
+        BenchParams.sensor.Vn = Vn;
+        BenchParams.sensor.Xn = Xn;
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+        return;
+    }
+
+    Seq_WriteBegin(&BenchParams.sensor.seq);
+    BenchParams.sensor.Vn2 = BenchParams.sensor.Vn1;
+    BenchParams.sensor.Vn1 = BenchParams.sensor.Vn;
+    BenchParams.sensor.Vn = Vn;
+    BenchParams.sensor.Xn = Xn;
+    Seq_WriteEnd(&BenchParams.sensor.seq);
+}
+
+static void Bench_WriteConfig(Bench_Mode_t mode, float Xset)
+{
+    OS_ERR err;
+    CPU_TS ts;
+
+    if (mode == BENCH_MODE_MUTEX)
+    {
+        OSMutexPend(&BenchMutex, 0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        BenchParams.config.ACC01 = 1u;
+        BenchParams.config.Xset = Xset;
+        OSMutexPost(&BenchMutex, OS_OPT_POST_NONE, &err);
+        return;
+    }
+
+    Param_WriteBegin(&BenchParams.config.seq);
+    BenchParams.config.ACC01 = 1u;
+    BenchParams.config.Xset = Xset;
+    Param_WriteEnd(&BenchParams.config.seq);
+}
+
+// ---------------------------------------------------------------------------
+// Tasks
+// ---------------------------------------------------------------------------
+
+static void Bench_TickHook(void)
+{
+    OS_ERR err;
+
+    if (BenchReleasing)
+    {
+        BenchReleaseTS = CPU_TS_Get64();
+        OSTaskSemPost(&ControlTCB, OS_OPT_POST_NONE, &err);
+    }
+}
+
+static void Bench_ControlTask(void *p_arg)
+{
+    OS_ERR err;
+    CPU_TS ts;
+    Bench_Snapshot_t snap;
+    CPU_TS64 t0, t1;
+
+    while (1)
+    {
+        OSTaskSemPend(0, OS_OPT_PEND_BLOCKING, &ts, &err);
+        if (BenchReleases >= BenchReleasesMax)
+        {
+            continue;
+        }
+
+        t0 = CPU_TS_Get64();
+        BenchRetries += Bench_Read(BenchMode, &snap);
+        t1 = CPU_TS_Get64();
+        BenchLatency[BenchReleases] = t1 - BenchReleaseTS;
+        BenchBlocked[BenchReleases] = t1 - t0;
+        BenchReleases++;
+
+        Bench_WriteControl(BenchMode, snap.K1 * (snap.Vset - snap.Vn), snap.Vset);
+    }
+}
+
+// Reads in bursts and yields for a tick so the Setup-like writer also runs
+static void Bench_DisplayTask(void *p_arg)
+{
+    OS_ERR err;
+    Bench_Snapshot_t snap;
+    CPU_INT32U i;
+
+    while (1)
+    {
+        if (BenchMode == BENCH_MODE_IDLE)
+        {
+            OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+            continue;
+        }
+        for (i = 0u; i < 2000u; i++)
+        {
+            (void)Bench_Read(BenchMode, &snap);
+            BenchDisplayReads++;
+        }
+        OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+    }
+}
+
+static void Bench_SetupTask(void *p_arg)
+{
+    OS_ERR err;
+    float x = 0.0f;
+
+    while (1)
+    {
+        if (BenchMode == BENCH_MODE_IDLE)
+        {
+            OSTimeDly(1u, OS_OPT_TIME_DLY, &err);
+            continue;
+        }
+        Bench_WriteConfig(BenchMode, x);
+        x += 1.0f;
+        BenchSetupWrites++;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Measurement
+// ---------------------------------------------------------------------------
+
+typedef void (*Bench_Op_t)(Bench_Mode_t mode);
+
+static void Bench_OpRead(Bench_Mode_t mode)
+{
+    Bench_Snapshot_t snap;
+
+    (void)Bench_Read(mode, &snap);
+}
+
+static void Bench_OpWriteControl(Bench_Mode_t mode)
+{
+    Bench_WriteControl(mode, 1.0f, 2.0f);
+}
+
+static void Bench_OpWriteSensors(Bench_Mode_t mode)
+{
+    Bench_WriteSensors(mode, 1.0f, 2.0f);
+}
+
+// Mean ns per operation over a batch (timer overhead amortised)
+static double Bench_Uncontended(Bench_Op_t op, Bench_Mode_t mode, CPU_INT32U iter)
+{
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        op(mode);
+    }
+    t1 = CPU_TS_Get64();
+    return (double)(t1 - t0) / (double)iter;
+}
+
+static void Bench_Contended(Bench_Mode_t mode, const char *label)
+{
+    OS_ERR err;
+    Bench_Stats_t lat, blk;
+    OS_CTX_SW_CTR ctx_sw0 = OSTaskCtxSwCtr;
+    CPU_INT32U releases;
+
+    BenchReleases = 0u;
+    BenchRetries = 0u;
+    BenchDisplayReads = 0u;
+    BenchSetupWrites = 0u;
+    BenchMode = mode;
+    BenchReleasing = true;
+    while (BenchReleases < BenchReleasesMax)
+    {
+        OSTimeDly(10u, OS_OPT_TIME_DLY, &err);
+    }
+    BenchReleasing = false;
+    BenchMode = BENCH_MODE_IDLE;
+    releases = BenchReleases;
+
+    Bench_Stats(BenchLatency, releases, 1000.0, &lat);
+    Bench_Stats(BenchBlocked, releases, 1000.0, &blk);
+    printf("  %s\n", label);
+    Bench_PrintStatsRow("    release -> snapshot (us)", &lat);
+    Bench_PrintStatsRow("    blocked in acquire (us)", &blk);
+    printf("    seqlock retries %llu, background reads %llu, writes %llu, context switches %u\n",
+           (unsigned long long)BenchRetries, (unsigned long long)BenchDisplayReads,
+           (unsigned long long)BenchSetupWrites, (unsigned)(OSTaskCtxSwCtr - ctx_sw0));
+}
+
+static void Bench_MasterTask(void *p_arg)
+{
+    const char *env_iter = getenv("BENCH_ITER");
+    CPU_INT32U iter = (env_iter != NULL && atoi(env_iter) > 0) ? (CPU_INT32U)atoi(env_iter) : 200000u;
+
+    printf("Parameter block access: ParamMutex vs seqlock (host shim)\n");
+    printf("  uncontended, mean ns/op over %u ops   %10s %10s\n", (unsigned)iter, "mutex", "seqlock");
+    printf("    Control read (11 fields, 3 blocks)   %10.1f %10.1f\n",
+           Bench_Uncontended(Bench_OpRead, BENCH_MODE_MUTEX, iter),
+           Bench_Uncontended(Bench_OpRead, BENCH_MODE_SEQLOCK, iter));
+    printf("    Control write (dMn, Vset)            %10.1f %10.1f\n",
+           Bench_Uncontended(Bench_OpWriteControl, BENCH_MODE_MUTEX, iter),
+           Bench_Uncontended(Bench_OpWriteControl, BENCH_MODE_SEQLOCK, iter));
+    printf("    Sensors write (shift + Xn)           %10.1f %10.1f\n",
+           Bench_Uncontended(Bench_OpWriteSensors, BENCH_MODE_MUTEX, iter),
+           Bench_Uncontended(Bench_OpWriteSensors, BENCH_MODE_SEQLOCK, iter));
+
+    printf("  contended: Control released every tick, Display reader + Setup writer busy\n");
+    Bench_PrintStatsHeader("");
+    Bench_Contended(BENCH_MODE_MUTEX, "ParamMutex (priority inheritance)");
+    Bench_Contended(BENCH_MODE_SEQLOCK, "seqlock");
+    exit(0);
+}
+
+int main(void)
+{
+    OS_ERR err;
+    const char *env_rel = getenv("BENCH_RELEASES");
+
+    BenchReleasesMax = (env_rel != NULL && atoi(env_rel) > 0) ? (CPU_INT32U)atoi(env_rel) : 300u;
+    BenchLatency = calloc(BenchReleasesMax, sizeof(*BenchLatency));
+    BenchBlocked = calloc(BenchReleasesMax, sizeof(*BenchBlocked));
+
+    OSInit(&err);
+    OSMutexCreate(&BenchMutex, "Bench Param Mutex", &err);
+    OS_AppTimeTickHookPtr = Bench_TickHook;
+
+    OSTaskCreate(&MasterTCB, "Bench Master", Bench_MasterTask, 0, BENCH_PRIO_MASTER,
+                 &MasterStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&ControlTCB, "Bench Control", Bench_ControlTask, 0, BENCH_PRIO_CONTROL,
+                 &ControlStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&DisplayTCB, "Bench Display", Bench_DisplayTask, 0, BENCH_PRIO_DISPLAY,
+                 &DisplayStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+    OSTaskCreate(&SetupTCB, "Bench Setup", Bench_SetupTask, 0, BENCH_PRIO_SETUP,
+                 &SetupStk[0], BENCH_STK_SIZE / 10u, BENCH_STK_SIZE, 0, 0, 0, OS_OPT_TASK_NONE, &err);
+
+    OSStart(&err);
+    return 0;
+}
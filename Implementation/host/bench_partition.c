@@ -0,0 +1,494 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_params.h"
+#include "acc_seqlock.h"
+#include "bench_util.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Dual-core partition: per-writer cache-line blocks (acc_params.h) vs the
+// former single-struct Parameter Memory Block, on two pinned pthreads
+//
+// The host shim runs one task at a time, so this benchmark uses plain
+// pthreads pinned to two CPUs: a hard core (Sensors and Control stages: writes
+// the sensor and control blocks, reads the configuration) and a soft core
+// (Display: reads the sensor block and ACC01). Both layouts run the same
+// seqlock code with one sequence counter per writer; only the placement
+// differs. Bench_Legacy_t keeps the former field order, which packs all three
+// writers into the first cache line.
+//
+// 1. Publish latency: the hard core publishes a frame every BENCH_GAP_NS
+//    (sensor block stamped with CPU_TS_Get64(), then the control block); the
+//    soft core polls the sensor seq and records stamp → consistent snapshot.
+//    Also reports the hard core's cost per frame publish. Every snapshot must
+//    be whole (Xn, Vn and release of the same frame).
+// 2. False sharing: for BENCH_MS each core runs flat out, the hard core
+//    publishing frames, the soft core reading ACC01 and the gains, which no
+//    one writes. Reports ns per operation on each core.
+//
+// With a single CPU online both threads share it (yielding while they wait)
+// and the numbers show no cross-core traffic.
+//
+// Environment:
+//   BENCH_FRAMES    frames published for the latency run (default 20000)
+//   BENCH_GAP_NS    hard-core frame gap for the latency run (default 5000)
+//   BENCH_MS        false-sharing run time per layout (default 200)
+
+// Former layout: one struct, all writers in the first line
+typedef struct {
+    _Alignas(ACC_CACHE_LINE) volatile uint32_t seq_sensor;
+    volatile uint32_t seq_control;
+    volatile uint32_t seq_config;
+    uint8_t ACC01;
+    ACC_Value_t K1, K2, K3;
+    ACC_Value_t Vcruise;
+    ACC_Value_t Vset;
+    ACC_Value_t Xset;
+    ACC_Value_t Xn;
+    ACC_Value_t Vn;
+    ACC_Value_t Vn1;
+    ACC_Value_t Vn2;
+    ACC_Value_t dMn;
+    ACC_Value_t deltaV;
+    uint8_t rate;
+    CPU_TS release;
+} Bench_Legacy_t;
+
+// Field addresses of one layout, so both run the same access code
+typedef struct {
+    const char *name;
+    volatile uint32_t *seq_sensor, *seq_control, *seq_config;
+    ACC_Value_t *Xn, *Vn, *Vn1, *Vn2;
+    CPU_TS *release;
+    ACC_Value_t *dMn, *Vset;
+    uint8_t *ACC01;
+    ACC_Value_t *K1, *K2, *K3, *Xset, *Vcruise, *deltaV;
+} Bench_View_t;
+
+typedef struct {
+    ACC_Value_t Xn, Vn, Vn1, Vn2;
+    CPU_TS release;
+} Bench_SensorSnap_t;
+
+typedef struct {
+    uint8_t ACC01;
+    ACC_Value_t K1, K2, K3, Xset, Vcruise, deltaV;
+} Bench_ConfigSnap_t;
+
+static ACC_Parameters_t BenchSplit;
+static Bench_Legacy_t BenchLegacy;
+
+static int BenchCpu[2];
+static CPU_BOOLEAN BenchShared;                 // Only one CPU: threads time-share it
+static pthread_barrier_t BenchBarrier;
+static atomic_bool BenchStop;
+
+// Latency run
+static CPU_INT32U BenchFrames;
+static CPU_INT64U BenchGap;
+static CPU_INT64U *BenchLatency;                // stamp → snapshot (ns)
+static CPU_INT64U *BenchPublish;                // hard-core frame publish (ns)
+static CPU_INT32U BenchSeen;
+static CPU_INT32U BenchTorn;
+
+// False-sharing run
+static CPU_INT64U BenchRunNs;
+static CPU_INT64U BenchHardOps, BenchSoftOps;
+static volatile uint32_t BenchSink;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static void Bench_ViewSplit(Bench_View_t *p_view)
+{
+    p_view->name = "per-writer blocks";
+    p_view->seq_sensor = &BenchSplit.sensor.seq;
+    p_view->seq_control = &BenchSplit.control.seq;
+    p_view->seq_config = &BenchSplit.config.seq;
+    p_view->Xn = &BenchSplit.sensor.Xn;
+    p_view->Vn = &BenchSplit.sensor.Vn;
+    p_view->Vn1 = &BenchSplit.sensor.Vn1;
+    p_view->Vn2 = &BenchSplit.sensor.Vn2;
+    p_view->release = &BenchSplit.sensor.release;
+    p_view->dMn = &BenchSplit.control.dMn;
+    p_view->Vset = &BenchSplit.control.Vset;
+    p_view->ACC01 = &BenchSplit.config.ACC01;
+    p_view->K1 = &BenchSplit.config.K1;
+    p_view->K2 = &BenchSplit.config.K2;
+    p_view->K3 = &BenchSplit.config.K3;
+    p_view->Xset = &BenchSplit.config.Xset;
+    p_view->Vcruise = &BenchSplit.config.Vcruise;
+    p_view->deltaV = &BenchSplit.config.deltaV;
+}
+
+static void Bench_ViewLegacy(Bench_View_t *p_view)
+{
+    p_view->name = "single struct";
+    p_view->seq_sensor = &BenchLegacy.seq_sensor;
+    p_view->seq_control = &BenchLegacy.seq_control;
+    p_view->seq_config = &BenchLegacy.seq_config;
+    p_view->Xn = &BenchLegacy.Xn;
+    p_view->Vn = &BenchLegacy.Vn;
+    p_view->Vn1 = &BenchLegacy.Vn1;
+    p_view->Vn2 = &BenchLegacy.Vn2;
+    p_view->release = &BenchLegacy.release;
+    p_view->dMn = &BenchLegacy.dMn;
+    p_view->Vset = &BenchLegacy.Vset;
+    p_view->ACC01 = &BenchLegacy.ACC01;
+    p_view->K1 = &BenchLegacy.K1;
+    p_view->K2 = &BenchLegacy.K2;
+    p_view->K3 = &BenchLegacy.K3;
+    p_view->Xset = &BenchLegacy.Xset;
+    p_view->Vcruise = &BenchLegacy.Vcruise;
+    p_view->deltaV = &BenchLegacy.deltaV;
+}
+
+static void Bench_Pin(int cpu)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+static void Bench_Relax(void)
+{
+    if (BenchShared)
+    {
+        sched_yield();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Access patterns as used by acc_tasks.c
+// ---------------------------------------------------------------------------
+
+static ACC_Value_t Bench_Value(CPU_INT32U k)
+{
+    return ACC_VALUE_FROM_FLOAT((float)(k & 0x7FFFu));
+}
+
+// Sensors stage then Control stage of frame k (Control's gain read included)
+static void Bench_PublishFrame(const Bench_View_t *p_view, CPU_INT32U k, CPU_TS stamp)
+{
+    ACC_Value_t v = Bench_Value(k);
+    ACC_Value_t K1, Vset;
+    uint32_t seq;
+
+    Seq_WriteBegin(p_view->seq_sensor);
+    *p_view->Vn2 = *p_view->Vn1;
+    *p_view->Vn1 = *p_view->Vn;
+    *p_view->Vn = v;
+    *p_view->Xn = v;
+    *p_view->release = stamp;
+    Seq_WriteEnd(p_view->seq_sensor);
+
+    do
+    {
+        seq = Seq_ReadBegin(p_view->seq_config);
+        K1 = *p_view->K1;
+    } while (Seq_ReadRetry(p_view->seq_config, seq));
+    Vset = *p_view->Vset;
+
+    Seq_WriteBegin(p_view->seq_control);
+    *p_view->dMn = K1 - v;                      // Stand-in for the law (not timed here)
+    *p_view->Vset = Vset;
+    Seq_WriteEnd(p_view->seq_control);
+}
+
+static void Bench_ReadSensor(const Bench_View_t *p_view, Bench_SensorSnap_t *p_snap)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = Seq_ReadBegin(p_view->seq_sensor);
+        p_snap->Xn = *p_view->Xn;
+        p_snap->Vn = *p_view->Vn;
+        p_snap->Vn1 = *p_view->Vn1;
+        p_snap->Vn2 = *p_view->Vn2;
+        p_snap->release = *p_view->release;
+    } while (Seq_ReadRetry(p_view->seq_sensor, seq));
+}
+
+static void Bench_ReadConfig(const Bench_View_t *p_view, Bench_ConfigSnap_t *p_snap)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = Seq_ReadBegin(p_view->seq_config);
+        p_snap->ACC01 = *p_view->ACC01;
+        p_snap->K1 = *p_view->K1;
+        p_snap->K2 = *p_view->K2;
+        p_snap->K3 = *p_view->K3;
+        p_snap->Xset = *p_view->Xset;
+        p_snap->Vcruise = *p_view->Vcruise;
+        p_snap->deltaV = *p_view->deltaV;
+    } while (Seq_ReadRetry(p_view->seq_config, seq));
+}
+
+static void Bench_Reset(const Bench_View_t *p_view)
+{
+    *p_view->seq_sensor = 0u;
+    *p_view->seq_control = 0u;
+    *p_view->seq_config = 0u;
+    *p_view->Xn = *p_view->Vn = *p_view->Vn1 = *p_view->Vn2 = ACC_VALUE(0.0);
+    *p_view->release = 0u;
+    *p_view->dMn = ACC_VALUE(0.0);
+    *p_view->Vset = ACC_VALUE(100.0);
+    *p_view->ACC01 = 1u;
+    *p_view->K1 = ACC_VALUE(1.0);
+    *p_view->K2 = ACC_VALUE(0.5);
+    *p_view->K3 = ACC_VALUE(0.25);
+    *p_view->Xset = ACC_VALUE(50.0);
+    *p_view->Vcruise = ACC_VALUE(100.0);
+    *p_view->deltaV = ACC_VALUE(5.0);
+}
+
+// ---------------------------------------------------------------------------
+// 1. Publish latency
+// ---------------------------------------------------------------------------
+
+// Frame k is stamped with its publish time in release (low 32 bits) and the
+// values Bench_Value(k), so the soft core can tell a torn snapshot
+static void *Bench_LatencyHard(void *p_arg)
+{
+    const Bench_View_t *p_view = p_arg;
+    CPU_TS64 next, t0;
+    CPU_INT32U k;
+
+    Bench_Pin(BenchCpu[0]);
+    pthread_barrier_wait(&BenchBarrier);
+    next = CPU_TS_Get64();
+    for (k = 1u; k <= BenchFrames; k++)
+    {
+        next += BenchGap;
+        while (CPU_TS_Get64() < next)
+        {
+            Bench_Relax();
+        }
+        t0 = CPU_TS_Get64();
+        Bench_PublishFrame(p_view, k, (CPU_TS)t0);
+        BenchPublish[k - 1u] = CPU_TS_Get64() - t0;
+    }
+    atomic_store(&BenchStop, true);
+    return NULL;
+}
+
+static void *Bench_LatencySoft(void *p_arg)
+{
+    const Bench_View_t *p_view = p_arg;
+    Bench_SensorSnap_t snap;
+    Bench_ConfigSnap_t cfg;
+    uint32_t last = *p_view->seq_sensor;
+
+    Bench_Pin(BenchCpu[1]);
+    pthread_barrier_wait(&BenchBarrier);
+    while (!atomic_load(&BenchStop))
+    {
+        uint32_t seq = *p_view->seq_sensor;
+
+        if (seq == last || (seq & 1u) != 0u)
+        {
+            Bench_Relax();
+            continue;
+        }
+        Bench_ReadSensor(p_view, &snap);
+        BenchLatency[BenchSeen++] = (CPU_TS)((CPU_TS)CPU_TS_Get64() - snap.release);  // Mod 2^32 ns
+        if (snap.Xn != snap.Vn)
+        {
+            BenchTorn++;
+        }
+        Bench_ReadConfig(p_view, &cfg);                            // Display's ACC01
+        last = seq;
+    }
+    return NULL;
+}
+
+static CPU_INT32U Bench_Latency(const Bench_View_t *p_view)
+{
+    pthread_t hard, soft;
+    Bench_Stats_t lat, pub;
+
+    Bench_Reset(p_view);
+    BenchSeen = 0u;
+    BenchTorn = 0u;
+    atomic_store(&BenchStop, false);
+    pthread_barrier_init(&BenchBarrier, NULL, 2u);
+    pthread_create(&soft, NULL, Bench_LatencySoft, (void *)p_view);
+    pthread_create(&hard, NULL, Bench_LatencyHard, (void *)p_view);
+    pthread_join(hard, NULL);
+    pthread_join(soft, NULL);
+    pthread_barrier_destroy(&BenchBarrier);
+
+    Bench_Stats(BenchLatency, BenchSeen, 1.0, &lat);
+    Bench_Stats(BenchPublish, BenchFrames, 1.0, &pub);
+    printf("  %s\n", p_view->name);
+    Bench_PrintStatsRow("    publish -> snapshot (ns)", &lat);
+    Bench_PrintStatsRow("    hard-core frame publish (ns)", &pub);
+    printf("    frames %u, seen %u, torn %u\n", (unsigned)BenchFrames, (unsigned)BenchSeen,
+           (unsigned)BenchTorn);
+    return BenchTorn;
+}
+
+// ---------------------------------------------------------------------------
+// 2. False sharing
+// ---------------------------------------------------------------------------
+
+static void *Bench_SharingHard(void *p_arg)
+{
+    const Bench_View_t *p_view = p_arg;
+    CPU_INT64U ops = 0u;
+    CPU_INT32U k = 1u;
+
+    Bench_Pin(BenchCpu[0]);
+    pthread_barrier_wait(&BenchBarrier);
+    while (!atomic_load_explicit(&BenchStop, memory_order_relaxed))
+    {
+        Bench_PublishFrame(p_view, k, (CPU_TS)k);
+        k++;
+        ops++;
+        if ((ops & 1023u) == 0u)
+        {
+            Bench_Relax();
+        }
+    }
+    BenchHardOps = ops;
+    return NULL;
+}
+
+static void *Bench_SharingSoft(void *p_arg)
+{
+    const Bench_View_t *p_view = p_arg;
+    Bench_ConfigSnap_t cfg;
+    CPU_INT64U ops = 0u;
+
+    Bench_Pin(BenchCpu[1]);
+    pthread_barrier_wait(&BenchBarrier);
+    while (!atomic_load_explicit(&BenchStop, memory_order_relaxed))
+    {
+        Bench_ReadConfig(p_view, &cfg);
+        BenchSink = cfg.ACC01;
+        ops++;
+        if ((ops & 1023u) == 0u)
+        {
+            Bench_Relax();
+        }
+    }
+    BenchSoftOps = ops;
+    return NULL;
+}
+
+static void Bench_Sharing(const Bench_View_t *p_view, double *p_hard_ns, double *p_soft_ns)
+{
+    pthread_t hard, soft;
+    CPU_TS64 t0, t1;
+
+    Bench_Reset(p_view);
+    atomic_store(&BenchStop, false);
+    pthread_barrier_init(&BenchBarrier, NULL, 3u);
+    pthread_create(&soft, NULL, Bench_SharingSoft, (void *)p_view);
+    pthread_create(&hard, NULL, Bench_SharingHard, (void *)p_view);
+    pthread_barrier_wait(&BenchBarrier);
+    t0 = CPU_TS_Get64();
+    while (CPU_TS_Get64() - t0 < BenchRunNs)
+    {
+        sched_yield();
+    }
+    atomic_store(&BenchStop, true);
+    pthread_join(hard, NULL);
+    pthread_join(soft, NULL);
+    t1 = CPU_TS_Get64();
+    pthread_barrier_destroy(&BenchBarrier);
+
+    *p_hard_ns = (BenchHardOps > 0u) ? (double)(t1 - t0) / (double)BenchHardOps : 0.0;
+    *p_soft_ns = (BenchSoftOps > 0u) ? (double)(t1 - t0) / (double)BenchSoftOps : 0.0;
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+// First two CPUs this process may run on
+static void Bench_PickCpus(void)
+{
+    cpu_set_t set;
+    int n = 0;
+
+    BenchCpu[0] = BenchCpu[1] = 0;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE && n < 2; cpu++)
+        {
+            if (CPU_ISSET(cpu, &set))
+            {
+                BenchCpu[n++] = cpu;
+            }
+        }
+    }
+    if (n < 2)
+    {
+        BenchCpu[1] = BenchCpu[0];
+    }
+    BenchShared = (n < 2);
+}
+
+int main(void)
+{
+    Bench_View_t views[2];
+    double hard_ns[2], soft_ns[2];
+    CPU_INT32U torn = 0u;
+    CPU_INT32U i;
+
+    BenchFrames = Bench_Env("BENCH_FRAMES", 20000u);
+    BenchGap = Bench_Env("BENCH_GAP_NS", 5000u);
+    BenchRunNs = (CPU_INT64U)Bench_Env("BENCH_MS", 200u) * 1000000u;
+    BenchLatency = calloc(BenchFrames, sizeof(*BenchLatency));
+    BenchPublish = calloc(BenchFrames, sizeof(*BenchPublish));
+    Bench_ViewSplit(&views[0]);
+    Bench_ViewLegacy(&views[1]);
+    Bench_PickCpus();
+
+    printf("Dual-core partition: per-writer blocks vs single struct (pinned pthreads)\n");
+    printf("  hard core CPU %d, soft core CPU %d%s\n", BenchCpu[0], BenchCpu[1],
+           BenchShared ? " (one CPU online: threads time-share it, no cross-core traffic)" : "");
+    printf("  layout: sensor/control/config blocks %u/%u/%u bytes at offsets %u/%u/%u; "
+           "single struct %u bytes, one line holds every writer\n",
+           (unsigned)sizeof(ACC_SensorParams_t), (unsigned)sizeof(ACC_ControlParams_t),
+           (unsigned)sizeof(ACC_ConfigParams_t), (unsigned)offsetof(ACC_Parameters_t, sensor),
+           (unsigned)offsetof(ACC_Parameters_t, control), (unsigned)offsetof(ACC_Parameters_t, config),
+           (unsigned)sizeof(Bench_Legacy_t));
+
+    printf("  publish latency: frame every %llu ns, Display polling on the other core\n",
+           (unsigned long long)BenchGap);
+    Bench_PrintStatsHeader("");
+    for (i = 0u; i < 2u; i++)
+    {
+        torn += Bench_Latency(&views[i]);
+    }
+
+    printf("  false sharing: frames flat out on the hard core, ACC01 + gains read flat out on the soft core\n");
+    printf("    %-20s %14s %14s\n", "", "hard ns/frame", "soft ns/read");
+    for (i = 0u; i < 2u; i++)
+    {
+        Bench_Sharing(&views[i], &hard_ns[i], &soft_ns[i]);
+        printf("    %-20s %14.1f %14.1f\n", views[i].name, hard_ns[i], soft_ns[i]);
+    }
+
+    if (torn != 0u)
+    {
+        printf("FAIL: torn sensor snapshots\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,270 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_radar.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Multi-target radar: in-path lead selection check and cost at 64 tracks
+//
+// 1. Check: Radar_SelectLead() against a reference in double with libm
+//    sin/cos on random frames (0 to RADAR_TRACKS_MAX tracks, ranges up to
+//    RADAR_RANGE_MAX_M, azimuth ±0.5 rad, yaw rate ±0.3 rad/s). The reference
+//    decides with the gate narrowed and widened by BENCH_TOL; frames where the
+//    two disagree, or where the nearest candidates are closer than BENCH_TOL,
+//    are ambiguous and skipped. Otherwise the same slot must be selected.
+// 2. Curve: a left curve of 500 m radius with the lead 60 m ahead in the own
+//    lane, a slower car in the right lane and guard-rail posts on both sides.
+//    The predicted path must select the lead; a straight path (yaw rate
+//    ignored) is shown for comparison.
+// 3. Cost: ns per selection at 64, 8 and 0 valid tracks (the cost must not
+//    depend on the count) and of the scalar reference at 64.
+//
+// Environment:
+//   BENCH_FRAMES    random frames checked (default 200000)
+//   BENCH_ITER      selections timed per row (default 2000000)
+//   BENCH_SEED      frame seed (default 1)
+
+#if ACC_RADAR_EN
+
+#define BENCH_TOL         0.05      // m: gate edge and tie margin of the reference
+#define BENCH_SET_QTY     64u       // Frames per timed set (cycled)
+#define BENCH_LANE_M      3.5f
+#define BENCH_RAIL_M      6.25f     // Guard rails: 1 m beyond the outer lane edges
+#define BENCH_NONE        UINT32_MAX
+
+static ACC_RadarFrame_t BenchSet[BENCH_SET_QTY];
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static double Bench_Uniform(void)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (double)((BenchRng * 2685821657736338717ull) >> 11) / 9007199254740992.0;
+}
+
+static double Bench_Range(double lo, double hi)
+{
+    return lo + (hi - lo) * Bench_Uniform();
+}
+
+static void Bench_RandomFrame(ACC_RadarFrame_t *p_frame, CPU_INT32U count, double yaw)
+{
+    CPU_INT32U i;
+
+    for (i = 0u; i < RADAR_TRACKS_MAX; i++)
+    {
+        p_frame->range[i] = ACC_VALUE_FROM_FLOAT((float)Bench_Range(1.0, RADAR_RANGE_MAX_M));
+        p_frame->range_rate[i] = ACC_VALUE_FROM_FLOAT((float)Bench_Range(-30.0, 10.0));
+        p_frame->azimuth[i] = ACC_VALUE_FROM_FLOAT((float)Bench_Range(-0.5, 0.5));
+    }
+    p_frame->count = count;
+    p_frame->yaw_rate = ACC_VALUE_FROM_FLOAT((float)yaw);
+}
+
+// Reference: nearest in-path slot with the gate widened by margin (m)
+static CPU_INT32U Bench_Reference(const ACC_RadarFrame_t *p_frame, double Vn, double margin,
+                                  double *p_x, double *p_x2)
+{
+    double v = fmax(Vn / 3.6, RADAR_V_MIN_KMH / 3.6);
+    double half_k = 0.5 * (double)ACC_VALUE_TO_FLOAT(p_frame->yaw_rate) / v;
+    CPU_INT32U best = BENCH_NONE;
+    CPU_INT32U i;
+
+    *p_x = *p_x2 = 1e9;
+    for (i = 0u; i < p_frame->count; i++)
+    {
+        double r = ACC_VALUE_TO_FLOAT(p_frame->range[i]);
+        double a = ACC_VALUE_TO_FLOAT(p_frame->azimuth[i]);
+        double x = r * cos(a);
+        double dy = r * sin(a) - half_k * x * x;
+        double gate = RADAR_LANE_HALF_M + RADAR_GATE_GROW * x + margin;
+
+        if (x > RADAR_X_MIN_M && fabs(dy) < gate)
+        {
+            if (x < *p_x)
+            {
+                *p_x2 = *p_x;
+                *p_x = x;
+                best = i;
+            }
+            else if (x < *p_x2)
+            {
+                *p_x2 = x;
+            }
+        }
+    }
+    return best;
+}
+
+static CPU_INT32U Bench_Check(CPU_INT32U frames)
+{
+    ACC_RadarFrame_t frame;
+    ACC_RadarLead_t lead;
+    CPU_INT32U errors = 0u, skipped = 0u, found = 0u;
+    double err_max = 0.0;
+    CPU_INT32U n;
+
+    for (n = 0u; n < frames; n++)
+    {
+        double Vn = Bench_Range(0.0, 150.0);
+        double x_in, x_in2, x_out, x_out2;
+        CPU_INT32U in, out;
+        ACC_Value_t Xn;
+
+        Bench_RandomFrame(&frame, (CPU_INT32U)(Bench_Uniform() * (RADAR_TRACKS_MAX + 1u)),
+                          Bench_Range(-0.3, 0.3));
+        Xn = Radar_SelectLead(&frame, ACC_VALUE_FROM_FLOAT((float)Vn), &lead);
+        in = Bench_Reference(&frame, Vn, -BENCH_TOL, &x_in, &x_in2);
+        out = Bench_Reference(&frame, Vn, BENCH_TOL, &x_out, &x_out2);
+        if (in != out || x_in2 - x_in < BENCH_TOL)
+        {
+            skipped++;
+            continue;
+        }
+        if (in == BENCH_NONE)
+        {
+            if (lead.found || ACC_VALUE_TO_FLOAT(Xn) != (float)RADAR_RANGE_MAX_M)
+            {
+                errors++;
+            }
+            continue;
+        }
+        found++;
+        if (!lead.found || lead.idx != in || Xn != lead.x || lead.range_rate != frame.range_rate[in])
+        {
+            errors++;
+            continue;
+        }
+        err_max = fmax(err_max, fabs(ACC_VALUE_TO_FLOAT(Xn) - x_in));
+    }
+    if (err_max > BENCH_TOL)
+    {
+        errors++;
+    }
+    printf("check: %u frames (%u with a lead, %u ambiguous skipped), max |x - reference| %.4f m, %u errors: %s\n",
+           (unsigned)frames, (unsigned)found, (unsigned)skipped, err_max, (unsigned)errors,
+           (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// Object on the road at arc length s ahead, lateral offset d (left +), on a
+// road of curvature k (1/m, left +), seen from the ego vehicle heading along it
+static void Bench_Place(ACC_RadarFrame_t *p_frame, double s, double d, double k, double v_rel)
+{
+    CPU_INT32U i = p_frame->count++;
+    double x = s, y = d + 0.5 * k * s * s;
+
+    if (fabs(k) > 1e-9)
+    {
+        x = (1.0 / k - d) * sin(k * s);
+        y = 1.0 / k - (1.0 / k - d) * cos(k * s);
+    }
+    p_frame->range[i] = ACC_VALUE_FROM_FLOAT((float)hypot(x, y));
+    p_frame->azimuth[i] = ACC_VALUE_FROM_FLOAT((float)atan2(y, x));
+    p_frame->range_rate[i] = ACC_VALUE_FROM_FLOAT((float)(v_rel * cos(atan2(y, x))));
+}
+
+static CPU_INT32U Bench_Curve(void)
+{
+    const double k = 1.0 / 500.0, v = 90.0 / 3.6;
+    ACC_RadarFrame_t frame = { .count = 0u };
+    ACC_RadarLead_t lead, straight;
+    double s;
+
+    Bench_Place(&frame, 45.0, -BENCH_LANE_M, k, -15.0 / 3.6);         // Slower car, right lane
+    Bench_Place(&frame, 60.0, 0.0, k, 0.0);                          // Lead, own lane (slot 1)
+    for (s = 10.0; s <= 150.0 && frame.count + 2u <= RADAR_TRACKS_MAX; s += 20.0)
+    {
+        Bench_Place(&frame, s, BENCH_RAIL_M - BENCH_LANE_M, k, -v);  // Left rail
+        Bench_Place(&frame, s, -BENCH_RAIL_M, k, -v);                // Right rail
+    }
+    frame.yaw_rate = ACC_VALUE_FROM_FLOAT((float)(v * k));
+    (void)Radar_SelectLead(&frame, ACC_VALUE_FROM_FLOAT(90.0f), &lead);
+    frame.yaw_rate = ACC_VALUE(0.0);
+    (void)Radar_SelectLead(&frame, ACC_VALUE_FROM_FLOAT(90.0f), &straight);
+
+    printf("curve (R 500 m, %u tracks): predicted path -> slot %u at %.1f m (%s), straight path -> %s",
+           (unsigned)frame.count, (unsigned)lead.idx, ACC_VALUE_TO_FLOAT(lead.x),
+           (lead.found && lead.idx == 1u) ? "lead, ok" : "FAIL",
+           straight.found ? "" : "no target\n");
+    if (straight.found)
+    {
+        printf("slot %u at %.1f m (%s)\n", (unsigned)straight.idx, ACC_VALUE_TO_FLOAT(straight.x),
+               (straight.idx == 0u) ? "right-lane car" : (straight.idx == 1u) ? "lead" : "guard rail");
+    }
+    return (lead.found && lead.idx == 1u) ? 0u : 1u;
+}
+
+static double Bench_Time(CPU_INT32U count, bool reference, CPU_INT32U iter)
+{
+    ACC_RadarLead_t lead;
+    volatile double sink = 0.0;
+    double x, x2;
+    CPU_TS64 t0, t1;
+    CPU_INT32U i;
+
+    for (i = 0u; i < BENCH_SET_QTY; i++)
+    {
+        Bench_RandomFrame(&BenchSet[i], count, Bench_Range(-0.3, 0.3));
+    }
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        const ACC_RadarFrame_t *p_frame = &BenchSet[i & (BENCH_SET_QTY - 1u)];
+
+        if (reference)
+        {
+            sink += Bench_Reference(p_frame, 90.0, 0.0, &x, &x2);
+        }
+        else
+        {
+            sink += ACC_VALUE_TO_FLOAT(Radar_SelectLead(p_frame, ACC_VALUE(90.0), &lead));
+        }
+    }
+    t1 = CPU_TS_Get64();
+    (void)sink;
+    return (double)(t1 - t0) / (double)iter;
+}
+
+int main(void)
+{
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 2000000u);
+    CPU_INT32U errors;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Multi-target radar: in-path lead selection (%u slots, %s)\n",
+           (unsigned)RADAR_TRACKS_MAX, ACC_FIXED_POINT ? "Q16.16" : "float");
+    errors = Bench_Check(Bench_Env("BENCH_FRAMES", 200000u));
+    errors += Bench_Curve();
+    printf("cost, mean ns per frame over %u frames\n", (unsigned)iter);
+    printf("  Radar_SelectLead, 64 valid tracks   %8.1f\n", Bench_Time(RADAR_TRACKS_MAX, false, iter));
+    printf("  Radar_SelectLead, 8 valid tracks    %8.1f\n", Bench_Time(8u, false, iter));
+    printf("  Radar_SelectLead, no tracks         %8.1f\n", Bench_Time(0u, false, iter));
+    printf("  scalar reference (libm), 64 tracks  %8.1f\n", Bench_Time(RADAR_TRACKS_MAX, true, iter / 10u));
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("multi-target radar disabled (ACC_RADAR_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_RADAR_EN
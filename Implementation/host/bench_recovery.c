@@ -0,0 +1,235 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_recovery.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checkpoint / rollback: check word, checkpoint selection, rollback budget
+// and the cost per frame
+//
+// 1. Check word: every single-bit flip of a stored checkpoint must fail it.
+// 2. Restore: a random sequence of computed frames (one in four in doubt),
+//    new engagements, damaged slots and rollbacks against a model of the
+//    ring. Recovery_Restore() must return the newest undamaged checkpoint
+//    of the current engagement, or none if there is no such checkpoint.
+// 3. Budget: RECOVERY_MAX_ROLLBACKS rollbacks within RECOVERY_WINDOW_MS are
+//    allowed, one more is refused, and one after the window is allowed.
+// 4. Cost: ns per Recovery_Frame() (mean over frames, one in
+//    RECOVERY_CKPT_FRAMES stores a checkpoint) and per Recovery_Restore().
+//
+// Environment:
+//   BENCH_OPS       restore steps (default 1000000)
+//   BENCH_ITER      frames timed (default 10000000)
+//   BENCH_SEED      random seed (default 1)
+
+#if ACC_RECOVERY_EN
+
+typedef struct {
+    ACC_Checkpoint_t ckpt;
+    bool             damaged;
+} BenchSlot_t;
+
+static ACC_Recovery_t BenchRec;
+static CPU_INT64U BenchRng;
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static CPU_INT32U Bench_Next(CPU_INT32U n)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (CPU_INT32U)(((BenchRng * 2685821657736338717ull) >> 32) % n);
+}
+
+static ACC_Value_t Bench_Value(void)
+{
+    return ACC_VALUE_FROM_FLOAT((float)Bench_Next(200000u) / 1000.0f);
+}
+
+// 1. Single-bit flips
+static CPU_INT32U Bench_CheckWord(void)
+{
+    ACC_Checkpoint_t good, bad;
+    CPU_INT32U byte, bit, flips = 0u, missed = 0u;
+
+    Recovery_Init(&BenchRec);
+    Recovery_Frame(&BenchRec, 7u, false, Bench_Value(), Bench_Value(), Bench_Value());
+    while (BenchRec.taken == 0u)
+    {
+        Recovery_Frame(&BenchRec, 7u, false, Bench_Value(), Bench_Value(), Bench_Value());
+    }
+    good = BenchRec.ring[0];
+    for (byte = 0u; byte < sizeof(good); byte++)
+    {
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            bad = good;
+            ((uint8_t *)&bad)[byte] ^= (uint8_t)(1u << bit);
+            if (memcmp(&bad, &good, sizeof(bad)) == 0)
+            {
+                continue;   // Padding
+            }
+            flips++;
+            missed += (Recovery_Check(&bad) == bad.check);
+        }
+    }
+    memset(&bad, 0, sizeof(bad));
+    missed += (Recovery_Check(&bad) == bad.check);      // Unwritten slot
+    printf("  check word   %8u bit flips      missed %u  %s\n",
+           (unsigned)flips, (unsigned)missed, (missed == 0u) ? "ok" : "FAIL");
+    return missed;
+}
+
+// 2. Restore against a model of the ring
+static CPU_INT32U Bench_Restore(CPU_INT32U ops)
+{
+    BenchSlot_t model[RECOVERY_CKPT_QTY];
+    CPU_INT32U head = 0u, n, errors = 0u, found = 0u, none = 0u;
+    uint32_t engage = 1u;
+
+    Recovery_Init(&BenchRec);
+    memset(model, 0, sizeof(model));
+    for (n = 0u; n < ops; n++)
+    {
+        CPU_INT32U op = Bench_Next(100u);
+
+        if (op < 80u)
+        {
+            bool doubt = (Bench_Next(4u) == 0u);
+            ACC_Value_t Vset = Bench_Value(), dMn = Bench_Value(), Amodel = Bench_Value();
+            uint32_t taken = BenchRec.taken;
+
+            Recovery_Frame(&BenchRec, engage, doubt, Vset, dMn, Amodel);
+            if (BenchRec.taken != taken)
+            {
+                errors += doubt;
+                model[head].ckpt = BenchRec.ring[head];
+                model[head].damaged = false;
+                errors += (model[head].ckpt.Vset != Vset) || (model[head].ckpt.engage != engage);
+                head = (head + 1u) % RECOVERY_CKPT_QTY;
+            }
+        }
+        else if (op < 83u)
+        {
+            engage++;
+        }
+        else if (op < 90u)
+        {
+            // One bit of one slot
+            CPU_INT32U slot = Bench_Next(RECOVERY_CKPT_QTY);
+
+            ((uint8_t *)&BenchRec.ring[slot])[Bench_Next(sizeof(ACC_Checkpoint_t))] ^=
+                (uint8_t)(1u << Bench_Next(8u));
+            model[slot].damaged = memcmp(&BenchRec.ring[slot], &model[slot].ckpt, sizeof(ACC_Checkpoint_t)) != 0;
+        }
+        else
+        {
+            ACC_Checkpoint_t got;
+            const ACC_Checkpoint_t *p_expect = NULL;
+            CPU_INT32U i;
+            bool ok;
+
+            // Newest undamaged written slot; stop at an older engagement
+            for (i = 1u; i <= RECOVERY_CKPT_QTY; i++)
+            {
+                const BenchSlot_t *p_slot = &model[(head + RECOVERY_CKPT_QTY - i) % RECOVERY_CKPT_QTY];
+
+                if (p_slot->damaged || p_slot->ckpt.frame == 0u)
+                {
+                    continue;
+                }
+                p_expect = (p_slot->ckpt.engage == engage) ? &p_slot->ckpt : NULL;
+                break;
+            }
+            ok = Recovery_Restore(&BenchRec, engage, &got);
+            errors += (ok != (p_expect != NULL)) ||
+                      (ok && memcmp(&got, p_expect, sizeof(got)) != 0);
+            found += ok;
+            none += !ok;
+        }
+    }
+    printf("  restore      %8u steps          %u taken, %u restored, %u without one, "
+           "%u damaged slots skipped, errors %u  %s\n",
+           (unsigned)ops, (unsigned)BenchRec.taken, (unsigned)found, (unsigned)none,
+           (unsigned)BenchRec.invalid, (unsigned)errors, (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// 3. Rollback budget
+static CPU_INT32U Bench_Budget(void)
+{
+    OS_TICK window = MS_TO_TICKS(RECOVERY_WINDOW_MS);
+    OS_TICK t = 1000u;
+    CPU_INT32U i, errors = 0u;
+
+    Recovery_Init(&BenchRec);
+    for (i = 0u; i < RECOVERY_MAX_ROLLBACKS; i++)
+    {
+        errors += !Recovery_Allow(&BenchRec, t + i);
+    }
+    errors += Recovery_Allow(&BenchRec, t + window - 1u);          // One more in the window
+    errors += !Recovery_Allow(&BenchRec, t + window);               // First one has left it
+    errors += (BenchRec.rollbacks != RECOVERY_MAX_ROLLBACKS + 1u) || (BenchRec.shutdowns != 1u);
+    printf("  budget       %u rollbacks per %u ms      errors %u  %s\n",
+           (unsigned)RECOVERY_MAX_ROLLBACKS, (unsigned)RECOVERY_WINDOW_MS, (unsigned)errors,
+           (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+int main(void)
+{
+    CPU_INT32U ops = Bench_Env("BENCH_OPS", 1000000u);
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 10000000u);
+    CPU_INT32U errors = 0u, i;
+    ACC_Checkpoint_t got;
+    volatile CPU_INT32U sink = 0u;
+    CPU_TS64 t0, t1, t2;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Checkpoint / rollback: %u slots, one per %u frames, checkpoint %u bytes\n",
+           (unsigned)RECOVERY_CKPT_QTY, (unsigned)RECOVERY_CKPT_FRAMES, (unsigned)sizeof(ACC_Checkpoint_t));
+    errors += Bench_CheckWord();
+    errors += Bench_Restore(ops);
+    errors += Bench_Budget();
+
+    Recovery_Init(&BenchRec);
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        Recovery_Frame(&BenchRec, 1u, false, (ACC_Value_t)i, ACC_VALUE(1.0), ACC_VALUE(0.0));
+    }
+    t1 = CPU_TS_Get64();
+    for (i = 0u; i < iter / 10u; i++)
+    {
+        sink += Recovery_Restore(&BenchRec, 1u, &got);
+    }
+    t2 = CPU_TS_Get64();
+    printf("cost, mean over %u frames\n", (unsigned)iter);
+    printf("  Recovery_Frame, per frame                %8.1f ns\n", (double)(t1 - t0) / iter);
+    printf("  Recovery_Restore                         %8.1f ns\n", (double)(t2 - t1) / (iter / 10u));
+    (void)sink;
+    if (errors != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
+
+#else
+
+int main(void)
+{
+    printf("checkpoint / rollback disabled (ACC_RECOVERY_EN 0)\n");
+    return 0;
+}
+
+#endif // ACC_RECOVERY_EN
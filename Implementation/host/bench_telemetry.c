@@ -0,0 +1,194 @@
+#include "os.h"
+#include "acc_config.h"
+#include "acc_telemetry.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Telemetry: codec round trip, encoded size and the producer's cost
+//
+// 1. Round trip: random records (values from small steps to any 32-bit
+//    pattern, flag changes, sequence gaps) are encoded and decoded. Every
+//    decoded record must equal the Q16.16 of the one encoded, and no prefix
+//    of an encoded record may decode.
+// 2. Size: bytes per record of a following drive (ego speed closing on a
+//    slower lead, the gap settling on Xset), without and with sensor noise
+//    (0.5 m and 0.5 km/h, 1 sigma), against the raw record.
+// 3. Cost: ns per Telem_Put() (the Control stage's share) and per record
+//    encoded (Telem_Task's).
+//
+// Environment:
+//   BENCH_OPS       round-trip records (default 1000000)
+//   BENCH_ITER      records timed (default 10000000)
+//   BENCH_SEED      random seed (default 1)
+
+#define BENCH_DRIVE_FRAMES    3000u     // 5 minutes at 100 ms
+
+static CPU_INT64U BenchRng;
+static ACC_TelemRing_t BenchRing;
+static uint8_t BenchBuf[TELEM_ENC_MAX];
+
+static CPU_INT32U Bench_Env(const char *name, CPU_INT32U dflt)
+{
+    const char *env = getenv(name);
+
+    return (env != NULL && atoi(env) > 0) ? (CPU_INT32U)atoi(env) : dflt;
+}
+
+static CPU_INT32U Bench_Next(CPU_INT32U n)
+{
+    // xorshift64*
+    BenchRng ^= BenchRng >> 12;
+    BenchRng ^= BenchRng << 25;
+    BenchRng ^= BenchRng >> 27;
+    return (CPU_INT32U)(((BenchRng * 2685821657736338717ull) >> 32) % n);
+}
+
+static float Bench_Gauss(float sigma)
+{
+    float u1 = ((float)Bench_Next(1u << 24) + 1.0f) / 16777216.0f;
+    float u2 = (float)Bench_Next(1u << 24) / 16777216.0f;
+
+    return sigma * sqrtf(-2.0f * logf(u1)) * cosf(6.2831853f * u2);
+}
+
+static int32_t Bench_Q(ACC_Value_t v)
+{
+#if ACC_FIXED_POINT
+    return v;
+#else
+    return Q_FromFloat(v);
+#endif
+}
+
+// A value near the previous one, or anywhere
+static ACC_Value_t Bench_Value(ACC_Value_t prev)
+{
+    switch (Bench_Next(4u))
+    {
+        case 0u:
+#if ACC_FIXED_POINT
+            return (ACC_Value_t)(Bench_Next(0xFFFFFFFFu) ^ (Bench_Next(2u) << 31));
+#else
+            return ACC_VALUE_FROM_FLOAT((float)Bench_Next(2000000u) / 100.0f - 10000.0f);
+#endif
+        case 1u:
+            return ACC_VALUE(0.0);
+        default:
+#if ACC_FIXED_POINT
+            return Q_Add(prev, Q_FromFloat((float)Bench_Next(2001u) / 1000.0f - 1.0f));
+#else
+            return prev + ((float)Bench_Next(2001u) / 1000.0f - 1.0f);
+#endif
+    }
+}
+
+// 1. Encode, decode, compare
+static CPU_INT32U Bench_RoundTrip(CPU_INT32U ops)
+{
+    ACC_TelemCodec_t enc, dec, probe;
+    ACC_TelemRec_t rec;
+    ACC_TelemFrame_t got;
+    CPU_INT32U n, len, cut, errors = 0u;
+
+    Telem_CodecInit(&enc);
+    Telem_CodecInit(&dec);
+    memset(&rec, 0, sizeof(rec));
+    rec.seq = 0xFFFFFFFFu;
+    for (n = 0u; n < ops; n++)
+    {
+        rec.seq += 1u + ((Bench_Next(16u) == 0u) ? Bench_Next(1000u) : 0u);
+        rec.flags = (Bench_Next(8u) == 0u) ? Bench_Next(0x400u) : rec.flags;
+        rec.Xn = Bench_Value(rec.Xn);
+        rec.Vn = Bench_Value(rec.Vn);
+        rec.Vset = Bench_Value(rec.Vset);
+        rec.dMn = Bench_Value(rec.dMn);
+        len = Telem_Encode(&enc, &rec, BenchBuf);
+        errors += (len > TELEM_ENC_MAX);
+        for (cut = 0u; cut < len; cut++)
+        {
+            probe = dec;
+            errors += (Telem_Decode(&probe, BenchBuf, cut, &got) != 0u);
+        }
+        errors += (Telem_Decode(&dec, BenchBuf, len, &got) != len);
+        errors += (got.seq != rec.seq) || (got.flags != rec.flags) ||
+                  (got.v[0] != Bench_Q(rec.Xn)) || (got.v[1] != Bench_Q(rec.Vn)) ||
+                  (got.v[2] != Bench_Q(rec.Vset)) || (got.v[3] != Bench_Q(rec.dMn));
+    }
+    printf("  round trip   %8u records        errors %u  %s\n",
+           (unsigned)ops, (unsigned)errors, (errors == 0u) ? "ok" : "FAIL");
+    return errors;
+}
+
+// 2. Following drive: mean bytes per record
+static double Bench_Drive(float noise)
+{
+    ACC_TelemCodec_t enc;
+    ACC_TelemRec_t rec;
+    float gap = 120.0f, ego = 110.0f, lead = 90.0f, vset = 100.0f, dM = 0.0f;
+    CPU_INT32U n, bytes = 0u;
+
+    Telem_CodecInit(&enc);
+    for (n = 0u; n < BENCH_DRIVE_FRAMES; n++)
+    {
+        // 100 ms frames: speed follows dM, the gap the speed difference
+        vset = (gap >= 50.0f) ? 100.0f : vset - 2.0f * 0.1f;
+        dM = 0.5f * (vset - ego);
+        ego += 0.1f * dM;
+        gap += (lead - ego) / 3.6f * 0.1f;
+        rec = (ACC_TelemRec_t){ n, TELEM_F_ENGAGE * (n == 0u),
+                                ACC_VALUE_FROM_FLOAT(gap + Bench_Gauss(noise)),
+                                ACC_VALUE_FROM_FLOAT(ego + Bench_Gauss(noise)),
+                                ACC_VALUE_FROM_FLOAT(vset), ACC_VALUE_FROM_FLOAT(dM) };
+        bytes += Telem_Encode(&enc, &rec, BenchBuf);
+    }
+    return (double)bytes / BENCH_DRIVE_FRAMES;
+}
+
+int main(void)
+{
+    CPU_INT32U ops = Bench_Env("BENCH_OPS", 1000000u);
+    CPU_INT32U iter = Bench_Env("BENCH_ITER", 10000000u);
+    CPU_INT32U errors, i, bytes = 0u;
+    ACC_TelemCodec_t enc;
+    double smooth, noisy;
+    CPU_TS64 t0, t1, t2;
+
+    BenchRng = Bench_Env("BENCH_SEED", 1u);
+    printf("Telemetry: record %u bytes raw, %u encoded at most, ring %u records\n",
+           (unsigned)sizeof(ACC_TelemRec_t), (unsigned)TELEM_ENC_MAX, (unsigned)TELEM_RING_SIZE);
+    errors = Bench_RoundTrip(ops);
+    smooth = Bench_Drive(0.0f);
+    noisy = Bench_Drive(0.5f);
+    printf("encoded size, following drive of %u frames\n", (unsigned)BENCH_DRIVE_FRAMES);
+    printf("  sensors without noise                  %6.2f bytes per record (%.0f %% of raw)\n",
+           smooth, smooth / sizeof(ACC_TelemRec_t) * 100.0);
+    printf("  sensors with noise                     %6.2f bytes per record (%.0f %% of raw)\n",
+           noisy, noisy / sizeof(ACC_TelemRec_t) * 100.0);
+
+    // Producer: the ring is emptied after each put (one more store per record)
+    memset(&BenchRing, 0, sizeof(BenchRing));
+    t0 = CPU_TS_Get64();
+    for (i = 0u; i < iter; i++)
+    {
+        Telem_Put(&BenchRing, 0u, (ACC_Value_t)i, ACC_VALUE(90.0), ACC_VALUE(100.0), ACC_VALUE(0.5));
+        BenchRing.tail = BenchRing.head;
+    }
+    t1 = CPU_TS_Get64();
+    Telem_CodecInit(&enc);
+    for (i = 0u; i < iter; i++)
+    {
+        bytes += Telem_Encode(&enc, &BenchRing.rec[i & (TELEM_RING_SIZE - 1u)], BenchBuf);
+    }
+    t2 = CPU_TS_Get64();
+    printf("cost, mean over %u records (%u bytes encoded)\n", (unsigned)iter, (unsigned)bytes);
+    printf("  Telem_Put (Control stage)              %8.1f ns\n", (double)(t1 - t0) / iter);
+    printf("  Telem_Encode (Telem_Task)              %8.1f ns\n", (double)(t2 - t1) / iter);
+    if (errors != 0u || BenchRing.drops != 0u)
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+    return 0;
+}
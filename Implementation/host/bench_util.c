@@ -0,0 +1,62 @@
+#include "bench_util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int Bench_CompareU64(const void *a, const void *b)
+{
+    CPU_INT64U x = *(const CPU_INT64U *)a;
+    CPU_INT64U y = *(const CPU_INT64U *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double Bench_Percentile(const CPU_INT64U *sorted, CPU_INT32U n, double pct)
+{
+    CPU_INT32U ix = (CPU_INT32U)(pct / 100.0 * (double)(n - 1u) + 0.5);
+
+    return (double)sorted[ix];
+}
+
+void Bench_Stats(CPU_INT64U *samples, CPU_INT32U n, double div, Bench_Stats_t *p_stats)
+{
+    double sum = 0.0;
+    CPU_INT32U i;
+
+    memset(p_stats, 0, sizeof(*p_stats));
+    p_stats->n = n;
+    if (n == 0u)
+    {
+        return;
+    }
+
+    qsort(samples, n, sizeof(*samples), Bench_CompareU64);
+    for (i = 0u; i < n; i++)
+    {
+        sum += (double)samples[i];
+    }
+    p_stats->min = (double)samples[0] / div;
+    p_stats->p50 = Bench_Percentile(samples, n, 50.0) / div;
+    p_stats->p90 = Bench_Percentile(samples, n, 90.0) / div;
+    p_stats->p99 = Bench_Percentile(samples, n, 99.0) / div;
+    p_stats->max = (double)samples[n - 1u] / div;
+    p_stats->mean = sum / (double)n / div;
+}
+
+void Bench_PrintStatsHeader(const char *label)
+{
+    printf("  %-32s %8s %9s %9s %9s %9s %9s %9s\n",
+           label, "n", "min", "p50", "p90", "p99", "max", "mean");
+}
+
+void Bench_PrintStatsRow(const char *label, const Bench_Stats_t *p_stats)
+{
+    if (p_stats->n == 0u)
+    {
+        printf("  %-32s %8s\n", label, "no samples");
+        return;
+    }
+    printf("  %-32s %8u %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+           label, (unsigned)p_stats->n,
+           p_stats->min, p_stats->p50, p_stats->p90, p_stats->p99, p_stats->max, p_stats->mean);
+}
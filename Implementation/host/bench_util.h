@@ -0,0 +1,25 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include "cpu.h"
+
+// Sample statistics shared by the host harness and benchmarks
+
+typedef struct {
+    CPU_INT32U n;
+    double     min;
+    double     p50;
+    double     p90;
+    double     p99;
+    double     max;
+    double     mean;
+} Bench_Stats_t;
+
+// Sorts samples[] in place; values are scaled by 1/div (e.g. 1000 for ns → us)
+void Bench_Stats(CPU_INT64U *samples, CPU_INT32U n, double div, Bench_Stats_t *p_stats);
+
+// "%8u %9.1f ..." row: n min p50 p90 p99 max mean
+void Bench_PrintStatsRow(const char *label, const Bench_Stats_t *p_stats);
+void Bench_PrintStatsHeader(const char *label);
+
+#endif // BENCH_UTIL_H
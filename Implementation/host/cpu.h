@@ -0,0 +1,32 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Host (Linux/POSIX) port of the uC/CPU data types used by the ACC code.
+// Only the subset referenced by Implementation/ and the host shim is provided.
+
+typedef char            CPU_CHAR;
+typedef uint8_t         CPU_INT08U;
+typedef uint16_t        CPU_INT16U;
+typedef uint32_t        CPU_INT32U;
+typedef uint64_t        CPU_INT64U;
+typedef bool            CPU_BOOLEAN;
+
+// Stack element: native word on the host, 32-bit on the Cortex-M target
+typedef uintptr_t       CPU_STK;
+typedef size_t          CPU_STK_SIZE;
+
+// Timestamp: 32-bit free-running counter, 1 count = 1 ns on the host.
+// Wraps after ~4.29 s, so only differences between close stamps are meaningful.
+typedef CPU_INT32U      CPU_TS;
+typedef CPU_INT64U      CPU_TS64;
+
+CPU_TS   CPU_TS_Get32(void);
+CPU_TS64 CPU_TS_Get64(void);
+
+#define CPU_TS_TmrFreq_Hz   1000000000u
+
+#endif // CPU_H
@@ -0,0 +1,346 @@
+#ifndef OS_H
+#define OS_H
+
+// Host (Linux/POSIX) shim for the uC/OS-III API subset used by the ACC code.
+//
+// Every task runs on its own pthread, but only the task holding the simulated
+// CPU (OSTCBCurPtr) executes; all others wait on their TCB condition variable.
+// Scheduling is fixed-priority preemptive: the highest-priority ready task is
+// dispatched at every kernel call and at OSIntExit(). A task preempted by an
+// interrupt keeps running until its next kernel call (the host cannot stop a
+// thread mid-instruction), which is a preemption point like on the target.
+//
+// The tick runs on a dedicated thread at OS_CFG_TICK_RATE_HZ and is delivered
+// as an interrupt (OSIntEnter/OSTimeTick/OSIntExit). Any non-task thread may act
+// as an ISR by bracketing its kernel calls with OSIntEnter()/OSIntExit().
+//
+// With OS_HostVirtualTime set there is no tick thread: time only advances
+// through OS_HostTimeAdvance(), which delivers each tick once all tasks are
+// blocked. Task code then takes zero simulated time, runs never overlap a tick,
+// and a run is reproducible for the same inputs.
+
+#include <pthread.h>
+#include "cpu.h"
+#include "os_cfg.h"
+
+// ---------------------------------------------------------------------------
+// Data types
+// ---------------------------------------------------------------------------
+
+typedef CPU_INT08U      OS_PRIO;
+typedef CPU_INT32U      OS_TICK;
+typedef CPU_INT32U      OS_SEM_CTR;
+typedef CPU_INT32U      OS_FLAGS;
+typedef CPU_INT16U      OS_MSG_SIZE;
+typedef CPU_INT16U      OS_MSG_QTY;
+typedef CPU_INT16U      OS_MEM_QTY;
+typedef CPU_INT16U      OS_MEM_SIZE;
+typedef CPU_INT16U      OS_OPT;
+typedef CPU_INT08U      OS_NESTING_CTR;
+typedef CPU_INT32U      OS_CTX_SW_CTR;
+typedef CPU_INT32U      OS_STK_SIZE;
+typedef CPU_INT08U      OS_STATE;
+typedef CPU_INT08U      OS_STATUS;
+typedef CPU_INT16U      OS_OBJ_QTY;
+
+typedef void (*OS_TASK_PTR)(void *p_arg);
+typedef void (*OS_TMR_CALLBACK_PTR)(void *p_tmr, void *p_arg);
+typedef void (*OS_APP_HOOK_VOID)(void);
+
+// ---------------------------------------------------------------------------
+// Error codes
+// ---------------------------------------------------------------------------
+
+typedef enum os_err {
+    OS_ERR_NONE = 0u,
+    OS_ERR_FATAL_RETURN,
+    OS_ERR_FLAG_PEND_OPT,
+    OS_ERR_MEM_FULL,
+    OS_ERR_MEM_INVALID_P_ADDR,
+    OS_ERR_MEM_INVALID_BLKS,
+    OS_ERR_MEM_NO_FREE_BLKS,
+    OS_ERR_MUTEX_NESTING,
+    OS_ERR_MUTEX_NOT_OWNER,
+    OS_ERR_MUTEX_OWNER,
+    OS_ERR_OBJ_PTR_NULL,
+    OS_ERR_OS_NOT_RUNNING,
+    OS_ERR_PEND_ABORT,
+    OS_ERR_PEND_ABORT_NONE,
+    OS_ERR_PEND_ISR,
+    OS_ERR_PEND_WOULD_BLOCK,
+    OS_ERR_PRIO_INVALID,
+    OS_ERR_PTR_INVALID,
+    OS_ERR_SCHED_LOCKED,
+    OS_ERR_SCHED_NOT_LOCKED,
+    OS_ERR_Q_MAX,
+    OS_ERR_Q_SIZE,
+    OS_ERR_SEM_OVF,
+    OS_ERR_TASK_CREATE_ISR,
+    OS_ERR_TASK_OPT,
+    OS_ERR_TASK_WAITING,
+    OS_ERR_TCB_INVALID,
+    OS_ERR_TIME_DLY_ISR,
+    OS_ERR_TIMEOUT,
+    OS_ERR_TMR_INVALID,
+    OS_ERR_TMR_INVALID_PERIOD,
+    OS_ERR_TMR_STOPPED
+} OS_ERR;
+
+// ---------------------------------------------------------------------------
+// Options
+// ---------------------------------------------------------------------------
+
+#define OS_OPT_NONE                 (OS_OPT)0x0000u
+
+#define OS_OPT_PEND_FLAG_CLR_ALL    (OS_OPT)0x0001u
+#define OS_OPT_PEND_FLAG_CLR_ANY    (OS_OPT)0x0002u
+#define OS_OPT_PEND_FLAG_SET_ALL    (OS_OPT)0x0004u
+#define OS_OPT_PEND_FLAG_SET_ANY    (OS_OPT)0x0008u
+#define OS_OPT_PEND_FLAG_MASK       (OS_OPT)0x000Fu
+#define OS_OPT_PEND_FLAG_CONSUME    (OS_OPT)0x0100u
+#define OS_OPT_PEND_BLOCKING        (OS_OPT)0x0000u
+#define OS_OPT_PEND_NON_BLOCKING    (OS_OPT)0x8000u
+#define OS_OPT_PEND_ABORT_1         (OS_OPT)0x0000u
+#define OS_OPT_PEND_ABORT_ALL       (OS_OPT)0x0100u
+
+#define OS_OPT_POST_FLAG_SET        (OS_OPT)0x0000u
+#define OS_OPT_POST_FLAG_CLR        (OS_OPT)0x0001u
+#define OS_OPT_POST_FIFO            (OS_OPT)0x0000u
+#define OS_OPT_POST_LIFO            (OS_OPT)0x0010u
+#define OS_OPT_POST_1               (OS_OPT)0x0000u
+#define OS_OPT_POST_ALL             (OS_OPT)0x0200u
+#define OS_OPT_POST_NONE            (OS_OPT)0x0000u
+#define OS_OPT_POST_NO_SCHED        (OS_OPT)0x8000u
+
+#define OS_OPT_TASK_NONE            (OS_OPT)0x0000u
+#define OS_OPT_TASK_STK_CHK         (OS_OPT)0x0001u
+#define OS_OPT_TASK_STK_CLR         (OS_OPT)0x0002u
+#define OS_OPT_TASK_SAVE_FP         (OS_OPT)0x0004u
+
+#define OS_OPT_TIME_DLY             (OS_OPT)0x0000u
+#define OS_OPT_TIME_PERIODIC        (OS_OPT)0x0008u
+#define OS_OPT_TIME_HMSM_STRICT     (OS_OPT)0x0000u
+#define OS_OPT_TIME_HMSM_NON_STRICT (OS_OPT)0x0010u
+
+#define OS_OPT_TMR_ONE_SHOT         (OS_OPT)0x0001u
+#define OS_OPT_TMR_PERIODIC         (OS_OPT)0x0002u
+
+// ---------------------------------------------------------------------------
+// Task states and pend status
+// ---------------------------------------------------------------------------
+
+#define OS_TASK_STATE_RDY           (OS_STATE)0u
+#define OS_TASK_STATE_DLY           (OS_STATE)1u
+#define OS_TASK_STATE_PEND          (OS_STATE)2u
+#define OS_TASK_STATE_PEND_TIMEOUT  (OS_STATE)3u
+#define OS_TASK_STATE_DEL           (OS_STATE)255u
+
+#define OS_TASK_PEND_ON_NOTHING     (OS_STATE)0u
+#define OS_TASK_PEND_ON_FLAG        (OS_STATE)1u
+#define OS_TASK_PEND_ON_MUTEX       (OS_STATE)2u
+#define OS_TASK_PEND_ON_Q           (OS_STATE)3u
+#define OS_TASK_PEND_ON_SEM         (OS_STATE)4u
+#define OS_TASK_PEND_ON_TASK_SEM    (OS_STATE)5u
+
+#define OS_STATUS_PEND_OK           (OS_STATUS)0u
+#define OS_STATUS_PEND_ABORT        (OS_STATUS)1u
+#define OS_STATUS_PEND_TIMEOUT      (OS_STATUS)2u
+
+#define OS_TMR_STATE_UNUSED         (OS_STATE)0u
+#define OS_TMR_STATE_STOPPED        (OS_STATE)1u
+#define OS_TMR_STATE_RUNNING        (OS_STATE)2u
+#define OS_TMR_STATE_COMPLETED      (OS_STATE)3u
+
+// ---------------------------------------------------------------------------
+// Kernel objects
+// ---------------------------------------------------------------------------
+
+typedef struct os_tcb {
+    CPU_CHAR           *NamePtr;
+    OS_TASK_PTR         TaskEntryAddr;
+    void               *TaskEntryArg;
+    OS_PRIO             Prio;           // Current priority (raised by mutex inheritance)
+    OS_PRIO             BasePrio;       // Priority given at creation
+    OS_OPT              Opt;
+    CPU_STK            *StkBasePtr;
+    CPU_STK_SIZE        StkSize;
+    OS_STATE            TaskState;
+    OS_STATE            PendOn;
+    void               *PendObjPtr;
+    OS_STATUS           PendStatus;
+    OS_TICK             TickExpiry;     // Absolute tick for delays/timeouts
+    OS_TICK             TickCtrPrev;    // Reference for OS_OPT_TIME_PERIODIC
+    OS_SEM_CTR          SemCtr;         // Task semaphore
+    void               *MsgPtr;         // Message handed over by OSQPost
+    OS_MSG_SIZE         MsgSize;
+    OS_FLAGS            FlagsPend;
+    OS_FLAGS            FlagsRdy;
+    OS_OPT              FlagsOpt;
+    CPU_TS              TS;
+    OS_CTX_SW_CTR       CtxSwCtr;
+    CPU_TS64            CyclesStart;    // Dispatch time of the current run (ns on the host)
+    CPU_TS64            CyclesTotal;    // Accumulated run time (ns on the host)
+    CPU_INT32U          KernelCallCtr;  // Host port: kernel API calls made by the task
+    pthread_t           Thread;         // Host port
+    pthread_cond_t      Cond;           // Host port: signalled when dispatched
+    CPU_STK            *HostStkLo;      // Host port: lowest word of the thread stack (above the guard)
+    CPU_STK            *HostStkTop;     // Host port: stack pointer at task entry (NULL: not started)
+} OS_TCB;
+
+typedef struct os_sem {
+    CPU_CHAR           *NamePtr;
+    OS_SEM_CTR          Ctr;
+    CPU_TS              TS;
+} OS_SEM;
+
+typedef struct os_mutex {
+    CPU_CHAR           *NamePtr;
+    OS_TCB             *OwnerTCBPtr;
+    OS_NESTING_CTR      OwnerNestingCtr;
+    CPU_TS              TS;
+} OS_MUTEX;
+
+typedef struct os_msg {
+    void               *MsgPtr;
+    OS_MSG_SIZE         MsgSize;
+    CPU_TS              MsgTS;
+} OS_MSG;
+
+#define OS_CFG_Q_SIZE_MAX           16u
+
+typedef struct os_q {
+    CPU_CHAR           *NamePtr;
+    OS_MSG              Msgs[OS_CFG_Q_SIZE_MAX];
+    OS_MSG_QTY          NbrEntriesSize; // Max entries given at creation
+    OS_MSG_QTY          NbrEntries;
+    OS_MSG_QTY          InIx;
+    OS_MSG_QTY          OutIx;
+} OS_Q;
+
+typedef struct os_flag_grp {
+    CPU_CHAR           *NamePtr;
+    OS_FLAGS            Flags;
+    CPU_TS              TS;
+} OS_FLAG_GRP;
+
+typedef struct os_mem {
+    CPU_CHAR           *NamePtr;
+    void               *AddrPtr;
+    OS_MEM_SIZE         BlkSize;
+    OS_MEM_QTY          NbrMax;
+    OS_MEM_QTY          NbrFree;
+    CPU_INT64U          FreeMask;       // Host port: bit i set = block i free
+} OS_MEM;
+
+typedef struct os_tmr {
+    CPU_CHAR           *NamePtr;
+    OS_TMR_CALLBACK_PTR CallbackPtr;
+    void               *CallbackPtrArg;
+    OS_TICK             Dly;
+    OS_TICK             Period;
+    OS_OPT              Opt;
+    OS_STATE            State;
+    OS_TICK             Match;          // Absolute expiry tick
+} OS_TMR;
+
+// ---------------------------------------------------------------------------
+// Kernel state
+// ---------------------------------------------------------------------------
+
+extern OS_TCB          *OSTCBCurPtr;
+extern OS_TCB          *OSTCBHighRdyPtr;
+extern volatile OS_TICK OSTickCtr;
+extern OS_NESTING_CTR   OSIntNestingCtr;
+extern OS_NESTING_CTR   OSSchedLockNestingCtr;
+extern CPU_BOOLEAN      OSRunning;
+extern OS_CTX_SW_CTR    OSTaskCtxSwCtr;
+extern CPU_INT32U       OSKernelCallCtr;        // Host port: kernel API calls made by tasks
+extern CPU_TS64         OSTickCyclesMax;        // Host port: longest tick interrupt (ns), app tick hook excluded
+
+// Application hooks (called with the kernel locked: must not call the OS API)
+extern OS_APP_HOOK_VOID OS_AppTaskSwHookPtr;     // OSTCBHighRdyPtr is about to run (NULL: idle)
+// Called at the start of every tick in interrupt context (may post)
+extern OS_APP_HOOK_VOID OS_AppTimeTickHookPtr;
+
+#define OS_TS_GET()     CPU_TS_Get32()
+
+// ---------------------------------------------------------------------------
+// API
+// ---------------------------------------------------------------------------
+
+void        OSInit          (OS_ERR *p_err);
+void        OSStart         (OS_ERR *p_err);
+void        OSSchedLock     (OS_ERR *p_err);
+void        OSSchedUnlock   (OS_ERR *p_err);
+void        OSIntEnter      (void);
+void        OSIntExit       (void);
+void        OSTimeTick      (void);
+OS_TICK     OSTimeGet       (OS_ERR *p_err);
+void        OSTimeDly       (OS_TICK dly, OS_OPT opt, OS_ERR *p_err);
+void        OSTimeDlyHMSM   (CPU_INT16U hours, CPU_INT16U minutes, CPU_INT16U seconds,
+                             CPU_INT32U milli, OS_OPT opt, OS_ERR *p_err);
+
+void        OSTaskCreate    (OS_TCB *p_tcb, CPU_CHAR *p_name, OS_TASK_PTR p_task, void *p_arg,
+                             OS_PRIO prio, CPU_STK *p_stk_base, CPU_STK_SIZE stk_limit,
+                             CPU_STK_SIZE stk_size, OS_MSG_QTY q_size, OS_TICK time_quanta,
+                             void *p_ext, OS_OPT opt, OS_ERR *p_err);
+OS_SEM_CTR  OSTaskSemPend   (OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err);
+OS_SEM_CTR  OSTaskSemPost   (OS_TCB *p_tcb, OS_OPT opt, OS_ERR *p_err);
+OS_SEM_CTR  OSTaskSemSet    (OS_TCB *p_tcb, OS_SEM_CTR cnt, OS_ERR *p_err);
+CPU_BOOLEAN OSTaskSemPendAbort(OS_TCB *p_tcb, OS_OPT opt, OS_ERR *p_err);
+void        OSTaskStkChk    (OS_TCB *p_tcb, CPU_STK_SIZE *p_free, CPU_STK_SIZE *p_used, OS_ERR *p_err);
+
+void        OSSemCreate     (OS_SEM *p_sem, CPU_CHAR *p_name, OS_SEM_CTR cnt, OS_ERR *p_err);
+OS_SEM_CTR  OSSemPend       (OS_SEM *p_sem, OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err);
+OS_SEM_CTR  OSSemPost       (OS_SEM *p_sem, OS_OPT opt, OS_ERR *p_err);
+void        OSSemSet        (OS_SEM *p_sem, OS_SEM_CTR cnt, OS_ERR *p_err);
+OS_OBJ_QTY  OSSemPendAbort  (OS_SEM *p_sem, OS_OPT opt, OS_ERR *p_err);
+
+void        OSMutexCreate   (OS_MUTEX *p_mutex, CPU_CHAR *p_name, OS_ERR *p_err);
+void        OSMutexPend     (OS_MUTEX *p_mutex, OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err);
+void        OSMutexPost     (OS_MUTEX *p_mutex, OS_OPT opt, OS_ERR *p_err);
+
+void        OSQCreate       (OS_Q *p_q, CPU_CHAR *p_name, OS_MSG_QTY max_qty, OS_ERR *p_err);
+void       *OSQPend         (OS_Q *p_q, OS_TICK timeout, OS_OPT opt, OS_MSG_SIZE *p_msg_size,
+                             CPU_TS *p_ts, OS_ERR *p_err);
+void        OSQPost         (OS_Q *p_q, void *p_void, OS_MSG_SIZE msg_size, OS_OPT opt, OS_ERR *p_err);
+
+void        OSFlagCreate    (OS_FLAG_GRP *p_grp, CPU_CHAR *p_name, OS_FLAGS flags, OS_ERR *p_err);
+OS_FLAGS    OSFlagPend      (OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_TICK timeout, OS_OPT opt,
+                             CPU_TS *p_ts, OS_ERR *p_err);
+OS_FLAGS    OSFlagPost      (OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_OPT opt, OS_ERR *p_err);
+OS_FLAGS    OSFlagAccept    (OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_OPT opt, OS_ERR *p_err);
+
+void        OSMemCreate     (OS_MEM *p_mem, CPU_CHAR *p_name, void *p_addr, OS_MEM_QTY n_blks,
+                             OS_MEM_SIZE blk_size, OS_ERR *p_err);
+void       *OSMemGet        (OS_MEM *p_mem, OS_ERR *p_err);
+void        OSMemPut        (OS_MEM *p_mem, void *p_blk, OS_ERR *p_err);
+
+void        OSTmrCreate     (OS_TMR *p_tmr, CPU_CHAR *p_name, OS_TICK dly, OS_TICK period, OS_OPT opt,
+                             OS_TMR_CALLBACK_PTR p_callback, void *p_callback_arg, OS_ERR *p_err);
+void        OSTmrSet        (OS_TMR *p_tmr, OS_TICK dly, OS_TICK period, OS_TMR_CALLBACK_PTR p_callback,
+                             void *p_callback_arg, OS_ERR *p_err);
+CPU_BOOLEAN OSTmrStart      (OS_TMR *p_tmr, OS_ERR *p_err);
+CPU_BOOLEAN OSTmrStop       (OS_TMR *p_tmr, OS_OPT opt, void *p_callback_arg, OS_ERR *p_err);
+
+// ---------------------------------------------------------------------------
+// Host port extensions
+// ---------------------------------------------------------------------------
+
+// Runs on the main thread once OSStart() has dispatched the first task.
+// The default (weak) implementation returns and OSStart() then blocks forever.
+void        App_OS_HostMain (void);
+
+// Virtual time (set before OSStart(), e.g. from Hardware_Init()); the caller
+// of OS_HostTimeAdvance() is the tick interrupt and must not be a task
+extern CPU_BOOLEAN OS_HostVirtualTime;
+void        OS_HostTimeAdvance(OS_TICK ticks);
+
+// Stacks: every task thread runs on a cleared, guarded stack of the host's
+// own size, and OSTaskStkChk() counts the words used on it below the task
+// entry (host code, so sizes are not the target's). The tick thread, where
+// the tick interrupt and the hooks it calls run, is measured the same way;
+// 0 with virtual time (no tick thread).
+CPU_STK_SIZE OS_HostIsrStkUsed(void);
+
+#endif // OS_H
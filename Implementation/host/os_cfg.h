@@ -0,0 +1,14 @@
+#ifndef OS_CFG_H
+#define OS_CFG_H
+
+// Host build configuration (mirrors the target os_cfg.h requirements in README.md)
+
+#ifndef OS_CFG_TICK_RATE_HZ
+#define OS_CFG_TICK_RATE_HZ       100u    // 10 ms tick (1 ms with ACC_RATE_ADAPT_EN, see Makefile)
+#endif
+#define OS_CFG_PRIO_MAX           64u     // Priorities 0..63
+#define OS_CFG_TASK_MAX           16u     // Max tasks created with OSTaskCreate
+#define OS_CFG_MEM_BLKS_MAX       64u     // Max blocks per OS_MEM partition (host free-mask width)
+#define OS_CFG_TMR_MAX            8u      // Max software timers
+
+#endif // OS_CFG_H
@@ -0,0 +1,1514 @@
+#include "os.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+// Host (pthreads) implementation of the uC/OS-III subset declared in os.h.
+// One global lock serialises the kernel; see os.h for the execution model.
+
+OS_TCB          *OSTCBCurPtr;
+OS_TCB          *OSTCBHighRdyPtr;
+volatile OS_TICK OSTickCtr;
+OS_NESTING_CTR   OSIntNestingCtr;
+OS_NESTING_CTR   OSSchedLockNestingCtr;
+CPU_BOOLEAN      OSRunning;
+OS_CTX_SW_CTR    OSTaskCtxSwCtr;
+CPU_INT32U       OSKernelCallCtr;
+CPU_TS64         OSTickCyclesMax;
+CPU_BOOLEAN      OS_HostVirtualTime;
+
+OS_APP_HOOK_VOID OS_AppTaskSwHookPtr;
+OS_APP_HOOK_VOID OS_AppTimeTickHookPtr;
+
+static pthread_mutex_t  OS_HostLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   OS_HostIdleCond = PTHREAD_COND_INITIALIZER;   // Signalled when the CPU goes idle
+static __thread OS_TCB *OS_HostSelf;                // TCB of the calling task thread, NULL otherwise
+
+static OS_TCB          *OS_TaskTbl[OS_CFG_TASK_MAX];
+static CPU_INT08U       OS_TaskQty;
+static OS_TMR          *OS_TmrTbl[OS_CFG_TMR_MAX];
+static CPU_INT08U       OS_TmrQty;
+static CPU_TS64         OS_TickHookCycles;          // App tick hook time in the current tick
+static CPU_STK         *OS_TickStkLo;               // Tick thread stack (OS_HostIsrStkUsed)
+static CPU_STK *volatile OS_TickStkTop;
+
+#define OS_HOST_STK_BYTES   (256u * 1024u)          // Thread stack of every task and of the tick thread
+
+// ---------------------------------------------------------------------------
+// Timestamps
+// ---------------------------------------------------------------------------
+
+CPU_TS64 CPU_TS_Get64(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (CPU_TS64)now.tv_sec * 1000000000u + (CPU_TS64)now.tv_nsec;
+}
+
+CPU_TS CPU_TS_Get32(void)
+{
+    return (CPU_TS)CPU_TS_Get64();
+}
+
+// ---------------------------------------------------------------------------
+// Thread stacks
+// ---------------------------------------------------------------------------
+
+// Maps a thread stack for p_attr: zero-filled like OS_OPT_TASK_STK_CLR, with
+// an inaccessible lowest page so an overflow faults instead of corrupting.
+// Returns its lowest usable word (NULL: no memory).
+static CPU_STK *OS_HostStkAlloc(pthread_attr_t *p_attr)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *p = mmap(NULL, OS_HOST_STK_BYTES, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+
+    if (p == MAP_FAILED)
+    {
+        return NULL;
+    }
+    if (mprotect(p, page, PROT_NONE) != 0 ||
+        pthread_attr_setstack(p_attr, p, OS_HOST_STK_BYTES) != 0)
+    {
+        munmap(p, OS_HOST_STK_BYTES);
+        return NULL;
+    }
+    return (CPU_STK *)(p + page);
+}
+
+// Words between the deepest one ever written and top (stacks grow down)
+static CPU_STK_SIZE OS_HostStkUsed(const CPU_STK *p_lo, const CPU_STK *p_top)
+{
+    const CPU_STK *p = p_lo;
+
+    if (p_top == NULL)
+    {
+        return 0u;
+    }
+    while (p < p_top && *p == 0u)
+    {
+        p++;
+    }
+    return (CPU_STK_SIZE)(p_top - p);
+}
+
+CPU_STK_SIZE OS_HostIsrStkUsed(void)
+{
+    return OS_HostStkUsed(OS_TickStkLo, OS_TickStkTop);
+}
+
+// ---------------------------------------------------------------------------
+// Scheduler core (all helpers below run with OS_HostLock held)
+// ---------------------------------------------------------------------------
+
+// Block the calling task thread until it owns the simulated CPU
+static void OS_HostWaitCPU(OS_TCB *p_tcb)
+{
+    while (OSTCBCurPtr != p_tcb)
+    {
+        pthread_cond_wait(&p_tcb->Cond, &OS_HostLock);
+    }
+}
+
+// Enter the kernel. For a task this is also a preemption point: if an ISR
+// readied a higher-priority task meanwhile, wait here until dispatched again.
+static void OS_Lock(void)
+{
+    pthread_mutex_lock(&OS_HostLock);
+    if (OS_HostSelf != NULL && OSRunning)
+    {
+        OS_HostWaitCPU(OS_HostSelf);
+        OS_HostSelf->KernelCallCtr++;
+        OSKernelCallCtr++;
+    }
+}
+
+static void OS_Unlock(void)
+{
+    pthread_mutex_unlock(&OS_HostLock);
+}
+
+static OS_TCB *OS_HighRdy(void)
+{
+    OS_TCB *p_high = NULL;
+    CPU_INT08U i;
+
+    for (i = 0u; i < OS_TaskQty; i++)
+    {
+        OS_TCB *p_tcb = OS_TaskTbl[i];
+        if (p_tcb->TaskState == OS_TASK_STATE_RDY &&
+            (p_high == NULL || p_tcb->Prio < p_high->Prio))
+        {
+            p_high = p_tcb;
+        }
+    }
+    return p_high;
+}
+
+// Dispatch the highest-priority ready task. Called from a task, the caller
+// returns only once it owns the CPU again; from an ISR the switch is deferred
+// to the outermost OSIntExit().
+static void OS_Sched(void)
+{
+    OS_TCB *p_high;
+
+    if (!OSRunning || OSSchedLockNestingCtr > 0u || (OS_HostSelf == NULL && OSIntNestingCtr > 0u))
+    {
+        return;
+    }
+
+    p_high = OS_HighRdy();
+    if (p_high != OSTCBCurPtr)
+    {
+        CPU_TS64 now = CPU_TS_Get64();
+
+        OSTCBHighRdyPtr = p_high;
+        if (OSTCBCurPtr != NULL)
+        {
+            OSTCBCurPtr->CyclesTotal += now - OSTCBCurPtr->CyclesStart;
+        }
+        // Also called with OSTCBHighRdyPtr == NULL when the CPU goes idle
+        // (the switch to the idle task on the target)
+        if (OS_AppTaskSwHookPtr != NULL)
+        {
+            OS_AppTaskSwHookPtr();
+        }
+        if (p_high != NULL)
+        {
+            p_high->CtxSwCtr++;
+            p_high->CyclesStart = now;
+            OSTaskCtxSwCtr++;
+        }
+        OSTCBCurPtr = p_high;
+        if (p_high != NULL)
+        {
+            pthread_cond_signal(&p_high->Cond);
+        }
+        else
+        {
+            pthread_cond_broadcast(&OS_HostIdleCond);
+        }
+    }
+
+    if (OS_HostSelf != NULL)
+    {
+        OS_HostWaitCPU(OS_HostSelf);
+    }
+}
+
+static CPU_BOOLEAN OS_TickReached(OS_TICK expiry)
+{
+    return (OS_TICK)(OSTickCtr - expiry) < 0x80000000u;
+}
+
+// Put the running task on an object's wait list (timeout 0 = forever) and switch away
+static void OS_Pend(OS_TCB *p_tcb, OS_STATE pend_on, void *p_obj, OS_TICK timeout)
+{
+    p_tcb->PendOn = pend_on;
+    p_tcb->PendObjPtr = p_obj;
+    p_tcb->PendStatus = OS_STATUS_PEND_OK;
+    if (timeout > 0u)
+    {
+        p_tcb->TaskState = OS_TASK_STATE_PEND_TIMEOUT;
+        p_tcb->TickExpiry = OSTickCtr + timeout;
+    }
+    else
+    {
+        p_tcb->TaskState = OS_TASK_STATE_PEND;
+    }
+    OS_Sched();
+}
+
+static void OS_Rdy(OS_TCB *p_tcb, OS_STATUS status, CPU_TS ts)
+{
+    p_tcb->TaskState = OS_TASK_STATE_RDY;
+    p_tcb->PendOn = OS_TASK_PEND_ON_NOTHING;
+    p_tcb->PendObjPtr = NULL;
+    p_tcb->PendStatus = status;
+    p_tcb->TS = ts;
+}
+
+// Highest-priority task waiting on p_obj, or NULL
+static OS_TCB *OS_PendListHighest(OS_STATE pend_on, void *p_obj)
+{
+    OS_TCB *p_high = NULL;
+    CPU_INT08U i;
+
+    for (i = 0u; i < OS_TaskQty; i++)
+    {
+        OS_TCB *p_tcb = OS_TaskTbl[i];
+        if ((p_tcb->TaskState == OS_TASK_STATE_PEND || p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) &&
+            p_tcb->PendOn == pend_on && p_tcb->PendObjPtr == p_obj &&
+            (p_high == NULL || p_tcb->Prio < p_high->Prio))
+        {
+            p_high = p_tcb;
+        }
+    }
+    return p_high;
+}
+
+static OS_ERR OS_PendStatusErr(OS_STATUS status)
+{
+    switch (status)
+    {
+        case OS_STATUS_PEND_OK:      return OS_ERR_NONE;
+        case OS_STATUS_PEND_ABORT:   return OS_ERR_PEND_ABORT;
+        default:                     return OS_ERR_TIMEOUT;
+    }
+}
+
+static CPU_BOOLEAN OS_PendFromISR(OS_OPT opt, OS_ERR *p_err)
+{
+    if (OS_HostSelf == NULL && (opt & OS_OPT_PEND_NON_BLOCKING) == 0u)
+    {
+        *p_err = OS_ERR_PEND_ISR;
+        return true;
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Kernel start, interrupts and tick
+// ---------------------------------------------------------------------------
+
+__attribute__((weak)) void App_OS_HostMain(void)
+{
+}
+
+static void OS_TickISR(void)
+{
+    CPU_TS64 t0, dt;
+
+    t0 = CPU_TS_Get64();
+    OSIntEnter();
+    OSTimeTick();
+    OSIntExit();
+    // Tick overhead: the application's hook (simulated peripheral IRQs) is not the kernel's
+    dt = CPU_TS_Get64() - t0 - OS_TickHookCycles;
+    if (dt > OSTickCyclesMax)
+    {
+        OSTickCyclesMax = dt;
+    }
+}
+
+static void *OS_TickThread(void *p_arg)
+{
+    struct timespec next;
+    const long period_ns = 1000000000L / (long)OS_CFG_TICK_RATE_HZ;
+
+    (void)p_arg;
+    OS_TickStkTop = (CPU_STK *)__builtin_frame_address(0);
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    while (1)
+    {
+        next.tv_nsec += period_ns;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        OS_TickISR();
+    }
+    return NULL;
+}
+
+// Virtual time: wait until every task is blocked
+static void OS_HostWaitIdle(void)
+{
+    pthread_mutex_lock(&OS_HostLock);
+    while (OSTCBCurPtr != NULL)
+    {
+        pthread_cond_wait(&OS_HostIdleCond, &OS_HostLock);
+    }
+    pthread_mutex_unlock(&OS_HostLock);
+}
+
+// Virtual time: task code takes no time, so the next tick is due as soon as
+// the CPU goes idle. Delivers the ticks back to back from the caller's thread
+// and returns once the work they released has run to completion.
+void OS_HostTimeAdvance(OS_TICK ticks)
+{
+    OS_HostWaitIdle();
+    while (ticks > 0u)
+    {
+        OS_TickISR();
+        OS_HostWaitIdle();
+        ticks--;
+    }
+}
+
+void OSInit(OS_ERR *p_err)
+{
+    OSTCBCurPtr = NULL;
+    OSTCBHighRdyPtr = NULL;
+    OSTickCtr = 0u;
+    OSIntNestingCtr = 0u;
+    OSSchedLockNestingCtr = 0u;
+    OSRunning = false;
+    OSTaskCtxSwCtr = 0u;
+    OSKernelCallCtr = 0u;
+    OSTickCyclesMax = 0u;
+    OS_TaskQty = 0u;
+    OS_TmrQty = 0u;
+    *p_err = OS_ERR_NONE;
+}
+
+void OSStart(OS_ERR *p_err)
+{
+    pthread_t tick_thread;
+    pthread_attr_t attr;
+
+    OS_Lock();
+    OSRunning = true;
+    OS_Sched();
+    OS_Unlock();
+
+    if (!OS_HostVirtualTime)
+    {
+        pthread_attr_init(&attr);
+        OS_TickStkLo = OS_HostStkAlloc(&attr);
+        if (OS_TickStkLo == NULL ||
+            pthread_create(&tick_thread, &attr, OS_TickThread, NULL) != 0)
+        {
+            pthread_attr_destroy(&attr);
+            *p_err = OS_ERR_FATAL_RETURN;
+            return;
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    App_OS_HostMain();
+
+    // Like the target, OSStart() never returns
+    while (1)
+    {
+        pause();
+    }
+}
+
+// The running task keeps the CPU until the matching OSSchedUnlock(); ISRs still run
+void OSSchedLock(OS_ERR *p_err)
+{
+    if (OS_HostSelf == NULL)
+    {
+        *p_err = OS_ERR_SCHED_LOCKED;
+        return;
+    }
+    OS_Lock();
+    OSSchedLockNestingCtr++;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+void OSSchedUnlock(OS_ERR *p_err)
+{
+    OS_Lock();
+    if (OSSchedLockNestingCtr == 0u)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_SCHED_NOT_LOCKED;
+        return;
+    }
+    if (--OSSchedLockNestingCtr == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+void OSIntEnter(void)
+{
+    OS_Lock();
+    OSIntNestingCtr++;
+    OS_Unlock();
+}
+
+void OSIntExit(void)
+{
+    OS_Lock();
+    if (OSIntNestingCtr > 0u)
+    {
+        OSIntNestingCtr--;
+    }
+    OS_Sched();
+    OS_Unlock();
+}
+
+void OSTimeTick(void)
+{
+    OS_TMR *expired[OS_CFG_TMR_MAX];
+    CPU_INT08U n_expired = 0u;
+    CPU_INT08U i;
+
+    OS_TickHookCycles = 0u;
+    if (OS_AppTimeTickHookPtr != NULL)
+    {
+        CPU_TS64 t0 = CPU_TS_Get64();
+
+        OS_AppTimeTickHookPtr();
+        OS_TickHookCycles = CPU_TS_Get64() - t0;
+    }
+
+    OS_Lock();
+    OSTickCtr++;
+
+    for (i = 0u; i < OS_TaskQty; i++)
+    {
+        OS_TCB *p_tcb = OS_TaskTbl[i];
+        if ((p_tcb->TaskState == OS_TASK_STATE_DLY || p_tcb->TaskState == OS_TASK_STATE_PEND_TIMEOUT) &&
+            OS_TickReached(p_tcb->TickExpiry))
+        {
+            OS_Rdy(p_tcb,
+                   p_tcb->TaskState == OS_TASK_STATE_DLY ? OS_STATUS_PEND_OK : OS_STATUS_PEND_TIMEOUT,
+                   OS_TS_GET());
+        }
+    }
+
+    for (i = 0u; i < OS_TmrQty; i++)
+    {
+        OS_TMR *p_tmr = OS_TmrTbl[i];
+        if (p_tmr->State == OS_TMR_STATE_RUNNING && OS_TickReached(p_tmr->Match))
+        {
+            if (p_tmr->Opt == OS_OPT_TMR_PERIODIC)
+            {
+                p_tmr->Match += p_tmr->Period;
+            }
+            else
+            {
+                p_tmr->State = OS_TMR_STATE_COMPLETED;
+            }
+            expired[n_expired++] = p_tmr;
+        }
+    }
+    OS_Unlock();
+
+    // Callbacks run outside the kernel lock so they can use the API (timer task context)
+    for (i = 0u; i < n_expired; i++)
+    {
+        expired[i]->CallbackPtr(expired[i], expired[i]->CallbackPtrArg);
+    }
+}
+
+OS_TICK OSTimeGet(OS_ERR *p_err)
+{
+    *p_err = OS_ERR_NONE;
+    return OSTickCtr;
+}
+
+void OSTimeDly(OS_TICK dly, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+
+    if (p_tcb == NULL)
+    {
+        *p_err = OS_ERR_TIME_DLY_ISR;
+        return;
+    }
+
+    OS_Lock();
+    if (opt & OS_OPT_TIME_PERIODIC)
+    {
+        p_tcb->TickCtrPrev += dly;
+        p_tcb->TickExpiry = p_tcb->TickCtrPrev;
+    }
+    else
+    {
+        p_tcb->TickExpiry = OSTickCtr + dly;
+    }
+
+    if (dly > 0u && !OS_TickReached(p_tcb->TickExpiry))
+    {
+        p_tcb->TaskState = OS_TASK_STATE_DLY;
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+void OSTimeDlyHMSM(CPU_INT16U hours, CPU_INT16U minutes, CPU_INT16U seconds,
+                   CPU_INT32U milli, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TICK ticks;
+
+    ticks = ((OS_TICK)hours * 3600u + (OS_TICK)minutes * 60u + (OS_TICK)seconds) * OS_CFG_TICK_RATE_HZ
+          + OS_CFG_TICK_RATE_HZ * (milli + 500u / OS_CFG_TICK_RATE_HZ) / 1000u;
+    OSTimeDly(ticks, opt & ~OS_OPT_TIME_HMSM_NON_STRICT, p_err);
+}
+
+// ---------------------------------------------------------------------------
+// Tasks and task semaphores
+// ---------------------------------------------------------------------------
+
+static void *OS_TaskThread(void *p_arg)
+{
+    OS_TCB *p_tcb = (OS_TCB *)p_arg;
+
+    OS_HostSelf = p_tcb;
+    p_tcb->HostStkTop = (CPU_STK *)__builtin_frame_address(0);
+    pthread_mutex_lock(&OS_HostLock);
+    OS_HostWaitCPU(p_tcb);
+    OS_Unlock();
+
+    p_tcb->TaskEntryAddr(p_tcb->TaskEntryArg);
+
+    // Returning from a task deletes it
+    OS_Lock();
+    p_tcb->TaskState = OS_TASK_STATE_DEL;
+    OS_HostSelf = NULL;
+    OS_Sched();
+    OS_Unlock();
+    return NULL;
+}
+
+void OSTaskCreate(OS_TCB *p_tcb, CPU_CHAR *p_name, OS_TASK_PTR p_task, void *p_arg,
+                  OS_PRIO prio, CPU_STK *p_stk_base, CPU_STK_SIZE stk_limit,
+                  CPU_STK_SIZE stk_size, OS_MSG_QTY q_size, OS_TICK time_quanta,
+                  void *p_ext, OS_OPT opt, OS_ERR *p_err)
+{
+    pthread_attr_t attr;
+
+    (void)stk_limit;
+    (void)q_size;
+    (void)time_quanta;
+    (void)p_ext;
+
+    if (OS_HostSelf == NULL && OSIntNestingCtr > 0u)
+    {
+        *p_err = OS_ERR_TASK_CREATE_ISR;
+        return;
+    }
+    if (p_tcb == NULL)
+    {
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    if (prio >= OS_CFG_PRIO_MAX - 1u)
+    {
+        *p_err = OS_ERR_PRIO_INVALID;
+        return;
+    }
+
+    OS_Lock();
+    if (OS_TaskQty >= OS_CFG_TASK_MAX)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+
+    memset(p_tcb, 0, sizeof(*p_tcb));
+    p_tcb->NamePtr = p_name;
+    p_tcb->TaskEntryAddr = p_task;
+    p_tcb->TaskEntryArg = p_arg;
+    p_tcb->Prio = prio;
+    p_tcb->BasePrio = prio;
+    p_tcb->Opt = opt;
+    p_tcb->StkBasePtr = p_stk_base;
+    p_tcb->StkSize = stk_size;
+    p_tcb->TaskState = OS_TASK_STATE_RDY;
+    p_tcb->TickCtrPrev = OSTickCtr;
+    pthread_cond_init(&p_tcb->Cond, NULL);
+
+    if ((opt & OS_OPT_TASK_STK_CLR) && p_stk_base != NULL)
+    {
+        memset(p_stk_base, 0, stk_size * sizeof(CPU_STK));
+    }
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    p_tcb->HostStkLo = OS_HostStkAlloc(&attr);
+    if (p_tcb->HostStkLo == NULL ||
+        pthread_create(&p_tcb->Thread, &attr, OS_TaskThread, p_tcb) != 0)
+    {
+        pthread_attr_destroy(&attr);
+        OS_Unlock();
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    pthread_attr_destroy(&attr);
+
+    OS_TaskTbl[OS_TaskQty++] = p_tcb;
+    OS_Sched();
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+OS_SEM_CTR OSTaskSemPend(OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+    OS_SEM_CTR ctr;
+
+    if (OS_PendFromISR(opt, p_err) || p_tcb == NULL)
+    {
+        *p_err = OS_ERR_PEND_ISR;
+        return 0u;
+    }
+
+    OS_Lock();
+    if (p_tcb->SemCtr > 0u)
+    {
+        ctr = --p_tcb->SemCtr;
+        if (p_ts != NULL)
+        {
+            *p_ts = p_tcb->TS;
+        }
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return ctr;
+    }
+    if (opt & OS_OPT_PEND_NON_BLOCKING)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return 0u;
+    }
+
+    OS_Pend(p_tcb, OS_TASK_PEND_ON_TASK_SEM, p_tcb, timeout);
+    *p_err = OS_PendStatusErr(p_tcb->PendStatus);
+    if (p_ts != NULL)
+    {
+        *p_ts = p_tcb->TS;
+    }
+    ctr = p_tcb->SemCtr;
+    OS_Unlock();
+    return ctr;
+}
+
+OS_SEM_CTR OSTaskSemPost(OS_TCB *p_tcb, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_SEM_CTR ctr;
+    CPU_TS ts = OS_TS_GET();
+
+    if (p_tcb == NULL)
+    {
+        p_tcb = OS_HostSelf;
+    }
+
+    OS_Lock();
+    if (p_tcb->PendOn == OS_TASK_PEND_ON_TASK_SEM)
+    {
+        OS_Rdy(p_tcb, OS_STATUS_PEND_OK, ts);
+        ctr = 0u;
+        if ((opt & OS_OPT_POST_NO_SCHED) == 0u)
+        {
+            OS_Sched();
+        }
+    }
+    else
+    {
+        if (p_tcb->SemCtr == (OS_SEM_CTR)~0u)
+        {
+            OS_Unlock();
+            *p_err = OS_ERR_SEM_OVF;
+            return 0u;
+        }
+        ctr = ++p_tcb->SemCtr;
+        p_tcb->TS = ts;
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return ctr;
+}
+
+OS_SEM_CTR OSTaskSemSet(OS_TCB *p_tcb, OS_SEM_CTR cnt, OS_ERR *p_err)
+{
+    OS_SEM_CTR prev;
+
+    if (p_tcb == NULL)
+    {
+        p_tcb = OS_HostSelf;
+    }
+
+    OS_Lock();
+    prev = p_tcb->SemCtr;
+    if (p_tcb->PendOn == OS_TASK_PEND_ON_TASK_SEM)
+    {
+        *p_err = OS_ERR_TASK_WAITING;
+    }
+    else
+    {
+        p_tcb->SemCtr = cnt;
+        *p_err = OS_ERR_NONE;
+    }
+    OS_Unlock();
+    return prev;
+}
+
+CPU_BOOLEAN OSTaskSemPendAbort(OS_TCB *p_tcb, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_Lock();
+    if (p_tcb == NULL || p_tcb->PendOn != OS_TASK_PEND_ON_TASK_SEM)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_PEND_ABORT_NONE;
+        return false;
+    }
+    OS_Rdy(p_tcb, OS_STATUS_PEND_ABORT, OS_TS_GET());
+    if ((opt & OS_OPT_POST_NO_SCHED) == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return true;
+}
+
+// Stack high-water mark: on the host measured on the task's thread stack,
+// free counted against the configured StkSize as on the target
+void OSTaskStkChk(OS_TCB *p_tcb, CPU_STK_SIZE *p_free, CPU_STK_SIZE *p_used, OS_ERR *p_err)
+{
+    CPU_STK_SIZE used;
+
+    if (p_free == NULL || p_used == NULL)
+    {
+        *p_err = OS_ERR_PTR_INVALID;
+        return;
+    }
+    OS_Lock();
+    if (p_tcb == NULL)
+    {
+        p_tcb = OS_HostSelf;
+    }
+    if (p_tcb == NULL)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TCB_INVALID;
+        return;
+    }
+    if ((p_tcb->Opt & OS_OPT_TASK_STK_CHK) == 0u)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TASK_OPT;
+        return;
+    }
+    used = OS_HostStkUsed(p_tcb->HostStkLo, p_tcb->HostStkTop);
+    OS_Unlock();
+    *p_used = used;
+    *p_free = (used < p_tcb->StkSize) ? p_tcb->StkSize - used : 0u;
+    *p_err = OS_ERR_NONE;
+}
+
+// ---------------------------------------------------------------------------
+// Semaphores
+// ---------------------------------------------------------------------------
+
+void OSSemCreate(OS_SEM *p_sem, CPU_CHAR *p_name, OS_SEM_CTR cnt, OS_ERR *p_err)
+{
+    if (p_sem == NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+    p_sem->NamePtr = p_name;
+    p_sem->Ctr = cnt;
+    p_sem->TS = 0u;
+    *p_err = OS_ERR_NONE;
+}
+
+OS_SEM_CTR OSSemPend(OS_SEM *p_sem, OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+    OS_SEM_CTR ctr;
+
+    if (OS_PendFromISR(opt, p_err))
+    {
+        return 0u;
+    }
+
+    OS_Lock();
+    if (p_sem->Ctr > 0u)
+    {
+        ctr = --p_sem->Ctr;
+        if (p_ts != NULL)
+        {
+            *p_ts = p_sem->TS;
+        }
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return ctr;
+    }
+    if ((opt & OS_OPT_PEND_NON_BLOCKING) || p_tcb == NULL)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return 0u;
+    }
+
+    OS_Pend(p_tcb, OS_TASK_PEND_ON_SEM, p_sem, timeout);
+    *p_err = OS_PendStatusErr(p_tcb->PendStatus);
+    if (p_ts != NULL)
+    {
+        *p_ts = p_tcb->TS;
+    }
+    ctr = p_sem->Ctr;
+    OS_Unlock();
+    return ctr;
+}
+
+OS_SEM_CTR OSSemPost(OS_SEM *p_sem, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb;
+    OS_SEM_CTR ctr;
+    CPU_TS ts = OS_TS_GET();
+
+    OS_Lock();
+    p_tcb = OS_PendListHighest(OS_TASK_PEND_ON_SEM, p_sem);
+    if (p_tcb == NULL)
+    {
+        if (p_sem->Ctr == (OS_SEM_CTR)~0u)
+        {
+            OS_Unlock();
+            *p_err = OS_ERR_SEM_OVF;
+            return 0u;
+        }
+        ctr = ++p_sem->Ctr;
+        p_sem->TS = ts;
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return ctr;
+    }
+
+    do
+    {
+        OS_Rdy(p_tcb, OS_STATUS_PEND_OK, ts);
+        p_tcb = (opt & OS_OPT_POST_ALL) ? OS_PendListHighest(OS_TASK_PEND_ON_SEM, p_sem) : NULL;
+    } while (p_tcb != NULL);
+
+    ctr = p_sem->Ctr;
+    if ((opt & OS_OPT_POST_NO_SCHED) == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return ctr;
+}
+
+void OSSemSet(OS_SEM *p_sem, OS_SEM_CTR cnt, OS_ERR *p_err)
+{
+    OS_Lock();
+    if (OS_PendListHighest(OS_TASK_PEND_ON_SEM, p_sem) != NULL)
+    {
+        *p_err = OS_ERR_TASK_WAITING;
+    }
+    else
+    {
+        p_sem->Ctr = cnt;
+        *p_err = OS_ERR_NONE;
+    }
+    OS_Unlock();
+}
+
+OS_OBJ_QTY OSSemPendAbort(OS_SEM *p_sem, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb;
+    OS_OBJ_QTY n = 0u;
+    CPU_TS ts = OS_TS_GET();
+
+    OS_Lock();
+    while ((p_tcb = OS_PendListHighest(OS_TASK_PEND_ON_SEM, p_sem)) != NULL)
+    {
+        OS_Rdy(p_tcb, OS_STATUS_PEND_ABORT, ts);
+        n++;
+        if ((opt & OS_OPT_PEND_ABORT_ALL) == 0u)
+        {
+            break;
+        }
+    }
+    if (n > 0u && (opt & OS_OPT_POST_NO_SCHED) == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = (n > 0u) ? OS_ERR_NONE : OS_ERR_PEND_ABORT_NONE;
+    return n;
+}
+
+// ---------------------------------------------------------------------------
+// Mutexes (with priority inheritance)
+// ---------------------------------------------------------------------------
+
+void OSMutexCreate(OS_MUTEX *p_mutex, CPU_CHAR *p_name, OS_ERR *p_err)
+{
+    if (p_mutex == NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+    p_mutex->NamePtr = p_name;
+    p_mutex->OwnerTCBPtr = NULL;
+    p_mutex->OwnerNestingCtr = 0u;
+    p_mutex->TS = 0u;
+    *p_err = OS_ERR_NONE;
+}
+
+void OSMutexPend(OS_MUTEX *p_mutex, OS_TICK timeout, OS_OPT opt, CPU_TS *p_ts, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+
+    if (p_tcb == NULL)
+    {
+        *p_err = OS_ERR_PEND_ISR;
+        return;
+    }
+
+    OS_Lock();
+    if (p_mutex->OwnerTCBPtr == NULL)
+    {
+        p_mutex->OwnerTCBPtr = p_tcb;
+        p_mutex->OwnerNestingCtr = 1u;
+        if (p_ts != NULL)
+        {
+            *p_ts = p_mutex->TS;
+        }
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+    if (p_mutex->OwnerTCBPtr == p_tcb)
+    {
+        p_mutex->OwnerNestingCtr++;
+        OS_Unlock();
+        *p_err = OS_ERR_MUTEX_OWNER;
+        return;
+    }
+    if (opt & OS_OPT_PEND_NON_BLOCKING)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return;
+    }
+
+    // Priority inheritance: the owner runs at the waiter's priority until it posts
+    if (p_mutex->OwnerTCBPtr->Prio > p_tcb->Prio)
+    {
+        p_mutex->OwnerTCBPtr->Prio = p_tcb->Prio;
+    }
+
+    OS_Pend(p_tcb, OS_TASK_PEND_ON_MUTEX, p_mutex, timeout);
+    *p_err = OS_PendStatusErr(p_tcb->PendStatus);
+    if (p_ts != NULL)
+    {
+        *p_ts = p_tcb->TS;
+    }
+    OS_Unlock();
+}
+
+void OSMutexPost(OS_MUTEX *p_mutex, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+    OS_TCB *p_next;
+    CPU_TS ts = OS_TS_GET();
+
+    OS_Lock();
+    if (p_mutex->OwnerTCBPtr != p_tcb || p_tcb == NULL)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_MUTEX_NOT_OWNER;
+        return;
+    }
+    if (--p_mutex->OwnerNestingCtr > 0u)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_MUTEX_NESTING;
+        return;
+    }
+
+    p_tcb->Prio = p_tcb->BasePrio;
+    p_mutex->TS = ts;
+    p_next = OS_PendListHighest(OS_TASK_PEND_ON_MUTEX, p_mutex);
+    if (p_next == NULL)
+    {
+        p_mutex->OwnerTCBPtr = NULL;
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+
+    // Hand the mutex straight to the highest-priority waiter
+    p_mutex->OwnerTCBPtr = p_next;
+    p_mutex->OwnerNestingCtr = 1u;
+    OS_Rdy(p_next, OS_STATUS_PEND_OK, ts);
+    if ((opt & OS_OPT_POST_NO_SCHED) == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+// ---------------------------------------------------------------------------
+// Message queues
+// ---------------------------------------------------------------------------
+
+void OSQCreate(OS_Q *p_q, CPU_CHAR *p_name, OS_MSG_QTY max_qty, OS_ERR *p_err)
+{
+    if (p_q == NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+    if (max_qty == 0u || max_qty > OS_CFG_Q_SIZE_MAX)
+    {
+        *p_err = OS_ERR_Q_SIZE;
+        return;
+    }
+    memset(p_q, 0, sizeof(*p_q));
+    p_q->NamePtr = p_name;
+    p_q->NbrEntriesSize = max_qty;
+    *p_err = OS_ERR_NONE;
+}
+
+void *OSQPend(OS_Q *p_q, OS_TICK timeout, OS_OPT opt, OS_MSG_SIZE *p_msg_size,
+              CPU_TS *p_ts, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+    void *p_void;
+
+    if (OS_PendFromISR(opt, p_err))
+    {
+        return NULL;
+    }
+
+    OS_Lock();
+    if (p_q->NbrEntries > 0u)
+    {
+        OS_MSG *p_msg = &p_q->Msgs[p_q->OutIx];
+        p_void = p_msg->MsgPtr;
+        *p_msg_size = p_msg->MsgSize;
+        if (p_ts != NULL)
+        {
+            *p_ts = p_msg->MsgTS;
+        }
+        p_q->OutIx = (OS_MSG_QTY)((p_q->OutIx + 1u) % p_q->NbrEntriesSize);
+        p_q->NbrEntries--;
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return p_void;
+    }
+    if ((opt & OS_OPT_PEND_NON_BLOCKING) || p_tcb == NULL)
+    {
+        OS_Unlock();
+        *p_msg_size = 0u;
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return NULL;
+    }
+
+    OS_Pend(p_tcb, OS_TASK_PEND_ON_Q, p_q, timeout);
+    *p_err = OS_PendStatusErr(p_tcb->PendStatus);
+    if (*p_err == OS_ERR_NONE)
+    {
+        p_void = p_tcb->MsgPtr;
+        *p_msg_size = p_tcb->MsgSize;
+    }
+    else
+    {
+        p_void = NULL;
+        *p_msg_size = 0u;
+    }
+    if (p_ts != NULL)
+    {
+        *p_ts = p_tcb->TS;
+    }
+    OS_Unlock();
+    return p_void;
+}
+
+void OSQPost(OS_Q *p_q, void *p_void, OS_MSG_SIZE msg_size, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb;
+    CPU_TS ts = OS_TS_GET();
+
+    OS_Lock();
+    p_tcb = OS_PendListHighest(OS_TASK_PEND_ON_Q, p_q);
+    if (p_tcb != NULL)
+    {
+        // A task is waiting: hand the message over directly
+        p_tcb->MsgPtr = p_void;
+        p_tcb->MsgSize = msg_size;
+        OS_Rdy(p_tcb, OS_STATUS_PEND_OK, ts);
+        if ((opt & OS_OPT_POST_NO_SCHED) == 0u)
+        {
+            OS_Sched();
+        }
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return;
+    }
+
+    if (p_q->NbrEntries >= p_q->NbrEntriesSize)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_Q_MAX;
+        return;
+    }
+
+    if (opt & OS_OPT_POST_LIFO)
+    {
+        p_q->OutIx = (OS_MSG_QTY)((p_q->OutIx + p_q->NbrEntriesSize - 1u) % p_q->NbrEntriesSize);
+        p_q->Msgs[p_q->OutIx] = (OS_MSG){ p_void, msg_size, ts };
+    }
+    else
+    {
+        p_q->InIx = (OS_MSG_QTY)((p_q->OutIx + p_q->NbrEntries) % p_q->NbrEntriesSize);
+        p_q->Msgs[p_q->InIx] = (OS_MSG){ p_void, msg_size, ts };
+    }
+    p_q->NbrEntries++;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+// ---------------------------------------------------------------------------
+// Event flags
+// ---------------------------------------------------------------------------
+
+// Flags of interest that satisfy the wait condition, or 0 if not satisfied
+static OS_FLAGS OS_FlagTest(OS_FLAGS grp_flags, OS_FLAGS flags, OS_OPT mode)
+{
+    OS_FLAGS rdy;
+
+    switch (mode)
+    {
+        case OS_OPT_PEND_FLAG_SET_ALL:
+            rdy = grp_flags & flags;
+            return (rdy == flags) ? rdy : 0u;
+        case OS_OPT_PEND_FLAG_SET_ANY:
+            return grp_flags & flags;
+        case OS_OPT_PEND_FLAG_CLR_ALL:
+            rdy = ~grp_flags & flags;
+            return (rdy == flags) ? rdy : 0u;
+        case OS_OPT_PEND_FLAG_CLR_ANY:
+            return ~grp_flags & flags;
+        default:
+            return 0u;
+    }
+}
+
+static void OS_FlagConsume(OS_FLAG_GRP *p_grp, OS_FLAGS rdy, OS_OPT opt)
+{
+    if (opt & OS_OPT_PEND_FLAG_CONSUME)
+    {
+        OS_OPT mode = opt & OS_OPT_PEND_FLAG_MASK;
+        if (mode == OS_OPT_PEND_FLAG_SET_ALL || mode == OS_OPT_PEND_FLAG_SET_ANY)
+        {
+            p_grp->Flags &= ~rdy;
+        }
+        else
+        {
+            p_grp->Flags |= rdy;
+        }
+    }
+}
+
+void OSFlagCreate(OS_FLAG_GRP *p_grp, CPU_CHAR *p_name, OS_FLAGS flags, OS_ERR *p_err)
+{
+    if (p_grp == NULL)
+    {
+        *p_err = OS_ERR_OBJ_PTR_NULL;
+        return;
+    }
+    p_grp->NamePtr = p_name;
+    p_grp->Flags = flags;
+    p_grp->TS = 0u;
+    *p_err = OS_ERR_NONE;
+}
+
+OS_FLAGS OSFlagPend(OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_TICK timeout, OS_OPT opt,
+                    CPU_TS *p_ts, OS_ERR *p_err)
+{
+    OS_TCB *p_tcb = OS_HostSelf;
+    OS_OPT mode = opt & OS_OPT_PEND_FLAG_MASK;
+    OS_FLAGS rdy;
+
+    if (mode != OS_OPT_PEND_FLAG_SET_ALL && mode != OS_OPT_PEND_FLAG_SET_ANY &&
+        mode != OS_OPT_PEND_FLAG_CLR_ALL && mode != OS_OPT_PEND_FLAG_CLR_ANY)
+    {
+        *p_err = OS_ERR_FLAG_PEND_OPT;
+        return 0u;
+    }
+    if (OS_PendFromISR(opt, p_err))
+    {
+        return 0u;
+    }
+
+    OS_Lock();
+    rdy = OS_FlagTest(p_grp->Flags, flags, mode);
+    if (rdy != 0u)
+    {
+        OS_FlagConsume(p_grp, rdy, opt);
+        if (p_ts != NULL)
+        {
+            *p_ts = p_grp->TS;
+        }
+        OS_Unlock();
+        *p_err = OS_ERR_NONE;
+        return rdy;
+    }
+    if ((opt & OS_OPT_PEND_NON_BLOCKING) || p_tcb == NULL)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_PEND_WOULD_BLOCK;
+        return 0u;
+    }
+
+    p_tcb->FlagsPend = flags;
+    p_tcb->FlagsOpt = opt;
+    p_tcb->FlagsRdy = 0u;
+    OS_Pend(p_tcb, OS_TASK_PEND_ON_FLAG, p_grp, timeout);
+    *p_err = OS_PendStatusErr(p_tcb->PendStatus);
+    if (p_ts != NULL)
+    {
+        *p_ts = p_tcb->TS;
+    }
+    rdy = (*p_err == OS_ERR_NONE) ? p_tcb->FlagsRdy : 0u;
+    OS_Unlock();
+    return rdy;
+}
+
+OS_FLAGS OSFlagPost(OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_OPT opt, OS_ERR *p_err)
+{
+    OS_FLAGS grp_flags;
+    CPU_TS ts = OS_TS_GET();
+    CPU_BOOLEAN readied = false;
+    CPU_INT08U i;
+
+    OS_Lock();
+    if (opt & OS_OPT_POST_FLAG_CLR)
+    {
+        p_grp->Flags &= ~flags;
+    }
+    else
+    {
+        p_grp->Flags |= flags;
+    }
+    p_grp->TS = ts;
+
+    // Wake every waiter whose condition now holds, highest priority first
+    for (;;)
+    {
+        OS_TCB *p_high = NULL;
+        OS_FLAGS rdy_high = 0u;
+
+        for (i = 0u; i < OS_TaskQty; i++)
+        {
+            OS_TCB *p_tcb = OS_TaskTbl[i];
+            OS_FLAGS rdy;
+            if (p_tcb->PendOn != OS_TASK_PEND_ON_FLAG || p_tcb->PendObjPtr != p_grp)
+            {
+                continue;
+            }
+            rdy = OS_FlagTest(p_grp->Flags, p_tcb->FlagsPend, p_tcb->FlagsOpt & OS_OPT_PEND_FLAG_MASK);
+            if (rdy != 0u && (p_high == NULL || p_tcb->Prio < p_high->Prio))
+            {
+                p_high = p_tcb;
+                rdy_high = rdy;
+            }
+        }
+        if (p_high == NULL)
+        {
+            break;
+        }
+        p_high->FlagsRdy = rdy_high;
+        OS_FlagConsume(p_grp, rdy_high, p_high->FlagsOpt);
+        OS_Rdy(p_high, OS_STATUS_PEND_OK, ts);
+        readied = true;
+    }
+
+    grp_flags = p_grp->Flags;
+    if (readied && (opt & OS_OPT_POST_NO_SCHED) == 0u)
+    {
+        OS_Sched();
+    }
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return grp_flags;
+}
+
+// Non-blocking check (uC/OS-II style); equivalent to OSFlagPend(..., OS_OPT_PEND_NON_BLOCKING)
+OS_FLAGS OSFlagAccept(OS_FLAG_GRP *p_grp, OS_FLAGS flags, OS_OPT opt, OS_ERR *p_err)
+{
+    return OSFlagPend(p_grp, flags, 0u, opt | OS_OPT_PEND_NON_BLOCKING, NULL, p_err);
+}
+
+// ---------------------------------------------------------------------------
+// Memory partitions
+// ---------------------------------------------------------------------------
+
+void OSMemCreate(OS_MEM *p_mem, CPU_CHAR *p_name, void *p_addr, OS_MEM_QTY n_blks,
+                 OS_MEM_SIZE blk_size, OS_ERR *p_err)
+{
+    if (p_addr == NULL)
+    {
+        *p_err = OS_ERR_MEM_INVALID_P_ADDR;
+        return;
+    }
+    if (n_blks < 2u || n_blks > OS_CFG_MEM_BLKS_MAX || blk_size == 0u)
+    {
+        *p_err = OS_ERR_MEM_INVALID_BLKS;
+        return;
+    }
+    p_mem->NamePtr = p_name;
+    p_mem->AddrPtr = p_addr;
+    p_mem->BlkSize = blk_size;
+    p_mem->NbrMax = n_blks;
+    p_mem->NbrFree = n_blks;
+    p_mem->FreeMask = (n_blks == 64u) ? ~(CPU_INT64U)0u : (((CPU_INT64U)1u << n_blks) - 1u);
+    *p_err = OS_ERR_NONE;
+}
+
+void *OSMemGet(OS_MEM *p_mem, OS_ERR *p_err)
+{
+    unsigned ix;
+
+    OS_Lock();
+    if (p_mem->FreeMask == 0u)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_MEM_NO_FREE_BLKS;
+        return NULL;
+    }
+    ix = (unsigned)__builtin_ctzll(p_mem->FreeMask);
+    p_mem->FreeMask &= ~((CPU_INT64U)1u << ix);
+    p_mem->NbrFree--;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return (CPU_INT08U *)p_mem->AddrPtr + (size_t)ix * p_mem->BlkSize;
+}
+
+void OSMemPut(OS_MEM *p_mem, void *p_blk, OS_ERR *p_err)
+{
+    size_t offset;
+    unsigned ix;
+
+    if (p_blk == NULL || (CPU_INT08U *)p_blk < (CPU_INT08U *)p_mem->AddrPtr)
+    {
+        *p_err = OS_ERR_MEM_INVALID_P_ADDR;
+        return;
+    }
+    offset = (size_t)((CPU_INT08U *)p_blk - (CPU_INT08U *)p_mem->AddrPtr);
+    ix = (unsigned)(offset / p_mem->BlkSize);
+    if (offset % p_mem->BlkSize != 0u || ix >= p_mem->NbrMax)
+    {
+        *p_err = OS_ERR_MEM_INVALID_P_ADDR;
+        return;
+    }
+
+    OS_Lock();
+    if (p_mem->FreeMask & ((CPU_INT64U)1u << ix))
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_MEM_FULL;
+        return;
+    }
+    p_mem->FreeMask |= (CPU_INT64U)1u << ix;
+    p_mem->NbrFree++;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+// ---------------------------------------------------------------------------
+// Software timers (callbacks run from the tick, see OSTimeTick)
+// ---------------------------------------------------------------------------
+
+void OSTmrCreate(OS_TMR *p_tmr, CPU_CHAR *p_name, OS_TICK dly, OS_TICK period, OS_OPT opt,
+                 OS_TMR_CALLBACK_PTR p_callback, void *p_callback_arg, OS_ERR *p_err)
+{
+    if (p_tmr == NULL)
+    {
+        *p_err = OS_ERR_TMR_INVALID;
+        return;
+    }
+    if (opt == OS_OPT_TMR_PERIODIC && period == 0u)
+    {
+        *p_err = OS_ERR_TMR_INVALID_PERIOD;
+        return;
+    }
+
+    OS_Lock();
+    if (p_tmr->State == OS_TMR_STATE_UNUSED)
+    {
+        if (OS_TmrQty >= OS_CFG_TMR_MAX)
+        {
+            OS_Unlock();
+            *p_err = OS_ERR_TMR_INVALID;
+            return;
+        }
+        OS_TmrTbl[OS_TmrQty++] = p_tmr;
+    }
+    p_tmr->NamePtr = p_name;
+    p_tmr->CallbackPtr = p_callback;
+    p_tmr->CallbackPtrArg = p_callback_arg;
+    p_tmr->Dly = dly;
+    p_tmr->Period = period;
+    p_tmr->Opt = opt;
+    p_tmr->State = OS_TMR_STATE_STOPPED;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+// A running timer keeps its current expiry and reloads with the new period
+// after it; OSTmrStart() restarts it with the new delay at once
+void OSTmrSet(OS_TMR *p_tmr, OS_TICK dly, OS_TICK period, OS_TMR_CALLBACK_PTR p_callback,
+              void *p_callback_arg, OS_ERR *p_err)
+{
+    OS_Lock();
+    if (p_tmr->State == OS_TMR_STATE_UNUSED)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TMR_INVALID;
+        return;
+    }
+    if (p_tmr->Opt == OS_OPT_TMR_PERIODIC && period == 0u)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TMR_INVALID_PERIOD;
+        return;
+    }
+    p_tmr->Dly = dly;
+    p_tmr->Period = period;
+    p_tmr->CallbackPtr = p_callback;
+    p_tmr->CallbackPtrArg = p_callback_arg;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+}
+
+// Starting a running timer restarts it from its initial delay
+CPU_BOOLEAN OSTmrStart(OS_TMR *p_tmr, OS_ERR *p_err)
+{
+    OS_Lock();
+    if (p_tmr->State == OS_TMR_STATE_UNUSED)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TMR_INVALID;
+        return false;
+    }
+    p_tmr->Match = OSTickCtr + ((p_tmr->Dly > 0u) ? p_tmr->Dly : p_tmr->Period);
+    p_tmr->State = OS_TMR_STATE_RUNNING;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return true;
+}
+
+CPU_BOOLEAN OSTmrStop(OS_TMR *p_tmr, OS_OPT opt, void *p_callback_arg, OS_ERR *p_err)
+{
+    (void)opt;
+    (void)p_callback_arg;
+
+    OS_Lock();
+    if (p_tmr->State != OS_TMR_STATE_RUNNING)
+    {
+        OS_Unlock();
+        *p_err = OS_ERR_TMR_STOPPED;
+        return false;
+    }
+    p_tmr->State = OS_TMR_STATE_STOPPED;
+    OS_Unlock();
+    *p_err = OS_ERR_NONE;
+    return true;
+}
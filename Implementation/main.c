@@ -2,15 +2,19 @@
 #include "acc_types.h"
 #include "acc_config.h"
 #include "acc_hardware.h"
+#include "acc_trace.h"
 
 // Forward declarations for task functions
 void Setup_Task(void *p_arg);
+#if ACC_CYCLIC_EXEC
+void Frame_Task(void *p_arg);
+#else
 void Sensors_Task(void *p_arg);
 void Control_Task(void *p_arg);
 void Actuator_Task(void *p_arg);
+#endif
 void Display_Task(void *p_arg);
 void IRQ_sensors_ISR(void);
-void Watchdog_Timer_Callback(void *p_arg);
 
 int main(void)
 {
@@ -22,42 +26,95 @@ int main(void)
     // 2. Initialize uC/OS-III kernel
     OSInit(&err);
     
+#if ACC_TRACE_EN
+    //    - Trace rings and task-switch hook (before any task runs)
+    Trace_Init();
+#endif
+    
     // 3. Create kernel objects (before tasks)
     //    - Timer Semaphore
     OSSemCreate(&TimerSemaphore, "Timer Sem", 0, &err);
     
-    //    - Flow Control Semaphore
-    OSSemCreate(&FlowControlSemaphore, "Flow Ctrl Sem", 3, &err);
+    //    (Parameter Memory Block needs no kernel object: seqlock, see acc_seqlock.h)
+    
+    //    - Control→Actuator Latest-Value Mailbox (no queue, partition or
+    //      flow-control semaphore; Actuator is woken via its task semaphore)
+    Mailbox_Init(&ControlActuatorMailbox);
+    
+    //    - LCD shadow (Display_Task sends only the cells that changed)
+    Display_Init(&DisplayPanel);
+    
+    //    - Frame deadline monitor (no open job until the first release)
+    Deadline_Reset(&DeadlineMon);
+    
+#if ACC_RECOVERY_EN
+    //    - Checkpoint ring (no valid checkpoint until Control stores one)
+    Recovery_Init(&Recovery);
+#endif
     
-    //    - Parameter Block Mutex
-    OSMutexCreate(&ParamMutex, "Param Mutex", &err);
+#if ACC_MODE_EN
+    //    - Criticality mode (normal until a stage overruns its budget)
+    Mode_Init(&ModeMgr);
+#endif
     
-    //    - Control→Actuator Message Queue
-    OSQCreate(&ControlActuatorQueue, "Ctrl Act Queue", 3, &err);
+#if ACC_TELEMETRY_EN
+    //    - Telemetry ring (empty; Telem_Task writes the stream header first)
+    Telem_Init(&Telemetry);
+#endif
+    
+#if ACC_RATE_ADAPT_EN
+    //    - Control-rate levels (gain tables per sample period)
+    Rate_Init();
+    Rate_Reset(&RateCtl);
+#endif
+    
+#if ACC_KALMAN_EN
+    //    - Estimator model per control-rate level (and Q16.16 gain schedule)
+    Kalman_Init();
+    Kalman_Reset(&Estimator);
+#endif
     
     //    - Event Flag Group
     OSFlagCreate(&EventFlagGroup, "ACC Event Flags", (OS_FLAGS)0, &err);
     
-    //    - Memory Partition (for message buffers)
-    // Backing store: static float MessageBufferArray[3];
-    OSMemCreate(&MessagePartition, "Msg Partition", 
-                (void*)MessageBufferArray, 3, sizeof(float), &err);
-    
     // 4. Initialize Parameter Memory Block (set defaults before using)
-    Parameters.seq = 0;
-    Parameters.ACC01 = 0;  // ACC OFF
-    Parameters.K1 = 1.0f;  // Example controller gains (set before use)
-    Parameters.K2 = 0.5f;
-    Parameters.K3 = 0.25f;
-    Parameters.Vcruise = 100.0f;  // Example: 100 km/h cruise speed
-    Parameters.Xset = 50.0f;  // Example: 50m minimum safe distance
-    Parameters.deltaV = 5.0f;  // Example: 5 km/h reduction
-    Parameters.Vset = Parameters.Vcruise;  // Initialize Vset after Vcruise is set
-    Parameters.dMn = 0.0f;
-    Parameters.Xn = 0.0f;
-    Parameters.Vn = 0.0f;
-    Parameters.Vn1 = 0.0f;
-    Parameters.Vn2 = 0.0f;
+    //    (one block per writer, see acc_params.h)
+    Parameters.config.seq = 0;
+    Parameters.config.ACC01 = 0;  // ACC OFF
+    Parameters.config.engage = 0;
+    Parameters.config.rollback = 0;
+    Parameters.config.K1 = ACC_VALUE(1.0);  // Example controller gains (set before use)
+    Parameters.config.K2 = ACC_VALUE(0.5);
+    Parameters.config.K3 = ACC_VALUE(0.25);
+    Parameters.config.Vcruise = ACC_VALUE(100.0);  // Example: 100 km/h cruise speed
+    Parameters.config.Xset = ACC_VALUE(50.0);  // Example: 50m minimum safe distance
+    Parameters.config.deltaV = ACC_VALUE(5.0);  // Example: 5 km/h reduction
+    Parameters.config.law = ACC_LAW_DEFAULT;  // Equation 3 or explicit MPC
+    Parameters.control.seq = 0;
+    Parameters.control.Vset = Parameters.config.Vcruise;  // Initialize Vset after Vcruise is set
+    Parameters.control.dMn = ACC_VALUE(0.0);
+    Parameters.control.Amodel = ACC_VALUE(0.0);
+    Parameters.control.engage = 0;
+    Parameters.control.rollback = 0;
+    Parameters.sensor.seq = 0;
+    Parameters.sensor.Xn = ACC_VALUE(0.0);
+    Parameters.sensor.Vn = ACC_VALUE(0.0);
+    Parameters.sensor.Vn1 = ACC_VALUE(0.0);
+    Parameters.sensor.Vn2 = ACC_VALUE(0.0);
+    Parameters.sensor.rollback = 0;
+    
+#if ACC_CALIB_EN
+    //    - First calibration set: the defaults above at every speed
+    //      (within the CALIB_* ranges of acc_config.h)
+    {
+        ACC_CalibImage_t img;
+        
+        Calib_Flat(&img, 0u,
+                   Parameters.config.K1, Parameters.config.K2, Parameters.config.K3,
+                   Parameters.config.Vcruise, Parameters.config.Xset, Parameters.config.deltaV);
+        (void)Calib_Init(&Calibration, &img);
+    }
+#endif
     
     // 5. Create tasks (after objects are created)
     //    - Setup Task
@@ -66,23 +123,31 @@ int main(void)
                  STK_SIZE_SETUP, 0, 0, 0,
                  OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
     
-    //    - Sensors Task (FP task - save FP context)
+#if ACC_CYCLIC_EXEC
+    //    - Frame Task (cyclic executive: Sensors → Control → Actuator per release)
+    OSTaskCreate(&FrameTCB, "Frame", Frame_Task, 0,
+                 PRIO_FRAME, &FrameStk[0], STK_SIZE_FRAME/10,
+                 STK_SIZE_FRAME, 0, 0, 0,
+                 OPT_TASK_HARD, &err);
+#else
+    //    - Sensors Task (FP task - save FP context unless ACC_FIXED_POINT)
     OSTaskCreate(&SensorsTCB, "Sensors", Sensors_Task, 0,
                  PRIO_SENSORS, &SensorsStk[0], STK_SIZE_SENSORS/10,
                  STK_SIZE_SENSORS, 0, 0, 0,
-                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | OS_OPT_TASK_SAVE_FP, &err);
+                 OPT_TASK_HARD, &err);
     
-    //    - Control Task (FP task - save FP context)
+    //    - Control Task (FP task - save FP context unless ACC_FIXED_POINT)
     OSTaskCreate(&ControlTCB, "Control", Control_Task, 0,
                  PRIO_CONTROL, &ControlStk[0], STK_SIZE_CONTROL/10,
                  STK_SIZE_CONTROL, 0, 0, 0,
-                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | OS_OPT_TASK_SAVE_FP, &err);
+                 OPT_TASK_HARD, &err);
     
-    //    - Actuator Task (FP task - save FP context)
+    //    - Actuator Task (FP task - save FP context unless ACC_FIXED_POINT)
     OSTaskCreate(&ActuatorTCB, "Actuator", Actuator_Task, 0,
                  PRIO_ACTUATOR, &ActuatorStk[0], STK_SIZE_ACTUATOR/10,
                  STK_SIZE_ACTUATOR, 0, 0, 0,
-                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR | OS_OPT_TASK_SAVE_FP, &err);
+                 OPT_TASK_HARD, &err);
+#endif
     
     //    - Display Task
     OSTaskCreate(&DisplayTCB, "Display", Display_Task, 0,
@@ -90,14 +155,25 @@ int main(void)
                  STK_SIZE_DISPLAY, 0, 0, 0,
                  OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
     
-    // 6. Create and start watchdog timer (after tasks are ready)
-    OSTmrCreate(&WatchdogTimer, "WD Timer", 0,
-                MS_TO_TICKS(100), OS_OPT_TMR_PERIODIC,  // Period = 100ms (matches timer period)
-                Watchdog_Timer_Callback, NULL, &err);
+#if ACC_TRACE_EN
+    //    - Trace Task (drains the trace rings)
+    OSTaskCreate(&TraceTCB, "Trace", Trace_Task, 0,
+                 PRIO_TRACE, &TraceStk[0], STK_SIZE_TRACE/10,
+                 STK_SIZE_TRACE, 0, 0, 0,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+#endif
     
-    OSTmrStart(&WatchdogTimer, &err);
+#if ACC_TELEMETRY_EN
+    //    - Telem Task (drains the telemetry ring; lowest application priority)
+    OSTaskCreate(&TelemTCB, "Telem", Telem_Task, 0,
+                 PRIO_TELEM, &TelemStk[0], STK_SIZE_TELEM/10,
+                 STK_SIZE_TELEM, 0, 0, 0,
+                 OS_OPT_TASK_STK_CHK | OS_OPT_TASK_STK_CLR, &err);
+#endif
     
-    // 7. Start multitasking
+    // 6. Start multitasking
+    //    (frame deadlines are checked per job against the ISR release, see
+    //     acc_deadline.h; Setup_Task resets the monitor on ACC_ON)
     OSStart(&err);
     
     // Should never reach here